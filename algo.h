@@ -0,0 +1,1274 @@
+#ifndef MINISTL_ALGO_H
+#define MINISTL_ALGO_H
+
+// This header contains the algorithms of ministl beyond the basic ones in algobase.h
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "algobase.h"
+#include "functional.h"
+#include "heap_algo.h"
+#include "iterator.h"
+#include "memory.h"
+#include "simd_partition.h"
+#include "util.h"
+
+namespace ministl
+{
+    /*************************************************transform*********************************************/
+    /********************第一个版本以 unary_op 作用于[first, last)，结果保存到以 result 为起始的容器上*************/
+    /********************第二个版本以 binary_op 作用于两个序列，结果保存到以 result 为起始的容器上****************/
+    /*******************************************************************************************************/
+    template <class InputIter, class OutputIter, class UnaryOperation>
+    OutputIter transform(InputIter first, InputIter last, OutputIter result, UnaryOperation unary_op)
+    {
+        for (; first != last; ++first, ++result)
+        {
+            *result = unary_op(*first);
+        }
+        return result;
+    }
+
+    template <class InputIter1, class InputIter2, class OutputIter, class BinaryOperation>
+    OutputIter transform(InputIter1 first1, InputIter1 last1, InputIter2 first2,
+                         OutputIter result, BinaryOperation binary_op)
+    {
+        for (; first1 != last1; ++first1, ++first2, ++result)
+        {
+            *result = binary_op(*first1, *first2);
+        }
+        return result;
+    }
+
+    /***********************************************lower_bound*********************************************/
+    /****************************在[first, last)中查找第一个不小于 value 的元素，返回指向它的迭代器*****************/
+    /*******************************************************************************************************/
+    template <class ForwardIter, class T, class Compared>
+    ForwardIter lower_bound(ForwardIter first, ForwardIter last, const T& value, Compared comp)
+    {
+        auto len = ministl::distance(first, last);
+        while (len > 0)
+        {
+            const auto half = len / 2;
+            ForwardIter middle = first;
+            ministl::advance(middle, half);
+            if (comp(*middle, value))
+            {
+                first = ++middle;
+                len = len - half - 1;
+            }
+            else
+            {
+                len = half;
+            }
+        }
+        return first;
+    }
+
+    template <class ForwardIter, class T>
+    ForwardIter lower_bound(ForwardIter first, ForwardIter last, const T& value)
+    {
+        return ministl::lower_bound(first, last, value, ministl::less<T>());
+    }
+
+    /*****************************************branchless_lower_bound**************************************/
+    // notes:
+    // 与 lower_bound 结果相同，仅用于随机访问迭代器。每轮只根据比较结果移动 base，不提前退出，
+    // 编译器会把它生成条件传送(cmov)而不是分支，查找路径不可预测时省去了分支预测失败的代价；
+    // 循环次数固定为 ceil(log2(n))，对读多写少、被反复查找的有序数组(如 flat_set)更快。
+    /*******************************************************************************************************/
+    template <class RandomIter, class T, class Compared>
+    RandomIter branchless_lower_bound(RandomIter first, RandomIter last, const T& value, Compared comp)
+    {
+        auto len = last - first;
+        if (len == 0)
+            return first;
+        while (len > 1)
+        {
+            const auto half = len / 2;
+            first = comp(first[half], value) ? first + half : first;
+            len -= half;
+        }
+        return first + static_cast<decltype(len)>(comp(*first, value));
+    }
+
+    template <class RandomIter, class T>
+    RandomIter branchless_lower_bound(RandomIter first, RandomIter last, const T& value)
+    {
+        return ministl::branchless_lower_bound(first, last, value, ministl::less<T>());
+    }
+
+    /***********************************************upper_bound*********************************************/
+    /****************************在[first, last)中查找第一个大于 value 的元素，返回指向它的迭代器*******************/
+    /*******************************************************************************************************/
+    template <class ForwardIter, class T, class Compared>
+    ForwardIter upper_bound(ForwardIter first, ForwardIter last, const T& value, Compared comp)
+    {
+        auto len = ministl::distance(first, last);
+        while (len > 0)
+        {
+            const auto half = len / 2;
+            ForwardIter middle = first;
+            ministl::advance(middle, half);
+            if (comp(value, *middle))
+            {
+                len = half;
+            }
+            else
+            {
+                first = ++middle;
+                len = len - half - 1;
+            }
+        }
+        return first;
+    }
+
+    template <class ForwardIter, class T>
+    ForwardIter upper_bound(ForwardIter first, ForwardIter last, const T& value)
+    {
+        return ministl::upper_bound(first, last, value, ministl::less<T>());
+    }
+
+    /**************************************************rotate***********************************************/
+    /**********************将[first, middle)内的元素和 [middle, last)内的元素互换，返回原 first 的新位置*************/
+    /*******************************************************************************************************/
+    template <class ForwardIter>
+    ForwardIter rotate(ForwardIter first, ForwardIter middle, ForwardIter last)
+    {
+        if (first == middle)
+            return last;
+        if (middle == last)
+            return first;
+        ForwardIter first2 = middle;
+        do
+        {
+            ministl::iter_swap(first++, first2++);
+            if (first == middle)
+                middle = first2;
+        } while (first2 != last);
+        const ForwardIter new_first = first;
+        first2 = middle;
+        while (first2 != last)
+        {
+            ministl::iter_swap(first++, first2++);
+            if (first == middle)
+                middle = first2;
+            else if (first2 == last)
+                first2 = middle;
+        }
+        return new_first;
+    }
+
+    /************************************************is_sorted**********************************************/
+    template <class ForwardIter, class Compared>
+    bool is_sorted(ForwardIter first, ForwardIter last, Compared comp)
+    {
+        if (first == last)
+            return true;
+        ForwardIter next = first;
+        for (++next; next != last; first = next, ++next)
+        {
+            if (comp(*next, *first))
+                return false;
+        }
+        return true;
+    }
+
+    template <class ForwardIter>
+    bool is_sorted(ForwardIter first, ForwardIter last)
+    {
+        return ministl::is_sorted(first, last,
+                                  ministl::less<typename iterator_traits<ForwardIter>::value_type>());
+    }
+
+    /**************************************************sort*************************************************/
+    // notes:
+    // sort 为 introsort：三数取中(大区间取九数中位)的快速排序，区间短于 sort_insertion_threshold 时改用插入排序，
+    // 分区次数超过 2 * log2(n) 时改用堆排序，最坏情况仍为 O(nlogn)。
+    // 算术类型与指针使用 BlockQuicksort 式的无分支分区：先把放错一侧的元素的偏移量批量记入两个小块，
+    // 再成批交换，比较结果只参与算术运算而不产生难以预测的分支。
+    // 枢轴与左侧上一个枢轴相等时用 partition_left 把相等元素一次归位，大量重复元素时不会退化。
+    // 分区没有发生交换且较为均衡时尝试有限步数的插入排序，已排序的输入只需 O(n)。
+    /*******************************************************************************************************/
+    constexpr ptrdiff_t sort_insertion_threshold = 24;
+    constexpr ptrdiff_t sort_ninther_threshold = 128;
+    constexpr size_t    sort_partial_insertion_limit = 8;
+    constexpr size_t    sort_block_size = 64;
+
+    // 无分支分区只用于比较开销小且不会抛出异常的类型
+    template <class T>
+    struct sort_use_branchless : public m_bool_constant<std::is_arithmetic<T>::value ||
+                                                        std::is_pointer<T>::value> {};
+
+    template <class Size>
+    int sort_log2(Size n)
+    {
+        int k = 0;
+        for (; n > 1; n >>= 1)
+            ++k;
+        return k;
+    }
+
+    template <class RandomIter, class T, class Compared>
+    void unguarded_linear_insert(RandomIter last, T value, Compared comp)
+    {
+        RandomIter next = last;
+        --next;
+        while (comp(value, *next))
+        {
+            *last = ministl::move(*next);
+            last = next;
+            --next;
+        }
+        *last = ministl::move(value);
+    }
+
+    template <class RandomIter, class Compared>
+    void insertion_sort(RandomIter first, RandomIter last, Compared comp)
+    {
+        if (first == last)
+            return;
+        for (RandomIter i = first + 1; i != last; ++i)
+        {
+            auto value = ministl::move(*i);
+            if (comp(value, *first))
+            {
+                ministl::move_backward(first, i, i + 1);
+                *first = ministl::move(value);
+            }
+            else
+            {
+                ministl::unguarded_linear_insert(i, ministl::move(value), comp);
+            }
+        }
+    }
+
+    // 调用者保证 first 之前存在不大于区间内任何元素的值
+    template <class RandomIter, class Compared>
+    void unguarded_insertion_sort(RandomIter first, RandomIter last, Compared comp)
+    {
+        for (RandomIter i = first; i != last; ++i)
+            ministl::unguarded_linear_insert(i, ministl::move(*i), comp);
+    }
+
+    // 移动次数超过 sort_partial_insertion_limit 时放弃并返回 false
+    template <class RandomIter, class Compared>
+    bool partial_insertion_sort(RandomIter first, RandomIter last, Compared comp)
+    {
+        if (first == last)
+            return true;
+        size_t moved = 0;
+        for (RandomIter cur = first + 1; cur != last; ++cur)
+        {
+            if (moved > sort_partial_insertion_limit)
+                return false;
+            RandomIter sift = cur;
+            RandomIter sift_1 = cur - 1;
+            if (comp(*sift, *sift_1))
+            {
+                auto value = ministl::move(*sift);
+                do
+                {
+                    *sift-- = ministl::move(*sift_1);
+                } while (sift != first && comp(value, *--sift_1));
+                *sift = ministl::move(value);
+                moved += static_cast<size_t>(cur - sift);
+            }
+        }
+        return true;
+    }
+
+    template <class RandomIter, class Compared>
+    void sort2(RandomIter a, RandomIter b, Compared comp)
+    {
+        if (comp(*b, *a))
+            ministl::iter_swap(a, b);
+    }
+
+    // 使 *a <= *b <= *c
+    template <class RandomIter, class Compared>
+    void sort3(RandomIter a, RandomIter b, RandomIter c, Compared comp)
+    {
+        ministl::sort2(a, b, comp);
+        ministl::sort2(b, c, comp);
+        ministl::sort2(a, b, comp);
+    }
+
+    // 以 *first 为枢轴，小于枢轴的元素放到左边，其余放到右边，返回枢轴的最终位置以及分区前是否已经分好
+    // 调用者保证 (first, last) 中存在不小于枢轴的元素
+    template <class RandomIter, class Compared>
+    ministl::pair<RandomIter, bool>
+    partition_right(RandomIter first, RandomIter last, Compared comp, m_false_type)
+    {
+        auto pivot = ministl::move(*first);
+        RandomIter left = first;
+        RandomIter right = last;
+        while (comp(*++left, pivot));
+        if (left - 1 == first)
+            while (left < right && !comp(*--right, pivot));
+        else
+            while (!comp(*--right, pivot));
+        const bool already_partitioned = left >= right;
+        while (left < right)
+        {
+            ministl::iter_swap(left, right);
+            while (comp(*++left, pivot));
+            while (!comp(*--right, pivot));
+        }
+        RandomIter pivot_pos = left - 1;
+        *first = ministl::move(*pivot_pos);
+        *pivot_pos = ministl::move(pivot);
+        return ministl::pair<RandomIter, bool>(pivot_pos, already_partitioned);
+    }
+
+    // 按偏移量成批交换左右两侧放错的元素；数量相等时逐对交换，否则用一次循环移位减少赋值次数
+    template <class RandomIter>
+    void swap_offsets(RandomIter left_base, RandomIter right_base, const unsigned char* offsets_l,
+                      const unsigned char* offsets_r, size_t num, bool use_swaps)
+    {
+        if (use_swaps)
+        {
+            for (size_t i = 0; i < num; ++i)
+                ministl::iter_swap(left_base + offsets_l[i], right_base - offsets_r[i]);
+        }
+        else if (num > 0)
+        {
+            RandomIter l = left_base + offsets_l[0];
+            RandomIter r = right_base - offsets_r[0];
+            auto tmp = ministl::move(*l);
+            *l = ministl::move(*r);
+            for (size_t i = 1; i < num; ++i)
+            {
+                l = left_base + offsets_l[i];
+                *r = ministl::move(*l);
+                r = right_base - offsets_r[i];
+                *l = ministl::move(*r);
+            }
+            *r = ministl::move(tmp);
+        }
+    }
+
+    // 无分支版本，结果与上面的 partition_right 相同
+    template <class RandomIter, class Compared>
+    ministl::pair<RandomIter, bool>
+    partition_right(RandomIter first, RandomIter last, Compared comp, m_true_type)
+    {
+        auto pivot = ministl::move(*first);
+        RandomIter left = first;
+        RandomIter right = last;
+        while (comp(*++left, pivot));
+        if (left - 1 == first)
+            while (left < right && !comp(*--right, pivot));
+        else
+            while (!comp(*--right, pivot));
+        const bool already_partitioned = left >= right;
+        if (!already_partitioned)
+        {
+            ministl::iter_swap(left, right);
+            ++left;
+            alignas(64) unsigned char offsets_l[sort_block_size];
+            alignas(64) unsigned char offsets_r[sort_block_size];
+            RandomIter left_base = left;
+            RandomIter right_base = right;
+            size_t num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+            while (left < right)
+            {
+                // 只为空的块填充新的偏移量，剩余元素不足两块时平分给两侧
+                const size_t num_unknown = static_cast<size_t>(right - left);
+                const size_t left_split = num_l == 0 ? (num_r == 0 ? num_unknown / 2 : num_unknown) : 0;
+                const size_t right_split = num_r == 0 ? (num_unknown - left_split) : 0;
+                const size_t left_count = ministl::min(left_split, sort_block_size);
+                const size_t right_count = ministl::min(right_split, sort_block_size);
+                for (size_t i = 0; i < left_count; ++i)
+                {
+                    offsets_l[num_l] = static_cast<unsigned char>(i);
+                    num_l += !comp(*left, pivot);
+                    ++left;
+                }
+                for (size_t i = 0; i < right_count;)
+                {
+                    offsets_r[num_r] = static_cast<unsigned char>(++i);
+                    num_r += comp(*--right, pivot);
+                }
+                const size_t num = ministl::min(num_l, num_r);
+                ministl::swap_offsets(left_base, right_base, offsets_l + start_l, offsets_r + start_r,
+                                      num, num_l == num_r);
+                num_l -= num;
+                num_r -= num;
+                start_l += num;
+                start_r += num;
+                if (num_l == 0)
+                {
+                    start_l = 0;
+                    left_base = left;
+                }
+                if (num_r == 0)
+                {
+                    start_r = 0;
+                    right_base = right;
+                }
+            }
+            // 一侧的块还有剩余，把它们交换到分界处
+            if (num_l)
+            {
+                while (num_l--)
+                    ministl::iter_swap(left_base + offsets_l[start_l + num_l], --right);
+                left = right;
+            }
+            if (num_r)
+            {
+                while (num_r--)
+                    ministl::iter_swap(right_base - offsets_r[start_r + num_r], left), ++left;
+                right = left;
+            }
+        }
+        RandomIter pivot_pos = left - 1;
+        *first = ministl::move(*pivot_pos);
+        *pivot_pos = ministl::move(pivot);
+        return ministl::pair<RandomIter, bool>(pivot_pos, already_partitioned);
+    }
+
+    // 与枢轴相等的元素放到左边，返回枢轴的最终位置，之后 [first, pivot_pos] 都等于枢轴
+    template <class RandomIter, class Compared>
+    RandomIter partition_left(RandomIter first, RandomIter last, Compared comp)
+    {
+        auto pivot = ministl::move(*first);
+        RandomIter left = first;
+        RandomIter right = last;
+        while (comp(pivot, *--right));
+        if (right + 1 == last)
+            while (left < right && !comp(pivot, *++left));
+        else
+            while (!comp(pivot, *++left));
+        while (left < right)
+        {
+            ministl::iter_swap(left, right);
+            while (comp(pivot, *--right));
+            while (!comp(pivot, *++left));
+        }
+        *first = ministl::move(*right);
+        *right = ministl::move(pivot);
+        return right;
+    }
+
+    template <class RandomIter, class Compared, class Branchless>
+    void intro_sort(RandomIter first, RandomIter last, Compared comp, int depth_limit, bool leftmost)
+    {
+        typedef typename iterator_traits<RandomIter>::difference_type difference_type;
+        while (true)
+        {
+            const difference_type size = last - first;
+            if (size < sort_insertion_threshold)
+            {
+                if (leftmost)
+                    ministl::insertion_sort(first, last, comp);
+                else
+                    ministl::unguarded_insertion_sort(first, last, comp);
+                return;
+            }
+
+            // 选择枢轴放到 *first，同时保证 last - 1 处不小于枢轴
+            const difference_type half = size / 2;
+            if (size > sort_ninther_threshold)
+            {
+                ministl::sort3(first, first + half, last - 1, comp);
+                ministl::sort3(first + 1, first + (half - 1), last - 2, comp);
+                ministl::sort3(first + 2, first + (half + 1), last - 3, comp);
+                ministl::sort3(first + (half - 1), first + half, first + (half + 1), comp);
+                ministl::iter_swap(first, first + half);
+            }
+            else
+            {
+                ministl::sort3(first + half, first, last - 1, comp);
+            }
+
+            if (!leftmost && !comp(*(first - 1), *first))
+            {
+                first = ministl::partition_left(first, last, comp) + 1;
+                continue;
+            }
+            if (depth_limit == 0)
+            {
+                ministl::make_heap(first, last, comp);
+                ministl::sort_heap(first, last, comp);
+                return;
+            }
+            --depth_limit;
+
+            const ministl::pair<RandomIter, bool> part = ministl::partition_right(first, last, comp, Branchless());
+            const RandomIter pivot_pos = part.first;
+            const difference_type left_size = pivot_pos - first;
+            const difference_type right_size = last - (pivot_pos + 1);
+            if (part.second && left_size >= size / 8 && right_size >= size / 8 &&
+                ministl::partial_insertion_sort(first, pivot_pos, comp) &&
+                ministl::partial_insertion_sort(pivot_pos + 1, last, comp))
+                return;
+
+            // 递归处理较短的一侧，较长的一侧继续循环，栈深度为 O(logn)
+            if (left_size < right_size)
+            {
+                ministl::intro_sort<RandomIter, Compared, Branchless>(first, pivot_pos, comp, depth_limit, leftmost);
+                first = pivot_pos + 1;
+                leftmost = false;
+            }
+            else
+            {
+                ministl::intro_sort<RandomIter, Compared, Branchless>(pivot_pos + 1, last, comp, depth_limit, false);
+                last = pivot_pos;
+            }
+        }
+    }
+
+    template <class RandomIter, class Compared>
+    void sort(RandomIter first, RandomIter last, Compared comp)
+    {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        if (last - first < 2)
+            return;
+        ministl::intro_sort<RandomIter, Compared, sort_use_branchless<value_type>>(
+                first, last, comp, 2 * ministl::sort_log2(last - first), true);
+    }
+
+    /***********************************************radix_sort**********************************************/
+    // radix_traits<T>::key 把 T 映射为无符号整数，且保持 < 的顺序：
+    //   无符号整数 : 本身
+    //   有符号整数 : 翻转符号位
+    //   浮点数     : 非负数翻转符号位，负数按位取反(NaN 按位模式排在两端)
+    // 其他定长键类型可以特化 radix_traits，提供 value、key_type 与 key()
+    /*******************************************************************************************************/
+    template <class T, class = void>
+    struct radix_traits
+    {
+        static constexpr bool value = false;
+    };
+
+    template <class T>
+    struct radix_traits<T, typename std::enable_if<std::is_integral<T>::value &&
+                                                   !std::is_same<T, bool>::value>::type>
+    {
+        static constexpr bool value = true;
+        typedef typename std::make_unsigned<T>::type key_type;
+
+        static key_type key(T x) noexcept
+        {
+            return std::is_signed<T>::value
+                   ? static_cast<key_type>(static_cast<key_type>(x) ^
+                                           (static_cast<key_type>(1) << (8 * sizeof(T) - 1)))
+                   : static_cast<key_type>(x);
+        }
+    };
+
+    template <>
+    struct radix_traits<float>
+    {
+        static constexpr bool value = true;
+        typedef uint32_t key_type;
+
+        static key_type key(float x) noexcept
+        {
+            key_type bits;
+            std::memcpy(&bits, &x, sizeof(bits));
+            return (bits >> 31) ? ~bits : (bits | 0x80000000u);
+        }
+    };
+
+    template <>
+    struct radix_traits<double>
+    {
+        static constexpr bool value = true;
+        typedef uint64_t key_type;
+
+        static key_type key(double x) noexcept
+        {
+            key_type bits;
+            std::memcpy(&bits, &x, sizeof(bits));
+            return (bits >> 63) ? ~bits : (bits | 0x8000000000000000ull);
+        }
+    };
+
+    // 按 radix_traits 的键比较，基数排序退回 introsort 时使用，顺序与基数排序一致
+    template <class T>
+    struct radix_key_less
+    {
+        bool operator()(const T& lhs, const T& rhs) const
+        {
+            return radix_traits<T>::key(lhs) < radix_traits<T>::key(rhs);
+        }
+    };
+
+    // 算术类型直接用 < 比较，其他类型按键比较
+    template <class T>
+    struct radix_fallback_compare
+    {
+        typedef typename std::conditional<std::is_arithmetic<T>::value,
+                ministl::less<T>, radix_key_less<T>>::type type;
+    };
+
+    // 元素数不少于该值时 sort(first, last) 改用基数排序
+    constexpr size_t radix_sort_threshold = 1 << 12;
+    // sort(first, last) 自动选择基数排序时允许的最多趟数
+    constexpr size_t radix_sort_auto_passes = 6;
+    // 自动选择时抽样的键数
+    constexpr size_t radix_sample_size = 256;
+
+    // 按第 shift 位起的 8 位把 src 的元素分配到 dst，offset 为各桶的起始下标
+    template <class Traits, class SrcIter, class DstIter>
+    void radix_scatter(SrcIter src, size_t n, DstIter dst, unsigned shift, size_t* offset)
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            const size_t digit = static_cast<size_t>((Traits::key(src[i]) >> shift) & 0xff);
+            dst[offset[digit]++] = ministl::move(src[i]);
+        }
+    }
+
+    // 等距抽取至多 radix_sample_size 个键，返回抽样中与首个键不同的字节数
+    // 抽样只会低估需要的趟数，超过上限时可以不做完整的直方图就直接退回 introsort
+    template <class RandomIter, class Key>
+    size_t radix_sample_passes(RandomIter first, RandomIter last, Key& diff)
+    {
+        typedef radix_traits<typename iterator_traits<RandomIter>::value_type> traits;
+        const size_t n = static_cast<size_t>(last - first);
+        const size_t step = n / radix_sample_size + 1;
+        const Key first_key = traits::key(*first);
+        diff = 0;
+        for (size_t i = step; i < n; i += step)
+            diff |= static_cast<Key>(traits::key(first[i]) ^ first_key);
+        size_t passes = 0;
+        for (size_t p = 0; p < sizeof(Key); ++p)
+            passes += ((diff >> (8 * p)) & 0xff) != 0;
+        return passes;
+    }
+
+    // 一次遍历得到 mask 中各字节所在趟(每趟 8 位)的直方图，返回实际需要的趟数：
+    // 所有键在某一位上相同时该趟可以跳过；mask 之外的字节上存在不同的键时返回 Passes + 1
+    template <class RandomIter, class Key, size_t Passes>
+    size_t radix_histogram(RandomIter first, RandomIter last, Key mask, size_t (&count)[Passes][256])
+    {
+        typedef radix_traits<typename iterator_traits<RandomIter>::value_type> traits;
+        const size_t n = static_cast<size_t>(last - first);
+        const Key first_key = traits::key(*first);
+        std::memset(count, 0, sizeof(count));
+        unsigned shifts[Passes];
+        size_t active = 0;
+        for (size_t p = 0; p < Passes; ++p)
+        {
+            if ((mask >> (8 * p)) & 0xff)
+                shifts[active++] = static_cast<unsigned>(8 * p);
+            else
+                count[p][(first_key >> (8 * p)) & 0xff] = n;
+        }
+        Key diff = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            const Key k = traits::key(first[i]);
+            diff |= static_cast<Key>(k ^ first_key);
+            for (size_t a = 0; a < active; ++a)
+                ++count[shifts[a] / 8][(k >> shifts[a]) & 0xff];
+        }
+        if (diff & static_cast<Key>(~mask))
+            return Passes + 1;
+        size_t needed = 0;
+        for (size_t p = 0; p < Passes; ++p)
+            needed += count[p][(first_key >> (8 * p)) & 0xff] != n;
+        return needed;
+    }
+
+    // LSD 基数排序，在原区间与 buffer 之间来回分配，count 为 radix_histogram 的结果
+    template <class RandomIter, class T, size_t Passes>
+    void radix_sort_with_buffer(RandomIter first, RandomIter last, T* buffer, size_t (&count)[Passes][256])
+    {
+        typedef radix_traits<T> traits;
+        const size_t n = static_cast<size_t>(last - first);
+        const typename traits::key_type first_key = traits::key(*first);
+        bool in_buffer = false;
+        for (size_t p = 0; p < Passes; ++p)
+        {
+            const unsigned shift = static_cast<unsigned>(8 * p);
+            if (count[p][(first_key >> shift) & 0xff] == n)
+                continue;
+            size_t offset[256];
+            size_t sum = 0;
+            for (size_t d = 0; d < 256; ++d)
+            {
+                offset[d] = sum;
+                sum += count[p][d];
+            }
+            if (in_buffer)
+                ministl::radix_scatter<traits>(buffer, n, first, shift, offset);
+            else
+                ministl::radix_scatter<traits>(first, n, buffer, shift, offset);
+            in_buffer = !in_buffer;
+        }
+        if (in_buffer)
+            ministl::move(buffer, buffer + n, first);
+    }
+
+    // max_passes 为允许的最多趟数，需要更多趟，或者申请不到足够的临时空间时退回 introsort
+    // max_passes 小于键的字节数时先抽样：抽样已超过上限则不再遍历整个区间，否则只统计抽样中变化的字节
+    template <class RandomIter>
+    void radix_sort(RandomIter first, RandomIter last, size_t max_passes)
+    {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        typedef typename radix_traits<value_type>::key_type key_type;
+        if (last - first < 2)
+            return;
+        key_type mask = static_cast<key_type>(~static_cast<key_type>(0));
+        bool radix = true;
+        if (max_passes < sizeof(key_type))
+        {
+            key_type diff = 0;
+            radix = ministl::radix_sample_passes(first, last, diff) <= max_passes;
+            for (size_t p = 0; p < sizeof(key_type); ++p)
+            {
+                if (((diff >> (8 * p)) & 0xff) == 0)
+                    mask = static_cast<key_type>(mask & ~(static_cast<key_type>(0xff) << (8 * p)));
+            }
+        }
+        size_t count[sizeof(key_type)][256];
+        if (radix && ministl::radix_histogram(first, last, mask, count) <= max_passes)
+        {
+            temporary_buffer<RandomIter, value_type> buf(first, last);
+            if (buf.begin() != nullptr && buf.size() == last - first)
+            {
+                ministl::radix_sort_with_buffer(first, last, buf.begin(), count);
+                return;
+            }
+        }
+        ministl::sort(first, last, typename radix_fallback_compare<value_type>::type());
+    }
+
+    template <class RandomIter>
+    void radix_sort(RandomIter first, RandomIter last)
+    {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        static_assert(radix_traits<value_type>::value, "radix_sort requires a radix_traits specialization");
+        ministl::radix_sort(first, last, sizeof(typename radix_traits<value_type>::key_type));
+    }
+
+    // 每趟分配的开销约为 introsort 一层分区的两倍，趟数较多(例如取值遍布全范围的 64 位整数、
+    // 正负混合的浮点数)时 introsort 更快，由抽样直接判定，不额外遍历整个区间
+    template <class RandomIter>
+    void sort_dispatch(RandomIter first, RandomIter last, m_true_type)
+    {
+        if (static_cast<size_t>(last - first) >= radix_sort_threshold)
+            ministl::radix_sort(first, last, radix_sort_auto_passes);
+        else
+            ministl::sort(first, last,
+                          typename radix_fallback_compare<typename iterator_traits<RandomIter>::value_type>::type());
+    }
+
+    template <class RandomIter>
+    void sort_dispatch(RandomIter first, RandomIter last, m_false_type)
+    {
+        ministl::sort(first, last, ministl::less<typename iterator_traits<RandomIter>::value_type>());
+    }
+
+    // 元素类型有 radix_traits 时自动选择基数排序
+    template <class RandomIter>
+    void sort(RandomIter first, RandomIter last)
+    {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        ministl::sort_dispatch(first, last, m_bool_constant<radix_traits<value_type>::value>());
+    }
+
+    /***********************************************stable_sort*********************************************/
+    // notes:
+    // 归并排序，临时空间来自 temporary_buffer：先对长为 stable_sort_chunk 的小段做插入排序，
+    // 再在原区间与缓冲区之间来回归并。缓冲区不足时把区间对半递归，归并时以二分查找切开两段、
+    // 旋转后分别归并(merge_adaptive)，完全申请不到缓冲区时退化为 O(nlog²n) 的原地归并。
+    /*******************************************************************************************************/
+    constexpr ptrdiff_t stable_sort_chunk = 16;
+
+    // 把有序区间 [first1, last1) 与 [first2, last2) 移动归并到 result，相等时取第一段的元素
+    template <class InputIter1, class InputIter2, class OutputIter, class Compared>
+    OutputIter move_merge(InputIter1 first1, InputIter1 last1, InputIter2 first2, InputIter2 last2,
+                          OutputIter result, Compared comp)
+    {
+        while (first1 != last1 && first2 != last2)
+        {
+            if (comp(*first2, *first1))
+            {
+                *result = ministl::move(*first2);
+                ++first2;
+            }
+            else
+            {
+                *result = ministl::move(*first1);
+                ++first1;
+            }
+            ++result;
+        }
+        return ministl::move(first2, last2, ministl::move(first1, last1, result));
+    }
+
+    // 把缓冲区中的 [first1, last1) 与紧随输出区间之后的 [first2, last2) 归并到 result，
+    // 缓冲区用完时第二段剩余的元素已在原位，不再移动(避免自我移动赋值)
+    template <class InputIter1, class RandomIter, class Compared>
+    void move_merge_adaptive(InputIter1 first1, InputIter1 last1, RandomIter first2, RandomIter last2,
+                             RandomIter result, Compared comp)
+    {
+        while (first1 != last1 && first2 != last2)
+        {
+            if (comp(*first2, *first1))
+            {
+                *result = ministl::move(*first2);
+                ++first2;
+            }
+            else
+            {
+                *result = ministl::move(*first1);
+                ++first1;
+            }
+            ++result;
+        }
+        ministl::move(first1, last1, result);
+    }
+
+    // 从后往前归并，result 为输出区间的尾部
+    template <class BidirectionalIter1, class BidirectionalIter2, class BidirectionalIter3, class Compared>
+    void move_merge_backward(BidirectionalIter1 first1, BidirectionalIter1 last1,
+                             BidirectionalIter2 first2, BidirectionalIter2 last2,
+                             BidirectionalIter3 result, Compared comp)
+    {
+        if (first1 == last1)
+        {
+            ministl::move_backward(first2, last2, result);
+            return;
+        }
+        if (first2 == last2)
+            return;
+        --last1;
+        --last2;
+        while (true)
+        {
+            if (comp(*last2, *last1))
+            {
+                *--result = ministl::move(*last1);
+                if (first1 == last1)
+                {
+                    ministl::move_backward(first2, ++last2, result);
+                    return;
+                }
+                --last1;
+            }
+            else
+            {
+                *--result = ministl::move(*last2);
+                if (first2 == last2)
+                    return;
+                --last2;
+            }
+        }
+    }
+
+    template <class RandomIter, class OutputIter, class Distance, class Compared>
+    void merge_sort_loop(RandomIter first, RandomIter last, OutputIter result, Distance step, Compared comp)
+    {
+        const Distance two_step = 2 * step;
+        while (last - first >= two_step)
+        {
+            result = ministl::move_merge(first, first + step, first + step, first + two_step, result, comp);
+            first += two_step;
+        }
+        step = ministl::min(static_cast<Distance>(last - first), step);
+        ministl::move_merge(first, first + step, first + step, last, result, comp);
+    }
+
+    // 缓冲区至少能容纳 last - first 个元素
+    template <class RandomIter, class T, class Compared>
+    void merge_sort_with_buffer(RandomIter first, RandomIter last, T* buffer, Compared comp)
+    {
+        typedef typename iterator_traits<RandomIter>::difference_type difference_type;
+        const difference_type len = last - first;
+        for (RandomIter it = first; it < last; it += ministl::min(stable_sort_chunk, last - it))
+            ministl::insertion_sort(it, it + ministl::min(stable_sort_chunk, last - it), comp);
+        difference_type step = stable_sort_chunk;
+        while (step < len)
+        {
+            ministl::merge_sort_loop(first, last, buffer, step, comp);
+            step *= 2;
+            ministl::merge_sort_loop(buffer, buffer + len, first, step, comp);
+            step *= 2;
+        }
+    }
+
+    // 借助缓冲区旋转 [first, middle) 与 [middle, last)，缓冲区不够时调用 rotate
+    template <class RandomIter, class T, class Distance>
+    RandomIter rotate_adaptive(RandomIter first, RandomIter middle, RandomIter last,
+                               Distance len1, Distance len2, T* buffer, Distance buffer_size)
+    {
+        if (len1 > len2 && len2 <= buffer_size)
+        {
+            if (len2 == 0)
+                return first;
+            T* buffer_end = ministl::move(middle, last, buffer);
+            ministl::move_backward(first, middle, last);
+            return ministl::move(buffer, buffer_end, first);
+        }
+        if (len1 <= buffer_size)
+        {
+            if (len1 == 0)
+                return last;
+            T* buffer_end = ministl::move(first, middle, buffer);
+            ministl::move(middle, last, first);
+            return ministl::move_backward(buffer, buffer_end, last);
+        }
+        return ministl::rotate(first, middle, last);
+    }
+
+    template <class RandomIter, class T, class Distance, class Compared>
+    void merge_adaptive(RandomIter first, RandomIter middle, RandomIter last, Distance len1, Distance len2,
+                        T* buffer, Distance buffer_size, Compared comp)
+    {
+        if (len1 == 0 || len2 == 0)
+            return;
+        if (len1 <= len2 && len1 <= buffer_size)
+        {
+            T* buffer_end = ministl::move(first, middle, buffer);
+            ministl::move_merge_adaptive(buffer, buffer_end, middle, last, first, comp);
+        }
+        else if (len2 <= buffer_size)
+        {
+            T* buffer_end = ministl::move(middle, last, buffer);
+            ministl::move_merge_backward(first, middle, buffer, buffer_end, last, comp);
+        }
+        else if (len1 + len2 == 2)
+        {
+            if (comp(*middle, *first))
+                ministl::iter_swap(first, middle);
+        }
+        else
+        {
+            RandomIter first_cut = first;
+            RandomIter second_cut = middle;
+            Distance len11 = 0;
+            Distance len22 = 0;
+            if (len1 > len2)
+            {
+                len11 = len1 / 2;
+                first_cut += len11;
+                second_cut = ministl::lower_bound(middle, last, *first_cut, comp);
+                len22 = second_cut - middle;
+            }
+            else
+            {
+                len22 = len2 / 2;
+                second_cut += len22;
+                first_cut = ministl::upper_bound(first, middle, *second_cut, comp);
+                len11 = first_cut - first;
+            }
+            RandomIter new_middle = ministl::rotate_adaptive(first_cut, middle, second_cut, len1 - len11,
+                                                             len22, buffer, buffer_size);
+            ministl::merge_adaptive(first, first_cut, new_middle, len11, len22, buffer, buffer_size, comp);
+            ministl::merge_adaptive(new_middle, second_cut, last, len1 - len11, len2 - len22,
+                                    buffer, buffer_size, comp);
+        }
+    }
+
+    template <class RandomIter, class T, class Distance, class Compared>
+    void stable_sort_adaptive(RandomIter first, RandomIter last, T* buffer, Distance buffer_size, Compared comp)
+    {
+        const Distance len = last - first;
+        if (len <= stable_sort_chunk)
+        {
+            ministl::insertion_sort(first, last, comp);
+            return;
+        }
+        const Distance half = (len + 1) / 2;
+        const RandomIter middle = first + half;
+        if (half > buffer_size)
+        {
+            ministl::stable_sort_adaptive(first, middle, buffer, buffer_size, comp);
+            ministl::stable_sort_adaptive(middle, last, buffer, buffer_size, comp);
+        }
+        else
+        {
+            ministl::merge_sort_with_buffer(first, middle, buffer, comp);
+            ministl::merge_sort_with_buffer(middle, last, buffer, comp);
+        }
+        ministl::merge_adaptive(first, middle, last, half, len - half, buffer, buffer_size, comp);
+    }
+
+    template <class RandomIter, class Compared>
+    void stable_sort(RandomIter first, RandomIter last, Compared comp)
+    {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        if (last - first < 2)
+            return;
+        temporary_buffer<RandomIter, value_type> buf(first, last);
+        ministl::stable_sort_adaptive(first, last, buf.begin(), buf.size(), comp);
+    }
+
+    template <class RandomIter>
+    void stable_sort(RandomIter first, RandomIter last)
+    {
+        ministl::stable_sort(first, last, ministl::less<typename iterator_traits<RandomIter>::value_type>());
+    }
+
+    /**********************************************inplace_merge*******************************************/
+    // notes:
+    // 把相邻的两段有序区间 [first, middle) 与 [middle, last) 合并为一段，是稳定的：
+    // 相等元素中来自前一段的排在前面。缓冲区足够时 O(n)，否则退化为 O(nlogn) 的原地归并。
+    /*******************************************************************************************************/
+    template <class RandomIter, class Compared>
+    void inplace_merge(RandomIter first, RandomIter middle, RandomIter last, Compared comp)
+    {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        typedef typename iterator_traits<RandomIter>::difference_type difference_type;
+        if (first == middle || middle == last)
+            return;
+        const difference_type len1 = middle - first;
+        const difference_type len2 = last - middle;
+        temporary_buffer<RandomIter, value_type> buf(first, last);
+        ministl::merge_adaptive(first, middle, last, len1, len2, buf.begin(),
+                                static_cast<difference_type>(buf.size()), comp);
+    }
+
+    template <class RandomIter>
+    void inplace_merge(RandomIter first, RandomIter middle, RandomIter last)
+    {
+        ministl::inplace_merge(first, middle, last, ministl::less<typename iterator_traits<RandomIter>::value_type>());
+    }
+
+    /************************************************partition*********************************************/
+    /*********************把满足 pred 的元素放到区间前段，返回指向第一个不满足 pred 的元素的迭代器*****************/
+    /*******************************************************************************************************/
+    template <class BidirectionalIter, class UnaryPredicate>
+    BidirectionalIter partition(BidirectionalIter first, BidirectionalIter last, UnaryPredicate pred)
+    {
+        while (true)
+        {
+            while (first != last && pred(*first))
+                ++first;
+            if (first == last)
+                break;
+            --last;
+            while (first != last && !pred(*last))
+                --last;
+            if (first == last)
+                break;
+            ministl::iter_swap(first, last);
+            ++first;
+        }
+        return first;
+    }
+
+    /**************************************************unique***********************************************/
+    /*****************移除[first, last)中相邻的重复元素，每组只保留第一个，返回新区间的尾后迭代器*****************/
+    /*******************************************************************************************************/
+    template <class ForwardIter, class BinaryPredicate>
+    ForwardIter unique(ForwardIter first, ForwardIter last, BinaryPredicate pred)
+    {
+        if (first == last)
+            return last;
+        ForwardIter result = first;
+        while (++first != last)
+        {
+            if (!pred(*result, *first) && ++result != first)
+                *result = ministl::move(*first);
+        }
+        return ++result;
+    }
+
+    template <class ForwardIter>
+    ForwardIter unique(ForwardIter first, ForwardIter last)
+    {
+        return ministl::unique(first, last, ministl::equal_to<typename iterator_traits<ForwardIter>::value_type>());
+    }
+
+    /**********************************************nth_element*********************************************/
+    // notes:
+    // 重新排列 [first, last)，使 nth 处为排序后应在该位置的元素，它之前的元素都不大于它，之后的都不小于它。
+    // 通用版本为 introselect：与 sort 相同的枢轴选择与分区，只继续处理 nth 所在的一侧，
+    // 分区次数超过 2 * log2(n) 时改用堆选择，最坏情况为 O(nlogn)。
+    // 算术类型配合 ministl::less / greater 时按枢轴值调用 pivot_partition，按运行时检测到的指令集使用
+    // AVX-512 / AVX2 的向量化分区，区间短于 simd_select_threshold 后交给通用版本。
+    /*******************************************************************************************************/
+    constexpr ptrdiff_t simd_select_threshold = 256;
+
+    // 把 [first, last) 中最小的 middle - first 个元素放到 [first, middle)，且 *first 为其中最大的一个
+    template <class RandomIter, class Compared>
+    void heap_select(RandomIter first, RandomIter middle, RandomIter last, Compared comp)
+    {
+        typedef typename iterator_traits<RandomIter>::difference_type difference_type;
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        ministl::make_heap(first, middle, comp);
+        for (RandomIter i = middle; i < last; ++i)
+        {
+            if (comp(*i, *first))
+            {
+                value_type value = ministl::move(*i);
+                *i = ministl::move(*first);
+                ministl::adjust_heap(first, static_cast<difference_type>(0),
+                                     static_cast<difference_type>(middle - first), ministl::move(value), comp);
+            }
+        }
+    }
+
+    template <class RandomIter, class Compared, class Branchless>
+    void intro_select(RandomIter first, RandomIter nth, RandomIter last, Compared comp, int depth_limit)
+    {
+        typedef typename iterator_traits<RandomIter>::difference_type difference_type;
+        bool leftmost = true;
+        while (last - first > sort_insertion_threshold)
+        {
+            if (depth_limit == 0)
+            {
+                ministl::heap_select(first, nth + 1, last, comp);
+                ministl::iter_swap(first, nth);
+                return;
+            }
+            --depth_limit;
+
+            const difference_type size = last - first;
+            const difference_type half = size / 2;
+            if (size > sort_ninther_threshold)
+            {
+                ministl::sort3(first, first + half, last - 1, comp);
+                ministl::sort3(first + 1, first + (half - 1), last - 2, comp);
+                ministl::sort3(first + 2, first + (half + 1), last - 3, comp);
+                ministl::sort3(first + (half - 1), first + half, first + (half + 1), comp);
+                ministl::iter_swap(first, first + half);
+            }
+            else
+            {
+                ministl::sort3(first + half, first, last - 1, comp);
+            }
+
+            // 枢轴与左侧的上一个枢轴相等：相等的元素一次归位，nth 落在其中时已经完成
+            if (!leftmost && !comp(*(first - 1), *first))
+            {
+                const RandomIter equal_last = ministl::partition_left(first, last, comp);
+                if (nth <= equal_last)
+                    return;
+                first = equal_last + 1;
+                continue;
+            }
+            const RandomIter pivot_pos = ministl::partition_right(first, last, comp, Branchless()).first;
+            if (pivot_pos == nth)
+                return;
+            if (nth < pivot_pos)
+            {
+                last = pivot_pos;
+            }
+            else
+            {
+                first = pivot_pos + 1;
+                leftmost = false;
+            }
+        }
+        ministl::insertion_sort(first, last, comp);
+    }
+
+    template <class T, class Compared>
+    void simd_select(T* first, T* nth, T* last, Compared comp)
+    {
+        const pivot_cmp strict = pivot_cmp_of<Compared>::strict;
+        const pivot_cmp inclusive = pivot_cmp_of<Compared>::inclusive;
+        // 没有可用的向量指令时，通用版本的无分支分区比标量的 pivot_partition 更快
+        int depth_limit = active_simd_level() == simd_level::none ? 0 : 2 * ministl::sort_log2(last - first);
+        while (last - first > simd_select_threshold && depth_limit > 0)
+        {
+            --depth_limit;
+            const ptrdiff_t half = (last - first) / 2;
+            ministl::sort3(first, first + half, last - 1, comp);
+            ministl::sort3(first + 1, first + (half - 1), last - 2, comp);
+            ministl::sort3(first + 2, first + (half + 1), last - 3, comp);
+            ministl::sort3(first + (half - 1), first + half, first + (half + 1), comp);
+            const T pivot = first[half];
+            T* middle = first + ministl::pivot_partition<strict>(first, last, pivot);
+            if (middle == first)
+            {
+                // 枢轴是区间中的最小值：把与之相等的元素放到左边
+                middle = first + ministl::pivot_partition<inclusive>(first, last, pivot);
+                if (nth < middle)
+                    return;
+                first = middle;
+            }
+            else if (nth < middle)
+            {
+                last = middle;
+            }
+            else
+            {
+                first = middle;
+            }
+        }
+        ministl::intro_select<T*, Compared, m_true_type>(first, nth, last, comp,
+                                                         2 * ministl::sort_log2(last - first));
+    }
+
+    template <class RandomIter, class Compared>
+    void nth_element_dispatch(RandomIter first, RandomIter nth, RandomIter last, Compared comp, m_true_type)
+    {
+        ministl::simd_select(first, nth, last, comp);
+    }
+
+    template <class RandomIter, class Compared>
+    void nth_element_dispatch(RandomIter first, RandomIter nth, RandomIter last, Compared comp, m_false_type)
+    {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        ministl::intro_select<RandomIter, Compared, sort_use_branchless<value_type>>(
+                first, nth, last, comp, 2 * ministl::sort_log2(last - first));
+    }
+
+    template <class RandomIter, class Compared>
+    void nth_element(RandomIter first, RandomIter nth, RandomIter last, Compared comp)
+    {
+        if (last - first < 2 || nth == last)
+            return;
+        ministl::nth_element_dispatch(first, nth, last, comp, simd_partitionable<RandomIter, Compared>());
+    }
+
+    template <class RandomIter>
+    void nth_element(RandomIter first, RandomIter nth, RandomIter last)
+    {
+        ministl::nth_element(first, nth, last, ministl::less<typename iterator_traits<RandomIter>::value_type>());
+    }
+
+    /**********************************************partial_sort********************************************/
+    // notes:
+    // 把 [first, last) 中最小的 middle - first 个元素按顺序放到 [first, middle)，其余元素的顺序不保证。
+    // 通用版本为堆选择后 sort_heap，O(nlogk)。可以向量化分区的类型在 k 不小于 n / partial_sort_select_ratio 时
+    // 先用 nth_element 在 O(n) 内选出前 k 个再排序，O(n + klogk)；k 很小时堆选择几乎每个元素只比较一次，反而更快。
+    /*******************************************************************************************************/
+    constexpr ptrdiff_t partial_sort_select_ratio = 64;
+
+    template <class RandomIter, class Compared>
+    void partial_sort_dispatch(RandomIter first, RandomIter middle, RandomIter last, Compared comp, m_false_type)
+    {
+        ministl::heap_select(first, middle, last, comp);
+        ministl::sort_heap(first, middle, comp);
+    }
+
+    template <class RandomIter, class Compared>
+    void partial_sort_dispatch(RandomIter first, RandomIter middle, RandomIter last, Compared comp, m_true_type)
+    {
+        if ((middle - first) * partial_sort_select_ratio < last - first)
+        {
+            ministl::partial_sort_dispatch(first, middle, last, comp, m_false_type());
+            return;
+        }
+        ministl::nth_element(first, middle - 1, last, comp);
+        ministl::sort(first, middle - 1, comp);
+    }
+
+    template <class RandomIter, class Compared>
+    void partial_sort(RandomIter first, RandomIter middle, RandomIter last, Compared comp)
+    {
+        if (first == middle)
+            return;
+        ministl::partial_sort_dispatch(first, middle, last, comp, simd_partitionable<RandomIter, Compared>());
+    }
+
+    template <class RandomIter>
+    void partial_sort(RandomIter first, RandomIter middle, RandomIter last)
+    {
+        ministl::partial_sort(first, middle, last, ministl::less<typename iterator_traits<RandomIter>::value_type>());
+    }
+}
+
+#endif //MINISTL_ALGO_H
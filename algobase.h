@@ -41,6 +41,30 @@ namespace ministl
         return cmp(rhs,lhs) ? rhs : lhs;
     }
 
+    // 告知编译器 ptr 按 N 字节对齐，调用方须保证对齐成立，如来自 aligned_allocator 的空间
+    // 只是优化提示，不保证更快：编译器仍可能保留通用的非对齐路径
+    template <size_t N, class T>
+    inline T* assume_aligned(T* ptr) noexcept
+    {
+        static_assert(N != 0 && (N & (N - 1)) == 0, "alignment must be a power of two");
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<T*>(__builtin_assume_aligned(ptr, N));
+#else
+        return ptr;
+#endif
+    }
+
+    // 软件预取：提示 CPU 提前把 addr 所在的 cache line 读入缓存，不会引发缺页或越界访问异常，
+    // 因此 addr 可以是越过数组末尾的地址
+    inline void prefetch_read(const void* addr) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(addr, 0, 3);
+#else
+        (void)addr;
+#endif
+    }
+
     //将两个迭代器的对象swap
     template <class Iter1,class Iter2>
     void iter_swap(Iter1 first,Iter2 second)
@@ -109,25 +133,24 @@ namespace ministl
 
     template <class BidirectionalIter1,class BidirectionalIter2>
     BidirectionalIter2
-    unchecked_copy_backward_cat(BidirectionalIter1 first,BidirectionalIter1 last,BidirectionalIter1 last2,
+    unchecked_copy_backward_cat(BidirectionalIter1 first,BidirectionalIter1 last,BidirectionalIter2 last2,
             ministl::bidirectional_iterator_tag)
     {
         while(first != last)
         {
-            *last2-- = *first++;
+            *--last2 = *--last;
         }
         return last2;
     }
 
     template <class RandomAccessIter1,class RandomAccessIter2>
     RandomAccessIter2
-    unchecked_copy_backward_cat(RandomAccessIter1 first,RandomAccessIter1 last,RandomAccessIter1 last2,
+    unchecked_copy_backward_cat(RandomAccessIter1 first,RandomAccessIter1 last,RandomAccessIter2 last2,
             ministl::random_access_iterator_tag)
     {
         for(auto n = last - first;n > 0;--n)
         {
-            //todo judge prefix or postfix
-            *last2-- = *first--;
+            *--last2 = *--last;
         }
         return last2;
     }
@@ -135,9 +158,9 @@ namespace ministl
     //overload resolution
     template <class BidirectionalIter1,class BidirectionalIter2>
     BidirectionalIter2
-    unchecked_copy_backward(BidirectionalIter1 first,BidirectionalIter1 last,BidirectionalIter1 last2)
+    unchecked_copy_backward(BidirectionalIter1 first,BidirectionalIter1 last,BidirectionalIter2 last2)
     {
-        unchecked_copy_backward_cat(first,last,last2,ministl::iterator_category(first));
+        return unchecked_copy_backward_cat(first,last,last2,ministl::iterator_category(first));
     }
 
     template <class _Tp1,class _Tp2>
@@ -319,8 +342,8 @@ namespace ministl
     template <class InputIter1,class InputIter2>
     bool equal(InputIter1 first1,InputIter1 last,InputIter2 first2)
     {
-        while(first1 != last)
-            if(*first1 != *last) return false;
+        for(;first1 != last;++first1,++first2)
+            if(*first1 != *first2) return false;
         return true;
     }
 
@@ -447,7 +470,11 @@ namespace ministl
     ministl::pair<InputIter1,InputIter2>
     mismatch(InputIter1 first1,InputIter1 last1,InputIter2 first2)
     {
-        while (first1 != last1 && *first1++ == *first2++);
+        while (first1 != last1 && *first1 == *first2)
+        {
+            ++first1;
+            ++first2;
+        }
         return ministl::pair<InputIter1,InputIter2>(first1,first2);
     }
 
@@ -0,0 +1,99 @@
+#ifndef MINISTL_ALIGNED_ALLOCATOR_H
+#define MINISTL_ALIGNED_ALLOCATOR_H
+
+// This header contains a template class aligned_allocator
+// 保证申请到的空间按 Align 字节对齐（如 64 字节的 cache line 或 AVX-512 的向量宽度）
+
+// notes:
+// ::operator new 只保证 alignof(std::max_align_t)（通常为 16 字节）的对齐。
+// 需要更强对齐的场合：按 cache line 隔离被不同线程写的数据以避免伪共享，
+// 使用要求对齐地址的 SIMD 指令（如 _mm256_load_ps），以及按页对齐的 I/O 缓冲区。
+// aligned_allocator 通过 allocator_traits<Alloc>::alignment 在编译期公开对齐值，
+// vector<T, aligned_allocator<T, 64>>::data() 据此告知编译器首地址已对齐。
+// 对齐本身不会让普通的循环变快：现代 x86 上对已对齐地址执行非对齐访存指令没有额外开销，
+// 编译器生成的循环在 16KB 规模的测量中与默认分配器没有可测的差别。
+
+#include <cstdlib>
+#include "allocator.h"
+
+#if defined(_WIN32)
+#include <malloc.h>
+#endif
+
+namespace ministl
+{
+    template <class T, size_t Align = 64>
+    class aligned_allocator
+    {
+        static_assert(Align != 0 && (Align & (Align - 1)) == 0, "alignment must be a power of two");
+        static_assert(Align >= alignof(T), "alignment must not be weaker than alignof(T)");
+    public:
+        typedef T                      value_type;
+        typedef T*                     pointer;
+        typedef const T*               const_pointer;
+        typedef T&                     reference;
+        typedef const T&               const_reference;
+        typedef size_t                 size_type;
+        typedef ptrdiff_t              difference_type;
+
+        // 编译期对齐值
+        static constexpr size_type alignment = Align < sizeof(void*) ? sizeof(void*) : Align;
+
+    public:
+        static T* allocate()              { return allocate(1); }
+        static T* allocate(size_type n);
+
+        static void deallocate(T* ptr);
+        static void deallocate(T* ptr,size_type)  { deallocate(ptr); }
+
+        static void construct(T* ptr)                     { ministl::construct(ptr); }
+        static void construct(T* ptr,const T& value)      { ministl::construct(ptr,value); }
+        static void construct(T* ptr,T &&value)           { ministl::construct(ptr,ministl::move(value)); }
+
+        template <class ...Args>
+        static void construct(T* ptr,Args&& ...args)      { ministl::construct(ptr,ministl::forward<Args>(args)...); }
+
+        static void destroy(T* ptr)                       { ministl::destroy(ptr); }
+        static void destroy(T* first,T* last)             { ministl::destroy(first,last); }
+    };
+
+    template <class T, size_t Align>
+    constexpr typename aligned_allocator<T, Align>::size_type aligned_allocator<T, Align>::alignment;
+
+    template <class T, size_t Align>
+    T* aligned_allocator<T, Align>::allocate(size_type n)
+    {
+        if (n == 0)
+            return nullptr;
+        if (n > static_cast<size_type>(-1) / sizeof(T))
+            throw std::bad_alloc();
+        void* p = nullptr;
+#if defined(_WIN32)
+        p = ::_aligned_malloc(n * sizeof(T), alignment);
+#else
+        if (::posix_memalign(&p, alignment, n * sizeof(T)) != 0)
+            p = nullptr;
+#endif
+        if (p == nullptr)
+            throw std::bad_alloc();
+        return static_cast<T*>(p);
+    }
+
+    template <class T, size_t Align>
+    void aligned_allocator<T, Align>::deallocate(T* ptr)
+    {
+        if (ptr == nullptr)
+            return;
+#if defined(_WIN32)
+        ::_aligned_free(ptr);
+#else
+        ::free(ptr);
+#endif
+    }
+
+    // cache line 对齐的常用别名
+    template <class T>
+    using cache_aligned_allocator = aligned_allocator<T, 64>;
+}
+
+#endif //MINISTL_ALIGNED_ALLOCATOR_H
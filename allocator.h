@@ -99,6 +99,44 @@ namespace ministl
         ministl::destroy(first,last);
     }
 
+    // 萃取分配器声明的 alignment
+    template <class Alloc, class = void>
+    struct allocator_alignment : public m_integral_constant<size_t, alignof(std::max_align_t)> {};
+
+    template <class Alloc>
+    struct allocator_alignment<Alloc, typename std::enable_if<(Alloc::alignment > 0)>::type>
+            : public m_integral_constant<size_t, Alloc::alignment> {};
+
+    // --------------------------------------------------------------------------------------
+    // 类模板 : allocator_traits
+    // 萃取分配器的可选特性，分配器未提供时使用默认行为
+    template <class Alloc>
+    struct allocator_traits
+    {
+        typedef typename Alloc::value_type          value_type;
+        typedef typename Alloc::size_type           size_type;
+
+    private:
+        template <class A>
+        static auto good_size_impl(size_type n, int) -> decltype(A::good_size(n))
+        { return A::good_size(n); }
+
+        template <class A>
+        static size_type good_size_impl(size_type n, long)
+        { return n; }
+
+    public:
+        // 分配器保证的首地址对齐值，未声明时为 ::operator new 的默认对齐
+        static constexpr size_t alignment = allocator_alignment<Alloc>::value;
+
+        // 分配器建议的容量：按页或大页粒度申请内存的分配器会把零头补满，容器扩容时据此取整
+        static size_type good_size(size_type n)
+        { return good_size_impl<Alloc>(n, 0); }
+    };
+
+    template <class Alloc>
+    constexpr size_t allocator_traits<Alloc>::alignment;
+
 }
 
 #endif //MINISTL_ALLOCATOR_H
@@ -0,0 +1,667 @@
+#ifndef MINISTL_BIT_VECTOR_H
+#define MINISTL_BIT_VECTOR_H
+
+// 这个头文件包含两个类 bit_vector, bit_rank_select
+// bit_vector      : 位向量，每个 bool 只占 1 位，按 64 位的字存储
+// bit_rank_select : bit_vector 的 rank / select 索引，常数时间回答“前 i 位有几个 1”与“第 k 个 1 在哪”
+
+// notes:
+// vector<bool> 在 vector.h 中被 static_assert 禁用，bit_vector 是独立的容器，不是 vector 的特化。
+// 存储：
+//   vector<uint64_t, aligned_allocator<uint64_t, 64>>，第 i 位在第 i / 64 个字的第 i % 64 位，
+//   最后一个字中超出 size() 的位始终为 0，count / find / 按位运算都不需要额外屏蔽。
+// 批量操作：
+//   set_range / reset_range / flip_range 按字处理，两端的字用掩码；
+//   count 与 &= |= ^= 在运行时按指令集选择 AVX-512(VPOPCNTQ) / AVX2(查表 popcount) / 标量版本。
+// bit_rank_select：
+//   每 65536 位记一个 64 位的绝对计数，每 512 位(一条 cache line)记一个 16 位的相对计数，额外空间约 3.2%；
+//   rank 最多再对一条 cache line 内的 8 个字做 popcount。select 每 8192 个 1(或 0)采样一次所在的块，
+//   在相邻两个采样之间二分块，再在块内逐字查找。索引建立后 bit_vector 被修改则索引失效，需要重新 build
+
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+
+#include "aligned_allocator.h"
+#include "exception.h"
+#include "simd_partition.h"
+#include "util.h"
+#include "vector.h"
+
+namespace ministl
+{
+    /*******************************************word helpers**********************************************/
+    // 没有 -mpopcnt 时 __builtin_popcountll 是一次 libgcc 调用，rank / select 的热路径改用内联的 SWAR
+    inline unsigned bit_popcount64(uint64_t w) noexcept
+    {
+#if defined(__POPCNT__)
+        return static_cast<unsigned>(__builtin_popcountll(w));
+#else
+        w = w - ((w >> 1) & 0x5555555555555555ull);
+        w = (w & 0x3333333333333333ull) + ((w >> 2) & 0x3333333333333333ull);
+        w = (w + (w >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+        return static_cast<unsigned>((w * 0x0101010101010101ull) >> 56);
+#endif
+    }
+
+    inline unsigned bit_ctz64(uint64_t w) noexcept
+    {
+        return static_cast<unsigned>(__builtin_ctzll(w));
+    }
+
+    // w 中第 k 个(从 0 开始)为 1 的位的下标，要求 k < popcount(w)。
+    // 字节前缀和与 k 逐字节比较，无分支地得到所在字节，字节内最多再清除 7 个低位
+    inline unsigned bit_select64(uint64_t w, unsigned k) noexcept
+    {
+        const uint64_t ones8 = 0x0101010101010101ull;
+        const uint64_t high8 = 0x8080808080808080ull;
+        uint64_t s = w - ((w >> 1) & 0x5555555555555555ull);
+        s = (s & 0x3333333333333333ull) + ((s >> 2) & 0x3333333333333333ull);
+        s = (s + (s >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+        const uint64_t prefix = s * ones8;  // 第 i 个字节为字节 0..i 中 1 的个数
+        // 前缀和不超过 k 的字节数，即所求位之前的完整字节数
+        const uint64_t le = (((k * ones8) | high8) - prefix) & high8;
+        const unsigned byte = static_cast<unsigned>(((le >> 7) * ones8) >> 56);
+        const unsigned before = static_cast<unsigned>(((prefix << 8) >> (byte * 8)) & 0xFF);
+        uint64_t b = (w >> (byte * 8)) & 0xFF;
+        for (unsigned r = k - before; r != 0; --r)
+            b &= b - 1;
+        return byte * 8 + bit_ctz64(b);
+    }
+
+    // 按位运算的函数对象，dst = op(dst, src)
+    struct bit_and_op    { uint64_t operator()(uint64_t a, uint64_t b) const noexcept { return a & b; } };
+    struct bit_or_op     { uint64_t operator()(uint64_t a, uint64_t b) const noexcept { return a | b; } };
+    struct bit_xor_op    { uint64_t operator()(uint64_t a, uint64_t b) const noexcept { return a ^ b; } };
+    struct bit_andnot_op { uint64_t operator()(uint64_t a, uint64_t b) const noexcept { return a & ~b; } };
+
+    /*********************************************kernels************************************************/
+    inline size_t scalar_bits_count(const uint64_t* words, size_t n) noexcept
+    {
+        size_t total = 0;
+        for (size_t i = 0; i < n; ++i)
+            total += bit_popcount64(words[i]);
+        return total;
+    }
+
+    template <class Op>
+    void scalar_bits_apply(uint64_t* dst, const uint64_t* src, size_t n) noexcept
+    {
+        for (size_t i = 0; i < n; ++i)
+            dst[i] = Op()(dst[i], src[i]);
+    }
+
+#if MINISTL_SIMD_X86
+#define MINISTL_TARGET_AVX512_POPCNT __attribute__((target("avx512f,avx512vpopcntdq,avx2,popcnt")))
+
+    inline bool bits_has_vpopcntdq() noexcept
+    {
+        static const bool supported = __builtin_cpu_supports("avx512vpopcntdq") != 0;
+        return supported;
+    }
+
+    // 每个半字节查表得到 1 的个数，再用 sad 把 32 个字节累加成 4 个 64 位的和
+    MINISTL_TARGET_AVX2 inline size_t avx2_bits_count(const uint64_t* words, size_t n) noexcept
+    {
+        const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                                0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+        const __m256i low_mask = _mm256_set1_epi8(0x0F);
+        __m256i acc = _mm256_setzero_si256();
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4)
+        {
+            const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i));
+            const __m256i lo = _mm256_and_si256(v, low_mask);
+            const __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask);
+            const __m256i cnt = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, lo), _mm256_shuffle_epi8(lookup, hi));
+            acc = _mm256_add_epi64(acc, _mm256_sad_epu8(cnt, _mm256_setzero_si256()));
+        }
+        size_t total = static_cast<size_t>(_mm256_extract_epi64(acc, 0) + _mm256_extract_epi64(acc, 1) +
+                                           _mm256_extract_epi64(acc, 2) + _mm256_extract_epi64(acc, 3));
+        for (; i < n; ++i)
+            total += static_cast<size_t>(__builtin_popcountll(words[i]));
+        return total;
+    }
+
+    MINISTL_TARGET_AVX512_POPCNT inline size_t avx512_bits_count(const uint64_t* words, size_t n) noexcept
+    {
+        __m512i acc = _mm512_setzero_si512();
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8)
+            acc = _mm512_add_epi64(acc, _mm512_popcnt_epi64(_mm512_loadu_si512(words + i)));
+        // 两个 256 位的半边相加后再取出四个 64 位计数；GCC 12 的 _mm512_reduce_add_epi64 与不带掩码的
+        // 取半边函数以未初始化的向量作为占位，-Wall 下报 -Wuninitialized，这里改用全 1 掩码的 maskz 形式
+        const __m256i half = _mm256_add_epi64(_mm512_maskz_extracti64x4_epi64(0xF, acc, 0),
+                                              _mm512_maskz_extracti64x4_epi64(0xF, acc, 1));
+        size_t total = static_cast<size_t>(_mm256_extract_epi64(half, 0) + _mm256_extract_epi64(half, 1) +
+                                           _mm256_extract_epi64(half, 2) + _mm256_extract_epi64(half, 3));
+        for (; i < n; ++i)
+            total += static_cast<size_t>(__builtin_popcountll(words[i]));
+        return total;
+    }
+
+    // 简单的逐字循环，在目标属性下由编译器展开为 256 / 512 位的向量指令
+    template <class Op>
+    MINISTL_FLATTEN_AVX2 void avx2_bits_apply(uint64_t* dst, const uint64_t* src, size_t n) noexcept
+    {
+        for (size_t i = 0; i < n; ++i)
+            dst[i] = Op()(dst[i], src[i]);
+    }
+
+    template <class Op>
+    MINISTL_FLATTEN_AVX512 void avx512_bits_apply(uint64_t* dst, const uint64_t* src, size_t n) noexcept
+    {
+        for (size_t i = 0; i < n; ++i)
+            dst[i] = Op()(dst[i], src[i]);
+    }
+#endif
+
+    // [words, words + n) 中 1 的个数
+    inline size_t bits_count(const uint64_t* words, size_t n) noexcept
+    {
+#if MINISTL_SIMD_X86
+        switch (active_simd_level())
+        {
+        case simd_level::avx512:
+            if (bits_has_vpopcntdq())
+                return ministl::avx512_bits_count(words, n);
+            return ministl::avx2_bits_count(words, n);
+        case simd_level::avx2:
+            return ministl::avx2_bits_count(words, n);
+        default:
+            break;
+        }
+#endif
+        return ministl::scalar_bits_count(words, n);
+    }
+
+    template <class Op>
+    void bits_apply(uint64_t* dst, const uint64_t* src, size_t n) noexcept
+    {
+#if MINISTL_SIMD_X86
+        switch (active_simd_level())
+        {
+        case simd_level::avx512:
+            return ministl::avx512_bits_apply<Op>(dst, src, n);
+        case simd_level::avx2:
+            return ministl::avx2_bits_apply<Op>(dst, src, n);
+        default:
+            break;
+        }
+#endif
+        ministl::scalar_bits_apply<Op>(dst, src, n);
+    }
+
+    /*********************************************bit_vector***********************************************/
+    class bit_vector
+    {
+    public:
+        typedef uint64_t                                            word_type;
+        typedef size_t                                              size_type;
+        typedef bool                                                value_type;
+        typedef bool                                                const_reference;
+        typedef ministl::vector<word_type, aligned_allocator<word_type, 64>> storage_type;
+
+        static constexpr size_type word_bits = 64;
+        static constexpr size_type npos = static_cast<size_type>(-1);
+
+        // 单个位的引用代理
+        class reference
+        {
+            word_type* word_;
+            word_type  mask_;
+
+        public:
+            reference(word_type* word, word_type mask) noexcept : word_(word), mask_(mask) {}
+
+            operator bool() const noexcept { return (*word_ & mask_) != 0; }
+            bool operator~() const noexcept { return (*word_ & mask_) == 0; }
+
+            reference& operator=(bool value) noexcept
+            {
+                *word_ = value ? (*word_ | mask_) : (*word_ & ~mask_);
+                return *this;
+            }
+
+            reference& operator=(const reference& rhs) noexcept { return *this = static_cast<bool>(rhs); }
+
+            void flip() noexcept { *word_ ^= mask_; }
+        };
+
+    private:
+        storage_type words_;
+        size_type    size_;
+
+    public:
+        bit_vector() noexcept : words_(), size_(0) {}
+
+        explicit bit_vector(size_type n, bool value = false) : words_(words_for(n), value ? ~word_type(0) : 0), size_(n)
+        {
+            clear_tail();
+        }
+
+        bit_vector(std::initializer_list<bool> list) : bit_vector(list.size())
+        {
+            size_type i = 0;
+            for (bool b : list)
+                set(i++, b);
+        }
+
+        bit_vector(const bit_vector&) = default;
+        bit_vector(bit_vector&& rhs) noexcept : words_(ministl::move(rhs.words_)), size_(rhs.size_) { rhs.size_ = 0; }
+
+        bit_vector& operator=(const bit_vector&) = default;
+
+        bit_vector& operator=(bit_vector&& rhs) noexcept
+        {
+            words_ = ministl::move(rhs.words_);
+            size_ = rhs.size_;
+            rhs.size_ = 0;
+            return *this;
+        }
+
+    public:
+        // 容量相关操作
+        bool      empty()      const noexcept { return size_ == 0; }
+        size_type size()       const noexcept { return size_; }
+        size_type capacity()   const noexcept { return words_.capacity() * word_bits; }
+        size_type max_size()   const noexcept { return words_.max_size() * word_bits; }
+        size_type word_count() const noexcept { return words_.size(); }
+        size_type size_in_bytes() const noexcept { return words_.size() * sizeof(word_type); }
+
+        void reserve(size_type n) { words_.reserve(words_for(n)); }
+        void shrink_to_fit()      { words_.shrink_to_fit(); }
+
+        // 底层的字，最后一个字中超出 size() 的位为 0
+        word_type*       data()       noexcept { return words_.data(); }
+        const word_type* data() const noexcept { return words_.data(); }
+
+        // 访问元素相关操作
+        reference operator[](size_type pos)
+        {
+            MINISTL_DEBUG(pos < size_);
+            return reference(words_.data() + pos / word_bits, word_type(1) << (pos % word_bits));
+        }
+
+        bool operator[](size_type pos) const
+        {
+            MINISTL_DEBUG(pos < size_);
+            return test_unchecked(pos);
+        }
+
+        bool test(size_type pos) const
+        {
+            THROW_OUT_OF_RANGE_IF(!(pos < size_), "bit_vector::test() subscript out of range");
+            return test_unchecked(pos);
+        }
+
+        reference at(size_type pos)
+        {
+            THROW_OUT_OF_RANGE_IF(!(pos < size_), "bit_vector::at() subscript out of range");
+            return (*this)[pos];
+        }
+
+        bool at(size_type pos) const { return test(pos); }
+
+        // 修改容器相关操作
+        void push_back(bool value)
+        {
+            if (size_ % word_bits == 0)
+                words_.push_back(0);
+            words_.back() |= static_cast<word_type>(value) << (size_ % word_bits);
+            ++size_;
+        }
+
+        void pop_back()
+        {
+            MINISTL_DEBUG(!empty());
+            --size_;
+            if (size_ % word_bits == 0)
+                words_.pop_back();
+            else
+                words_.back() &= ~(word_type(1) << (size_ % word_bits));
+        }
+
+        void resize(size_type n, bool value = false)
+        {
+            const size_type old_size = size_;
+            words_.resize(words_for(n), 0);
+            size_ = n;
+            if (n > old_size && value)
+                set_range(old_size, n);
+            clear_tail();
+        }
+
+        void clear() noexcept
+        {
+            words_.clear();
+            size_ = 0;
+        }
+
+        void swap(bit_vector& rhs) noexcept
+        {
+            words_.swap(rhs.words_);
+            ministl::swap(size_, rhs.size_);
+        }
+
+        // 单个位
+        bit_vector& set(size_type pos, bool value = true)
+        {
+            (*this)[pos] = value;
+            return *this;
+        }
+
+        bit_vector& reset(size_type pos)
+        {
+            (*this)[pos] = false;
+            return *this;
+        }
+
+        bit_vector& flip(size_type pos)
+        {
+            (*this)[pos].flip();
+            return *this;
+        }
+
+        // 全部位
+        bit_vector& set()
+        {
+            if (!words_.empty())
+                std::memset(words_.data(), 0xFF, words_.size() * sizeof(word_type));
+            clear_tail();
+            return *this;
+        }
+
+        bit_vector& reset()
+        {
+            if (!words_.empty())
+                std::memset(words_.data(), 0, words_.size() * sizeof(word_type));
+            return *this;
+        }
+
+        bit_vector& flip()
+        {
+            for (size_type i = 0; i < words_.size(); ++i)
+                words_[i] = ~words_[i];
+            clear_tail();
+            return *this;
+        }
+
+        // [first, last) 中的位
+        bit_vector& set_range(size_type first, size_type last)
+        {
+            apply_range(first, last, bit_or_op(), ~word_type(0));
+            return *this;
+        }
+
+        bit_vector& reset_range(size_type first, size_type last)
+        {
+            apply_range(first, last, bit_andnot_op(), ~word_type(0));
+            return *this;
+        }
+
+        bit_vector& flip_range(size_type first, size_type last)
+        {
+            apply_range(first, last, bit_xor_op(), ~word_type(0));
+            return *this;
+        }
+
+        // 统计与查找
+        size_type count() const noexcept { return ministl::bits_count(words_.data(), words_.size()); }
+
+        bool any()  const noexcept { return find_first() != npos; }
+        bool none() const noexcept { return !any(); }
+        bool all()  const noexcept { return count() == size_; }
+
+        // 第一个为 1 的位，不存在时返回 npos
+        size_type find_first() const noexcept { return find_from_word(0); }
+
+        // pos 之后(不含 pos)第一个为 1 的位，不存在时返回 npos
+        size_type find_next(size_type pos) const noexcept
+        {
+            if (pos + 1 >= size_)
+                return npos;
+            ++pos;
+            const size_type w = pos / word_bits;
+            const word_type rest = words_[w] & (~word_type(0) << (pos % word_bits));
+            if (rest != 0)
+                return w * word_bits + bit_ctz64(rest);
+            return find_from_word(w + 1);
+        }
+
+        // 按位运算，两个 bit_vector 的长度必须相同
+        bit_vector& operator&=(const bit_vector& rhs)
+        {
+            return apply_words<bit_and_op>(rhs);
+        }
+
+        bit_vector& operator|=(const bit_vector& rhs)
+        {
+            return apply_words<bit_or_op>(rhs);
+        }
+
+        bit_vector& operator^=(const bit_vector& rhs)
+        {
+            return apply_words<bit_xor_op>(rhs);
+        }
+
+        // *this &= ~rhs
+        bit_vector& and_not(const bit_vector& rhs)
+        {
+            return apply_words<bit_andnot_op>(rhs);
+        }
+
+        bit_vector operator~() const
+        {
+            bit_vector tmp(*this);
+            tmp.flip();
+            return tmp;
+        }
+
+        bool equal(const bit_vector& rhs) const noexcept
+        {
+            return size_ == rhs.size_ && words_ == rhs.words_;
+        }
+
+    private:
+        static size_type words_for(size_type n) noexcept { return (n + word_bits - 1) / word_bits; }
+
+        bool test_unchecked(size_type pos) const noexcept
+        {
+            return (words_[pos / word_bits] >> (pos % word_bits)) & 1;
+        }
+
+        // 把最后一个字中超出 size() 的位清零
+        void clear_tail() noexcept
+        {
+            if (size_ % word_bits != 0)
+                words_.back() &= (word_type(1) << (size_ % word_bits)) - 1;
+        }
+
+        size_type find_from_word(size_type w) const noexcept
+        {
+            for (; w < words_.size(); ++w)
+            {
+                if (words_[w] != 0)
+                    return w * word_bits + bit_ctz64(words_[w]);
+            }
+            return npos;
+        }
+
+        template <class Op>
+        void apply_range(size_type first, size_type last, Op op, word_type ones)
+        {
+            THROW_OUT_OF_RANGE_IF(first > last || last > size_, "bit_vector range out of range");
+            if (first == last)
+                return;
+            const size_type fw = first / word_bits;
+            const size_type lw = (last - 1) / word_bits;
+            const word_type head = ones << (first % word_bits);
+            const word_type tail = ones >> (word_bits - 1 - (last - 1) % word_bits);
+            if (fw == lw)
+            {
+                words_[fw] = op(words_[fw], head & tail);
+                return;
+            }
+            words_[fw] = op(words_[fw], head);
+            for (size_type w = fw + 1; w < lw; ++w)
+                words_[w] = op(words_[w], ones);
+            words_[lw] = op(words_[lw], tail);
+        }
+
+        template <class Op>
+        bit_vector& apply_words(const bit_vector& rhs)
+        {
+            THROW_LENGTH_ERROR_IF(size_ != rhs.size_, "bit_vector bitwise operation requires equal sizes");
+            ministl::bits_apply<Op>(words_.data(), rhs.words_.data(), words_.size());
+            return *this;
+        }
+    };
+
+    /*****************************************************************************************/
+
+    inline bool operator==(const bit_vector& lhs, const bit_vector& rhs) { return lhs.equal(rhs); }
+    inline bool operator!=(const bit_vector& lhs, const bit_vector& rhs) { return !lhs.equal(rhs); }
+
+    inline bit_vector operator&(bit_vector lhs, const bit_vector& rhs) { return lhs &= rhs; }
+    inline bit_vector operator|(bit_vector lhs, const bit_vector& rhs) { return lhs |= rhs; }
+    inline bit_vector operator^(bit_vector lhs, const bit_vector& rhs) { return lhs ^= rhs; }
+
+    inline void swap(bit_vector& lhs, bit_vector& rhs) noexcept { lhs.swap(rhs); }
+
+    /******************************************bit_rank_select*********************************************/
+    class bit_rank_select
+    {
+    public:
+        typedef size_t size_type;
+
+        static constexpr size_type npos = static_cast<size_type>(-1);
+        static constexpr size_type block_bits = 512;          // 一条 cache line
+        static constexpr size_type block_words = block_bits / 64;
+        static constexpr size_type super_bits = 65536;
+        static constexpr size_type blocks_per_super = super_bits / block_bits;
+        static constexpr size_type select_sample = 8192;
+
+    private:
+        const bit_vector*        bits_;
+        ministl::vector<uint64_t> super_;       // 每个超级块之前 1 的个数
+        ministl::vector<uint16_t> blocks_;      // 每个块之前、同一超级块内 1 的个数
+        ministl::vector<size_type> samples1_;   // 第 k * select_sample 个 1 所在的块
+        ministl::vector<size_type> samples0_;   // 第 k * select_sample 个 0 所在的块
+        size_type                ones_;
+
+    public:
+        bit_rank_select() noexcept : bits_(nullptr), ones_(0) {}
+
+        explicit bit_rank_select(const bit_vector& bits) : bit_rank_select() { build(bits); }
+
+        void build(const bit_vector& bits)
+        {
+            bits_ = &bits;
+            const size_type nwords = bits.word_count();
+            const size_type nblocks = (nwords + block_words - 1) / block_words;
+            // 末尾多留一项，rank(size()) 恰好落在块边界时也能直接查表
+            super_.assign(nblocks / blocks_per_super + 2, 0);
+            blocks_.assign(nblocks + 1, 0);
+            samples1_.clear();
+            samples0_.clear();
+            const uint64_t* words = bits.data();
+            size_type total = 0;
+            size_type next1 = 0;
+            size_type next0 = 0;
+            for (size_type b = 0; b <= nblocks; ++b)
+            {
+                if (b % blocks_per_super == 0)
+                    super_[b / blocks_per_super] = total;
+                blocks_[b] = static_cast<uint16_t>(total - super_[b / blocks_per_super]);
+                if (b == nblocks)
+                    break;
+                const size_type first = b * block_words;
+                const size_type last = ministl::min(first + block_words, nwords);
+                const size_type ones = ministl::scalar_bits_count(words + first, last - first);
+                const size_type zeros = ministl::min(block_bits, bits.size() - b * block_bits) - ones;
+                const size_type zeros_before = b * block_bits - total;
+                total += ones;
+                for (; next1 < total; next1 += select_sample)
+                    samples1_.push_back(b);
+                for (; next0 < zeros_before + zeros; next0 += select_sample)
+                    samples0_.push_back(b);
+            }
+            ones_ = total;
+        }
+
+        size_type size()  const noexcept { return bits_ == nullptr ? 0 : bits_->size(); }
+        size_type ones()  const noexcept { return ones_; }
+        size_type zeros() const noexcept { return size() - ones_; }
+
+        // 索引本身占用的字节数
+        size_type size_in_bytes() const noexcept
+        {
+            return super_.size() * sizeof(uint64_t) + blocks_.size() * sizeof(uint16_t) +
+                   (samples1_.size() + samples0_.size()) * sizeof(size_type);
+        }
+
+        // [0, pos) 中 1 的个数，pos <= size()
+        size_type rank1(size_type pos) const noexcept
+        {
+            MINISTL_DEBUG(bits_ != nullptr && pos <= bits_->size());
+            const size_type b = pos / block_bits;
+            size_type r = block_rank(b);
+            const uint64_t* words = bits_->data();
+            const size_type w_end = pos / 64;
+            for (size_type w = b * block_words; w < w_end; ++w)
+                r += bit_popcount64(words[w]);
+            if (pos % 64 != 0)
+                r += bit_popcount64(words[w_end] & ((uint64_t(1) << (pos % 64)) - 1));
+            return r;
+        }
+
+        size_type rank0(size_type pos) const noexcept { return pos - rank1(pos); }
+
+        // 第 k 个(从 0 开始)1 / 0 的位置，不存在时返回 npos
+        size_type select1(size_type k) const noexcept { return select<true>(k); }
+        size_type select0(size_type k) const noexcept { return select<false>(k); }
+
+    private:
+        size_type block_rank(size_type b) const noexcept
+        {
+            return static_cast<size_type>(super_[b / blocks_per_super]) + blocks_[b];
+        }
+
+        template <bool One>
+        size_type count_before_block(size_type b) const noexcept
+        {
+            return One ? block_rank(b) : b * block_bits - block_rank(b);
+        }
+
+        template <bool One>
+        size_type select(size_type k) const noexcept
+        {
+            if (k >= (One ? ones_ : zeros()))
+                return npos;
+            const ministl::vector<size_type>& samples = One ? samples1_ : samples0_;
+            const size_type s = k / select_sample;
+            // 所求的位在块 [lo, hi] 中：找最后一个之前计数不超过 k 的块
+            size_type lo = samples[s];
+            size_type len = (s + 1 < samples.size() ? samples[s + 1] : blocks_.size() - 2) - lo + 1;
+            while (len > 1)
+            {
+                const size_type half = len / 2;
+                lo = count_before_block<One>(lo + half) <= k ? lo + half : lo;  // 条件传送，不产生分支预测失败
+                len -= half;
+            }
+            size_type rest = k - count_before_block<One>(lo);
+            const uint64_t* words = bits_->data();
+            for (size_type w = lo * block_words;; ++w)
+            {
+                const uint64_t word = One ? words[w] : ~words[w];
+                const unsigned n = bit_popcount64(word);
+                if (rest < n)
+                    return w * 64 + bit_select64(word, static_cast<unsigned>(rest));
+                rest -= n;
+            }
+        }
+    };
+}
+
+#endif //MINISTL_BIT_VECTOR_H
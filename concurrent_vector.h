@@ -0,0 +1,456 @@
+#ifndef MINISTL_CONCURRENT_VECTOR_H
+#define MINISTL_CONCURRENT_VECTOR_H
+
+// 这个头文件包含一个模板类 concurrent_vector
+// concurrent_vector : 可以被多个线程同时追加的 vector，元素地址在整个生命周期内不变
+
+// notes:
+// 存储：
+//   元素分段存放，第 k 段有 16 * 2^k 个元素，覆盖下标 [16 * (2^k - 1), 16 * (2^(k+1) - 1))，
+//   下标 i 所在的段为 log2(i / 16 + 1)，用一次 clz 算出。段一旦分配就不再移动，
+//   扩容只分配新的段，已有元素的引用、指针与迭代器在增长时都不会失效。
+// 并发追加：
+//   push_back / emplace_back / grow_by 用一次 fetch_add 在 size 上占下一段下标，再在这些位置上构造元素，
+//   追加之间不加锁。需要新段时，线程各自分配后用 CAS 安装到段表，失败的一方释放自己的那份。
+// 并发读取：
+//   段表中的指针以 acquire 读取，读取与其他线程的追加可以同时进行。size() 包含其他线程已经占下、
+//   可能仍在构造的位置：读者只应读取已经发布的元素，即构造它的 push_back 已经返回，并且下标通过
+//   原子变量、锁或线程 join 等同步方式交给了读者。
+// 非并发操作：
+//   clear / swap / 赋值 / 析构不能与其他任何操作同时进行。
+// 异常保证：
+//   下标一经占下就计入 size，其他线程可能已经占下了之后的位置，size 无法回退。
+//   因此元素的构造抛出异常时，本次占下的其余位置改为默认构造的值 T()，再把异常抛给调用者，
+//   调用者之后会在这些位置上看到 T()；为此要求 T 可以默认构造(static_assert 检查)。
+//   补位的默认构造再抛出异常，或者分配段失败时，调用 std::terminate
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <initializer_list>
+#include <type_traits>
+
+#include "algobase.h"
+#include "allocator.h"
+#include "exception.h"
+#include "iterator.h"
+#include "uninitialized.h"
+#include "util.h"
+#include "vector.h"
+
+namespace ministl
+{
+    // x != 0，最高位的 1 的下标
+    inline size_t concurrent_log2(size_t x) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return sizeof(unsigned long long) * 8 - 1 - static_cast<size_t>(__builtin_clzll(x));
+#else
+        size_t n = 0;
+        while (x >>= 1)
+            ++n;
+        return n;
+#endif
+    }
+
+    template <class Container, class Value, class Ref, class Ptr>
+    class concurrent_vector_iterator : public ministl::iterator<ministl::random_access_iterator_tag, Value,
+                                                                ptrdiff_t, Ptr, Ref>
+    {
+        template <class, class, class, class> friend class concurrent_vector_iterator;
+
+    public:
+        typedef Ptr                         pointer;
+        typedef Ref                         reference;
+        typedef size_t                      size_type;
+        typedef ptrdiff_t                   difference_type;
+        typedef concurrent_vector_iterator  self;
+
+    private:
+        Container* c_;
+        size_type  index_;
+
+    public:
+        concurrent_vector_iterator() noexcept : c_(nullptr), index_(0) {}
+        concurrent_vector_iterator(Container* c, size_type index) noexcept : c_(c), index_(index) {}
+
+        // iterator 可以转换为 const_iterator
+        template <class C, class R, class P>
+        concurrent_vector_iterator(const concurrent_vector_iterator<C, Value, R, P>& rhs) noexcept
+                : c_(rhs.c_), index_(rhs.index_) {}
+
+        size_type index() const noexcept { return index_; }
+
+        reference operator*()  const { return (*c_)[index_]; }
+        pointer   operator->() const { return &(operator*()); }
+        reference operator[](difference_type n) const { return (*c_)[index_ + n]; }
+
+        self& operator++()    { ++index_; return *this; }
+        self  operator++(int) { self tmp = *this; ++index_; return tmp; }
+        self& operator--()    { --index_; return *this; }
+        self  operator--(int) { self tmp = *this; --index_; return tmp; }
+
+        self& operator+=(difference_type n) { index_ += n; return *this; }
+        self& operator-=(difference_type n) { index_ -= n; return *this; }
+        self  operator+(difference_type n) const { self tmp = *this; return tmp += n; }
+        self  operator-(difference_type n) const { self tmp = *this; return tmp -= n; }
+
+        difference_type operator-(const self& rhs) const
+        {
+            return static_cast<difference_type>(index_) - static_cast<difference_type>(rhs.index_);
+        }
+
+        bool operator==(const self& rhs) const { return index_ == rhs.index_; }
+        bool operator!=(const self& rhs) const { return index_ != rhs.index_; }
+        bool operator< (const self& rhs) const { return index_ <  rhs.index_; }
+        bool operator> (const self& rhs) const { return index_ >  rhs.index_; }
+        bool operator<=(const self& rhs) const { return index_ <= rhs.index_; }
+        bool operator>=(const self& rhs) const { return index_ >= rhs.index_; }
+    };
+
+    template <class T>
+    class concurrent_vector
+    {
+        static_assert(std::is_default_constructible<T>::value,
+                      "concurrent_vector<T> requires T to be default constructible: "
+                      "slots whose construction throws are filled with T()");
+
+    public:
+        typedef T                                               value_type;
+        typedef T*                                              pointer;
+        typedef const T*                                        const_pointer;
+        typedef T&                                              reference;
+        typedef const T&                                        const_reference;
+        typedef size_t                                          size_type;
+        typedef ptrdiff_t                                       difference_type;
+
+        typedef concurrent_vector_iterator<concurrent_vector, T, T&, T*>              iterator;
+        typedef concurrent_vector_iterator<const concurrent_vector, T, const T&, const T*> const_iterator;
+
+    private:
+        typedef ministl::allocator<T>  data_allocator;
+
+        static constexpr size_type first_bits   = 4;   // 第 0 段有 2^first_bits 个元素
+        static constexpr size_type max_segments = sizeof(size_type) * 8 - first_bits;
+
+        std::atomic<T*>                    segments_[max_segments];
+        alignas(64) std::atomic<size_type> size_;
+
+    public:
+        // 构造、复制、移动、析构函数，均不能与其他操作同时进行
+        concurrent_vector() noexcept : size_(0)
+        {
+            for (auto& s : segments_)
+                s.store(nullptr, std::memory_order_relaxed);
+        }
+
+        explicit concurrent_vector(size_type n) : concurrent_vector() { grow_by(n); }
+
+        concurrent_vector(size_type n, const value_type& value) : concurrent_vector() { grow_by(n, value); }
+
+        template <class Iter, typename std::enable_if<ministl::is_input_iterator<Iter>::value, int>::type = 0>
+        concurrent_vector(Iter first, Iter last) : concurrent_vector() { grow_by(first, last); }
+
+        concurrent_vector(std::initializer_list<value_type> list) : concurrent_vector(list.begin(), list.end()) {}
+
+        concurrent_vector(const concurrent_vector& rhs) : concurrent_vector() { grow_by(rhs.begin(), rhs.end()); }
+
+        concurrent_vector(concurrent_vector&& rhs) noexcept : concurrent_vector() { swap(rhs); }
+
+        concurrent_vector& operator=(const concurrent_vector& rhs)
+        {
+            if (this != &rhs)
+            {
+                concurrent_vector tmp(rhs);
+                swap(tmp);
+            }
+            return *this;
+        }
+
+        concurrent_vector& operator=(concurrent_vector&& rhs) noexcept
+        {
+            concurrent_vector tmp(ministl::move(rhs));
+            swap(tmp);
+            return *this;
+        }
+
+        ~concurrent_vector()
+        {
+            clear();
+            for (auto& s : segments_)
+                data_allocator::deallocate(s.load(std::memory_order_relaxed));
+        }
+
+    public:
+        // 迭代器相关操作
+        iterator       begin()        noexcept { return iterator(this, 0); }
+        const_iterator begin()  const noexcept { return const_iterator(this, 0); }
+        iterator       end()          noexcept { return iterator(this, size()); }
+        const_iterator end()    const noexcept { return const_iterator(this, size()); }
+        const_iterator cbegin() const noexcept { return begin(); }
+        const_iterator cend()   const noexcept { return end(); }
+
+        // 容量相关操作
+        bool      empty()    const noexcept { return size() == 0; }
+        size_type size()     const noexcept { return size_.load(std::memory_order_acquire); }
+        size_type max_size() const noexcept { return static_cast<size_type>(-1) / sizeof(T); }
+
+        // 从第 0 段起连续分配好的段能容纳的元素个数
+        size_type capacity() const noexcept
+        {
+            size_type k = 0;
+            while (k < max_segments && segments_[k].load(std::memory_order_acquire) != nullptr)
+                ++k;
+            return segment_base(k);
+        }
+
+        // 预先分配能容纳 n 个元素的段，可以与追加同时进行
+        void reserve(size_type n)
+        {
+            THROW_LENGTH_ERROR_IF(n > max_size(), "concurrent_vector<T>'s size too big");
+            if (n == 0)
+                return;
+            for (size_type k = 0; k <= segment_index(n - 1); ++k)
+                segment(k);
+        }
+
+        // 访问元素相关操作
+        reference operator[](size_type n)
+        {
+            const size_type k = segment_index(n);
+            return segments_[k].load(std::memory_order_acquire)[n - segment_base(k)];
+        }
+
+        const_reference operator[](size_type n) const
+        {
+            const size_type k = segment_index(n);
+            return segments_[k].load(std::memory_order_acquire)[n - segment_base(k)];
+        }
+
+        reference at(size_type n)
+        {
+            THROW_OUT_OF_RANGE_IF(!(n < size()), "concurrent_vector::at() subscript out of range");
+            return (*this)[n];
+        }
+
+        const_reference at(size_type n) const
+        {
+            THROW_OUT_OF_RANGE_IF(!(n < size()), "concurrent_vector::at() subscript out of range");
+            return (*this)[n];
+        }
+
+        reference       front()       { return (*this)[0]; }
+        const_reference front() const { return (*this)[0]; }
+
+        // 并发追加相关操作，返回指向第一个新元素的迭代器
+        template <class... Args>
+        iterator emplace_back(Args&&... args)
+        {
+            const size_type i = size_.fetch_add(1, std::memory_order_relaxed);
+            construct_at(slot(i), ministl::forward<Args>(args)...);
+            return iterator(this, i);
+        }
+
+        iterator push_back(const value_type& value) { return emplace_back(value); }
+        iterator push_back(value_type&& value)      { return emplace_back(ministl::move(value)); }
+
+        iterator grow_by(size_type n)
+        {
+            return grow_range(claim(n), n, [](T* p, size_type) { data_allocator::construct(p); });
+        }
+
+        iterator grow_by(size_type n, const value_type& value)
+        {
+            return grow_range(claim(n), n, [&value](T* p, size_type) { data_allocator::construct(p, value); });
+        }
+
+        template <class Iter, typename std::enable_if<ministl::is_input_iterator<Iter>::value, int>::type = 0>
+        iterator grow_by(Iter first, Iter last)
+        {
+            return grow_by_range(first, last, ministl::iterator_category(first));
+        }
+
+        iterator grow_by(std::initializer_list<value_type> list) { return grow_by(list.begin(), list.end()); }
+
+        // 保证至少有 n 个元素，不足的部分默认构造；返回指向原来第 n 个位置的迭代器
+        iterator grow_to_at_least(size_type n)
+        {
+            size_type cur = size_.load(std::memory_order_relaxed);
+            while (cur < n)
+            {
+                if (size_.compare_exchange_weak(cur, n, std::memory_order_relaxed))
+                {
+                    grow_range(cur, n - cur, [](T* p, size_type) { data_allocator::construct(p); });
+                    break;
+                }
+            }
+            return iterator(this, n);
+        }
+
+        // 非并发操作
+        void clear() noexcept
+        {
+            const size_type n = size_.load(std::memory_order_relaxed);
+            for (size_type k = 0; segment_base(k) < n; ++k)
+            {
+                T* p = segments_[k].load(std::memory_order_relaxed);
+                const size_type count = ministl::min(segment_size(k), n - segment_base(k));
+                data_allocator::destroy(p, p + count);
+            }
+            size_.store(0, std::memory_order_relaxed);
+        }
+
+        void swap(concurrent_vector& rhs) noexcept
+        {
+            for (size_type k = 0; k < max_segments; ++k)
+            {
+                T* p = segments_[k].load(std::memory_order_relaxed);
+                segments_[k].store(rhs.segments_[k].load(std::memory_order_relaxed), std::memory_order_relaxed);
+                rhs.segments_[k].store(p, std::memory_order_relaxed);
+            }
+            const size_type n = size_.load(std::memory_order_relaxed);
+            size_.store(rhs.size_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            rhs.size_.store(n, std::memory_order_relaxed);
+        }
+
+        // 按段整块复制到一个连续的 vector 中，只分配一次
+        ministl::vector<T> to_vector() const
+        {
+            ministl::vector<T> v;
+            const size_type n = size();
+            v.append_uninitialized(n, [this, n](T* dst) {
+                T* cur = dst;
+                try
+                {
+                    for (size_type k = 0; segment_base(k) < n; ++k)
+                    {
+                        const T* p = segments_[k].load(std::memory_order_acquire);
+                        cur = ministl::uninitialized_copy(p, p + ministl::min(segment_size(k), n - segment_base(k)), cur);
+                    }
+                }
+                catch (...)
+                {
+                    ministl::destroy(dst, cur);
+                    throw;
+                }
+            });
+            return v;
+        }
+
+    private:
+        static size_type segment_index(size_type i) noexcept { return concurrent_log2((i >> first_bits) + 1); }
+        static size_type segment_base(size_type k)  noexcept { return ((size_type(1) << k) - 1) << first_bits; }
+        static size_type segment_size(size_type k)  noexcept { return size_type(1) << (k + first_bits); }
+
+        // 第 k 段，没有时分配并安装
+        T* segment(size_type k) noexcept
+        {
+            T* p = segments_[k].load(std::memory_order_acquire);
+            if (p != nullptr)
+                return p;
+            T* fresh = data_allocator::allocate(segment_size(k));
+            if (segments_[k].compare_exchange_strong(p, fresh, std::memory_order_acq_rel, std::memory_order_acquire))
+                return fresh;
+            data_allocator::deallocate(fresh);
+            return p;
+        }
+
+        T* slot(size_type i) noexcept
+        {
+            const size_type k = segment_index(i);
+            return segment(k) + (i - segment_base(k));
+        }
+
+        size_type claim(size_type n)
+        {
+            THROW_LENGTH_ERROR_IF(n > max_size(), "concurrent_vector<T>'s size too big");
+            return size_.fetch_add(n, std::memory_order_relaxed);
+        }
+
+        template <class... Args>
+        static void construct_at(T* p, Args&&... args)
+        {
+            try
+            {
+                data_allocator::construct(p, ministl::forward<Args>(args)...);
+            }
+            catch (...)
+            {
+                fill_failed(p);
+                throw;
+            }
+        }
+
+        // 构造失败的位置已经计入 size，必须有一个对象，补上 T()；noexcept 使补位失败时 std::terminate
+        static void fill_failed(T* p) noexcept
+        {
+            data_allocator::construct(p);
+        }
+
+        // 输入迭代器只能遍历一次，不能先求长度再读取：先读入局部的 vector，再整段移动进来
+        template <class InputIter>
+        iterator grow_by_range(InputIter first, InputIter last, input_iterator_tag)
+        {
+            ministl::vector<T> buffer;
+            for (; first != last; ++first)
+                buffer.emplace_back(*first);
+            T* const src = buffer.data();
+            const size_type n = buffer.size();
+            return grow_range(claim(n), n, [src](T* p, size_type j) {
+                data_allocator::construct(p, ministl::move(src[j]));
+            });
+        }
+
+        template <class ForwardIter>
+        iterator grow_by_range(ForwardIter first, ForwardIter last, forward_iterator_tag)
+        {
+            const size_type n = static_cast<size_type>(ministl::distance(first, last));
+            return grow_range(claim(n), n, [&first](T* p, size_type) {
+                data_allocator::construct(p, *first);
+                ++first;
+            });
+        }
+
+        // 在已经占下的 [first, first + n) 上逐段构造元素，c(p, j) 构造第 j 个
+        template <class Construct>
+        iterator grow_range(size_type first, size_type n, Construct c)
+        {
+            size_type j = 0;
+            try
+            {
+                while (j < n)
+                {
+                    const size_type i = first + j;
+                    const size_type k = segment_index(i);
+                    T* p = segment(k) + (i - segment_base(k));
+                    const size_type count = ministl::min(n - j, segment_base(k) + segment_size(k) - i);
+                    for (size_type t = 0; t < count; ++t, ++j)
+                        c(p + t, j);
+                }
+            }
+            catch (...)
+            {
+                for (; j < n; ++j)
+                    fill_failed(slot(first + j));
+                throw;
+            }
+            return iterator(this, first);
+        }
+    };
+
+    /*****************************************************************************************/
+
+    template <class T>
+    bool operator==(const concurrent_vector<T>& lhs, const concurrent_vector<T>& rhs)
+    {
+        return lhs.size() == rhs.size() && ministl::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+
+    template <class T>
+    bool operator!=(const concurrent_vector<T>& lhs, const concurrent_vector<T>& rhs) { return !(lhs == rhs); }
+
+    template <class T>
+    void swap(concurrent_vector<T>& lhs, concurrent_vector<T>& rhs) noexcept { lhs.swap(rhs); }
+}
+
+#endif //MINISTL_CONCURRENT_VECTOR_H
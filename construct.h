@@ -28,10 +28,13 @@ namespace ministl
     template <class T, class ...Args>
     void construct(T* ptr, Args &&... args)
     {
-        ::new((void*) ptr) T(ministl::forward<T>(args)...);
+        ::new((void*) ptr) T(ministl::forward<Args>(args)...);
     }
 
     //destroy------>析构对象
+    template <class T>
+    void destroy(T* ptr);
+
     template <class T>
     void destroy_one(T*, std::true_type){}
 
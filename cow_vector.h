@@ -0,0 +1,391 @@
+#ifndef MINISTL_COW_VECTOR_H
+#define MINISTL_COW_VECTOR_H
+
+// 这个头文件包含一个模板类 cow_vector
+// cow_vector : 写时复制的 vector，拷贝只增加引用计数，第一次修改时才真正复制元素
+
+// notes:
+// 存储：
+//   一次分配同时放下控制块与元素：[cow_header | T T T ...]，控制块在元素之前，
+//   对象本身只保存 begin_ / end_ / cap_ 三个指针，与 vector 的布局相同。
+//   读(const 版本的 operator[] / begin / data / size 等)不碰控制块，开销与 vector 相同。
+// 共享与复制：
+//   拷贝构造与拷贝赋值原子地增加引用计数；修改前若引用计数不为 1，先复制一份独占的缓冲区。
+//   引用计数的增加用 relaxed，减少用 acq_rel，判断独占用 acquire，多个线程可以同时拷贝、销毁同一份快照。
+// 可变引用：
+//   非 const 的 operator[] / at / begin / end / front / back / data 交出了可以写入的引用或指针，
+//   交出后该缓冲区被标记为不可共享，之后的拷贝总是深拷贝，避免通过旧引用改到别人的快照；
+//   只读的场景请通过 const 引用或 cbegin / cend 访问。set(n, value) 修改元素但不交出引用
+
+#include <atomic>
+#include <cstddef>
+#include <initializer_list>
+#include <type_traits>
+
+#include "algobase.h"
+#include "allocator.h"
+#include "exception.h"
+#include "iterator.h"
+#include "uninitialized.h"
+#include "util.h"
+#include "vector.h"
+
+namespace ministl
+{
+    template <class T>
+    class cow_vector
+    {
+    public:
+        typedef T                                               value_type;
+        typedef T*                                              pointer;
+        typedef const T*                                        const_pointer;
+        typedef T&                                              reference;
+        typedef const T&                                        const_reference;
+        typedef size_t                                          size_type;
+        typedef ptrdiff_t                                       difference_type;
+
+        typedef value_type*                                     iterator;
+        typedef const value_type*                               const_iterator;
+
+    private:
+        struct cow_header
+        {
+            std::atomic<size_type> refs;
+            bool                   shareable;
+        };
+
+        // 以 align 字节为单位分配，控制块占 header_units 个单位，元素紧随其后
+        static constexpr size_t align = alignof(T) > alignof(cow_header) ? alignof(T) : alignof(cow_header);
+        typedef typename std::aligned_storage<align, align>::type unit_type;
+        typedef ministl::allocator<unit_type>                    unit_allocator;
+        typedef ministl::allocator<T>                            data_allocator;
+
+        static constexpr size_t header_units = (sizeof(cow_header) + align - 1) / align;
+
+        T* begin_;
+        T* end_;
+        T* cap_;
+
+    public:
+        // 构造、复制、移动、析构函数
+        cow_vector() noexcept : begin_(nullptr), end_(nullptr), cap_(nullptr) {}
+
+        explicit cow_vector(size_type n) : cow_vector(n, value_type()) {}
+
+        cow_vector(size_type n, const value_type& value) : cow_vector()
+        {
+            if (n == 0)
+                return;
+            allocate_block(n);
+            ministl::uninitialized_fill_n(begin_, n, value);
+            end_ = begin_ + n;
+        }
+
+        template <class Iter, typename std::enable_if<ministl::is_input_iterator<Iter>::value, int>::type = 0>
+        cow_vector(Iter first, Iter last) : cow_vector()
+        {
+            const size_type n = static_cast<size_type>(ministl::distance(first, last));
+            if (n == 0)
+                return;
+            allocate_block(n);
+            end_ = ministl::uninitialized_copy(first, last, begin_);
+        }
+
+        cow_vector(std::initializer_list<value_type> list) : cow_vector(list.begin(), list.end()) {}
+
+        cow_vector(const cow_vector& rhs) : cow_vector() { share_from(rhs); }
+
+        cow_vector(cow_vector&& rhs) noexcept : begin_(rhs.begin_), end_(rhs.end_), cap_(rhs.cap_)
+        {
+            rhs.begin_ = rhs.end_ = rhs.cap_ = nullptr;
+        }
+
+        cow_vector& operator=(const cow_vector& rhs)
+        {
+            if (this != &rhs)
+            {
+                cow_vector tmp(rhs);
+                swap(tmp);
+            }
+            return *this;
+        }
+
+        cow_vector& operator=(cow_vector&& rhs) noexcept
+        {
+            cow_vector tmp(ministl::move(rhs));
+            swap(tmp);
+            return *this;
+        }
+
+        cow_vector& operator=(std::initializer_list<value_type> list)
+        {
+            cow_vector tmp(list);
+            swap(tmp);
+            return *this;
+        }
+
+        ~cow_vector() { release(); }
+
+    public:
+        // 只读访问，不复制、不修改控制块
+        const_iterator begin()  const noexcept { return begin_; }
+        const_iterator end()    const noexcept { return end_; }
+        const_iterator cbegin() const noexcept { return begin_; }
+        const_iterator cend()   const noexcept { return end_; }
+
+        bool      empty()    const noexcept { return begin_ == end_; }
+        size_type size()     const noexcept { return static_cast<size_type>(end_ - begin_); }
+        size_type capacity() const noexcept { return static_cast<size_type>(cap_ - begin_); }
+        size_type max_size() const noexcept { return static_cast<size_type>(-1) / sizeof(T); }
+
+        const_reference operator[](size_type n) const
+        {
+            MINISTL_DEBUG(n < size());
+            return begin_[n];
+        }
+
+        const_reference at(size_type n) const
+        {
+            THROW_OUT_OF_RANGE_IF(!(n < size()), "cow_vector::at() subscript out of range");
+            return begin_[n];
+        }
+
+        const_reference front() const { return *begin_; }
+        const_reference back()  const { return *(end_ - 1); }
+        const_pointer   data()  const noexcept { return begin_; }
+
+        // 共享同一缓冲区的 cow_vector 个数，空容器为 0
+        size_type use_count() const noexcept
+        {
+            return begin_ == nullptr ? 0 : header()->refs.load(std::memory_order_acquire);
+        }
+
+        bool shared() const noexcept { return use_count() > 1; }
+
+        // 可写访问：先取得独占的缓冲区，并标记为不可共享
+        iterator begin() { return mutable_data(); }
+        iterator end()   { return mutable_data() + size(); }
+
+        reference operator[](size_type n)
+        {
+            MINISTL_DEBUG(n < size());
+            return mutable_data()[n];
+        }
+
+        reference at(size_type n)
+        {
+            THROW_OUT_OF_RANGE_IF(!(n < size()), "cow_vector::at() subscript out of range");
+            return mutable_data()[n];
+        }
+
+        reference front() { return *mutable_data(); }
+        reference back()  { return mutable_data()[size() - 1]; }
+        pointer   data()  { return mutable_data(); }
+
+        // 修改容器相关操作
+        void set(size_type n, const value_type& value)
+        {
+            MINISTL_DEBUG(n < size());
+            detach(capacity());
+            begin_[n] = value;
+        }
+
+        void reserve(size_type n)
+        {
+            if (n > capacity())
+            {
+                THROW_LENGTH_ERROR_IF(n > max_size(), "cow_vector<T>'s size too big");
+                detach(n);
+            }
+        }
+
+        template <class... Args>
+        void emplace_back(Args&&... args)
+        {
+            if (end_ != cap_ && unique())
+            {
+                data_allocator::construct(end_, ministl::forward<Args>(args)...);
+                ++end_;
+                return;
+            }
+            // 参数可能引用本容器中的元素，先构造出新元素再换缓冲区
+            value_type tmp(ministl::forward<Args>(args)...);
+            detach(end_ == cap_ ? ministl::growth_capacity(capacity(), size_type(1), max_size()) : capacity());
+            data_allocator::construct(end_, ministl::move(tmp));
+            ++end_;
+        }
+
+        void push_back(const value_type& value) { emplace_back(value); }
+        void push_back(value_type&& value)      { emplace_back(ministl::move(value)); }
+
+        void pop_back()
+        {
+            MINISTL_DEBUG(!empty());
+            detach(capacity());
+            --end_;
+            data_allocator::destroy(end_);
+        }
+
+        iterator erase(const_iterator first, const_iterator last)
+        {
+            MINISTL_DEBUG(begin_ <= first && first <= last && last <= end_);
+            const size_type pos = static_cast<size_type>(first - begin_);
+            const size_type count = static_cast<size_type>(last - first);
+            detach(capacity());
+            iterator r = begin_ + pos;
+            T* new_end = ministl::move(r + count, end_, r);
+            data_allocator::destroy(new_end, end_);
+            end_ = new_end;
+            return r;
+        }
+
+        iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+        void resize(size_type n) { resize(n, value_type()); }
+
+        void resize(size_type n, const value_type& value)
+        {
+            if (n < size())
+            {
+                erase(begin_ + n, end_);
+                return;
+            }
+            reserve(n);
+            detach(capacity());
+            end_ = ministl::uninitialized_fill_n(end_, n - size(), value);
+        }
+
+        // 放弃对缓冲区的引用，不复制
+        void clear() noexcept
+        {
+            release();
+            begin_ = end_ = cap_ = nullptr;
+        }
+
+        void swap(cow_vector& rhs) noexcept
+        {
+            ministl::swap(begin_, rhs.begin_);
+            ministl::swap(end_, rhs.end_);
+            ministl::swap(cap_, rhs.cap_);
+        }
+
+    private:
+        cow_header* header() const noexcept
+        {
+            return reinterpret_cast<cow_header*>(reinterpret_cast<unit_type*>(begin_) - header_units);
+        }
+
+        bool unique() const noexcept
+        {
+            return begin_ != nullptr && header()->refs.load(std::memory_order_acquire) == 1;
+        }
+
+        // 分配能放下 n 个元素的新缓冲区，引用计数为 1，元素尚未构造
+        void allocate_block(size_type n)
+        {
+            unit_type* block = unit_allocator::allocate(header_units + (n * sizeof(T) + align - 1) / align);
+            cow_header* h = reinterpret_cast<cow_header*>(block);
+            ::new (static_cast<void*>(h)) cow_header();
+            h->refs.store(1, std::memory_order_relaxed);
+            h->shareable = true;
+            begin_ = end_ = reinterpret_cast<T*>(block + header_units);
+            cap_ = begin_ + n;
+        }
+
+        static void free_block(T* first, T* last)
+        {
+            data_allocator::destroy(first, last);
+            cow_header* h = reinterpret_cast<cow_header*>(reinterpret_cast<unit_type*>(first) - header_units);
+            h->~cow_header();
+            unit_allocator::deallocate(reinterpret_cast<unit_type*>(h));
+        }
+
+        void release() noexcept
+        {
+            if (begin_ != nullptr && header()->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                free_block(begin_, end_);
+        }
+
+        void share_from(const cow_vector& rhs)
+        {
+            if (rhs.begin_ == nullptr)
+                return;
+            if (rhs.header()->shareable)
+            {
+                rhs.header()->refs.fetch_add(1, std::memory_order_relaxed);
+                begin_ = rhs.begin_;
+                end_ = rhs.end_;
+                cap_ = rhs.cap_;
+                return;
+            }
+            allocate_block(rhs.size());
+            end_ = ministl::uninitialized_copy(rhs.begin_, rhs.end_, begin_);
+        }
+
+        // 保证缓冲区独占且容量至少为 cap；共享时复制元素，独占时移动元素
+        void detach(size_type cap)
+        {
+            if (cap <= capacity() && unique())
+                return;
+            if (cap == 0)
+                return;
+            if (cap < size())
+                cap = size();
+            T* old_begin = begin_;
+            T* old_end = end_;
+            T* old_cap = cap_;
+            const bool owned = unique();
+            allocate_block(cap);
+            try
+            {
+                end_ = owned ? ministl::uninitialized_move(old_begin, old_end, begin_)
+                             : ministl::uninitialized_copy(old_begin, old_end, begin_);
+            }
+            catch (...)
+            {
+                free_block(begin_, begin_);
+                begin_ = old_begin;
+                end_ = old_end;
+                cap_ = old_cap;
+                throw;
+            }
+            if (old_begin != nullptr)
+            {
+                cow_header* h = reinterpret_cast<cow_header*>(reinterpret_cast<unit_type*>(old_begin) - header_units);
+                if (h->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                    free_block(old_begin, old_end);
+            }
+        }
+
+        T* mutable_data()
+        {
+            detach(capacity());
+            if (begin_ != nullptr)
+                header()->shareable = false;
+            return begin_;
+        }
+    };
+
+    /*****************************************************************************************/
+
+    template <class T>
+    bool operator==(const cow_vector<T>& lhs, const cow_vector<T>& rhs)
+    {
+        return lhs.size() == rhs.size() &&
+               (lhs.data() == rhs.data() || ministl::equal(lhs.begin(), lhs.end(), rhs.begin()));
+    }
+
+    template <class T>
+    bool operator!=(const cow_vector<T>& lhs, const cow_vector<T>& rhs) { return !(lhs == rhs); }
+
+    template <class T>
+    bool operator<(const cow_vector<T>& lhs, const cow_vector<T>& rhs)
+    {
+        return ministl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+    template <class T>
+    void swap(cow_vector<T>& lhs, cow_vector<T>& rhs) noexcept { lhs.swap(rhs); }
+}
+
+#endif //MINISTL_COW_VECTOR_H
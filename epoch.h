@@ -0,0 +1,229 @@
+#ifndef MINISTL_EPOCH_H
+#define MINISTL_EPOCH_H
+
+// 这个头文件包含基于 epoch 的内存回收(epoch-based reclamation)
+// epoch_domain : 全局 epoch 与各线程的登记记录，负责推进 epoch 并释放被替换下来的对象
+// epoch_guard  : 读者临界区，构造时登记当前 epoch，析构时退出
+
+// notes:
+// 读者进入临界区只有一次原子交换，不加锁、不等待其他线程(wait-free)，临界区可以嵌套。
+// 写者把已经不可见的对象交给 retire()，同时记下当时的全局 epoch e。全局 epoch 只有在所有临界区内的读者
+// 都登记了当前 epoch 时才能加一，到达 e + 2 时，e 之前进入临界区的读者都已离开，对象可以安全释放。
+// 读者持有临界区越久，回收越晚，临界区应当短小。
+// 线程第一次进入临界区时领取一条登记记录，线程退出时归还，之后由新线程复用，记录本身直到程序结束才释放。
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "aligned_allocator.h"
+#include "util.h"
+
+namespace ministl
+{
+    class epoch_domain
+    {
+    private:
+        struct alignas(64) record
+        {
+            std::atomic<uint64_t> state;    // 0 表示不在临界区，否则为 (epoch << 1) | 1
+            std::atomic<bool>     in_use;
+            record*               next;
+            size_t                depth;    // 嵌套层数，只由持有记录的线程访问
+
+            record() : state(0), in_use(true), next(nullptr), depth(0) {}
+        };
+
+        typedef ministl::aligned_allocator<record, 64> record_allocator;
+
+        struct retired
+        {
+            void*    ptr;
+            void   (*deleter)(void*);
+            uint64_t epoch;
+        };
+
+        // 当前线程领取的登记记录，线程退出时归还
+        struct thread_slot
+        {
+            record* rec;
+
+            thread_slot() : rec(nullptr) {}
+            ~thread_slot()
+            {
+                if (rec != nullptr)
+                    rec->in_use.store(false, std::memory_order_release);
+            }
+        };
+
+        alignas(64) std::atomic<uint64_t> epoch_;
+        alignas(64) std::atomic<record*>  records_;
+        mutable std::mutex                retire_lock_;
+        std::vector<retired>              retired_;
+
+        epoch_domain() : epoch_(1), records_(nullptr) {}
+
+    public:
+        epoch_domain(const epoch_domain&) = delete;
+        epoch_domain& operator=(const epoch_domain&) = delete;
+
+        // 程序结束时已经没有读者，释放剩下的对象与全部登记记录
+        ~epoch_domain()
+        {
+            for (auto& r : retired_)
+                r.deleter(r.ptr);
+            record* r = records_.load(std::memory_order_acquire);
+            while (r != nullptr)
+            {
+                record* next = r->next;
+                r->~record();
+                record_allocator::deallocate(r);
+                r = next;
+            }
+        }
+
+        static epoch_domain& instance()
+        {
+            static epoch_domain domain;
+            return domain;
+        }
+
+        // 读者进入、离开临界区
+        void enter()
+        {
+            record* r = local_record();
+            if (r->depth++ != 0)
+                return;
+            // 登记必须在随后读取共享指针之前对写者可见；x86 上 exchange 比 store 加 fence 便宜
+            r->state.exchange((epoch_.load(std::memory_order_relaxed) << 1) | 1, std::memory_order_seq_cst);
+        }
+
+        void leave() noexcept
+        {
+            record* r = local_slot().rec;
+            if (--r->depth == 0)
+                r->state.store(0, std::memory_order_release);
+        }
+
+        // p 已经对新进入的读者不可见，等可能持有它的读者全部离开后调用 deleter(p)
+        void retire(void* p, void (*deleter)(void*))
+        {
+            std::vector<retired> ready;
+            {
+                std::lock_guard<std::mutex> guard(retire_lock_);
+                retired_.push_back(retired{p, deleter, epoch_.load(std::memory_order_seq_cst)});
+                try_advance();
+                collect(ready);
+            }
+            for (auto& r : ready)
+                r.deleter(r.ptr);
+        }
+
+        template <class T>
+        void retire(T* p)
+        {
+            retire(static_cast<void*>(p), [](void* q) { delete static_cast<T*>(q); });
+        }
+
+        // 等到此前 retire 的对象全部释放，不能在临界区内调用
+        void synchronize()
+        {
+            for (;;)
+            {
+                std::vector<retired> ready;
+                bool done = false;
+                {
+                    std::lock_guard<std::mutex> guard(retire_lock_);
+                    try_advance();
+                    collect(ready);
+                    done = retired_.empty();
+                }
+                for (auto& r : ready)
+                    r.deleter(r.ptr);
+                if (done)
+                    return;
+                std::this_thread::yield();
+            }
+        }
+
+        // 等待释放的对象个数
+        size_t pending() const
+        {
+            std::lock_guard<std::mutex> guard(retire_lock_);
+            return retired_.size();
+        }
+
+        uint64_t epoch() const noexcept { return epoch_.load(std::memory_order_acquire); }
+
+    private:
+        static thread_slot& local_slot() noexcept
+        {
+            static thread_local thread_slot slot;
+            return slot;
+        }
+
+        record* local_record()
+        {
+            thread_slot& slot = local_slot();
+            if (slot.rec != nullptr)
+                return slot.rec;
+            // 先复用已退出线程归还的记录
+            for (record* r = records_.load(std::memory_order_acquire); r != nullptr; r = r->next)
+            {
+                bool expected = false;
+                if (!r->in_use.load(std::memory_order_relaxed) &&
+                    r->in_use.compare_exchange_strong(expected, true, std::memory_order_acq_rel))
+                    return slot.rec = r;
+            }
+            record* r = ::new (static_cast<void*>(record_allocator::allocate(1))) record();
+            r->next = records_.load(std::memory_order_relaxed);
+            while (!records_.compare_exchange_weak(r->next, r, std::memory_order_release, std::memory_order_relaxed))
+                ;
+            return slot.rec = r;
+        }
+
+        // 所有临界区内的读者都登记了当前 epoch 时，epoch 加一；只在持有 retire_lock_ 时调用
+        void try_advance()
+        {
+            const uint64_t e = epoch_.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            for (record* r = records_.load(std::memory_order_acquire); r != nullptr; r = r->next)
+            {
+                const uint64_t s = r->state.load(std::memory_order_acquire);
+                if ((s & 1) != 0 && (s >> 1) != e)
+                    return;
+            }
+            epoch_.store(e + 1, std::memory_order_seq_cst);
+        }
+
+        // 取出全局 epoch 已经比 retire 时大 2 的对象
+        void collect(std::vector<retired>& ready)
+        {
+            const uint64_t e = epoch_.load(std::memory_order_relaxed);
+            size_t kept = 0;
+            for (size_t i = 0; i < retired_.size(); ++i)
+            {
+                if (retired_[i].epoch + 2 <= e)
+                    ready.push_back(retired_[i]);
+                else
+                    retired_[kept++] = retired_[i];
+            }
+            retired_.resize(kept);
+        }
+    };
+
+    // 读者临界区
+    class epoch_guard
+    {
+    public:
+        epoch_guard() { epoch_domain::instance().enter(); }
+        ~epoch_guard() { epoch_domain::instance().leave(); }
+
+        epoch_guard(const epoch_guard&) = delete;
+        epoch_guard& operator=(const epoch_guard&) = delete;
+    };
+}
+
+#endif //MINISTL_EPOCH_H
@@ -0,0 +1,44 @@
+#ifndef MINISTL_EXECUTION_H
+#define MINISTL_EXECUTION_H
+
+// 这个头文件包含执行策略(execution policy)，作为并行算法重载的第一个参数
+// seq      : 在调用线程上顺序执行
+// par      : 在线程池上分块并行执行，块内顺序执行
+// par_unseq: 分块并行执行，块内允许向量化 / 重新结合(要求操作满足结合律且不加锁)
+
+#include <type_traits>
+
+#include "type_traits.h"
+
+namespace ministl
+{
+    namespace execution
+    {
+        struct sequenced_policy {};
+        struct parallel_policy {};
+        struct parallel_unsequenced_policy {};
+
+        constexpr sequenced_policy            seq{};
+        constexpr parallel_policy             par{};
+        constexpr parallel_unsequenced_policy par_unseq{};
+    }
+
+    template <class T>
+    struct is_execution_policy : public m_false_type {};
+
+    template <>
+    struct is_execution_policy<execution::sequenced_policy> : public m_true_type {};
+
+    template <>
+    struct is_execution_policy<execution::parallel_policy> : public m_true_type {};
+
+    template <>
+    struct is_execution_policy<execution::parallel_unsequenced_policy> : public m_true_type {};
+
+    // 去掉引用和 cv 限定后再判断，方便在模板参数推导中使用
+    template <class T>
+    struct is_execution_policy_decay
+            : public is_execution_policy<typename std::decay<T>::type> {};
+}
+
+#endif //MINISTL_EXECUTION_H
@@ -0,0 +1,117 @@
+#ifndef MINISTL_FLAT_HASH_MAP_H
+#define MINISTL_FLAT_HASH_MAP_H
+
+// 这个头文件包含一个模板类 flat_hash_map
+// flat_hash_map : 开放寻址的无序映射，底层实现为 flat_hash_table，元素为 pair<const Key, T>
+
+// notes:
+// 接口与 unordered_map 基本一致，不提供桶接口。查找、插入与删除的实现见 flat_hash_table.h。
+// 插入可能使全部迭代器与元素的引用失效(元素会在 rehash 时被移动)，删除只影响被删除的元素。
+// try_emplace / operator[] 在键已存在时不构造 mapped_type
+
+#include "flat_hash_table.h"
+
+namespace ministl
+{
+    template <class Key, class T, class Hash = std::hash<Key>, class KeyEqual = ministl::equal_to<Key>,
+              class Alloc = ministl::allocator<pair<const Key, T>>>
+    class flat_hash_map : public flat_hash_table<hash_map_policy<Key, T>, Hash, KeyEqual, Alloc>
+    {
+        typedef flat_hash_table<hash_map_policy<Key, T>, Hash, KeyEqual, Alloc> base_type;
+
+    public:
+        typedef T                                   mapped_type;
+        typedef typename base_type::key_type        key_type;
+        typedef typename base_type::value_type      value_type;
+        typedef typename base_type::iterator        iterator;
+        typedef typename base_type::const_iterator  const_iterator;
+
+        using base_type::base_type;
+
+        flat_hash_map() = default;
+
+    public:
+        mapped_type& operator[](const key_type& key)
+        {
+            return try_emplace(key).first->second;
+        }
+
+        mapped_type& at(const key_type& key)
+        {
+            iterator it = this->find(key);
+            THROW_OUT_OF_RANGE_IF(it == this->end(), "flat_hash_map<Key, T>::at() key not found");
+            return it->second;
+        }
+
+        const mapped_type& at(const key_type& key) const
+        {
+            const_iterator it = this->find(key);
+            THROW_OUT_OF_RANGE_IF(it == this->end(), "flat_hash_map<Key, T>::at() key not found");
+            return it->second;
+        }
+
+        template <class ...Args>
+        pair<iterator, bool> try_emplace(const key_type& key, Args&& ...args)
+        {
+            size_t hash = 0;
+            const pair<size_t, bool> pos = this->find_or_prepare_insert(key, hash);
+            if (pos.second)
+            {
+                base_type::slot_allocator::construct(this->slot_at(pos.first), key,
+                                                     mapped_type(ministl::forward<Args>(args)...));
+                this->commit_insert(pos.first, hash);
+            }
+            return pair<iterator, bool>(this->iterator_at(pos.first), pos.second);
+        }
+
+        template <class M>
+        pair<iterator, bool> insert_or_assign(const key_type& key, M&& obj)
+        {
+            size_t hash = 0;
+            const pair<size_t, bool> pos = this->find_or_prepare_insert(key, hash);
+            if (pos.second)
+            {
+                base_type::slot_allocator::construct(this->slot_at(pos.first), key, ministl::forward<M>(obj));
+                this->commit_insert(pos.first, hash);
+            }
+            else
+            {
+                this->slot_at(pos.first)->second = ministl::forward<M>(obj);
+            }
+            return pair<iterator, bool>(this->iterator_at(pos.first), pos.second);
+        }
+    };
+
+    /*****************************************************************************************/
+
+    template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+    bool operator==(const flat_hash_map<Key, T, Hash, KeyEqual, Alloc>& lhs,
+                    const flat_hash_map<Key, T, Hash, KeyEqual, Alloc>& rhs)
+    {
+        if (lhs.size() != rhs.size())
+            return false;
+        for (auto it = lhs.begin(); it != lhs.end(); ++it)
+        {
+            auto pos = rhs.find(it->first);
+            if (pos == rhs.end() || !(pos->second == it->second))
+                return false;
+        }
+        return true;
+    }
+
+    template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+    bool operator!=(const flat_hash_map<Key, T, Hash, KeyEqual, Alloc>& lhs,
+                    const flat_hash_map<Key, T, Hash, KeyEqual, Alloc>& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    template <class Key, class T, class Hash, class KeyEqual, class Alloc>
+    void swap(flat_hash_map<Key, T, Hash, KeyEqual, Alloc>& lhs,
+              flat_hash_map<Key, T, Hash, KeyEqual, Alloc>& rhs) noexcept
+    {
+        lhs.swap(rhs);
+    }
+}
+
+#endif //MINISTL_FLAT_HASH_MAP_H
@@ -0,0 +1,58 @@
+#ifndef MINISTL_FLAT_HASH_SET_H
+#define MINISTL_FLAT_HASH_SET_H
+
+// 这个头文件包含一个模板类 flat_hash_set
+// flat_hash_set : 开放寻址的无序集合，底层实现为 flat_hash_table
+
+// notes:
+// 与 unordered_set 相比，元素直接存放在连续的槽数组中，没有逐个节点的内存分配，
+// 查找时每 16 个槽只需一次 SSE2 比较，详见 flat_hash_table.h。
+// 插入可能使全部迭代器与元素的引用失效(元素会在 rehash 时被移动)
+
+#include "flat_hash_table.h"
+
+namespace ministl
+{
+    template <class Key, class Hash = std::hash<Key>, class KeyEqual = ministl::equal_to<Key>,
+              class Alloc = ministl::allocator<Key>>
+    class flat_hash_set : public flat_hash_table<hash_set_policy<Key>, Hash, KeyEqual, Alloc>
+    {
+        typedef flat_hash_table<hash_set_policy<Key>, Hash, KeyEqual, Alloc> base_type;
+
+    public:
+        using base_type::base_type;
+
+        flat_hash_set() = default;
+    };
+
+    /*****************************************************************************************/
+
+    template <class Key, class Hash, class KeyEqual, class Alloc>
+    bool operator==(const flat_hash_set<Key, Hash, KeyEqual, Alloc>& lhs,
+                    const flat_hash_set<Key, Hash, KeyEqual, Alloc>& rhs)
+    {
+        if (lhs.size() != rhs.size())
+            return false;
+        for (auto it = lhs.begin(); it != lhs.end(); ++it)
+        {
+            if (!rhs.contains(*it))
+                return false;
+        }
+        return true;
+    }
+
+    template <class Key, class Hash, class KeyEqual, class Alloc>
+    bool operator!=(const flat_hash_set<Key, Hash, KeyEqual, Alloc>& lhs,
+                    const flat_hash_set<Key, Hash, KeyEqual, Alloc>& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    template <class Key, class Hash, class KeyEqual, class Alloc>
+    void swap(flat_hash_set<Key, Hash, KeyEqual, Alloc>& lhs, flat_hash_set<Key, Hash, KeyEqual, Alloc>& rhs) noexcept
+    {
+        lhs.swap(rhs);
+    }
+}
+
+#endif //MINISTL_FLAT_HASH_SET_H
@@ -0,0 +1,779 @@
+#ifndef MINISTL_FLAT_HASH_TABLE_H
+#define MINISTL_FLAT_HASH_TABLE_H
+
+// 这个头文件包含一个模板类 flat_hash_table，是 flat_hash_map / flat_hash_set 的底层实现
+// flat_hash_table : 开放寻址的哈希表，采用 Swiss table 的控制字节设计
+
+// notes:
+// 元素直接存放在一个连续的槽数组中，另有一个等长的控制字节数组，每个槽对应一个字节：
+//   * empty(-128) / deleted(-2) / sentinel(-1)，或者元素哈希值的低 7 位 h2(0 ~ 127)
+// 哈希值的其余位 h1 决定探测的起点，按 16 个控制字节为一组探测：用一次 SSE2 比较找出组内 h2 相同的槽，
+// 只有这些槽才需要真正比较键(误报率约 1/128)；组内出现 empty 即可断定键不存在。
+// 控制字节数组末尾放一个 sentinel，再复制开头的 15 个字节，从任意位置读取一整组都不会越界也不需要回绕。
+//
+// 删除：若槽所在的任一 16 字节窗口都从未被填满过，说明没有探测序列经过它继续往后找，直接置为 empty；
+//      否则置为 deleted(墓碑)。墓碑占用增长额度，额度用完时如果元素不多于容量的 25/32，
+//      就地重新散列(in-place rehash)清除全部墓碑而不扩容，否则容量翻倍。
+// 容量为 2^k - 1，最大负载因子 7/8。槽数组通过 Alloc 申请，控制字节通过 ministl::allocator<int8_t> 申请。
+//
+// 迭代器为前向迭代器，插入可能使全部迭代器失效，删除只使被删除元素的迭代器失效。
+// 异常保证：
+//   插入时元素的构造抛出异常，容器不变；rehash 过程中要求哈希函数与元素的移动构造不抛出异常
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+
+#include "algobase.h"
+#include "allocator.h"
+#include "exception.h"
+#include "functional.h"
+#include "iterator.h"
+#include "util.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace ministl
+{
+    /*******************************************control byte**********************************************/
+    constexpr int8_t hash_ctrl_empty    = -128;
+    constexpr int8_t hash_ctrl_deleted  = -2;
+    constexpr int8_t hash_ctrl_sentinel = -1;
+
+    inline bool hash_ctrl_is_full(int8_t c) noexcept { return c >= 0; }
+    inline bool hash_ctrl_is_empty_or_deleted(int8_t c) noexcept { return c < hash_ctrl_sentinel; }
+
+    // x != 0，最低位的 1 的下标
+    inline unsigned hash_ctz(uint32_t x) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<unsigned>(__builtin_ctz(x));
+#else
+        unsigned n = 0;
+        for (; !(x & 1); x >>= 1)
+            ++n;
+        return n;
+#endif
+    }
+
+    // 16 位掩码中，最高位往下连续 0 的个数
+    inline unsigned hash_clz16(uint32_t x) noexcept
+    {
+        unsigned n = 0;
+        for (uint32_t bit = 1u << 15; bit != 0 && !(x & bit); bit >>= 1)
+            ++n;
+        return n;
+    }
+
+    // 一组 16 个控制字节，match 系列函数返回掩码，第 i 位为 1 表示组内第 i 个字节匹配
+#if defined(__SSE2__)
+    struct hash_group
+    {
+        static constexpr size_t width = 16;
+        __m128i ctrl;
+
+        explicit hash_group(const int8_t* p) noexcept
+                : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))) {}
+
+        uint32_t match(int8_t h2) const noexcept
+        {
+            return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl)));
+        }
+
+        uint32_t match_empty() const noexcept
+        {
+            return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(hash_ctrl_empty), ctrl)));
+        }
+
+        uint32_t match_empty_or_deleted() const noexcept
+        {
+            return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(hash_ctrl_sentinel), ctrl)));
+        }
+
+        // empty / deleted / sentinel 变为 empty，有元素的变为 deleted，就地重新散列时使用
+        static void convert_special_to_empty_and_full_to_deleted(int8_t* p) noexcept
+        {
+            const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+            const __m128i special = _mm_cmpgt_epi8(_mm_setzero_si128(), x);
+            const __m128i result = _mm_or_si128(_mm_and_si128(special, _mm_set1_epi8(hash_ctrl_empty)),
+                                                _mm_andnot_si128(special, _mm_set1_epi8(hash_ctrl_deleted)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(p), result);
+        }
+    };
+#else
+    struct hash_group
+    {
+        static constexpr size_t width = 16;
+        int8_t ctrl[width];
+
+        explicit hash_group(const int8_t* p) noexcept { std::memcpy(ctrl, p, width); }
+
+        uint32_t match(int8_t h2) const noexcept
+        {
+            uint32_t mask = 0;
+            for (size_t i = 0; i < width; ++i)
+                mask |= static_cast<uint32_t>(ctrl[i] == h2) << i;
+            return mask;
+        }
+
+        uint32_t match_empty() const noexcept { return match(hash_ctrl_empty); }
+
+        uint32_t match_empty_or_deleted() const noexcept
+        {
+            uint32_t mask = 0;
+            for (size_t i = 0; i < width; ++i)
+                mask |= static_cast<uint32_t>(ctrl[i] < hash_ctrl_sentinel) << i;
+            return mask;
+        }
+
+        static void convert_special_to_empty_and_full_to_deleted(int8_t* p) noexcept
+        {
+            for (size_t i = 0; i < width; ++i)
+                p[i] = p[i] < 0 ? hash_ctrl_empty : hash_ctrl_deleted;
+        }
+    };
+#endif
+
+    // 容量为 0 的表共用的控制字节：一个 sentinel 之后全是 empty，查找立即结束，begin() == end()
+    inline int8_t* hash_empty_group() noexcept
+    {
+        alignas(16) static int8_t group[hash_group::width] = {
+                hash_ctrl_sentinel, hash_ctrl_empty, hash_ctrl_empty, hash_ctrl_empty,
+                hash_ctrl_empty, hash_ctrl_empty, hash_ctrl_empty, hash_ctrl_empty,
+                hash_ctrl_empty, hash_ctrl_empty, hash_ctrl_empty, hash_ctrl_empty,
+                hash_ctrl_empty, hash_ctrl_empty, hash_ctrl_empty, hash_ctrl_empty};
+        return group;
+    }
+
+    // std::hash 对整数通常是恒等映射，低位与高位都要用到，先做一次乘法混合
+    inline size_t hash_mix(size_t h) noexcept
+    {
+#if defined(__SIZEOF_INT128__)
+        const unsigned __int128 m = static_cast<unsigned __int128>(h) * 0x9E3779B97F4A7C15ull;
+        return static_cast<size_t>(static_cast<uint64_t>(m) ^ static_cast<uint64_t>(m >> 64));
+#else
+        uint64_t x = static_cast<uint64_t>(h);
+        x ^= x >> 33;
+        x *= 0xFF51AFD7ED558CCDull;
+        x ^= x >> 33;
+        return static_cast<size_t>(x);
+#endif
+    }
+
+    // 三角探测序列：依次跳过 1, 2, 3, ... 组，容量为 2^k - 1 时恰好遍历每一组
+    struct hash_probe_seq
+    {
+        size_t mask;
+        size_t offset;
+        size_t index;
+
+        hash_probe_seq(size_t hash, size_t m) noexcept : mask(m), offset(hash & m), index(0) {}
+
+        size_t at(size_t i) const noexcept { return (offset + i) & mask; }
+
+        void next() noexcept
+        {
+            index += hash_group::width;
+            offset = (offset + index) & mask;
+        }
+    };
+
+    // 元素为键本身(flat_hash_set)
+    template <class Key>
+    struct hash_set_policy
+    {
+        typedef Key key_type;
+        typedef Key value_type;
+        static constexpr bool constant_iterator = true;
+        static const key_type& key(const value_type& v) noexcept { return v; }
+    };
+
+    // 元素为 pair<const Key, T>(flat_hash_map)
+    template <class Key, class T>
+    struct hash_map_policy
+    {
+        typedef Key                 key_type;
+        typedef pair<const Key, T>  value_type;
+        static constexpr bool constant_iterator = false;
+        static const key_type& key(const value_type& v) noexcept { return v.first; }
+    };
+
+    /****************************************flat_hash_iterator********************************************/
+    template <class V, class Ref, class Ptr>
+    struct flat_hash_iterator
+    {
+        typedef ministl::forward_iterator_tag                   iterator_category;
+        typedef V                                               value_type;
+        typedef Ptr                                             pointer;
+        typedef Ref                                             reference;
+        typedef ptrdiff_t                                       difference_type;
+        typedef flat_hash_iterator<V, Ref, Ptr>                 self;
+
+        int8_t* ctrl;
+        V*      slot;
+
+        flat_hash_iterator() noexcept : ctrl(nullptr), slot(nullptr) {}
+        flat_hash_iterator(int8_t* c, V* s) noexcept : ctrl(c), slot(s) {}
+
+        // 非 const 迭代器可以转换为 const 迭代器
+        flat_hash_iterator(const flat_hash_iterator<V, V&, V*>& other) noexcept
+                : ctrl(other.ctrl), slot(other.slot) {}
+
+        reference operator*()  const { return *slot; }
+        pointer   operator->() const { return slot; }
+
+        self& operator++()
+        {
+            ++ctrl;
+            ++slot;
+            skip_empty_or_deleted();
+            return *this;
+        }
+
+        self operator++(int)
+        {
+            self tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        // 按组跳过空槽，停在下一个元素或末尾的 sentinel 上
+        void skip_empty_or_deleted() noexcept
+        {
+            while (hash_ctrl_is_empty_or_deleted(*ctrl))
+            {
+                const unsigned shift = hash_ctz(~hash_group(ctrl).match_empty_or_deleted());
+                ctrl += shift;
+                slot += shift;
+            }
+        }
+
+        friend bool operator==(const self& lhs, const self& rhs) { return lhs.ctrl == rhs.ctrl; }
+        friend bool operator!=(const self& lhs, const self& rhs) { return lhs.ctrl != rhs.ctrl; }
+    };
+
+    /*****************************************flat_hash_table**********************************************/
+    template <class Policy, class Hash, class KeyEqual, class Alloc>
+    class flat_hash_table
+    {
+    public:
+        typedef typename Policy::key_type                                       key_type;
+        typedef typename Policy::value_type                                     value_type;
+        typedef Hash                                                            hasher;
+        typedef KeyEqual                                                        key_equal;
+        typedef Alloc                                                           allocator_type;
+        typedef Alloc                                                           slot_allocator;
+        typedef ministl::allocator<int8_t>                                      ctrl_allocator;
+
+        typedef size_t                                                          size_type;
+        typedef ptrdiff_t                                                       difference_type;
+        typedef value_type&                                                     reference;
+        typedef const value_type&                                               const_reference;
+
+        typedef flat_hash_iterator<value_type, const value_type&, const value_type*> const_iterator;
+        typedef typename std::conditional<Policy::constant_iterator, const_iterator,
+                flat_hash_iterator<value_type, value_type&, value_type*>>::type iterator;
+
+        static constexpr size_type group_width = hash_group::width;
+
+    private:
+        int8_t*     ctrl_;          // capacity_ + group_width 个控制字节
+        value_type* slots_;         // capacity_ 个槽
+        size_type   size_;
+        size_type   capacity_;      // 0 或 2^k - 1
+        size_type   growth_left_;   // 不扩容还能占用的空槽数(墓碑不计入)
+        Hash        hash_;
+        KeyEqual    eq_;
+
+    public:
+        flat_hash_table() noexcept
+                : ctrl_(hash_empty_group()), slots_(nullptr), size_(0), capacity_(0), growth_left_(0),
+                  hash_(), eq_() {}
+
+        explicit flat_hash_table(size_type n, const Hash& hash = Hash(), const KeyEqual& eq = KeyEqual())
+                : ctrl_(hash_empty_group()), slots_(nullptr), size_(0), capacity_(0), growth_left_(0),
+                  hash_(hash), eq_(eq)
+        {
+            reserve(n);
+        }
+
+        template <class Iter, typename std::enable_if<ministl::is_input_iterator<Iter>::value, int>::type = 0>
+        flat_hash_table(Iter first, Iter last, size_type n = 0, const Hash& hash = Hash(),
+                        const KeyEqual& eq = KeyEqual())
+                : flat_hash_table(n, hash, eq)
+        {
+            insert(first, last);
+        }
+
+        flat_hash_table(std::initializer_list<value_type> list, size_type n = 0, const Hash& hash = Hash(),
+                        const KeyEqual& eq = KeyEqual())
+                : flat_hash_table(ministl::max(n, list.size()), hash, eq)
+        {
+            insert(list.begin(), list.end());
+        }
+
+        flat_hash_table(const flat_hash_table& other)
+                : flat_hash_table(other.size(), other.hash_, other.eq_)
+        {
+            for (const_iterator it = other.begin(); it != other.end(); ++it)
+            {
+                const size_t hash = hash_of(Policy::key(*it));
+                const size_type i = find_first_non_full(hash);
+                slot_allocator::construct(slots_ + i, *it);
+                commit_insert(i, hash);
+            }
+        }
+
+        flat_hash_table(flat_hash_table&& other) noexcept
+                : ctrl_(other.ctrl_), slots_(other.slots_), size_(other.size_), capacity_(other.capacity_),
+                  growth_left_(other.growth_left_), hash_(other.hash_), eq_(other.eq_)
+        {
+            other.ctrl_ = hash_empty_group();
+            other.slots_ = nullptr;
+            other.size_ = 0;
+            other.capacity_ = 0;
+            other.growth_left_ = 0;
+        }
+
+        flat_hash_table& operator=(const flat_hash_table& other)
+        {
+            if (this != &other)
+            {
+                flat_hash_table tmp(other);
+                swap(tmp);
+            }
+            return *this;
+        }
+
+        flat_hash_table& operator=(flat_hash_table&& other) noexcept
+        {
+            flat_hash_table tmp(ministl::move(other));
+            swap(tmp);
+            return *this;
+        }
+
+        ~flat_hash_table()
+        {
+            destroy_slots();
+            deallocate(ctrl_, slots_, capacity_);
+        }
+
+    public:
+        // 迭代器相关操作
+        iterator begin() noexcept
+        {
+            iterator it(ctrl_, slots_);
+            it.skip_empty_or_deleted();
+            return it;
+        }
+
+        const_iterator begin() const noexcept
+        {
+            const_iterator it(ctrl_, slots_);
+            it.skip_empty_or_deleted();
+            return it;
+        }
+
+        iterator       end()          noexcept { return iterator(ctrl_ + capacity_, slots_ + capacity_); }
+        const_iterator end()    const noexcept { return const_iterator(ctrl_ + capacity_, slots_ + capacity_); }
+        const_iterator cbegin() const noexcept { return begin(); }
+        const_iterator cend()   const noexcept { return end(); }
+
+        // 容量相关操作
+        bool      empty()           const noexcept { return size_ == 0; }
+        size_type size()            const noexcept { return size_; }
+        size_type capacity()        const noexcept { return capacity_; }
+        size_type bucket_count()    const noexcept { return capacity_; }
+        size_type max_size()        const noexcept { return (static_cast<size_type>(-1) >> 1) / sizeof(value_type); }
+        float     load_factor()     const noexcept { return capacity_ == 0 ? 0.0f : static_cast<float>(size_) / capacity_; }
+        float     max_load_factor() const noexcept { return 7.0f / 8.0f; }
+
+        // 一次申请足够的空间，之后插入 n 个元素都不会再 rehash
+        void reserve(size_type n)
+        {
+            if (n > size_ + growth_left_)
+                resize(normalize_capacity(growth_to_capacity(n)));
+        }
+
+        // 把容量调整为能容纳 max(n, size()) 个元素的最小容量，n 为 0 时可以用来收缩
+        void rehash(size_type n)
+        {
+            const size_type need = ministl::max(n, size_);
+            const size_type cap = need == 0 ? 0 : normalize_capacity(growth_to_capacity(need));
+            if (cap == 0 && size_ == 0)
+            {
+                flat_hash_table tmp(0, hash_, eq_);
+                swap(tmp);
+            }
+            else if (cap != capacity_)
+            {
+                resize(cap);
+            }
+        }
+
+        hasher    hash_function() const { return hash_; }
+        key_equal key_eq()        const { return eq_; }
+
+        // 插入删除操作
+        pair<iterator, bool> insert(const value_type& value)
+        {
+            return emplace_key(Policy::key(value), value);
+        }
+
+        pair<iterator, bool> insert(value_type&& value)
+        {
+            return emplace_key(Policy::key(value), ministl::move(value));
+        }
+
+        template <class Iter, typename std::enable_if<ministl::is_input_iterator<Iter>::value, int>::type = 0>
+        void insert(Iter first, Iter last)
+        {
+            insert_range(first, last, ministl::iterator_category(first));
+        }
+
+        void insert(std::initializer_list<value_type> list) { insert(list.begin(), list.end()); }
+
+        template <class ...Args>
+        pair<iterator, bool> emplace(Args&& ...args)
+        {
+            value_type value(ministl::forward<Args>(args)...);
+            return insert(ministl::move(value));
+        }
+
+        iterator erase(const_iterator pos)
+        {
+            MINISTL_DEBUG(pos != end() && hash_ctrl_is_full(*pos.ctrl));
+            iterator next(pos.ctrl, pos.slot);
+            ++next;
+            erase_index(static_cast<size_type>(pos.ctrl - ctrl_));
+            return next;
+        }
+
+        iterator erase(const_iterator first, const_iterator last)
+        {
+            while (first != last)
+                first = erase(first);
+            return iterator(last.ctrl, last.slot);
+        }
+
+        size_type erase(const key_type& key)
+        {
+            const size_type i = find_index(key, hash_of(key));
+            if (i == capacity_)
+                return 0;
+            erase_index(i);
+            return 1;
+        }
+
+        void clear() noexcept
+        {
+            if (capacity_ == 0)
+                return;
+            destroy_slots();
+            reset_ctrl();
+            size_ = 0;
+            growth_left_ = capacity_to_growth(capacity_);
+        }
+
+        void swap(flat_hash_table& other) noexcept
+        {
+            ministl::swap(ctrl_, other.ctrl_);
+            ministl::swap(slots_, other.slots_);
+            ministl::swap(size_, other.size_);
+            ministl::swap(capacity_, other.capacity_);
+            ministl::swap(growth_left_, other.growth_left_);
+            ministl::swap(hash_, other.hash_);
+            ministl::swap(eq_, other.eq_);
+        }
+
+        // 查找操作
+        iterator find(const key_type& key)
+        {
+            return iterator_at(find_index(key, hash_of(key)));
+        }
+
+        const_iterator find(const key_type& key) const
+        {
+            const size_type i = find_index(key, hash_of(key));
+            return const_iterator(ctrl_ + i, slots_ + i);
+        }
+
+        bool      contains(const key_type& key) const { return find_index(key, hash_of(key)) != capacity_; }
+        size_type count(const key_type& key)    const { return contains(key) ? 1 : 0; }
+
+    protected:
+        // 键不存在时用 args 在空槽上构造元素
+        template <class ...Args>
+        pair<iterator, bool> emplace_key(const key_type& key, Args&& ...args)
+        {
+            size_t hash = 0;
+            const pair<size_type, bool> pos = find_or_prepare_insert(key, hash);
+            if (pos.second)
+            {
+                slot_allocator::construct(slots_ + pos.first, ministl::forward<Args>(args)...);
+                commit_insert(pos.first, hash);
+            }
+            return pair<iterator, bool>(iterator_at(pos.first), pos.second);
+        }
+
+        // 返回键所在的槽，或者为它准备好的空槽(second 为 true)。
+        // 调用者在空槽上构造元素之后调用 commit_insert，构造抛出异常时容器不变
+        pair<size_type, bool> find_or_prepare_insert(const key_type& key, size_t& hash)
+        {
+            hash = hash_of(key);
+            const size_type i = find_index(key, hash);
+            if (i != capacity_)
+                return pair<size_type, bool>(i, false);
+            return pair<size_type, bool>(prepare_insert(hash), true);
+        }
+
+        void commit_insert(size_type i, size_t hash) noexcept
+        {
+            growth_left_ -= ctrl_[i] == hash_ctrl_empty;
+            set_ctrl(i, h2(hash));
+            ++size_;
+        }
+
+        value_type* slot_at(size_type i)     noexcept { return slots_ + i; }
+        iterator    iterator_at(size_type i) noexcept { return iterator(ctrl_ + i, slots_ + i); }
+
+    private:
+        static size_t  h1(size_t hash) noexcept { return hash >> 7; }
+        static int8_t  h2(size_t hash) noexcept { return static_cast<int8_t>(hash & 0x7F); }
+
+        size_t hash_of(const key_type& key) const { return hash_mix(hash_(key)); }
+
+        // 不小于 n 的最小的 2^k - 1，至少为一组减一
+        static size_type normalize_capacity(size_type n) noexcept
+        {
+            size_type cap = group_width - 1;
+            while (cap < n)
+                cap = cap * 2 + 1;
+            return cap;
+        }
+
+        static size_type capacity_to_growth(size_type cap) noexcept { return cap - cap / 8; }
+        static size_type growth_to_capacity(size_type growth) noexcept { return growth + (growth - 1) / 7; }
+
+        // 返回键所在的槽，不存在时返回 capacity_
+        size_type find_index(const key_type& key, size_t hash) const
+        {
+            hash_probe_seq seq(h1(hash), capacity_);
+            while (true)
+            {
+                const hash_group g(ctrl_ + seq.offset);
+                for (uint32_t mask = g.match(h2(hash)); mask != 0; mask &= mask - 1)
+                {
+                    const size_type i = seq.at(hash_ctz(mask));
+                    if (eq_(Policy::key(slots_[i]), key))
+                        return i;
+                }
+                if (g.match_empty() != 0)
+                    return capacity_;
+                seq.next();
+                MINISTL_DEBUG(seq.index <= capacity_);
+            }
+        }
+
+        // 探测序列上第一个 empty 或 deleted 的槽
+        size_type find_first_non_full(size_t hash) const noexcept
+        {
+            hash_probe_seq seq(h1(hash), capacity_);
+            while (true)
+            {
+                const uint32_t mask = hash_group(ctrl_ + seq.offset).match_empty_or_deleted();
+                if (mask != 0)
+                    return seq.at(hash_ctz(mask));
+                seq.next();
+            }
+        }
+
+        size_type prepare_insert(size_t hash)
+        {
+            size_type i = find_first_non_full(hash);
+            if (growth_left_ == 0 && ctrl_[i] != hash_ctrl_deleted)
+            {
+                rehash_and_grow_if_necessary();
+                i = find_first_non_full(hash);
+            }
+            return i;
+        }
+
+        // 同时写入开头 group_width - 1 个字节在末尾的副本
+        void set_ctrl(size_type i, int8_t h) noexcept
+        {
+            ctrl_[i] = h;
+            ctrl_[((i - (group_width - 1)) & capacity_) + ((group_width - 1) & capacity_)] = h;
+        }
+
+        void reset_ctrl() noexcept
+        {
+            std::memset(ctrl_, static_cast<unsigned char>(hash_ctrl_empty), capacity_ + group_width);
+            ctrl_[capacity_] = hash_ctrl_sentinel;
+        }
+
+        void erase_index(size_type i);
+        void rehash_and_grow_if_necessary();
+        void resize(size_type new_capacity);
+        void drop_deletes_without_resize();
+
+        template <class Iter>
+        void insert_range(Iter first, Iter last, ministl::input_iterator_tag)
+        {
+            for (; first != last; ++first)
+                insert(*first);
+        }
+
+        template <class Iter>
+        void insert_range(Iter first, Iter last, ministl::forward_iterator_tag)
+        {
+            reserve(size_ + static_cast<size_type>(ministl::distance(first, last)));
+            for (; first != last; ++first)
+                insert(*first);
+        }
+
+        void destroy_slots() noexcept
+        {
+            if (std::is_trivially_destructible<value_type>::value)
+                return;
+            for (size_type i = 0; i != capacity_; ++i)
+            {
+                if (hash_ctrl_is_full(ctrl_[i]))
+                    slot_allocator::destroy(slots_ + i);
+            }
+        }
+
+        static void deallocate(int8_t* ctrl, value_type* slots, size_type cap) noexcept
+        {
+            if (cap == 0)
+                return;
+            ctrl_allocator::deallocate(ctrl, cap + group_width);
+            slot_allocator::deallocate(slots, cap);
+        }
+    };
+
+    /*****************************************************************************************/
+
+    template <class Policy, class Hash, class KeyEqual, class Alloc>
+    constexpr size_t flat_hash_table<Policy, Hash, KeyEqual, Alloc>::group_width;
+
+    // 删除 i 处的元素：i 前后的空槽之间不足一组时，没有探测序列会越过 i，可以直接置为 empty
+    template <class Policy, class Hash, class KeyEqual, class Alloc>
+    void flat_hash_table<Policy, Hash, KeyEqual, Alloc>::erase_index(size_type i)
+    {
+        slot_allocator::destroy(slots_ + i);
+        --size_;
+        bool was_never_full = capacity_ < group_width;
+        if (!was_never_full)
+        {
+            const size_type before = (i - group_width) & capacity_;
+            const uint32_t empty_after = hash_group(ctrl_ + i).match_empty();
+            const uint32_t empty_before = hash_group(ctrl_ + before).match_empty();
+            was_never_full = empty_before != 0 && empty_after != 0 &&
+                             hash_ctz(empty_after) + hash_clz16(empty_before) < group_width;
+        }
+        set_ctrl(i, was_never_full ? hash_ctrl_empty : hash_ctrl_deleted);
+        growth_left_ += was_never_full;
+    }
+
+    // 增长额度用完：墓碑较多时就地清除，否则容量翻倍
+    template <class Policy, class Hash, class KeyEqual, class Alloc>
+    void flat_hash_table<Policy, Hash, KeyEqual, Alloc>::rehash_and_grow_if_necessary()
+    {
+        if (capacity_ > group_width && size_ * 32 <= capacity_ * 25)
+            drop_deletes_without_resize();
+        else
+            resize(capacity_ == 0 ? group_width - 1 : capacity_ * 2 + 1);
+    }
+
+    template <class Policy, class Hash, class KeyEqual, class Alloc>
+    void flat_hash_table<Policy, Hash, KeyEqual, Alloc>::resize(size_type new_capacity)
+    {
+        int8_t* old_ctrl = ctrl_;
+        value_type* old_slots = slots_;
+        const size_type old_capacity = capacity_;
+        THROW_LENGTH_ERROR_IF(new_capacity > max_size(), "flat_hash_table<T>'s size too big");
+
+        int8_t* new_ctrl = ctrl_allocator::allocate(new_capacity + group_width);
+        value_type* new_slots = nullptr;
+        try
+        {
+            new_slots = slot_allocator::allocate(new_capacity);
+        }
+        catch (...)
+        {
+            ctrl_allocator::deallocate(new_ctrl, new_capacity + group_width);
+            throw;
+        }
+        ctrl_ = new_ctrl;
+        slots_ = new_slots;
+        capacity_ = new_capacity;
+        reset_ctrl();
+        growth_left_ = capacity_to_growth(capacity_) - size_;
+
+        for (size_type i = 0; i != old_capacity; ++i)
+        {
+            if (!hash_ctrl_is_full(old_ctrl[i]))
+                continue;
+            const size_t hash = hash_of(Policy::key(old_slots[i]));
+            const size_type target = find_first_non_full(hash);
+            set_ctrl(target, h2(hash));
+            slot_allocator::construct(slots_ + target, ministl::move(old_slots[i]));
+            slot_allocator::destroy(old_slots + i);
+        }
+        deallocate(old_ctrl, old_slots, old_capacity);
+    }
+
+    // 就地重新散列：先把所有元素标记为 deleted、墓碑标记为 empty，再逐个放回各自探测序列上的第一个空位。
+    // 目标位置仍是未处理的元素(deleted)时两者交换，再处理换过来的元素
+    template <class Policy, class Hash, class KeyEqual, class Alloc>
+    void flat_hash_table<Policy, Hash, KeyEqual, Alloc>::drop_deletes_without_resize()
+    {
+        for (size_type i = 0; i < capacity_ + 1; i += group_width)
+            hash_group::convert_special_to_empty_and_full_to_deleted(ctrl_ + i);
+        std::memcpy(ctrl_ + capacity_ + 1, ctrl_, group_width - 1);
+        ctrl_[capacity_] = hash_ctrl_sentinel;
+
+        alignas(value_type) unsigned char buffer[sizeof(value_type)];
+        value_type* tmp = reinterpret_cast<value_type*>(buffer);
+        for (size_type i = 0; i != capacity_; ++i)
+        {
+            if (ctrl_[i] != hash_ctrl_deleted)
+                continue;
+            const size_t hash = hash_of(Policy::key(slots_[i]));
+            const size_type target = find_first_non_full(hash);
+            const size_type probe_offset = h1(hash) & capacity_;
+            // 新旧位置落在探测序列的同一组内，查找时的效果相同，不必移动
+            if ((((target - probe_offset) & capacity_) / group_width) ==
+                (((i - probe_offset) & capacity_) / group_width))
+            {
+                set_ctrl(i, h2(hash));
+                continue;
+            }
+            if (ctrl_[target] == hash_ctrl_empty)
+            {
+                set_ctrl(target, h2(hash));
+                slot_allocator::construct(slots_ + target, ministl::move(slots_[i]));
+                slot_allocator::destroy(slots_ + i);
+                set_ctrl(i, hash_ctrl_empty);
+            }
+            else
+            {
+                set_ctrl(target, h2(hash));
+                slot_allocator::construct(tmp, ministl::move(slots_[i]));
+                slot_allocator::destroy(slots_ + i);
+                slot_allocator::construct(slots_ + i, ministl::move(slots_[target]));
+                slot_allocator::destroy(slots_ + target);
+                slot_allocator::construct(slots_ + target, ministl::move(*tmp));
+                slot_allocator::destroy(tmp);
+                --i;
+            }
+        }
+        growth_left_ = capacity_to_growth(capacity_) - size_;
+    }
+}
+
+#endif //MINISTL_FLAT_HASH_TABLE_H
@@ -0,0 +1,554 @@
+#ifndef MINISTL_FLAT_MAP_H
+#define MINISTL_FLAT_MAP_H
+
+// 这个头文件包含一个模板类 flat_map
+// flat_map : 以两个有序 vector 为底层存储的映射，键唯一
+
+// notes:
+// 键与值分别存放在两个 ministl::vector 中(split storage)，下标相同的键值是一对。
+// 查找只扫描键数组，值再大也不会把键挤出缓存；迭代器同时持有两个指针，解引用得到一对引用。
+//   * 批量构造：按键稳定排序后去重(相同的键保留先出现的那个)，O(nlogn)
+//   * insert_batch：把一批键值对先缓存到临时数组，排序去重后二分查找各自的插入位置，
+//                   再从尾部向前与原有的元素就地归并，复用已有容量，O(n + mlogm + mlogn)；
+//                   逐个 insert 则每次都要搬动插入点之后的全部元素，共 O(nm)
+//   * 查找：32/64 位整数键且比较操作为 ministl::less 时使用 simd_lower_bound，其余为 branchless_lower_bound
+//
+// 迭代器解引用得到 flat_map_reference(first 为键的 const 引用，second 为值的引用)，
+// 不是 pair<const Key, T>&；任何插入删除操作都会使迭代器失效。
+// 异常保证：
+//   单个插入满足强异常保证；批量操作中元素的比较或移动抛出异常时，容器被清空后再次抛出
+
+#include <initializer_list>
+
+#include "algo.h"
+#include "flat_set.h"
+#include "simd_search.h"
+#include "vector.h"
+
+namespace ministl
+{
+    // 解引用迭代器得到的一对引用，V 为 T 或 const T
+    template <class Key, class V>
+    struct flat_map_reference
+    {
+        const Key& first;
+        V&         second;
+
+        operator pair<Key, typename std::remove_const<V>::type>() const
+        {
+            return pair<Key, typename std::remove_const<V>::type>(first, second);
+        }
+    };
+
+    // operator-> 返回的代理对象
+    template <class Key, class V>
+    struct flat_map_arrow
+    {
+        flat_map_reference<Key, V> ref;
+        const flat_map_reference<Key, V>* operator->() const noexcept { return &ref; }
+    };
+
+    // flat_map 的迭代器，同时指向键数组和值数组
+    template <class Key, class V>
+    struct flat_map_iterator
+    {
+        typedef ministl::random_access_iterator_tag                         iterator_category;
+        typedef pair<Key, typename std::remove_const<V>::type>              value_type;
+        typedef flat_map_reference<Key, V>                                  reference;
+        typedef flat_map_arrow<Key, V>                                      pointer;
+        typedef ptrdiff_t                                                   difference_type;
+        typedef flat_map_iterator<Key, V>                                   self;
+
+        const Key* key_ptr;
+        V*         value_ptr;
+
+        flat_map_iterator() noexcept : key_ptr(nullptr), value_ptr(nullptr) {}
+        flat_map_iterator(const Key* k, V* v) noexcept : key_ptr(k), value_ptr(v) {}
+
+        // 非 const 迭代器可以转换为 const 迭代器
+        flat_map_iterator(const flat_map_iterator<Key, typename std::remove_const<V>::type>& other) noexcept
+                : key_ptr(other.key_ptr), value_ptr(other.value_ptr) {}
+
+        const Key& key()   const { return *key_ptr; }
+        V&         value() const { return *value_ptr; }
+
+        reference operator*()  const { return reference{*key_ptr, *value_ptr}; }
+        pointer   operator->() const { return pointer{operator*()}; }
+        reference operator[](difference_type n) const { return reference{key_ptr[n], value_ptr[n]}; }
+
+        self& operator++()    { ++key_ptr; ++value_ptr; return *this; }
+        self  operator++(int) { self tmp = *this; ++*this; return tmp; }
+        self& operator--()    { --key_ptr; --value_ptr; return *this; }
+        self  operator--(int) { self tmp = *this; --*this; return tmp; }
+
+        self& operator+=(difference_type n) { key_ptr += n; value_ptr += n; return *this; }
+        self& operator-=(difference_type n) { key_ptr -= n; value_ptr -= n; return *this; }
+        self  operator+(difference_type n) const { return self(key_ptr + n, value_ptr + n); }
+        self  operator-(difference_type n) const { return self(key_ptr - n, value_ptr - n); }
+        difference_type operator-(const self& rhs) const { return key_ptr - rhs.key_ptr; }
+
+        friend bool operator==(const self& lhs, const self& rhs) { return lhs.key_ptr == rhs.key_ptr; }
+        friend bool operator!=(const self& lhs, const self& rhs) { return lhs.key_ptr != rhs.key_ptr; }
+        friend bool operator< (const self& lhs, const self& rhs) { return lhs.key_ptr <  rhs.key_ptr; }
+        friend bool operator> (const self& lhs, const self& rhs) { return lhs.key_ptr >  rhs.key_ptr; }
+        friend bool operator<=(const self& lhs, const self& rhs) { return lhs.key_ptr <= rhs.key_ptr; }
+        friend bool operator>=(const self& lhs, const self& rhs) { return lhs.key_ptr >= rhs.key_ptr; }
+    };
+
+    /*********************************************flat_map**************************************************/
+    template <class Key, class T, class Compare = ministl::less<Key>,
+              class KeyAlloc = ministl::allocator<Key>, class MappedAlloc = ministl::allocator<T>>
+    class flat_map
+    {
+    public:
+        typedef Key                                             key_type;
+        typedef T                                               mapped_type;
+        typedef pair<Key, T>                                    value_type;
+        typedef Compare                                         key_compare;
+        typedef ministl::vector<Key, KeyAlloc>                  key_container_type;
+        typedef ministl::vector<T, MappedAlloc>                 mapped_container_type;
+
+        typedef size_t                                          size_type;
+        typedef ptrdiff_t                                       difference_type;
+        typedef flat_map_iterator<Key, T>                       iterator;
+        typedef flat_map_iterator<Key, const T>                 const_iterator;
+        typedef typename iterator::reference                    reference;
+        typedef typename const_iterator::reference              const_reference;
+
+    private:
+        key_container_type      keys_;
+        mapped_container_type   values_;
+        Compare                 comp_;
+
+    public:
+        flat_map() : keys_(), values_(), comp_() {}
+
+        explicit flat_map(const Compare& comp) : keys_(), values_(), comp_(comp) {}
+
+        template <class Iter, typename std::enable_if<ministl::is_input_iterator<Iter>::value, int>::type = 0>
+        flat_map(Iter first, Iter last, const Compare& comp = Compare())
+                : keys_(), values_(), comp_(comp)
+        {
+            insert_batch(first, last);
+        }
+
+        flat_map(std::initializer_list<value_type> list, const Compare& comp = Compare())
+                : keys_(), values_(), comp_(comp)
+        {
+            insert_batch(list.begin(), list.end());
+        }
+
+        // 直接接管两个等长的 vector，按键排序并去重
+        flat_map(key_container_type&& keys, mapped_container_type&& values, const Compare& comp = Compare());
+
+        flat_map(sorted_unique_t, key_container_type&& keys, mapped_container_type&& values,
+                 const Compare& comp = Compare())
+                : keys_(ministl::move(keys)), values_(ministl::move(values)), comp_(comp)
+        {
+            THROW_LENGTH_ERROR_IF(keys_.size() != values_.size(),
+                                  "keys and values must have the same size in flat_map<Key, T>");
+            MINISTL_DEBUG(is_sorted_unique());
+        }
+
+        flat_map(const flat_map&) = default;
+        flat_map& operator=(const flat_map&) = default;
+
+        flat_map(flat_map&& other) noexcept
+                : keys_(ministl::move(other.keys_)), values_(ministl::move(other.values_)), comp_(other.comp_) {}
+
+        flat_map& operator=(flat_map&& other) noexcept
+        {
+            flat_map tmp(ministl::move(other));
+            swap(tmp);
+            return *this;
+        }
+
+        flat_map& operator=(std::initializer_list<value_type> list)
+        {
+            flat_map tmp(list, comp_);
+            swap(tmp);
+            return *this;
+        }
+
+    public:
+        // 迭代器相关操作
+        iterator       begin()        noexcept { return make_iter(0); }
+        const_iterator begin()  const noexcept { return make_iter(0); }
+        iterator       end()          noexcept { return make_iter(size()); }
+        const_iterator end()    const noexcept { return make_iter(size()); }
+        const_iterator cbegin() const noexcept { return begin(); }
+        const_iterator cend()   const noexcept { return end(); }
+
+        // 容量相关操作
+        bool      empty()    const noexcept { return keys_.empty(); }
+        size_type size()     const noexcept { return keys_.size(); }
+        size_type max_size() const noexcept { return ministl::min(keys_.max_size(), values_.max_size()); }
+        size_type capacity() const noexcept { return ministl::min(keys_.capacity(), values_.capacity()); }
+
+        void reserve(size_type n)
+        {
+            keys_.reserve(n);
+            values_.reserve(n);
+        }
+
+        void shrink_to_fit()
+        {
+            keys_.shrink_to_fit();
+            values_.shrink_to_fit();
+        }
+
+        // 底层的键数组与值数组
+        const key_container_type&    keys()   const noexcept { return keys_; }
+        const mapped_container_type& values() const noexcept { return values_; }
+
+        key_compare key_comp() const { return comp_; }
+
+        // 访问元素
+        mapped_type& operator[](const key_type& key)
+        {
+            return try_emplace(key).first.value();
+        }
+
+        mapped_type& at(const key_type& key)
+        {
+            iterator pos = find(key);
+            THROW_OUT_OF_RANGE_IF(pos == end(), "flat_map<Key, T>::at() key not found");
+            return pos.value();
+        }
+
+        const mapped_type& at(const key_type& key) const
+        {
+            const_iterator pos = find(key);
+            THROW_OUT_OF_RANGE_IF(pos == end(), "flat_map<Key, T>::at() key not found");
+            return pos.value();
+        }
+
+        // 插入删除操作
+        pair<iterator, bool> insert(const value_type& value)
+        {
+            return try_emplace(value.first, value.second);
+        }
+
+        pair<iterator, bool> insert(value_type&& value)
+        {
+            return try_emplace(value.first, ministl::move(value.second));
+        }
+
+        template <class Iter, typename std::enable_if<ministl::is_input_iterator<Iter>::value, int>::type = 0>
+        void insert(Iter first, Iter last) { insert_batch(first, last); }
+
+        void insert(std::initializer_list<value_type> list) { insert_batch(list.begin(), list.end()); }
+
+        // 键不存在时以 args 构造值并插入，键已存在时什么也不做
+        template <class ...Args>
+        pair<iterator, bool> try_emplace(const key_type& key, Args&& ...args);
+
+        template <class ...Args>
+        pair<iterator, bool> emplace(const key_type& key, Args&& ...args)
+        {
+            return try_emplace(key, ministl::forward<Args>(args)...);
+        }
+
+        template <class M>
+        pair<iterator, bool> insert_or_assign(const key_type& key, M&& obj)
+        {
+            pair<iterator, bool> result = try_emplace(key, ministl::forward<M>(obj));
+            if (!result.second)
+                result.first.value() = ministl::forward<M>(obj);
+            return result;
+        }
+
+        // 批量插入：已经存在的键保留原值，批内重复的键保留先出现的那个
+        template <class Iter, typename std::enable_if<ministl::is_input_iterator<Iter>::value, int>::type = 0>
+        void insert_batch(Iter first, Iter last);
+
+        iterator erase(const_iterator pos)
+        {
+            MINISTL_DEBUG(pos >= cbegin() && pos < cend());
+            const size_type n = index_of(pos);
+            keys_.erase(keys_.begin() + n);
+            values_.erase(values_.begin() + n);
+            return make_iter(n);
+        }
+
+        iterator erase(const_iterator first, const_iterator last)
+        {
+            MINISTL_DEBUG(first >= cbegin() && last <= cend() && !(last < first));
+            const size_type n = index_of(first);
+            const size_type m = index_of(last);
+            keys_.erase(keys_.begin() + n, keys_.begin() + m);
+            values_.erase(values_.begin() + n, values_.begin() + m);
+            return make_iter(n);
+        }
+
+        size_type erase(const key_type& key)
+        {
+            const_iterator pos = find(key);
+            if (pos == cend())
+                return 0;
+            erase(pos);
+            return 1;
+        }
+
+        void clear()
+        {
+            keys_.clear();
+            values_.clear();
+        }
+
+        void swap(flat_map& other) noexcept
+        {
+            keys_.swap(other.keys_);
+            values_.swap(other.values_);
+            ministl::swap(comp_, other.comp_);
+        }
+
+        // 查找操作
+        iterator       lower_bound(const key_type& key)       { return make_iter(lower_bound_index(key)); }
+        const_iterator lower_bound(const key_type& key) const { return make_iter(lower_bound_index(key)); }
+        iterator       upper_bound(const key_type& key)       { return make_iter(upper_bound_index(key)); }
+        const_iterator upper_bound(const key_type& key) const { return make_iter(upper_bound_index(key)); }
+        iterator       find(const key_type& key)              { return make_iter(find_index(key)); }
+        const_iterator find(const key_type& key)        const { return make_iter(find_index(key)); }
+
+        pair<iterator, iterator> equal_range(const key_type& key)
+        {
+            return pair<iterator, iterator>(lower_bound(key), upper_bound(key));
+        }
+
+        pair<const_iterator, const_iterator> equal_range(const key_type& key) const
+        {
+            return pair<const_iterator, const_iterator>(lower_bound(key), upper_bound(key));
+        }
+
+        bool      contains(const key_type& key) const { return find_index(key) != size(); }
+        size_type count(const key_type& key)    const { return contains(key) ? 1 : 0; }
+
+    private:
+        iterator       make_iter(size_type n)       noexcept { return iterator(keys_.data() + n, values_.data() + n); }
+        const_iterator make_iter(size_type n) const noexcept { return const_iterator(keys_.data() + n, values_.data() + n); }
+        size_type      index_of(const_iterator pos) const noexcept { return static_cast<size_type>(pos.key_ptr - keys_.data()); }
+
+        // 为 m 个新元素预留空间，容量不足时按 growth_capacity 增长
+        void reserve_more(size_type m)
+        {
+            const size_type n = size() + m;
+            if (capacity() < n)
+                reserve(ministl::max(n, ministl::growth_capacity(capacity(), m, max_size())));
+        }
+
+        // 把 src(0), ..., src(m - 1) 插入 c，src(j) 插在原有的第 pos[j] 个元素之前，pos 非递减
+        template <class Container, class Src>
+        static void merge_back(Container& c, const ministl::vector<size_type>& pos, Src src);
+
+        size_type lower_bound_index(const key_type& key) const
+        {
+            return lower_bound_dispatch(key, simd_searchable<Key, Compare>());
+        }
+
+        size_type lower_bound_dispatch(const key_type& key, m_true_type) const
+        {
+            return ministl::simd_lower_bound(keys_.data(), size(), key);
+        }
+
+        size_type lower_bound_dispatch(const key_type& key, m_false_type) const
+        {
+            return static_cast<size_type>(
+                    ministl::branchless_lower_bound(keys_.data(), keys_.data() + size(), key, comp_) - keys_.data());
+        }
+
+        size_type upper_bound_index(const key_type& key) const
+        {
+            const size_type n = lower_bound_index(key);
+            return (n != size() && !comp_(key, keys_[n])) ? n + 1 : n;
+        }
+
+        size_type find_index(const key_type& key) const
+        {
+            const size_type n = lower_bound_index(key);
+            return (n != size() && !comp_(key, keys_[n])) ? n : size();
+        }
+
+        bool is_sorted_unique() const;
+    };
+
+    /*****************************************************************************************/
+
+    template <class Key, class T, class Compare, class KeyAlloc, class MappedAlloc>
+    flat_map<Key, T, Compare, KeyAlloc, MappedAlloc>::
+    flat_map(key_container_type&& keys, mapped_container_type&& values, const Compare& comp)
+            : keys_(), values_(), comp_(comp)
+    {
+        THROW_LENGTH_ERROR_IF(keys.size() != values.size(),
+                              "keys and values must have the same size in flat_map<Key, T>");
+        const size_type n = keys.size();
+        // 对下标排序，相同的键按原有顺序排列，只保留第一个
+        ministl::vector<size_type> order(n, 0);
+        for (size_type i = 0; i < n; ++i)
+            order[i] = i;
+        const key_container_type& k = keys;
+        ministl::stable_sort(order.begin(), order.end(),
+                             [&k, &comp](size_type a, size_type b) { return comp(k[a], k[b]); });
+        keys_.reserve(n);
+        values_.reserve(n);
+        for (size_type i = 0; i < n; ++i)
+        {
+            if (i != 0 && !comp_(keys_.back(), keys[order[i]]))
+                continue;
+            keys_.emplace_back(ministl::move(keys[order[i]]));
+            values_.emplace_back(ministl::move(values[order[i]]));
+        }
+    }
+
+    template <class Key, class T, class Compare, class KeyAlloc, class MappedAlloc>
+    template <class ...Args>
+    pair<typename flat_map<Key, T, Compare, KeyAlloc, MappedAlloc>::iterator, bool>
+    flat_map<Key, T, Compare, KeyAlloc, MappedAlloc>::try_emplace(const key_type& key, Args&& ...args)
+    {
+        const size_type n = lower_bound_index(key);
+        if (n != size() && !comp_(key, keys_[n]))
+            return pair<iterator, bool>(make_iter(n), false);
+        keys_.insert(keys_.begin() + n, key);
+        try
+        {
+            values_.emplace(values_.begin() + n, ministl::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            keys_.erase(keys_.begin() + n);
+            throw;
+        }
+        return pair<iterator, bool>(make_iter(n), true);
+    }
+
+    // 先把整批元素缓存到临时数组中排序去重，求出每个新键的插入位置，再从尾部向前与原有的元素就地归并
+    template <class Key, class T, class Compare, class KeyAlloc, class MappedAlloc>
+    template <class Iter, typename std::enable_if<ministl::is_input_iterator<Iter>::value, int>::type>
+    void flat_map<Key, T, Compare, KeyAlloc, MappedAlloc>::insert_batch(Iter first, Iter last)
+    {
+        ministl::vector<value_type> batch(first, last);
+        if (batch.empty())
+            return;
+        const Compare& comp = comp_;
+        ministl::stable_sort(batch.begin(), batch.end(),
+                             [&comp](const value_type& a, const value_type& b) { return comp(a.first, b.first); });
+        batch.erase(ministl::unique(batch.begin(), batch.end(),
+                                    [&comp](const value_type& a, const value_type& b) { return !comp(a.first, b.first); }),
+                    batch.end());
+
+        const size_type n = size();
+        const size_type m = batch.size();
+        try
+        {
+            // 整批都在已有的键之后(如按时间递增的键)，直接追加
+            if (n == 0 || comp_(keys_.back(), batch.front().first))
+            {
+                reserve_more(m);
+                for (size_type j = 0; j < m; ++j)
+                {
+                    keys_.emplace_back(ministl::move(batch[j].first));
+                    values_.emplace_back(ministl::move(batch[j].second));
+                }
+                return;
+            }
+            // 键已经存在时保留原值，其余的键记下在 batch 中的下标与插入位置
+            ministl::vector<size_type> index;
+            ministl::vector<size_type> pos;
+            index.reserve(m);
+            pos.reserve(m);
+            for (size_type j = 0; j < m; ++j)
+            {
+                const size_type p = lower_bound_index(batch[j].first);
+                if (p != n && !comp_(batch[j].first, keys_[p]))
+                    continue;
+                index.push_back(j);
+                pos.push_back(p);
+            }
+            if (pos.empty())
+                return;
+            reserve_more(pos.size());
+            merge_back(keys_, pos, [&batch, &index](size_type j) -> Key& { return batch[index[j]].first; });
+            merge_back(values_, pos, [&batch, &index](size_type j) -> T& { return batch[index[j]].second; });
+        }
+        catch (...)
+        {
+            clear();
+            throw;
+        }
+    }
+
+    // 从尾部向前归并：落在原有 size 之后的位置在未初始化空间上构造，其余位置移动赋值
+    template <class Key, class T, class Compare, class KeyAlloc, class MappedAlloc>
+    template <class Container, class Src>
+    void flat_map<Key, T, Compare, KeyAlloc, MappedAlloc>::
+    merge_back(Container& c, const ministl::vector<size_type>& pos, Src src)
+    {
+        typedef typename Container::value_type elem;
+        const size_type n = c.size();
+        const size_type m = pos.size();
+        size_type i = n;        //原有元素中尚未放置的是 [0, i)
+        size_type j = m;        //新元素中尚未放置的是 [0, j)
+        size_type k = n + m;    //结果中尚未写入的是 [0, k)
+        c.append_uninitialized(m, [&](elem* dst) {
+            elem* const base = dst - n;
+            try
+            {
+                for (; k > n; --k)
+                {
+                    if (i > 0 && (j == 0 || pos[j - 1] < i))
+                        ministl::construct(base + k - 1, ministl::move(base[--i]));
+                    else
+                        ministl::construct(base + k - 1, ministl::move(src(--j)));
+                }
+            }
+            catch (...)
+            {
+                ministl::destroy(base + k, base + n + m);
+                throw;
+            }
+        });
+        for (; j > 0; --k)
+        {
+            if (pos[j - 1] < i)
+                c[k - 1] = ministl::move(c[--i]);
+            else
+                c[k - 1] = ministl::move(src(--j));
+        }
+    }
+
+    template <class Key, class T, class Compare, class KeyAlloc, class MappedAlloc>
+    bool flat_map<Key, T, Compare, KeyAlloc, MappedAlloc>::is_sorted_unique() const
+    {
+        for (size_type i = 1; i < size(); ++i)
+        {
+            if (!comp_(keys_[i - 1], keys_[i]))
+                return false;
+        }
+        return true;
+    }
+
+    //overload
+    template <class Key, class T, class Compare, class KeyAlloc, class MappedAlloc>
+    bool operator==(const flat_map<Key, T, Compare, KeyAlloc, MappedAlloc>& lhs,
+                    const flat_map<Key, T, Compare, KeyAlloc, MappedAlloc>& rhs)
+    {
+        return lhs.keys() == rhs.keys() && lhs.values() == rhs.values();
+    }
+
+    template <class Key, class T, class Compare, class KeyAlloc, class MappedAlloc>
+    bool operator!=(const flat_map<Key, T, Compare, KeyAlloc, MappedAlloc>& lhs,
+                    const flat_map<Key, T, Compare, KeyAlloc, MappedAlloc>& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    // 重载 ministl 的 swap
+    template <class Key, class T, class Compare, class KeyAlloc, class MappedAlloc>
+    void swap(flat_map<Key, T, Compare, KeyAlloc, MappedAlloc>& lhs,
+              flat_map<Key, T, Compare, KeyAlloc, MappedAlloc>& rhs)
+    {
+        lhs.swap(rhs);
+    }
+}
+
+#endif //MINISTL_FLAT_MAP_H
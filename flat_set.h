@@ -0,0 +1,475 @@
+#ifndef MINISTL_FLAT_SET_H
+#define MINISTL_FLAT_SET_H
+
+// 这个头文件包含一个模板类 flat_set
+// flat_set : 以有序 vector 为底层存储的集合，键唯一
+
+// notes:
+// 红黑树的每个节点单独分配，查找时沿指针逐层跳转，几乎每一层都是一次 cache miss。
+// flat_set 把键按顺序连续存放在 ministl::vector 中，适合读多写少、被反复查找的场景：
+//   * 批量构造(范围 / 初始化列表 / 直接接管一个 vector)：先排序再去重，O(nlogn)
+//   * 查找使用 branchless_lower_bound，循环次数固定、没有难以预测的分支
+//   * 单个插入、删除需要搬动元素，O(n)；批量插入先排序新元素，再与原有元素归并去重
+//
+// 布局(Layout)：
+//   * sorted_layout    : 只有有序数组，默认选项
+//   * eytzinger_layout : 额外保存一份按 Eytzinger(BFS) 顺序排列的键，tree[k] 的左右孩子为 tree[2k]、tree[2k+1]。
+//                        查找路径上前几层的键集中在数组头部，常驻缓存；同一节点往下若干层的后代在内存中连续，
+//                        每一步预取 tree[k * stride] 所在的 cache line，把下几层的访存延迟与当前的比较重叠起来。
+//                        集合远大于缓存时查找明显更快，代价是键多存一份、每次修改后 O(n) 重建索引，
+//                        因此只适合构造后很少修改的集合
+//
+// 迭代器为指向有序数组的 const 指针，任何修改操作都会使迭代器失效。
+// 异常保证：
+//   批量插入时比较操作或元素的移动抛出异常，容器被清空后再次抛出；其余操作与 vector 相同
+
+#include <initializer_list>
+
+#include "algo.h"
+#include "aligned_allocator.h"
+#include "vector.h"
+
+namespace ministl
+{
+    // 布局选项
+    struct sorted_layout {};
+    struct eytzinger_layout {};
+
+    // 标记输入已经有序且没有重复元素，构造时跳过排序与去重
+    struct sorted_unique_t {};
+    constexpr sorted_unique_t sorted_unique{};
+
+    /*******************************************flat_index**************************************************/
+    // 有序数组之上的查找索引，lower_bound 返回第一个不小于 key 的元素在有序数组中的下标
+    template <class Key, class Compare, class Layout>
+    class flat_index;
+
+    template <class Key, class Compare>
+    class flat_index<Key, Compare, sorted_layout>
+    {
+    public:
+        void build(const Key*, size_t) {}
+
+        size_t lower_bound(const Key* data, size_t n, const Key& key, const Compare& comp) const
+        {
+            return static_cast<size_t>(ministl::branchless_lower_bound(data, data + n, key, comp) - data);
+        }
+
+        void swap(flat_index&) noexcept {}
+    };
+
+    // 不大于 x 的最大的 2 的幂
+    constexpr size_t flat_floor_pow2(size_t x)
+    {
+        return x < 2 ? 1 : 2 * flat_floor_pow2(x / 2);
+    }
+
+    // x 二进制末尾连续 1 的个数
+    inline unsigned flat_trailing_ones(size_t x) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<unsigned>(__builtin_ctzll(~static_cast<unsigned long long>(x)));
+#else
+        unsigned n = 0;
+        for (; x & 1; x >>= 1)
+            ++n;
+        return n;
+#endif
+    }
+
+    template <class Key, class Compare>
+    class flat_index<Key, Compare, eytzinger_layout>
+    {
+    public:
+        // 一条 cache line 能放下的键数(取 2 的幂)，tree[k * stride] 起的 stride 个键
+        // 是 k 往下 log2(stride) 层的全部后代，在对齐的空间中恰好占满一条 cache line
+        static constexpr size_t prefetch_stride = 64 / sizeof(Key) >= 2 ? flat_floor_pow2(64 / sizeof(Key)) : 2;
+
+    private:
+        ministl::vector<Key, aligned_allocator<Key, 64>> tree_;   // tree_[1..n] 为 BFS 顺序，tree_[0] 不使用
+        ministl::vector<size_t>                          rank_;   // rank_[k] 为 tree_[k] 在有序数组中的下标
+
+    public:
+        void build(const Key* data, size_t n)
+        {
+            if (n == 0)
+            {
+                tree_.clear();
+                rank_.clear();
+                return;
+            }
+            tree_.assign(n + 1, data[0]);
+            rank_.assign(n + 1, 0);
+            size_t i = 0;
+            fill(data, i, 1, n);
+        }
+
+        size_t lower_bound(const Key*, size_t n, const Key& key, const Compare& comp) const
+        {
+            const Key* tree = tree_.data();
+            const uintptr_t base = reinterpret_cast<uintptr_t>(tree);
+            size_t k = 1;
+            while (k <= n)
+            {
+                ministl::prefetch_read(reinterpret_cast<const void*>(base + k * prefetch_stride * sizeof(Key)));
+                k = 2 * k + static_cast<size_t>(comp(tree[k], key));
+            }
+            // 最后一次向左走的位置即为结果：去掉末尾连续的 1(向右走)以及那一次向左
+            k >>= flat_trailing_ones(k) + 1;
+            return k == 0 ? n : rank_[k];
+        }
+
+        void swap(flat_index& other) noexcept
+        {
+            tree_.swap(other.tree_);
+            rank_.swap(other.rank_);
+        }
+
+    private:
+        // 中序遍历隐式的完全二叉树，依次填入有序数组的元素
+        void fill(const Key* data, size_t& i, size_t k, size_t n)
+        {
+            if (k > n)
+                return;
+            fill(data, i, 2 * k, n);
+            tree_[k] = data[i];
+            rank_[k] = i++;
+            fill(data, i, 2 * k + 1, n);
+        }
+    };
+
+    /*********************************************flat_set**************************************************/
+    template <class Key, class Compare = ministl::less<Key>, class Layout = sorted_layout,
+              class Alloc = ministl::allocator<Key>>
+    class flat_set
+    {
+    public:
+        typedef Key                                             key_type;
+        typedef Key                                             value_type;
+        typedef Compare                                         key_compare;
+        typedef Compare                                         value_compare;
+        typedef Layout                                          layout_type;
+        typedef ministl::vector<Key, Alloc>                     container_type;
+
+        typedef typename container_type::size_type              size_type;
+        typedef typename container_type::difference_type        difference_type;
+        typedef const Key&                                      reference;
+        typedef const Key&                                      const_reference;
+        typedef const Key*                                      iterator;
+        typedef const Key*                                      const_iterator;
+        typedef ministl::reverse_iterator<const_iterator>       reverse_iterator;
+        typedef ministl::reverse_iterator<const_iterator>       const_reverse_iterator;
+
+    private:
+        container_type                          data_;
+        Compare                                 comp_;
+        flat_index<Key, Compare, Layout>        index_;
+
+    public:
+        flat_set() : data_(), comp_(), index_() {}
+
+        explicit flat_set(const Compare& comp) : data_(), comp_(comp), index_() {}
+
+        template <class Iter, typename std::enable_if<ministl::is_input_iterator<Iter>::value, int>::type = 0>
+        flat_set(Iter first, Iter last, const Compare& comp = Compare())
+                : data_(first, last), comp_(comp), index_()
+        {
+            normalize();
+        }
+
+        flat_set(std::initializer_list<value_type> list, const Compare& comp = Compare())
+                : data_(list), comp_(comp), index_()
+        {
+            normalize();
+        }
+
+        // 直接接管一个 vector 的存储，不复制元素
+        explicit flat_set(container_type&& cont, const Compare& comp = Compare())
+                : data_(ministl::move(cont)), comp_(comp), index_()
+        {
+            normalize();
+        }
+
+        flat_set(sorted_unique_t, container_type&& cont, const Compare& comp = Compare())
+                : data_(ministl::move(cont)), comp_(comp), index_()
+        {
+            MINISTL_DEBUG(is_sorted_unique());
+            rebuild_index();
+        }
+
+        flat_set(const flat_set&) = default;
+        flat_set& operator=(const flat_set&) = default;
+
+        flat_set(flat_set&& other) noexcept
+                : data_(ministl::move(other.data_)), comp_(other.comp_), index_()
+        {
+            index_.swap(other.index_);
+        }
+
+        flat_set& operator=(flat_set&& other) noexcept
+        {
+            flat_set tmp(ministl::move(other));
+            swap(tmp);
+            return *this;
+        }
+
+        flat_set& operator=(std::initializer_list<value_type> list)
+        {
+            flat_set tmp(list, comp_);
+            swap(tmp);
+            return *this;
+        }
+
+    public:
+        // 迭代器相关操作
+        const_iterator begin()  const noexcept { return data_.begin(); }
+        const_iterator end()    const noexcept { return data_.end(); }
+        const_iterator cbegin() const noexcept { return begin(); }
+        const_iterator cend()   const noexcept { return end(); }
+        const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+        const_reverse_iterator rend()   const noexcept { return const_reverse_iterator(begin()); }
+
+        // 容量相关操作
+        bool      empty()    const noexcept { return data_.empty(); }
+        size_type size()     const noexcept { return data_.size(); }
+        size_type max_size() const noexcept { return data_.max_size(); }
+        size_type capacity() const noexcept { return data_.capacity(); }
+        void      reserve(size_type n)      { data_.reserve(n); }
+        void      shrink_to_fit()           { data_.shrink_to_fit(); }
+
+        // 按顺序访问第 n 小的元素
+        const_reference nth(size_type n) const
+        {
+            MINISTL_DEBUG(n < size());
+            return data_[n];
+        }
+        size_type index_of(const_iterator pos) const noexcept { return static_cast<size_type>(pos - begin()); }
+
+        // 底层的有序数组
+        const container_type& sequence() const noexcept { return data_; }
+
+        // 取走底层的有序数组，容器变为空
+        container_type extract()
+        {
+            container_type result(ministl::move(data_));
+            rebuild_index();
+            return result;
+        }
+
+        key_compare   key_comp()   const { return comp_; }
+        value_compare value_comp() const { return comp_; }
+
+        // 插入删除操作
+        pair<iterator, bool> insert(const value_type& value)
+        {
+            const_iterator pos = lower_bound(value);
+            if (pos != end() && !comp_(value, *pos))
+                return pair<iterator, bool>(pos, false);
+            pos = data_.insert(pos, value);
+            rebuild_index();
+            return pair<iterator, bool>(pos, true);
+        }
+
+        pair<iterator, bool> insert(value_type&& value)
+        {
+            const_iterator pos = lower_bound(value);
+            if (pos != end() && !comp_(value, *pos))
+                return pair<iterator, bool>(pos, false);
+            pos = data_.insert(pos, ministl::move(value));
+            rebuild_index();
+            return pair<iterator, bool>(pos, true);
+        }
+
+        template <class ...Args>
+        pair<iterator, bool> emplace(Args&& ...args)
+        {
+            return insert(value_type(ministl::forward<Args>(args)...));
+        }
+
+        template <class Iter, typename std::enable_if<ministl::is_input_iterator<Iter>::value, int>::type = 0>
+        void insert(Iter first, Iter last);
+
+        void insert(std::initializer_list<value_type> list) { insert(list.begin(), list.end()); }
+
+        iterator erase(const_iterator pos)
+        {
+            MINISTL_DEBUG(pos >= begin() && pos < end());
+            const size_type n = index_of(pos);
+            data_.erase(pos);
+            rebuild_index();
+            return begin() + n;
+        }
+
+        iterator erase(const_iterator first, const_iterator last)
+        {
+            MINISTL_DEBUG(first >= begin() && last <= end() && !(last < first));
+            const size_type n = index_of(first);
+            data_.erase(first, last);
+            rebuild_index();
+            return begin() + n;
+        }
+
+        size_type erase(const key_type& key)
+        {
+            const_iterator pos = find(key);
+            if (pos == end())
+                return 0;
+            erase(pos);
+            return 1;
+        }
+
+        void clear()
+        {
+            data_.clear();
+            rebuild_index();
+        }
+
+        void swap(flat_set& other) noexcept
+        {
+            data_.swap(other.data_);
+            ministl::swap(comp_, other.comp_);
+            index_.swap(other.index_);
+        }
+
+        // 查找操作
+        const_iterator lower_bound(const key_type& key) const
+        {
+            return begin() + index_.lower_bound(data_.data(), size(), key, comp_);
+        }
+
+        const_iterator upper_bound(const key_type& key) const
+        {
+            const_iterator pos = lower_bound(key);
+            return (pos != end() && !comp_(key, *pos)) ? pos + 1 : pos;
+        }
+
+        pair<const_iterator, const_iterator> equal_range(const key_type& key) const
+        {
+            const_iterator pos = lower_bound(key);
+            const_iterator next = (pos != end() && !comp_(key, *pos)) ? pos + 1 : pos;
+            return pair<const_iterator, const_iterator>(pos, next);
+        }
+
+        const_iterator find(const key_type& key) const
+        {
+            const_iterator pos = lower_bound(key);
+            return (pos != end() && !comp_(key, *pos)) ? pos : end();
+        }
+
+        bool      contains(const key_type& key) const { return find(key) != end(); }
+        size_type count(const key_type& key)    const { return contains(key) ? 1 : 0; }
+
+    private:
+        // 有序数组排好序后 a 不大于 b，两者等价当且仅当 !comp(a, b)
+        struct equivalent
+        {
+            const Compare& comp;
+            explicit equivalent(const Compare& c) : comp(c) {}
+            bool operator()(const Key& a, const Key& b) const { return !comp(a, b); }
+        };
+
+        void normalize();
+        void rebuild_index() { index_.build(data_.data(), data_.size()); }
+        bool is_sorted_unique() const;
+    };
+
+    /*****************************************************************************************/
+
+    // 批量插入：新元素追加到尾部后单独排序，再与原有的有序数组归并。
+    // 归并是稳定的，去重时保留原有的元素，O(n + mlogm)
+    template <class Key, class Compare, class Layout, class Alloc>
+    template <class Iter, typename std::enable_if<ministl::is_input_iterator<Iter>::value, int>::type>
+    void flat_set<Key, Compare, Layout, Alloc>::insert(Iter first, Iter last)
+    {
+        const size_type old_size = size();
+        data_.insert(data_.end(), first, last);
+        if (size() == old_size)
+            return;
+        try
+        {
+            auto middle = data_.begin() + old_size;
+            ministl::sort(middle, data_.end(), comp_);
+            ministl::inplace_merge(data_.begin(), middle, data_.end(), comp_);
+            data_.erase(ministl::unique(data_.begin(), data_.end(), equivalent(comp_)), data_.end());
+        }
+        catch (...)
+        {
+            clear();
+            throw;
+        }
+        rebuild_index();
+    }
+
+    template <class Key, class Compare, class Layout, class Alloc>
+    void flat_set<Key, Compare, Layout, Alloc>::normalize()
+    {
+        try
+        {
+            ministl::sort(data_.begin(), data_.end(), comp_);
+            data_.erase(ministl::unique(data_.begin(), data_.end(), equivalent(comp_)), data_.end());
+        }
+        catch (...)
+        {
+            data_.clear();
+            throw;
+        }
+        rebuild_index();
+    }
+
+    template <class Key, class Compare, class Layout, class Alloc>
+    bool flat_set<Key, Compare, Layout, Alloc>::is_sorted_unique() const
+    {
+        for (size_type i = 1; i < size(); ++i)
+        {
+            if (!comp_(data_[i - 1], data_[i]))
+                return false;
+        }
+        return true;
+    }
+
+    //overload
+    template <class Key, class Compare, class Layout, class Alloc>
+    bool operator==(const flat_set<Key, Compare, Layout, Alloc>& lhs, const flat_set<Key, Compare, Layout, Alloc>& rhs)
+    {
+        return lhs.sequence() == rhs.sequence();
+    }
+
+    template <class Key, class Compare, class Layout, class Alloc>
+    bool operator<(const flat_set<Key, Compare, Layout, Alloc>& lhs, const flat_set<Key, Compare, Layout, Alloc>& rhs)
+    {
+        return lhs.sequence() < rhs.sequence();
+    }
+
+    template <class Key, class Compare, class Layout, class Alloc>
+    bool operator!=(const flat_set<Key, Compare, Layout, Alloc>& lhs, const flat_set<Key, Compare, Layout, Alloc>& rhs)
+    {
+        return !(lhs == rhs);
+    }
+
+    template <class Key, class Compare, class Layout, class Alloc>
+    bool operator>(const flat_set<Key, Compare, Layout, Alloc>& lhs, const flat_set<Key, Compare, Layout, Alloc>& rhs)
+    {
+        return rhs < lhs;
+    }
+
+    template <class Key, class Compare, class Layout, class Alloc>
+    bool operator<=(const flat_set<Key, Compare, Layout, Alloc>& lhs, const flat_set<Key, Compare, Layout, Alloc>& rhs)
+    {
+        return !(rhs < lhs);
+    }
+
+    template <class Key, class Compare, class Layout, class Alloc>
+    bool operator>=(const flat_set<Key, Compare, Layout, Alloc>& lhs, const flat_set<Key, Compare, Layout, Alloc>& rhs)
+    {
+        return !(lhs < rhs);
+    }
+
+    // 重载 ministl 的 swap
+    template <class Key, class Compare, class Layout, class Alloc>
+    void swap(flat_set<Key, Compare, Layout, Alloc>& lhs, flat_set<Key, Compare, Layout, Alloc>& rhs)
+    {
+        lhs.swap(rhs);
+    }
+}
+
+#endif //MINISTL_FLAT_SET_H
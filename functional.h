@@ -0,0 +1,55 @@
+#ifndef MINISTL_FUNCTIONAL_H
+#define MINISTL_FUNCTIONAL_H
+
+// 这个头文件包含了 ministl 的函数对象：算术运算、关系运算以及证同函数
+
+namespace ministl
+{
+    /*******************************************算术类函数对象*********************************************/
+    template <class T>
+    struct plus
+    {
+        T operator()(const T& lhs, const T& rhs) const { return lhs + rhs; }
+    };
+
+    template <class T>
+    struct minus
+    {
+        T operator()(const T& lhs, const T& rhs) const { return lhs - rhs; }
+    };
+
+    template <class T>
+    struct multiplies
+    {
+        T operator()(const T& lhs, const T& rhs) const { return lhs * rhs; }
+    };
+
+    /*******************************************关系类函数对象*********************************************/
+    template <class T>
+    struct equal_to
+    {
+        bool operator()(const T& lhs, const T& rhs) const { return lhs == rhs; }
+    };
+
+    template <class T>
+    struct less
+    {
+        bool operator()(const T& lhs, const T& rhs) const { return lhs < rhs; }
+    };
+
+    template <class T>
+    struct greater
+    {
+        bool operator()(const T& lhs, const T& rhs) const { return rhs < lhs; }
+    };
+
+    /*********************************************证同函数*************************************************/
+    // 不改变元素，返回本身
+    template <class T>
+    struct identity
+    {
+        const T& operator()(const T& x) const { return x; }
+    };
+}
+
+#endif //MINISTL_FUNCTIONAL_H
@@ -0,0 +1,352 @@
+#ifndef MINISTL_HEAP_ALGO_H
+#define MINISTL_HEAP_ALGO_H
+
+// 这个头文件包含 heap 的四个算法 : push_heap, pop_heap, sort_heap, make_heap
+// 以及它们的 d 叉堆版本 : dary_push_heap, dary_pop_heap, dary_sort_heap, dary_make_heap, dary_is_heap
+// 默认为 max-heap，重载版本使用函数对象 comp 代替比较操作
+
+// notes:
+// d 叉堆中节点 i 的子节点为 [d * i + 1, d * i + d]，父节点为 (i - 1) / d。
+// 树高降为 log_d(n)，下溯时一个节点的 d 个子节点连续存放，挑出最大者只需顺序扫描一两条 cache line，
+// 而二叉堆每下降一层就是一次新的、无法预测的访存。d 取 4 或 8 时 pop 通常明显快于二叉堆，
+// push 的比较次数也随树高一起减少。Arity 为 2 时与上面的二叉堆算法等价
+
+#include "algobase.h"
+#include "functional.h"
+#include "iterator.h"
+#include "util.h"
+
+namespace ministl
+{
+    /************************************************push_heap**********************************************/
+    /**************************新元素已置于容器尾部 last - 1，将其上溯到合适的位置*********************************/
+    /*******************************************************************************************************/
+    template <class RandomIter, class Distance, class T, class Compared>
+    void push_heap_aux(RandomIter first, Distance hole_index, Distance top_index, T value, Compared comp)
+    {
+        Distance parent = (hole_index - 1) / 2;
+        while (hole_index > top_index && comp(*(first + parent), value))
+        {
+            *(first + hole_index) = ministl::move(*(first + parent));
+            hole_index = parent;
+            parent = (hole_index - 1) / 2;
+        }
+        *(first + hole_index) = ministl::move(value);
+    }
+
+    template <class RandomIter, class Compared>
+    void push_heap(RandomIter first, RandomIter last, Compared comp)
+    {
+        typedef typename iterator_traits<RandomIter>::difference_type difference_type;
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        if (last - first < 2)
+            return;
+        value_type value = ministl::move(*(last - 1));
+        ministl::push_heap_aux(first, static_cast<difference_type>(last - first - 1),
+                               static_cast<difference_type>(0), ministl::move(value), comp);
+    }
+
+    template <class RandomIter>
+    void push_heap(RandomIter first, RandomIter last)
+    {
+        ministl::push_heap(first, last, ministl::less<typename iterator_traits<RandomIter>::value_type>());
+    }
+
+    /************************************************adjust_heap********************************************/
+    /*************************从 hole_index 处的空洞开始下溯到叶子，再把 value 上溯回合适的位置*********************/
+    /*******************************************************************************************************/
+    template <class RandomIter, class Distance, class T, class Compared>
+    void adjust_heap(RandomIter first, Distance hole_index, Distance len, T value, Compared comp)
+    {
+        const Distance top_index = hole_index;
+        Distance child = 2 * hole_index + 2;
+        while (child < len)
+        {
+            if (comp(*(first + child), *(first + (child - 1))))
+                --child;
+            *(first + hole_index) = ministl::move(*(first + child));
+            hole_index = child;
+            child = 2 * child + 2;
+        }
+        if (child == len)
+        {
+            // 只有左子节点
+            *(first + hole_index) = ministl::move(*(first + (child - 1)));
+            hole_index = child - 1;
+        }
+        ministl::push_heap_aux(first, hole_index, top_index, ministl::move(value), comp);
+    }
+
+    /************************************************pop_heap***********************************************/
+    /*************************把堆顶元素移到容器尾部 last - 1，并调整 [first, last - 1) 使之仍为堆****************/
+    /*******************************************************************************************************/
+    template <class RandomIter, class Compared>
+    void pop_heap(RandomIter first, RandomIter last, Compared comp)
+    {
+        typedef typename iterator_traits<RandomIter>::difference_type difference_type;
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        if (last - first < 2)
+            return;
+        --last;
+        value_type value = ministl::move(*last);
+        *last = ministl::move(*first);
+        ministl::adjust_heap(first, static_cast<difference_type>(0),
+                             static_cast<difference_type>(last - first), ministl::move(value), comp);
+    }
+
+    template <class RandomIter>
+    void pop_heap(RandomIter first, RandomIter last)
+    {
+        ministl::pop_heap(first, last, ministl::less<typename iterator_traits<RandomIter>::value_type>());
+    }
+
+    /************************************************sort_heap**********************************************/
+    /******************************不断执行 pop_heap，直到首尾相差最多为 1*****************************************/
+    /*******************************************************************************************************/
+    template <class RandomIter, class Compared>
+    void sort_heap(RandomIter first, RandomIter last, Compared comp)
+    {
+        while (last - first > 1)
+        {
+            ministl::pop_heap(first, last, comp);
+            --last;
+        }
+    }
+
+    template <class RandomIter>
+    void sort_heap(RandomIter first, RandomIter last)
+    {
+        ministl::sort_heap(first, last, ministl::less<typename iterator_traits<RandomIter>::value_type>());
+    }
+
+    /************************************************make_heap**********************************************/
+    /******************************从最后一个非叶子节点开始依次下溯，把 [first, last) 变成堆**********************/
+    /*******************************************************************************************************/
+    template <class RandomIter, class Compared>
+    void make_heap(RandomIter first, RandomIter last, Compared comp)
+    {
+        typedef typename iterator_traits<RandomIter>::difference_type difference_type;
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        const difference_type len = last - first;
+        if (len < 2)
+            return;
+        difference_type hole_index = (len - 2) / 2;
+        while (true)
+        {
+            value_type value = ministl::move(*(first + hole_index));
+            ministl::adjust_heap(first, hole_index, len, ministl::move(value), comp);
+            if (hole_index == 0)
+                return;
+            --hole_index;
+        }
+    }
+
+    template <class RandomIter>
+    void make_heap(RandomIter first, RandomIter last)
+    {
+        ministl::make_heap(first, last, ministl::less<typename iterator_traits<RandomIter>::value_type>());
+    }
+
+    /*******************************************dary_push_heap**********************************************/
+    /*************************d 叉堆版本：新元素已置于 last - 1，将其上溯到合适的位置*****************************/
+    /*******************************************************************************************************/
+    template <size_t Arity, class RandomIter, class Distance, class T, class Compared>
+    void dary_push_heap_aux(RandomIter first, Distance hole_index, Distance top_index, T value, Compared comp)
+    {
+        const Distance arity = static_cast<Distance>(Arity);
+        while (hole_index > top_index)
+        {
+            const Distance parent = (hole_index - 1) / arity;
+            if (!comp(*(first + parent), value))
+                break;
+            *(first + hole_index) = ministl::move(*(first + parent));
+            hole_index = parent;
+        }
+        *(first + hole_index) = ministl::move(value);
+    }
+
+    template <size_t Arity, class RandomIter, class Compared>
+    void dary_push_heap(RandomIter first, RandomIter last, Compared comp)
+    {
+        static_assert(Arity >= 2, "heap arity must be at least 2");
+        typedef typename iterator_traits<RandomIter>::difference_type difference_type;
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        if (last - first < 2)
+            return;
+        value_type value = ministl::move(*(last - 1));
+        ministl::dary_push_heap_aux<Arity>(first, static_cast<difference_type>(last - first - 1),
+                                           static_cast<difference_type>(0), ministl::move(value), comp);
+    }
+
+    template <size_t Arity, class RandomIter>
+    void dary_push_heap(RandomIter first, RandomIter last)
+    {
+        ministl::dary_push_heap<Arity>(first, last, ministl::less<typename iterator_traits<RandomIter>::value_type>());
+    }
+
+    /*******************************************dary_adjust_heap********************************************/
+    /**********************空洞每次换成最大的子节点直到叶子，再把 value 上溯回合适的位置****************************/
+    /*******************************************************************************************************/
+    // [child, child + count) 中最大者的下标。小的可平凡复制类型把当前最大值留在寄存器里，
+    // 下标与值都用条件赋值更新，编译为 cmov，避免每次比较一次难以预测的分支
+    template <class RandomIter, class Distance, class Compared>
+    Distance dary_max_child_aux(RandomIter first, Distance child, Distance count, Compared comp, m_true_type)
+    {
+        Distance best = child;
+        typename iterator_traits<RandomIter>::value_type best_value = *(first + child);
+        for (Distance i = child + 1; i < child + count; ++i)
+        {
+            const bool greater = comp(best_value, *(first + i));
+            best += static_cast<Distance>(greater) * (i - best);
+            best_value = greater ? *(first + i) : best_value;
+        }
+        return best;
+    }
+
+    template <class RandomIter, class Distance, class Compared>
+    Distance dary_max_child_aux(RandomIter first, Distance child, Distance count, Compared comp, m_false_type)
+    {
+        Distance best = child;
+        for (Distance i = child + 1; i < child + count; ++i)
+        {
+            if (comp(*(first + best), *(first + i)))
+                best = i;
+        }
+        return best;
+    }
+
+    template <class RandomIter, class Distance, class Compared>
+    Distance dary_max_child(RandomIter first, Distance child, Distance count, Compared comp)
+    {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        return ministl::dary_max_child_aux(first, child, count, comp, m_bool_constant<
+                std::is_trivially_copyable<value_type>::value && sizeof(value_type) <= 16>());
+    }
+
+    template <size_t Arity, class RandomIter, class Distance, class T, class Compared>
+    void dary_adjust_heap(RandomIter first, Distance hole_index, Distance len, T value, Compared comp)
+    {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        const Distance arity = static_cast<Distance>(Arity);
+        const Distance line = sizeof(value_type) >= 64 ? 1 : static_cast<Distance>(64 / sizeof(value_type));
+        const Distance top_index = hole_index;
+        Distance child = arity * hole_index + 1;
+        while (child + arity <= len)
+        {
+            // 一组兄弟节点的子节点在数组中也是连续的，比较这一组之前先预取下一层可能用到的 Arity * Arity 个元素，
+            // 每条 cache line 预取一次，最后一个元素可能跨到下一条 cache line，单独再预取一次
+            const Distance grandchild = arity * child + 1;
+            if (grandchild < len)
+            {
+                const Distance span = ministl::min(arity * arity, len - grandchild);
+                for (Distance k = 0; k < span; k += line)
+                    ministl::prefetch_read(&*(first + (grandchild + k)));
+                ministl::prefetch_read(&*(first + (grandchild + span - 1)));
+            }
+            const Distance best = ministl::dary_max_child(first, child, arity, comp);
+            *(first + hole_index) = ministl::move(*(first + best));
+            hole_index = best;
+            child = arity * hole_index + 1;
+        }
+        if (child < len)
+        {
+            // 最后一组子节点不满 Arity 个
+            const Distance best = ministl::dary_max_child(first, child, len - child, comp);
+            *(first + hole_index) = ministl::move(*(first + best));
+            hole_index = best;
+        }
+        ministl::dary_push_heap_aux<Arity>(first, hole_index, top_index, ministl::move(value), comp);
+    }
+
+    /*******************************************dary_pop_heap***********************************************/
+    /*********************把堆顶元素移到 last - 1，并调整 [first, last - 1) 使之仍为 d 叉堆***********************/
+    /*******************************************************************************************************/
+    template <size_t Arity, class RandomIter, class Compared>
+    void dary_pop_heap(RandomIter first, RandomIter last, Compared comp)
+    {
+        static_assert(Arity >= 2, "heap arity must be at least 2");
+        typedef typename iterator_traits<RandomIter>::difference_type difference_type;
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        if (last - first < 2)
+            return;
+        --last;
+        value_type value = ministl::move(*last);
+        *last = ministl::move(*first);
+        ministl::dary_adjust_heap<Arity>(first, static_cast<difference_type>(0),
+                                         static_cast<difference_type>(last - first), ministl::move(value), comp);
+    }
+
+    template <size_t Arity, class RandomIter>
+    void dary_pop_heap(RandomIter first, RandomIter last)
+    {
+        ministl::dary_pop_heap<Arity>(first, last, ministl::less<typename iterator_traits<RandomIter>::value_type>());
+    }
+
+    /*******************************************dary_sort_heap**********************************************/
+    template <size_t Arity, class RandomIter, class Compared>
+    void dary_sort_heap(RandomIter first, RandomIter last, Compared comp)
+    {
+        while (last - first > 1)
+        {
+            ministl::dary_pop_heap<Arity>(first, last, comp);
+            --last;
+        }
+    }
+
+    template <size_t Arity, class RandomIter>
+    void dary_sort_heap(RandomIter first, RandomIter last)
+    {
+        ministl::dary_sort_heap<Arity>(first, last, ministl::less<typename iterator_traits<RandomIter>::value_type>());
+    }
+
+    /*******************************************dary_make_heap**********************************************/
+    /**************************从最后一个非叶子节点开始依次下溯，O(n) 地建立 d 叉堆*******************************/
+    /*******************************************************************************************************/
+    template <size_t Arity, class RandomIter, class Compared>
+    void dary_make_heap(RandomIter first, RandomIter last, Compared comp)
+    {
+        static_assert(Arity >= 2, "heap arity must be at least 2");
+        typedef typename iterator_traits<RandomIter>::difference_type difference_type;
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        const difference_type len = last - first;
+        if (len < 2)
+            return;
+        difference_type hole_index = (len - 2) / static_cast<difference_type>(Arity);
+        while (true)
+        {
+            value_type value = ministl::move(*(first + hole_index));
+            ministl::dary_adjust_heap<Arity>(first, hole_index, len, ministl::move(value), comp);
+            if (hole_index == 0)
+                return;
+            --hole_index;
+        }
+    }
+
+    template <size_t Arity, class RandomIter>
+    void dary_make_heap(RandomIter first, RandomIter last)
+    {
+        ministl::dary_make_heap<Arity>(first, last, ministl::less<typename iterator_traits<RandomIter>::value_type>());
+    }
+
+    /*******************************************dary_is_heap************************************************/
+    template <size_t Arity, class RandomIter, class Compared>
+    bool dary_is_heap(RandomIter first, RandomIter last, Compared comp)
+    {
+        typedef typename iterator_traits<RandomIter>::difference_type difference_type;
+        const difference_type len = last - first;
+        for (difference_type i = 1; i < len; ++i)
+        {
+            if (comp(*(first + (i - 1) / static_cast<difference_type>(Arity)), *(first + i)))
+                return false;
+        }
+        return true;
+    }
+
+    template <size_t Arity, class RandomIter>
+    bool dary_is_heap(RandomIter first, RandomIter last)
+    {
+        return ministl::dary_is_heap<Arity>(first, last, ministl::less<typename iterator_traits<RandomIter>::value_type>());
+    }
+}
+
+#endif //MINISTL_HEAP_ALGO_H
@@ -0,0 +1,114 @@
+#ifndef MINISTL_HUGE_PAGE_ALLOCATOR_H
+#define MINISTL_HUGE_PAGE_ALLOCATOR_H
+
+// This header contains a template class huge_page_allocator
+// 以 2MB 大页支撑大块内存，降低随机访问大数组时的 dTLB miss
+
+// notes:
+// 大小不足 huge_page_threshold 的申请仍走 ::operator new，避免小容器浪费整块大页；
+// 超过阈值的申请按 huge_page_size 取整并 2MB 对齐，再根据 Mode 选择大页来源：
+//   * huge_page_mode::transparent : madvise(MADV_HUGEPAGE)，由内核的透明大页机制支撑
+//   * huge_page_mode::hugetlb     : 先尝试 MAP_HUGETLB 从预留大页池申请，失败时回退到 transparent
+// 与 allocator 一样以 static 函数提供接口，deallocate 必须传入申请时的 n
+
+#include "allocator.h"
+#include "page_memory.h"
+
+namespace ministl
+{
+    enum class huge_page_mode
+    {
+        transparent,
+        hugetlb
+    };
+
+    template <class T, huge_page_mode Mode = huge_page_mode::transparent>
+    class huge_page_allocator
+    {
+    public:
+        typedef T                      value_type;
+        typedef T*                     pointer;
+        typedef const T*               const_pointer;
+        typedef T&                     reference;
+        typedef const T&               const_reference;
+        typedef size_t                 size_type;
+        typedef ptrdiff_t              difference_type;
+
+        // 达到该字节数的申请才使用大页
+        static constexpr size_type huge_page_threshold = huge_page_size / 2;
+
+    public:
+        static T* allocate()              { return allocator<T>::allocate(); }
+        static T* allocate(size_type n);
+
+        static void deallocate(T* ptr)    { allocator<T>::deallocate(ptr); }
+        static void deallocate(T* ptr,size_type n);
+
+        // 大块内存的容量按大页取整，供 allocator_traits 使用
+        static size_type good_size(size_type n) noexcept;
+
+        static void construct(T* ptr)                     { ministl::construct(ptr); }
+        static void construct(T* ptr,const T& value)      { ministl::construct(ptr,value); }
+        static void construct(T* ptr,T &&value)           { ministl::construct(ptr,ministl::move(value)); }
+
+        template <class ...Args>
+        static void construct(T* ptr,Args&& ...args)      { ministl::construct(ptr,ministl::forward<Args>(args)...); }
+
+        static void destroy(T* ptr)                       { ministl::destroy(ptr); }
+        static void destroy(T* first,T* last)             { ministl::destroy(first,last); }
+
+    private:
+        static bool use_huge_page(size_type bytes) noexcept { return bytes >= huge_page_threshold; }
+    };
+
+    template <class T, huge_page_mode Mode>
+    constexpr typename huge_page_allocator<T, Mode>::size_type huge_page_allocator<T, Mode>::huge_page_threshold;
+
+    template <class T, huge_page_mode Mode>
+    T* huge_page_allocator<T, Mode>::allocate(size_type n)
+    {
+        if (n == 0)
+            return nullptr;
+        if (n > (static_cast<size_type>(-1) - huge_page_size) / sizeof(T))
+            throw std::bad_alloc();
+        const size_type bytes = n * sizeof(T);
+        if (!use_huge_page(bytes))
+            return allocator<T>::allocate(n);
+        const size_type mapped = round_up(bytes, huge_page_size);
+        if (Mode == huge_page_mode::hugetlb)
+        {
+            void* p = ministl::map_hugetlb_pages(mapped);
+            if (p != nullptr)
+                return static_cast<T*>(p);
+        }
+        void* p = ministl::map_pages(mapped, huge_page_size);
+        ministl::advise_huge_pages(p, mapped);
+        return static_cast<T*>(p);
+    }
+
+    template <class T, huge_page_mode Mode>
+    void huge_page_allocator<T, Mode>::deallocate(T* ptr, size_type n)
+    {
+        if (ptr == nullptr)
+            return;
+        const size_type bytes = n * sizeof(T);
+        if (!use_huge_page(bytes))
+            allocator<T>::deallocate(ptr, n);
+        else
+            ministl::unmap_pages(ptr, round_up(bytes, huge_page_size));
+    }
+
+    template <class T, huge_page_mode Mode>
+    typename huge_page_allocator<T, Mode>::size_type
+    huge_page_allocator<T, Mode>::good_size(size_type n) noexcept
+    {
+        if (n > (static_cast<size_type>(-1) - huge_page_size) / sizeof(T))
+            return n;
+        const size_type bytes = n * sizeof(T);
+        if (!use_huge_page(bytes))
+            return n;
+        return round_up(bytes, huge_page_size) / sizeof(T);
+    }
+}
+
+#endif //MINISTL_HUGE_PAGE_ALLOCATOR_H
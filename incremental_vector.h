@@ -0,0 +1,446 @@
+#ifndef MINISTL_INCREMENTAL_VECTOR_H
+#define MINISTL_INCREMENTAL_VECTOR_H
+
+// 这个头文件包含一个模板类 incremental_vector
+// incremental_vector : 渐进式扩容的向量
+
+// notes:
+// vector 扩容时会在一次 push_back 中把全部元素搬到新空间，单次操作的延迟与 size() 成正比。
+// incremental_vector 借鉴哈希表的渐进式 rehash：扩容时只申请新空间，新旧两块空间同时存在，
+// 之后的每次插入操作顺带搬迁固定数量(step)的旧元素，保证在新空间被填满之前完成搬迁。
+// 因此单次 push_back 的最坏延迟为 O(1)（不计内存分配本身的开销）。
+//
+// 代价：
+//   * 搬迁期间元素分布在两块空间中，operator[] 多一次可预测的分支，迭代器按下标实现
+//   * data() 需要连续空间，调用时会先一次性完成剩余的搬迁
+//   * 搬迁期间占用新旧两份内存
+//
+// 异常保证：
+//   每次只搬迁一个元素，构造失败时该元素仍留在旧空间，容器保持一致，
+//   push_back / emplace_back 满足强异常保证
+
+#include "vector.h"
+
+namespace ministl
+{
+    template <class T>
+    class incremental_vector;
+
+    // incremental_vector 的迭代器，以下标访问元素
+    template <class T, class Ref, class Ptr>
+    struct incremental_vector_iterator
+    {
+        typedef ministl::random_access_iterator_tag                 iterator_category;
+        typedef T                                                   value_type;
+        typedef Ptr                                                 pointer;
+        typedef Ref                                                 reference;
+        typedef ptrdiff_t                                           difference_type;
+        typedef size_t                                              size_type;
+        typedef incremental_vector_iterator<T, Ref, Ptr>            self;
+        typedef typename std::conditional<std::is_const<typename std::remove_reference<Ref>::type>::value,
+                const incremental_vector<T>, incremental_vector<T>>::type container_type;
+
+        container_type* con;
+        size_type       idx;
+
+        incremental_vector_iterator() noexcept : con(nullptr), idx(0) {}
+        incremental_vector_iterator(container_type* c, size_type i) noexcept : con(c), idx(i) {}
+
+        // 非 const 迭代器可以转换为 const 迭代器
+        template <class R, class P>
+        incremental_vector_iterator(const incremental_vector_iterator<T, R, P>& other) noexcept
+                : con(other.con), idx(other.idx) {}
+
+        reference operator*()  const { return (*con)[idx]; }
+        pointer   operator->() const { return &(operator*()); }
+        reference operator[](difference_type n) const { return (*con)[idx + n]; }
+
+        self& operator++()    { ++idx; return *this; }
+        self  operator++(int) { self tmp = *this; ++idx; return tmp; }
+        self& operator--()    { --idx; return *this; }
+        self  operator--(int) { self tmp = *this; --idx; return tmp; }
+
+        self& operator+=(difference_type n) { idx += n; return *this; }
+        self& operator-=(difference_type n) { idx -= n; return *this; }
+        self  operator+(difference_type n) const { return self(con, idx + n); }
+        self  operator-(difference_type n) const { return self(con, idx - n); }
+        difference_type operator-(const self& rhs) const
+        { return static_cast<difference_type>(idx) - static_cast<difference_type>(rhs.idx); }
+
+        bool operator==(const self& rhs) const { return idx == rhs.idx; }
+        bool operator!=(const self& rhs) const { return idx != rhs.idx; }
+        bool operator< (const self& rhs) const { return idx <  rhs.idx; }
+        bool operator> (const self& rhs) const { return idx >  rhs.idx; }
+        bool operator<=(const self& rhs) const { return idx <= rhs.idx; }
+        bool operator>=(const self& rhs) const { return idx >= rhs.idx; }
+    };
+
+    /*****************************************incremental_vector***************************************************/
+
+    template <class T>
+    class incremental_vector
+    {
+        static_assert(!std::is_same<bool ,T>::value,"bool in incremental_vector is abandoned in ministl");
+    public:
+        typedef typename ministl::allocator<T>                          allocator_type;
+        typedef typename ministl::allocator<T>                          data_allocator;
+
+        typedef typename allocator_type::value_type                     value_type;
+        typedef typename allocator_type::pointer                        pointer;
+        typedef typename allocator_type::const_pointer                  const_pointer;
+        typedef typename allocator_type::reference                      reference;
+        typedef typename allocator_type::const_reference                const_reference;
+        typedef typename allocator_type::size_type                      size_type;
+        typedef typename allocator_type::difference_type                difference_type;
+
+        typedef incremental_vector_iterator<T, T&, T*>                  iterator;
+        typedef incremental_vector_iterator<T, const T&, const T*>      const_iterator;
+        typedef ministl::reverse_iterator<iterator>                     reverse_iterator;
+        typedef ministl::reverse_iterator<const_iterator>               const_reverse_iterator;
+
+        allocator_type get_allocator() { return data_allocator();}
+
+    private:
+        pointer   begin_;       //新空间头部
+        pointer   end_;         //逻辑尾部，size() == end_ - begin_
+        pointer   cap_;         //新空间尾部
+
+        pointer   old_begin_;   //搬迁中的旧空间，不在搬迁时为 nullptr
+        size_type old_cap_;     //旧空间容量，用于释放
+        size_type migrated_;    //[0, migrated_) 已搬入新空间
+        size_type old_size_;    //[migrated_, old_size_) 仍在旧空间
+        size_type step_;        //每次插入操作搬迁的元素个数
+
+    public:
+        incremental_vector() noexcept
+                : begin_(nullptr), end_(nullptr), cap_(nullptr),
+                  old_begin_(nullptr), old_cap_(0), migrated_(0), old_size_(0), step_(0) {}
+
+        incremental_vector(size_type n, const value_type& value)
+                : incremental_vector()
+        {
+            reserve(n);
+            end_ = ministl::uninitialized_fill_n(begin_, n, value);
+        }
+
+        incremental_vector(std::initializer_list<value_type> list)
+                : incremental_vector()
+        {
+            reserve(list.size());
+            end_ = ministl::uninitialized_copy(list.begin(), list.end(), begin_);
+        }
+
+        incremental_vector(const incremental_vector& other)
+                : incremental_vector()
+        {
+            reserve(other.size());
+            for (size_type i = 0; i < other.size(); ++i, ++end_)
+                data_allocator::construct(end_, other[i]);
+        }
+
+        incremental_vector(incremental_vector&& other) noexcept
+                : incremental_vector()
+        {
+            swap(other);
+        }
+
+        incremental_vector& operator=(const incremental_vector& other)
+        {
+            if (this != &other)
+            {
+                incremental_vector tmp(other);
+                swap(tmp);
+            }
+            return *this;
+        }
+
+        incremental_vector& operator=(incremental_vector&& other) noexcept
+        {
+            incremental_vector tmp(ministl::move(other));
+            swap(tmp);
+            return *this;
+        }
+
+        ~incremental_vector()
+        {
+            release();
+        }
+
+    public:
+        /****************************************迭代器位置相关函数***************************************/
+        iterator       begin()        noexcept { return iterator(this, 0); }
+        const_iterator begin()  const noexcept { return const_iterator(this, 0); }
+        iterator       end()          noexcept { return iterator(this, size()); }
+        const_iterator end()    const noexcept { return const_iterator(this, size()); }
+        const_iterator cbegin() const noexcept { return begin(); }
+        const_iterator cend()   const noexcept { return end(); }
+
+        reverse_iterator       rbegin()       noexcept { return reverse_iterator(end()); }
+        const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+        reverse_iterator       rend()         noexcept { return reverse_iterator(begin()); }
+        const_reverse_iterator rend()   const noexcept { return const_reverse_iterator(begin()); }
+
+        //容量相关操作
+        bool      empty()    const noexcept { return begin_ == end_; }
+        size_type size()     const noexcept { return static_cast<size_type>(end_ - begin_); }
+        size_type capacity() const noexcept { return static_cast<size_type>(cap_ - begin_); }
+        size_type max_size() const noexcept { return std::numeric_limits<size_t>::max() / sizeof(T); }
+
+        // 是否有尚未完成的搬迁
+        bool      migrating() const noexcept { return old_begin_ != nullptr; }
+        // 剩余待搬迁的元素个数
+        size_type pending()   const noexcept { return old_size_ - migrated_; }
+
+        void reserve(size_type n);
+
+        //访问元素
+        reference operator[](size_type n)
+        {
+            MINISTL_DEBUG(n < size());
+            return *address(n);
+        }
+
+        const_reference operator[](size_type n) const
+        {
+            MINISTL_DEBUG(n < size());
+            return *address(n);
+        }
+
+        reference at(size_type n)
+        {
+            THROW_OUT_OF_RANGE_IF(n >= size(), "incremental_vector<T>::at() subscript out of range");
+            return (*this)[n];
+        }
+
+        const_reference at(size_type n) const
+        {
+            THROW_OUT_OF_RANGE_IF(n >= size(), "incremental_vector<T>::at() subscript out of range");
+            return (*this)[n];
+        }
+
+        reference       front()       { MINISTL_DEBUG(!empty()); return (*this)[0]; }
+        const_reference front() const { MINISTL_DEBUG(!empty()); return (*this)[0]; }
+        reference       back()        { MINISTL_DEBUG(!empty()); return *address(size() - 1); }
+        const_reference back()  const { MINISTL_DEBUG(!empty()); return *address(size() - 1); }
+
+        // 需要连续空间，会先完成剩余的搬迁
+        pointer data()
+        {
+            finish_migration();
+            return begin_;
+        }
+
+        //修改容器相关操作
+        template <class ...Args>
+        void emplace_back(Args&& ...args);
+
+        void push_back(const value_type& value)
+        { emplace_back(value); }
+        void push_back(value_type&& value)
+        { emplace_back(ministl::move(value)); }
+
+        void pop_back();
+        void clear() noexcept;
+
+        // 一次性完成剩余的搬迁并释放旧空间
+        void finish_migration();
+
+        void swap(incremental_vector& rhs) noexcept;
+
+    private:
+        // 搬迁期间，[migrated_, old_size_) 位于旧空间，其余位于新空间
+        pointer address(size_type n) const noexcept
+        {
+            return n - migrated_ < old_size_ - migrated_ ? old_begin_ + n : begin_ + n;
+        }
+
+        void start_growth();
+        void migrate(size_type count);
+        void release_old() noexcept;
+        void release() noexcept;
+    };
+
+    /***********************************************implementation********************************************************/
+
+    //预留空间会同步完成搬迁，适合在延迟不敏感的阶段调用
+    template <class T>
+    void incremental_vector<T>::reserve(size_type n)
+    {
+        if (capacity() >= n)
+            return;
+        THROW_LENGTH_ERROR_IF(n > max_size(), "n can not larger than max_size() in incremental_vector<T>::reserve(n)");
+        finish_migration();
+        const size_type old_size = size();
+        auto tmp = data_allocator::allocate(n);
+        try
+        {
+            ministl::uninitialized_move(begin_, end_, tmp);
+        }
+        catch (...)
+        {
+            data_allocator::deallocate(tmp, n);
+            throw;
+        }
+        data_allocator::destroy(begin_, end_);
+        data_allocator::deallocate(begin_, cap_ - begin_);
+        begin_ = tmp;
+        end_ = tmp + old_size;
+        cap_ = tmp + n;
+    }
+
+    // 在尾部就地构造元素，并顺带搬迁 step_ 个旧元素
+    // 先构造新元素再搬迁：参数可能引用尚在旧空间中的元素；搬迁失败时析构新元素，容器内容不变
+    template <class T>
+    template <class ...Args>
+    void incremental_vector<T>::emplace_back(Args&& ...args)
+    {
+        if (end_ == cap_)
+            start_growth();
+        data_allocator::construct(end_, ministl::forward<Args>(args)...);
+        ++end_;
+        if (old_begin_ != nullptr)
+        {
+            try
+            {
+                migrate(step_);
+            }
+            catch (...)
+            {
+                --end_;
+                data_allocator::destroy(end_);
+                throw;
+            }
+        }
+    }
+
+    template <class T>
+    void incremental_vector<T>::pop_back()
+    {
+        MINISTL_DEBUG(!empty());
+        const size_type idx = size() - 1;
+        data_allocator::destroy(address(idx));
+        --end_;
+        if (idx < old_size_)
+        {
+            //被删除的元素还在旧空间中，缩小待搬迁区间
+            old_size_ = idx;
+            if (migrated_ > old_size_)
+                migrated_ = old_size_;
+            if (migrated_ == old_size_)
+                release_old();
+        }
+    }
+
+    template <class T>
+    void incremental_vector<T>::clear() noexcept
+    {
+        if (old_begin_ != nullptr)
+        {
+            data_allocator::destroy(begin_, begin_ + migrated_);
+            data_allocator::destroy(old_begin_ + migrated_, old_begin_ + old_size_);
+            data_allocator::destroy(begin_ + old_size_, end_);
+            migrated_ = old_size_;
+            release_old();
+        }
+        else
+        {
+            data_allocator::destroy(begin_, end_);
+        }
+        end_ = begin_;
+    }
+
+    template <class T>
+    void incremental_vector<T>::finish_migration()
+    {
+        if (old_begin_ != nullptr)
+            migrate(old_size_ - migrated_);
+    }
+
+    template <class T>
+    void incremental_vector<T>::swap(incremental_vector& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            ministl::swap(begin_, rhs.begin_);
+            ministl::swap(end_, rhs.end_);
+            ministl::swap(cap_, rhs.cap_);
+            ministl::swap(old_begin_, rhs.old_begin_);
+            ministl::swap(old_cap_, rhs.old_cap_);
+            ministl::swap(migrated_, rhs.migrated_);
+            ministl::swap(old_size_, rhs.old_size_);
+            ministl::swap(step_, rhs.step_);
+        }
+    }
+
+    /*****************************************************************************************/
+    // helper function
+
+    // 申请新空间，但不搬迁任何元素
+    // 新空间剩余 free 个位置，每次插入搬迁 step_ 个元素，保证 free 次插入内搬迁完毕
+    template <class T>
+    void incremental_vector<T>::start_growth()
+    {
+        //上一轮搬迁理论上已完成，这里兜底
+        finish_migration();
+        const size_type old_size = size();
+        const size_type new_cap = ministl::growth_capacity(capacity(), static_cast<size_type>(1), max_size());
+        auto new_begin = data_allocator::allocate(new_cap);
+        if (old_size == 0)
+        {
+            data_allocator::deallocate(begin_, cap_ - begin_);
+        }
+        else
+        {
+            const size_type free = new_cap - old_size;
+            old_begin_ = begin_;
+            old_cap_ = capacity();
+            migrated_ = 0;
+            old_size_ = old_size;
+            step_ = (old_size + free - 1) / free;
+        }
+        begin_ = new_begin;
+        end_ = new_begin + old_size;
+        cap_ = new_begin + new_cap;
+    }
+
+    template <class T>
+    void incremental_vector<T>::migrate(size_type count)
+    {
+        const size_type last = ministl::min(migrated_ + count, old_size_);
+        for (; migrated_ != last; ++migrated_)
+        {
+            data_allocator::construct(begin_ + migrated_, ministl::move(old_begin_[migrated_]));
+            data_allocator::destroy(old_begin_ + migrated_);
+        }
+        if (migrated_ == old_size_)
+            release_old();
+    }
+
+    template <class T>
+    void incremental_vector<T>::release_old() noexcept
+    {
+        data_allocator::deallocate(old_begin_, old_cap_);
+        old_begin_ = nullptr;
+        old_cap_ = 0;
+        migrated_ = 0;
+        old_size_ = 0;
+        step_ = 0;
+    }
+
+    template <class T>
+    void incremental_vector<T>::release() noexcept
+    {
+        clear();
+        data_allocator::deallocate(begin_, cap_ - begin_);
+        begin_ = end_ = cap_ = nullptr;
+    }
+
+    // 重载 ministl 的 swap
+    template <class T>
+    void swap(incremental_vector<T>& lhs, incremental_vector<T>& rhs)
+    {
+        lhs.swap(rhs);
+    }
+}
+
+#endif //MINISTL_INCREMENTAL_VECTOR_H
@@ -29,8 +29,8 @@ namespace ministl
     {
     private:
         struct binary{char a;char b;};
-        template <class U> static binary Test(...){}
-        template <class U> static char Test(typename U::iterator_category *arg = 0){}
+        template <class U> static binary Test(...);
+        template <class U> static char Test(typename U::iterator_category *arg = 0);
     public:
         //单双元判断,sizeof在编译时期确定,typeid在runtime确定
         static const bool value = sizeof(Test<T>(0)) == sizeof(char);
@@ -45,10 +45,10 @@ namespace ministl
     struct iterator_traits_impl<Iterator,true>
     {
         typedef typename Iterator::iterator_category     iterator_category;
-        typedef typename Iterator::T                     value_type;
-        typedef typename Iterator::Pointer               pointer;
-        typedef typename Iterator::Reference             reference;
-        typedef typename Iterator::Distance              difference_type;
+        typedef typename Iterator::value_type            value_type;
+        typedef typename Iterator::pointer               pointer;
+        typedef typename Iterator::reference             reference;
+        typedef typename Iterator::difference_type       difference_type;
     };
 
     //特性萃取helper(泛化原型),带fill in 结构
@@ -222,7 +222,7 @@ namespace ministl
     public:
         reverse_iterator()= default;
         explicit reverse_iterator(iterator_type i): current(i){}
-        reverse_iterator(const self& other) : current(other.current){}
+        reverse_iterator(const self& other) = default;
 
     public:
         //取出正向迭代器
@@ -0,0 +1,98 @@
+#ifndef MINISTL_LOCKED_ALLOCATOR_H
+#define MINISTL_LOCKED_ALLOCATOR_H
+
+// This header contains a template class locked_allocator
+// 申请到的内存预先缺页并以 mlock 锁定在物理内存中，之后的访问既不缺页也不会被换出
+
+// notes:
+// 每次申请都单独向系统映射整页，锁定的范围正好是这次申请的页面，不与其他内存共享页面，
+// 释放时随 munmap 一起解除，不会误解其他缓冲区的锁定(mlock 不计次数)。
+// 小块申请同样占用整页，只适合延迟敏感路径上的大块缓冲区，如 vector<T, locked_allocator<T>>。
+// 锁定失败(超出 RLIMIT_MEMLOCK 等)时照常返回已预缺页但未锁定的内存，可用 lock_failures() 查询失败次数。
+// 非 Linux 平台下退化为 ::operator new，不锁定。
+// 与 allocator 一样以 static 函数提供接口，deallocate 必须传入申请时的 n
+
+#include <atomic>
+
+#include "allocator.h"
+#include "page_memory.h"
+
+namespace ministl
+{
+    template <class T>
+    class locked_allocator
+    {
+    public:
+        typedef T                      value_type;
+        typedef T*                     pointer;
+        typedef const T*               const_pointer;
+        typedef T&                     reference;
+        typedef const T&               const_reference;
+        typedef size_t                 size_type;
+        typedef ptrdiff_t              difference_type;
+
+    public:
+        static T* allocate()              { return allocate(1); }
+        static T* allocate(size_type n);
+
+        static void deallocate(T* ptr,size_type n);
+
+        // 容量按页取整，供 allocator_traits 使用
+        static size_type good_size(size_type n) noexcept;
+
+        // 累计 mlock 失败的次数
+        static size_t lock_failures() noexcept { return failures().load(std::memory_order_relaxed); }
+
+        static void construct(T* ptr)                     { ministl::construct(ptr); }
+        static void construct(T* ptr,const T& value)      { ministl::construct(ptr,value); }
+        static void construct(T* ptr,T &&value)           { ministl::construct(ptr,ministl::move(value)); }
+
+        template <class ...Args>
+        static void construct(T* ptr,Args&& ...args)      { ministl::construct(ptr,ministl::forward<Args>(args)...); }
+
+        static void destroy(T* ptr)                       { ministl::destroy(ptr); }
+        static void destroy(T* first,T* last)             { ministl::destroy(first,last); }
+
+    private:
+        static std::atomic<size_t>& failures() noexcept
+        {
+            static std::atomic<size_t> count(0);
+            return count;
+        }
+
+        static size_type mapped_bytes(size_type n) noexcept { return round_up(n * sizeof(T), page_size()); }
+    };
+
+    template <class T>
+    T* locked_allocator<T>::allocate(size_type n)
+    {
+        if (n == 0)
+            return nullptr;
+        if (n > (static_cast<size_type>(-1) - page_size()) / sizeof(T))
+            throw std::bad_alloc();
+        const size_type bytes = mapped_bytes(n);
+        void* p = ministl::map_pages(bytes);
+        if (!ministl::prefault_pages(p, bytes, ministl::prefault_lock))
+            failures().fetch_add(1, std::memory_order_relaxed);
+        return static_cast<T*>(p);
+    }
+
+    template <class T>
+    void locked_allocator<T>::deallocate(T* ptr, size_type n)
+    {
+        if (ptr == nullptr)
+            return;
+        // munmap 同时解除这段页面的锁定
+        ministl::unmap_pages(ptr, mapped_bytes(n));
+    }
+
+    template <class T>
+    typename locked_allocator<T>::size_type locked_allocator<T>::good_size(size_type n) noexcept
+    {
+        if (n == 0 || n > (static_cast<size_type>(-1) - page_size()) / sizeof(T))
+            return n;
+        return mapped_bytes(n) / sizeof(T);
+    }
+}
+
+#endif //MINISTL_LOCKED_ALLOCATOR_H
@@ -1,9 +1,57 @@
 #include <iostream>
 #include "test/t_vector.h"
+#include "test/t_incremental_vector.h"
+#include "test/t_huge_page_allocator.h"
+#include "test/t_aligned_allocator.h"
+#include "test/t_numa_allocator.h"
+#include "test/t_thread_pool.h"
+#include "test/t_parallel_algo.h"
+#include "test/t_parallel_vector.h"
+#include "test/t_sort.h"
+#include "test/t_parallel_sort.h"
+#include "test/t_partition.h"
+#include "test/t_flat_set.h"
+#include "test/t_flat_map.h"
+#include "test/t_flat_hash_map.h"
+#include "test/t_priority_queue.h"
+#include "test/t_soa_vector.h"
+#include "test/t_bit_vector.h"
+#include "test/t_packed_vector.h"
+#include "test/t_nullable_vector.h"
+#include "test/t_cow_vector.h"
+#include "test/t_persistent_vector.h"
+#include "test/t_rcu_vector.h"
+#include "test/t_concurrent_vector.h"
+#include "test/t_sharded_collector.h"
+#include "test/t_ring_buffer.h"
 using namespace std;
 
 int main()
 {
-    test();
+    vector_test();
+    incremental_vector_test();
+    huge_page_allocator_test();
+    aligned_allocator_test();
+    numa_allocator_test();
+    thread_pool_test();
+    parallel_algo_test();
+    parallel_vector_test();
+    sort_test();
+    parallel_sort_test();
+    partition_test();
+    flat_set_test();
+    flat_map_test();
+    flat_hash_map_test();
+    priority_queue_test();
+    soa_vector_test();
+    bit_vector_test();
+    packed_vector_test();
+    nullable_vector_test();
+    cow_vector_test();
+    persistent_vector_test();
+    rcu_vector_test();
+    concurrent_vector_test();
+    sharded_collector_test();
+    ring_buffer_test();
     return 0;
-}
\ No newline at end of file
+}
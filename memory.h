@@ -7,7 +7,7 @@
 
 #include <cstddef>
 #include <cstdlib>
-#include <climits>
+#include <cstdint>
 
 #include "algobase.h"
 #include "allocator.h"
@@ -24,23 +24,25 @@ namespace ministl
     }
 
     //获取与释放temp buffer
+    //申请大小只受地址空间限制(len * sizeof(T) 不溢出)，不再截断到 INT_MAX 字节，
+    //否则超过 2GB 的排序拿不到等长的缓冲区，只能退回较慢的路径
     template <class T>
-    pair<T,ptrdiff_t> get_buffer_helper(ptrdiff_t len,T*)
+    pair<T*,ptrdiff_t> get_buffer_helper(ptrdiff_t len,T*)
     {
-        if(len > static_cast<ptrdiff_t>(INT_MAX / sizeof(T)))
-            len = INT_MAX / sizeof(T);
+        if(len > static_cast<ptrdiff_t>(PTRDIFF_MAX / sizeof(T)))
+            len = PTRDIFF_MAX / sizeof(T);
         while(len > 0)
         {
             T* tmp = static_cast<T*>(malloc(static_cast<size_t>(len) * sizeof(T)));
             if(tmp)
-                return pair<T,ptrdiff_t >(tmp,len);
+                return pair<T*,ptrdiff_t >(tmp,len);
             len /= 2;   //申请失败大小减半
         }
-        return pair<T,ptrdiff_t>(nullptr,0);
+        return pair<T*,ptrdiff_t>(nullptr,0);
     }
 
     template <class T>
-    pair<T,ptrdiff_t> get_temporary_buffer(ptrdiff_t len)
+    pair<T*,ptrdiff_t> get_temporary_buffer(ptrdiff_t len)
     {
         return get_buffer_helper(len, static_cast<T*>(0));
     }
@@ -93,7 +95,8 @@ namespace ministl
 
     //constructor
     template <class ForwardIter,class T>
-    temporary_buffer<ForwardIter,T>::temporary_buffer(ForwardIter first, ForwardIter last) {
+    temporary_buffer<ForwardIter,T>::temporary_buffer(ForwardIter first, ForwardIter last)
+            : original_len(0), len(0), buffer(nullptr) {
         try {
             len = ministl::distance(first,last);
             allocate_buffer();
@@ -111,15 +114,9 @@ namespace ministl
     template <class ForwardIter,class T>
     void temporary_buffer<ForwardIter,T>::allocate_buffer() {
         original_len = len;
-        if(len > static_cast<ptrdiff_t>(INT_MAX / sizeof(T)))
-            len = INT_MAX / sizeof(T);
-        while (len > 0)
-        {
-            buffer = static_cast<T*>(malloc(len * sizeof(T)));
-            if (buffer)
-                break;
-            len /= 2;  // 申请失败时减少申请空间大小
-        }
+        pair<T*,ptrdiff_t> tmp = ministl::get_temporary_buffer<T>(len);
+        buffer = tmp.first;
+        len = tmp.second;
     }
 
     // --------------------------------------------------------------------------------------
@@ -0,0 +1,413 @@
+#ifndef MINISTL_NULLABLE_VECTOR_H
+#define MINISTL_NULLABLE_VECTOR_H
+
+// 这个头文件包含一个模板类 nullable_vector
+// nullable_vector : 可为空的列式向量，值连续存放，另用一个 bit_vector 记录每个元素是否有效(Arrow 风格)
+
+// notes:
+// 存储：
+//   values_ 连续存放全部元素(64 字节对齐)，validity_ 的第 i 位为 1 表示第 i 个元素有效。
+//   为 null 的槽位始终保存 T()，求和不需要看位图；相等比较可以直接比较两段存储。
+// 追加：
+//   push_back(value, valid) 用条件传送选择 value / T()，位图按位或入，没有依赖 valid 的分支；
+//   C++11 没有 std::optional，用 (value, valid) 与 get(i) 返回的指针(null 时为 nullptr)代替。
+// 归约与过滤：
+//   按位图的字分组，每组 64 个元素。整组为 null 直接跳过；整组有效时是连续的无分支循环，
+//   可被向量化；部分有效时 min / max 只遍历为 1 的位，filter 用位图屏蔽结果。
+//   sum / min_value / max_value / filter 在运行时按指令集选择 AVX-512 / AVX2 / 标量版本，
+//   三个版本是同一段代码在不同目标属性下的编译结果
+
+#include <cstdint>
+#include <initializer_list>
+#include <type_traits>
+
+#include "aligned_allocator.h"
+#include "bit_vector.h"
+#include "exception.h"
+#include "simd_partition.h"
+#include "span.h"
+#include "util.h"
+#include "vector.h"
+
+namespace ministl
+{
+    // 求和的累加类型：浮点数用 double，整数用 64 位
+    template <class T>
+    struct nullable_sum_type
+    {
+        typedef typename std::conditional<std::is_floating_point<T>::value, double,
+                typename std::conditional<std::is_signed<T>::value, int64_t, uint64_t>::type>::type type;
+    };
+
+    /*******************************************nullable kernels*******************************************/
+    template <class T, class Acc>
+    Acc scalar_nullable_sum(const T* values, const uint64_t* valid, size_t n) noexcept
+    {
+        Acc total = Acc();
+        for (size_t w = 0; w * 64 < n; ++w)
+        {
+            if (valid[w] == 0)
+                continue;
+            const T* p = values + w * 64;
+            const size_t m = n - w * 64 < 64 ? n - w * 64 : 64;
+            Acc s = Acc();
+            for (size_t j = 0; j < m; ++j)
+                s += static_cast<Acc>(p[j]);
+            total += s;
+        }
+        return total;
+    }
+
+    // better(a, b) 为 true 表示 a 比 b 更优，找不到有效元素时返回 false
+    template <class T, class Better>
+    bool scalar_nullable_extreme(const T* values, const uint64_t* valid, size_t n, T& out, Better better) noexcept
+    {
+        bool found = false;
+        T best = T();
+        for (size_t w = 0; w * 64 < n; ++w)
+        {
+            uint64_t bits = valid[w];
+            if (bits == 0)
+                continue;
+            const T* p = values + w * 64;
+            T local = p[bit_ctz64(bits)];
+            if (bits == ~uint64_t(0))
+            {
+                for (size_t j = 0; j < 64; ++j)
+                    local = better(p[j], local) ? p[j] : local;
+            }
+            else
+            {
+                for (; bits != 0; bits &= bits - 1)
+                {
+                    const T& v = p[bit_ctz64(bits)];
+                    local = better(v, local) ? v : local;
+                }
+            }
+            best = !found || better(local, best) ? local : best;
+            found = true;
+        }
+        out = best;
+        return found;
+    }
+
+    // out 的第 i 位 = validity 的第 i 位 && pred(values[i])
+    template <class T, class Pred>
+    void scalar_nullable_filter(const T* values, const uint64_t* valid, size_t n, Pred pred, uint64_t* out)
+    {
+        for (size_t w = 0; w * 64 < n; ++w)
+        {
+            const uint64_t bits = valid[w];
+            if (bits == 0)
+            {
+                out[w] = 0;
+                continue;
+            }
+            const T* p = values + w * 64;
+            const size_t m = n - w * 64 < 64 ? n - w * 64 : 64;
+            uint64_t r = 0;
+            for (size_t j = 0; j < m; ++j)
+                r |= static_cast<uint64_t>(pred(p[j]) ? 1 : 0) << j;
+            out[w] = r & bits;
+        }
+    }
+
+#if MINISTL_SIMD_X86
+    template <class T, class Acc>
+    MINISTL_FLATTEN_AVX2 Acc avx2_nullable_sum(const T* values, const uint64_t* valid, size_t n) noexcept
+    {
+        return ministl::scalar_nullable_sum<T, Acc>(values, valid, n);
+    }
+
+    template <class T, class Acc>
+    MINISTL_FLATTEN_AVX512 Acc avx512_nullable_sum(const T* values, const uint64_t* valid, size_t n) noexcept
+    {
+        return ministl::scalar_nullable_sum<T, Acc>(values, valid, n);
+    }
+
+    template <class T, class Better>
+    MINISTL_FLATTEN_AVX2 bool avx2_nullable_extreme(const T* values, const uint64_t* valid, size_t n, T& out,
+                                                    Better better) noexcept
+    {
+        return ministl::scalar_nullable_extreme(values, valid, n, out, better);
+    }
+
+    template <class T, class Better>
+    MINISTL_FLATTEN_AVX512 bool avx512_nullable_extreme(const T* values, const uint64_t* valid, size_t n, T& out,
+                                                        Better better) noexcept
+    {
+        return ministl::scalar_nullable_extreme(values, valid, n, out, better);
+    }
+
+    template <class T, class Pred>
+    MINISTL_FLATTEN_AVX2 void avx2_nullable_filter(const T* values, const uint64_t* valid, size_t n, Pred pred,
+                                                   uint64_t* out)
+    {
+        ministl::scalar_nullable_filter(values, valid, n, pred, out);
+    }
+
+    template <class T, class Pred>
+    MINISTL_FLATTEN_AVX512 void avx512_nullable_filter(const T* values, const uint64_t* valid, size_t n, Pred pred,
+                                                       uint64_t* out)
+    {
+        ministl::scalar_nullable_filter(values, valid, n, pred, out);
+    }
+#endif
+
+    template <class T, class Acc>
+    Acc nullable_sum(const T* values, const uint64_t* valid, size_t n) noexcept
+    {
+#if MINISTL_SIMD_X86
+        switch (active_simd_level())
+        {
+        case simd_level::avx512:
+            return ministl::avx512_nullable_sum<T, Acc>(values, valid, n);
+        case simd_level::avx2:
+            return ministl::avx2_nullable_sum<T, Acc>(values, valid, n);
+        default:
+            break;
+        }
+#endif
+        return ministl::scalar_nullable_sum<T, Acc>(values, valid, n);
+    }
+
+    template <class T, class Better>
+    bool nullable_extreme(const T* values, const uint64_t* valid, size_t n, T& out, Better better) noexcept
+    {
+#if MINISTL_SIMD_X86
+        switch (active_simd_level())
+        {
+        case simd_level::avx512:
+            return ministl::avx512_nullable_extreme(values, valid, n, out, better);
+        case simd_level::avx2:
+            return ministl::avx2_nullable_extreme(values, valid, n, out, better);
+        default:
+            break;
+        }
+#endif
+        return ministl::scalar_nullable_extreme(values, valid, n, out, better);
+    }
+
+    template <class T, class Pred>
+    void nullable_filter(const T* values, const uint64_t* valid, size_t n, Pred pred, uint64_t* out)
+    {
+#if MINISTL_SIMD_X86
+        switch (active_simd_level())
+        {
+        case simd_level::avx512:
+            return ministl::avx512_nullable_filter(values, valid, n, pred, out);
+        case simd_level::avx2:
+            return ministl::avx2_nullable_filter(values, valid, n, pred, out);
+        default:
+            break;
+        }
+#endif
+        ministl::scalar_nullable_filter(values, valid, n, pred, out);
+    }
+
+    /******************************************nullable_vector*********************************************/
+    template <class T>
+    class nullable_vector
+    {
+    public:
+        typedef T                                                   value_type;
+        typedef const T&                                            const_reference;
+        typedef size_t                                              size_type;
+        typedef typename nullable_sum_type<T>::type                 sum_type;
+        typedef ministl::vector<T, aligned_allocator<T, 64>>        values_type;
+
+    private:
+        values_type values_;     // null 的槽位保存 T()
+        bit_vector  validity_;
+
+    public:
+        nullable_vector() = default;
+
+        // n 个 null
+        explicit nullable_vector(size_type n) : values_(n, T()), validity_(n, false) {}
+
+        nullable_vector(std::initializer_list<T> list) : values_(list.begin(), list.end()), validity_(list.size(), true)
+        {
+        }
+
+    public:
+        // 容量相关操作
+        bool      empty()       const noexcept { return values_.empty(); }
+        size_type size()        const noexcept { return values_.size(); }
+        size_type valid_count() const noexcept { return validity_.count(); }
+        size_type null_count()  const noexcept { return size() - valid_count(); }
+
+        void reserve(size_type n)
+        {
+            values_.reserve(n);
+            validity_.reserve(n);
+        }
+
+        // 底层存储
+        span<const T>     values()   const noexcept { return span<const T>(values_.data(), values_.size()); }
+        const bit_vector& validity() const noexcept { return validity_; }
+
+        // 访问元素相关操作
+        bool is_valid(size_type n) const { return validity_[n]; }
+        bool is_null(size_type n)  const { return !validity_[n]; }
+
+        // 第 n 个槽位的值，null 时为 T()
+        const_reference operator[](size_type n) const
+        {
+            MINISTL_DEBUG(n < size());
+            return values_[n];
+        }
+
+        const_reference at(size_type n) const
+        {
+            THROW_OUT_OF_RANGE_IF(!(n < size()), "nullable_vector::at() subscript out of range");
+            THROW_RUNTIME_ERROR_IF(!validity_[n], "nullable_vector::at() element is null");
+            return values_[n];
+        }
+
+        // 有效时返回指向值的指针，null 时返回 nullptr
+        const T* get(size_type n) const
+        {
+            MINISTL_DEBUG(n < size());
+            return validity_[n] ? values_.data() + n : nullptr;
+        }
+
+        T value_or(size_type n, const T& other) const
+        {
+            MINISTL_DEBUG(n < size());
+            return validity_[n] ? values_[n] : other;
+        }
+
+        // 修改容器相关操作
+        void set(size_type n, const T& value)
+        {
+            values_[n] = value;
+            validity_.set(n);
+        }
+
+        void set_null(size_type n)
+        {
+            values_[n] = T();
+            validity_.reset(n);
+        }
+
+        void push_back(const T& value)
+        {
+            values_.push_back(value);
+            validity_.push_back(true);
+        }
+
+        // valid 为 false 时追加 null
+        void push_back(const T& value, bool valid)
+        {
+            values_.push_back(valid ? value : T());
+            validity_.push_back(valid);
+        }
+
+        void push_null()
+        {
+            values_.push_back(T());
+            validity_.push_back(false);
+        }
+
+        void pop_back()
+        {
+            MINISTL_DEBUG(!empty());
+            values_.pop_back();
+            validity_.pop_back();
+        }
+
+        // 批量追加 n 个有效值
+        void append(const T* values, size_type n)
+        {
+            reserve_more(n);
+            for (size_type i = 0; i < n; ++i)
+                values_.push_back(values[i]);
+            validity_.resize(validity_.size() + n, true);
+        }
+
+        // 批量追加 n 个值，valid[i] 为 false 的追加为 null
+        void append(const T* values, const bool* valid, size_type n)
+        {
+            reserve_more(n);
+            for (size_type i = 0; i < n; ++i)
+                push_back(values[i], valid[i]);
+        }
+
+        // 新增的元素为 null
+        void resize(size_type n)
+        {
+            values_.resize(n, T());
+            validity_.resize(n, false);
+        }
+
+        void clear()
+        {
+            values_.clear();
+            validity_.clear();
+        }
+
+        void swap(nullable_vector& rhs) noexcept
+        {
+            values_.swap(rhs.values_);
+            validity_.swap(rhs.validity_);
+        }
+
+        // 归约与过滤，跳过 null
+        sum_type sum() const noexcept
+        {
+            return ministl::nullable_sum<T, sum_type>(values_.data(), validity_.data(), size());
+        }
+
+        // 最小 / 最大的有效值，全部为 null 时返回 false
+        bool min_value(T& out) const noexcept
+        {
+            return ministl::nullable_extreme(values_.data(), validity_.data(), size(), out, ministl::less<T>());
+        }
+
+        bool max_value(T& out) const noexcept
+        {
+            return ministl::nullable_extreme(values_.data(), validity_.data(), size(), out, ministl::greater<T>());
+        }
+
+        // 有效且满足 pred 的元素组成的位图
+        template <class Pred>
+        bit_vector filter(Pred pred) const
+        {
+            bit_vector result(size());
+            ministl::nullable_filter(values_.data(), validity_.data(), size(), pred, result.data());
+            return result;
+        }
+
+        template <class Pred>
+        size_type count_if(Pred pred) const
+        {
+            return filter(pred).count();
+        }
+
+        bool equal(const nullable_vector& rhs) const
+        {
+            return validity_ == rhs.validity_ && values_ == rhs.values_;
+        }
+
+    private:
+        // 为 m 个新元素预留空间，容量不足时与 push_back 一样按 growth_capacity 增长
+        void reserve_more(size_type m)
+        {
+            const size_type n = size() + m;
+            if (values_.capacity() < n)
+                reserve(ministl::max(n, ministl::growth_capacity(values_.capacity(), m, values_.max_size())));
+        }
+    };
+
+    template <class T>
+    bool operator==(const nullable_vector<T>& lhs, const nullable_vector<T>& rhs) { return lhs.equal(rhs); }
+
+    template <class T>
+    bool operator!=(const nullable_vector<T>& lhs, const nullable_vector<T>& rhs) { return !lhs.equal(rhs); }
+
+    template <class T>
+    void swap(nullable_vector<T>& lhs, nullable_vector<T>& rhs) noexcept { lhs.swap(rhs); }
+}
+
+#endif //MINISTL_NULLABLE_VECTOR_H
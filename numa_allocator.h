@@ -0,0 +1,209 @@
+#ifndef MINISTL_NUMA_ALLOCATOR_H
+#define MINISTL_NUMA_ALLOCATOR_H
+
+// This header contains a template class numa_allocator
+// 按 NUMA 策略放置大块内存：本地节点、所有节点交织或绑定到指定节点
+
+// notes:
+// 直接通过 mbind / set_mempolicy / get_mempolicy 系统调用实现，不依赖 libnuma。
+// 大小不足 numa_threshold 的申请仍走 ::operator new；超过阈值的申请按页映射后调用 mbind：
+//   * numa_policy::local      : MPOL_LOCAL，页面落在首次访问它的线程所在的节点（first-touch）
+//   * numa_policy::interleave : MPOL_INTERLEAVE，页面轮流分布在当前进程允许的所有节点上
+//   * numa_policy::bind       : MPOL_BIND，页面只从 Node 节点分配
+// mbind 失败（如单节点机器上绑定不存在的节点、内核未开启 NUMA）时保持系统默认策略，分配照常成功。
+// 配合 vector(n, value, parallel_init)(见 parallel_uninitialized.h) 的并行 first-touch 初始化，可以让页面靠近之后使用它的线程。
+
+#include "allocator.h"
+#include "page_memory.h"
+
+#if defined(__linux__)
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace ministl
+{
+    enum class numa_policy
+    {
+        local,
+        interleave,
+        bind
+    };
+
+    // 节点掩码，最多支持 1024 个节点
+    struct numa_node_mask
+    {
+        static constexpr size_t max_nodes = 1024;
+        static constexpr size_t bits_per_word = sizeof(unsigned long) * 8;
+        unsigned long words[max_nodes / bits_per_word];
+
+        numa_node_mask() noexcept : words() {}
+
+        void set(size_t node) noexcept       { words[node / bits_per_word] |= 1ul << (node % bits_per_word); }
+        bool test(size_t node) const noexcept { return (words[node / bits_per_word] >> (node % bits_per_word)) & 1ul; }
+
+        size_t count() const noexcept
+        {
+            size_t n = 0;
+            for (auto w : words)
+                n += static_cast<size_t>(__builtin_popcountl(w));
+            return n;
+        }
+    };
+
+    // 当前进程允许使用的节点，无法获取时视为只有节点 0
+    inline numa_node_mask numa_allowed_nodes() noexcept
+    {
+        numa_node_mask mask;
+#if defined(__linux__) && defined(SYS_get_mempolicy)
+        const long ret = ::syscall(SYS_get_mempolicy, nullptr, mask.words, numa_node_mask::max_nodes,
+                                   nullptr, 4 /* MPOL_F_MEMS_ALLOWED */);
+        if (ret == 0 && mask.count() != 0)
+            return mask;
+#endif
+        mask = numa_node_mask();
+        mask.set(0);
+        return mask;
+    }
+
+    inline size_t numa_node_count() noexcept
+    {
+        static const size_t n = numa_allowed_nodes().count();
+        return n;
+    }
+
+    // 转换为 MPOL_* 模式与节点掩码
+    inline int numa_mode(numa_policy policy, int node, numa_node_mask& mask) noexcept
+    {
+        switch (policy)
+        {
+        case numa_policy::interleave:
+            mask = numa_allowed_nodes();
+            return 3;   // MPOL_INTERLEAVE
+        case numa_policy::bind:
+            mask = numa_node_mask();
+            if (node >= 0 && static_cast<size_t>(node) < numa_node_mask::max_nodes)
+                mask.set(static_cast<size_t>(node));
+            return 2;   // MPOL_BIND
+        default:
+            mask = numa_node_mask();
+            return 4;   // MPOL_LOCAL
+        }
+    }
+
+    // 为 [ptr, ptr + bytes) 设置放置策略，ptr 须按页对齐；返回是否成功
+    inline bool numa_bind_memory(void* ptr, size_t bytes, numa_policy policy, int node = 0) noexcept
+    {
+#if defined(__linux__) && defined(SYS_mbind)
+        numa_node_mask mask;
+        const int mode = numa_mode(policy, node, mask);
+        return ::syscall(SYS_mbind, ptr, bytes, mode, mask.words, numa_node_mask::max_nodes, 0) == 0;
+#else
+        (void)ptr;
+        (void)bytes;
+        (void)policy;
+        (void)node;
+        return false;
+#endif
+    }
+
+    // 设置调用线程之后申请内存的默认放置策略；返回是否成功
+    inline bool numa_set_thread_policy(numa_policy policy, int node = 0) noexcept
+    {
+#if defined(__linux__) && defined(SYS_set_mempolicy)
+        numa_node_mask mask;
+        const int mode = numa_mode(policy, node, mask);
+        return ::syscall(SYS_set_mempolicy, mode, mask.words, numa_node_mask::max_nodes) == 0;
+#else
+        (void)policy;
+        (void)node;
+        return false;
+#endif
+    }
+
+    /*****************************************numa_allocator***************************************************/
+
+    template <class T, numa_policy Policy = numa_policy::local, int Node = 0>
+    class numa_allocator
+    {
+    public:
+        typedef T                      value_type;
+        typedef T*                     pointer;
+        typedef const T*               const_pointer;
+        typedef T&                     reference;
+        typedef const T&               const_reference;
+        typedef size_t                 size_type;
+        typedef ptrdiff_t              difference_type;
+
+        // 达到该字节数的申请才单独映射并设置策略
+        static constexpr size_type numa_threshold = static_cast<size_type>(64) << 10;
+
+    public:
+        static T* allocate()              { return allocator<T>::allocate(); }
+        static T* allocate(size_type n);
+
+        static void deallocate(T* ptr)    { allocator<T>::deallocate(ptr); }
+        static void deallocate(T* ptr,size_type n);
+
+        // 策略以页为单位生效，大块内存的容量按页取整
+        static size_type good_size(size_type n) noexcept;
+
+        static void construct(T* ptr)                     { ministl::construct(ptr); }
+        static void construct(T* ptr,const T& value)      { ministl::construct(ptr,value); }
+        static void construct(T* ptr,T &&value)           { ministl::construct(ptr,ministl::move(value)); }
+
+        template <class ...Args>
+        static void construct(T* ptr,Args&& ...args)      { ministl::construct(ptr,ministl::forward<Args>(args)...); }
+
+        static void destroy(T* ptr)                       { ministl::destroy(ptr); }
+        static void destroy(T* first,T* last)             { ministl::destroy(first,last); }
+
+    private:
+        static bool use_numa(size_type bytes) noexcept { return bytes >= numa_threshold; }
+    };
+
+    template <class T, numa_policy Policy, int Node>
+    constexpr typename numa_allocator<T, Policy, Node>::size_type numa_allocator<T, Policy, Node>::numa_threshold;
+
+    template <class T, numa_policy Policy, int Node>
+    T* numa_allocator<T, Policy, Node>::allocate(size_type n)
+    {
+        if (n == 0)
+            return nullptr;
+        if (n > (static_cast<size_type>(-1) - ministl::page_size()) / sizeof(T))
+            throw std::bad_alloc();
+        const size_type bytes = n * sizeof(T);
+        if (!use_numa(bytes))
+            return allocator<T>::allocate(n);
+        const size_type mapped = round_up(bytes, ministl::page_size());
+        void* p = ministl::map_pages(mapped);
+        ministl::numa_bind_memory(p, mapped, Policy, Node);
+        return static_cast<T*>(p);
+    }
+
+    template <class T, numa_policy Policy, int Node>
+    void numa_allocator<T, Policy, Node>::deallocate(T* ptr, size_type n)
+    {
+        if (ptr == nullptr)
+            return;
+        const size_type bytes = n * sizeof(T);
+        if (!use_numa(bytes))
+            allocator<T>::deallocate(ptr, n);
+        else
+            ministl::unmap_pages(ptr, round_up(bytes, ministl::page_size()));
+    }
+
+    template <class T, numa_policy Policy, int Node>
+    typename numa_allocator<T, Policy, Node>::size_type
+    numa_allocator<T, Policy, Node>::good_size(size_type n) noexcept
+    {
+        if (n > (static_cast<size_type>(-1) - ministl::page_size()) / sizeof(T))
+            return n;
+        const size_type bytes = n * sizeof(T);
+        if (!use_numa(bytes))
+            return n;
+        return round_up(bytes, ministl::page_size()) / sizeof(T);
+    }
+}
+
+#endif //MINISTL_NUMA_ALLOCATOR_H
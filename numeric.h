@@ -0,0 +1,72 @@
+#ifndef MINISTL_NUMERIC_H
+#define MINISTL_NUMERIC_H
+
+// 这个头文件包含了 ministl 的数值算法
+
+#include "functional.h"
+#include "iterator.h"
+#include "util.h"
+
+namespace ministl
+{
+    /**************************************************reduce***********************************************/
+    /***********************以 binary_op 归约[first, last)与 init，op 须满足结合律与交换律************************/
+    /*******************************************************************************************************/
+    template <class InputIter, class T, class BinaryOp>
+    T reduce(InputIter first, InputIter last, T init, BinaryOp binary_op)
+    {
+        for (; first != last; ++first)
+        {
+            init = binary_op(ministl::move(init), *first);
+        }
+        return init;
+    }
+
+    template <class InputIter, class T>
+    T reduce(InputIter first, InputIter last, T init)
+    {
+        return ministl::reduce(first, last, init, ministl::plus<T>());
+    }
+
+    template <class InputIter>
+    typename iterator_traits<InputIter>::value_type
+    reduce(InputIter first, InputIter last)
+    {
+        typedef typename iterator_traits<InputIter>::value_type value_type;
+        return ministl::reduce(first, last, value_type(), ministl::plus<value_type>());
+    }
+
+    /**********************************************transform_reduce*****************************************/
+    /*****************第一个版本对每个元素先做 unary_op 变换再以 reduce_op 归约*************************************/
+    /*****************第二个版本对两个序列逐对做 transform_op（默认相乘，即内积），再以 reduce_op 归约****************/
+    /*******************************************************************************************************/
+    template <class InputIter, class T, class BinaryOp, class UnaryOp>
+    T transform_reduce(InputIter first, InputIter last, T init, BinaryOp reduce_op, UnaryOp unary_op)
+    {
+        for (; first != last; ++first)
+        {
+            init = reduce_op(ministl::move(init), unary_op(*first));
+        }
+        return init;
+    }
+
+    template <class InputIter1, class InputIter2, class T, class BinaryOp1, class BinaryOp2>
+    T transform_reduce(InputIter1 first1, InputIter1 last1, InputIter2 first2, T init,
+                       BinaryOp1 reduce_op, BinaryOp2 transform_op)
+    {
+        for (; first1 != last1; ++first1, ++first2)
+        {
+            init = reduce_op(ministl::move(init), transform_op(*first1, *first2));
+        }
+        return init;
+    }
+
+    template <class InputIter1, class InputIter2, class T>
+    T transform_reduce(InputIter1 first1, InputIter1 last1, InputIter2 first2, T init)
+    {
+        return ministl::transform_reduce(first1, last1, first2, init,
+                                         ministl::plus<T>(), ministl::multiplies<T>());
+    }
+}
+
+#endif //MINISTL_NUMERIC_H
@@ -0,0 +1,609 @@
+#ifndef MINISTL_PACKED_VECTOR_H
+#define MINISTL_PACKED_VECTOR_H
+
+// 这个头文件包含两个类 packed_vector, for_vector
+// packed_vector<Bits> : 定长位压缩的整数向量，每个元素占 Bits 位
+// for_vector          : frame-of-reference 压缩的整数向量，每 128 个元素一块，块内按“减去块内最小值”后的位宽压缩
+
+// notes:
+// 存储：
+//   元素紧密排列在 64 位的字中，第 i 个元素占位 [i * Bits, (i + 1) * Bits)，可以跨越两个字。
+//   末尾始终多留一个全 0 的字，位宽不超过 57 时读写都是一次非对齐的 8 字节访问加移位，没有分支；
+//   更宽的元素拆成两个字处理。位序按小端(x86)排列。size() 之后的位始终为 0。
+// 批量解码：
+//   decode 在运行时按指令集选择 AVX-512 / AVX2 的 gather + 可变移位版本，每次解出 8 / 4 个元素，或者标量版本；
+//   位宽超过 57 时使用标量版本。
+// for_vector：
+//   追加的元素先放在未压缩的尾块中，满 128 个后编码为一块：记录块内最小值 base 与位宽 w，
+//   块内保存 value - base，恰好占 2 * w 个字。对递增序列(时间戳、行号、排序后的键)而言，
+//   这就是相对于块首元素的差值编码，同时保留 O(1) 的随机访问；lower_bound 要求序列递增
+
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+
+#include "algo.h"
+#include "aligned_allocator.h"
+#include "exception.h"
+#include "iterator.h"
+#include "simd_partition.h"
+#include "util.h"
+#include "vector.h"
+
+namespace ministl
+{
+    /*******************************************packed helpers*********************************************/
+    inline uint64_t packed_mask(unsigned bits) noexcept
+    {
+        return bits >= 64 ? ~uint64_t(0) : (uint64_t(1) << bits) - 1;
+    }
+
+    // 存放 n 个 bits 位的元素需要的字数(不含末尾的填充字)
+    inline size_t packed_words(size_t n, unsigned bits) noexcept
+    {
+        return (n * bits + 63) / 64;
+    }
+
+    // 读出从第 bit 位开始的 bits 位，words 末尾需有一个填充字
+    inline uint64_t packed_load(const uint64_t* words, size_t bit, unsigned bits) noexcept
+    {
+        if (bits <= 57)
+        {
+            uint64_t w;
+            std::memcpy(&w, reinterpret_cast<const unsigned char*>(words) + bit / 8, sizeof(w));
+            return (w >> (bit % 8)) & packed_mask(bits);
+        }
+        const size_t idx = bit / 64;
+        const unsigned off = static_cast<unsigned>(bit % 64);
+        uint64_t v = words[idx] >> off;
+        if (off + bits > 64)
+            v |= words[idx + 1] << (64 - off);
+        return v & packed_mask(bits);
+    }
+
+    // 把 v 写入从第 bit 位开始的 bits 位，v 不能超过 bits 位
+    inline void packed_store(uint64_t* words, size_t bit, unsigned bits, uint64_t v) noexcept
+    {
+        const uint64_t mask = packed_mask(bits);
+        if (bits <= 57)
+        {
+            unsigned char* p = reinterpret_cast<unsigned char*>(words) + bit / 8;
+            const unsigned shift = static_cast<unsigned>(bit % 8);
+            uint64_t w;
+            std::memcpy(&w, p, sizeof(w));
+            w = (w & ~(mask << shift)) | (v << shift);
+            std::memcpy(p, &w, sizeof(w));
+            return;
+        }
+        const size_t idx = bit / 64;
+        const unsigned off = static_cast<unsigned>(bit % 64);
+        words[idx] = (words[idx] & ~(mask << off)) | (v << off);
+        if (off + bits > 64)
+            words[idx + 1] = (words[idx + 1] & ~(mask >> (64 - off))) | (v >> (64 - off));
+    }
+
+    // 把 in[0, n) - base 依次写入从第 bit 位开始的全 0 区域。
+    // 在寄存器里攒满一个字再写出，避免相邻元素的非对齐读改写互相阻塞 store forwarding
+    template <class Iter>
+    void packed_encode(uint64_t* words, size_t bit, unsigned bits, Iter in, size_t n, uint64_t base)
+    {
+        if (bits == 0 || n == 0)
+            return;
+        size_t idx = bit / 64;
+        unsigned fill = static_cast<unsigned>(bit % 64);
+        uint64_t acc = words[idx];
+        for (size_t i = 0; i < n; ++i, ++in)
+        {
+            const uint64_t v = static_cast<uint64_t>(*in) - base;
+            acc |= v << fill;
+            fill += bits;
+            if (fill >= 64)
+            {
+                words[idx++] = acc;
+                fill -= 64;
+                acc = fill == 0 ? 0 : v >> (bits - fill);
+            }
+        }
+        words[idx] = acc;
+    }
+
+    /*******************************************decode kernels*********************************************/
+    // out[i] = base + 第 i 个元素，元素从第 bit 位开始、每个 bits 位
+    inline void scalar_packed_decode(const uint64_t* words, size_t bit, unsigned bits, size_t n, uint64_t base,
+                                     uint64_t* out) noexcept
+    {
+        if (bits <= 57)
+        {
+            const unsigned char* bytes = reinterpret_cast<const unsigned char*>(words);
+            const uint64_t mask = packed_mask(bits);
+            for (size_t i = 0; i < n; ++i, bit += bits)
+            {
+                uint64_t w;
+                std::memcpy(&w, bytes + bit / 8, sizeof(w));
+                out[i] = base + ((w >> (bit % 8)) & mask);
+            }
+            return;
+        }
+        for (size_t i = 0; i < n; ++i, bit += bits)
+            out[i] = base + ministl::packed_load(words, bit, bits);
+    }
+
+#if MINISTL_SIMD_X86
+    // 每个通道按自己的位偏移 gather 8 字节，再按偏移的低 3 位右移、屏蔽
+    MINISTL_TARGET_AVX2 inline void avx2_packed_decode(const uint64_t* words, size_t bit, unsigned bits, size_t n,
+                                                       uint64_t base, uint64_t* out) noexcept
+    {
+        const long long* bytes = reinterpret_cast<const long long*>(words);
+        const long long b = static_cast<long long>(bit);
+        const long long s = static_cast<long long>(bits);
+        __m256i pos = _mm256_setr_epi64x(b, b + s, b + 2 * s, b + 3 * s);
+        const __m256i step = _mm256_set1_epi64x(4 * s);
+        const __m256i low3 = _mm256_set1_epi64x(7);
+        const __m256i mask = _mm256_set1_epi64x(static_cast<long long>(packed_mask(bits)));
+        const __m256i vbase = _mm256_set1_epi64x(static_cast<long long>(base));
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4)
+        {
+            __m256i v = _mm256_i64gather_epi64(bytes, _mm256_srli_epi64(pos, 3), 1);
+            v = _mm256_and_si256(_mm256_srlv_epi64(v, _mm256_and_si256(pos, low3)), mask);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_add_epi64(v, vbase));
+            pos = _mm256_add_epi64(pos, step);
+        }
+        ministl::scalar_packed_decode(words, bit + i * bits, bits, n - i, base, out + i);
+    }
+
+    MINISTL_TARGET_AVX512 inline void avx512_packed_decode(const uint64_t* words, size_t bit, unsigned bits,
+                                                           size_t n, uint64_t base, uint64_t* out) noexcept
+    {
+        const long long b = static_cast<long long>(bit);
+        const long long s = static_cast<long long>(bits);
+        __m512i pos = _mm512_setr_epi64(b, b + s, b + 2 * s, b + 3 * s, b + 4 * s, b + 5 * s, b + 6 * s, b + 7 * s);
+        const __m512i step = _mm512_set1_epi64(8 * s);
+        const __m512i low3 = _mm512_set1_epi64(7);
+        const __m512i mask = _mm512_set1_epi64(static_cast<long long>(packed_mask(bits)));
+        const __m512i vbase = _mm512_set1_epi64(static_cast<long long>(base));
+        const __mmask8 all = 0xFF;
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8)
+        {
+            // 全 1 掩码的 maskz / mask 形式与不带掩码的指令相同，但不经过 GCC 12 中未初始化的占位向量
+            __m512i v = _mm512_mask_i64gather_epi64(_mm512_setzero_si512(), all,
+                                                    _mm512_maskz_srli_epi64(all, pos, 3), words, 1);
+            v = _mm512_and_si512(_mm512_maskz_srlv_epi64(all, v, _mm512_and_si512(pos, low3)), mask);
+            _mm512_storeu_si512(out + i, _mm512_add_epi64(v, vbase));
+            pos = _mm512_add_epi64(pos, step);
+        }
+        ministl::scalar_packed_decode(words, bit + i * bits, bits, n - i, base, out + i);
+    }
+#endif
+
+    inline void packed_decode(const uint64_t* words, size_t bit, unsigned bits, size_t n, uint64_t base,
+                              uint64_t* out) noexcept
+    {
+#if MINISTL_SIMD_X86
+        if (bits <= 57)
+        {
+            switch (active_simd_level())
+            {
+            case simd_level::avx512:
+                return ministl::avx512_packed_decode(words, bit, bits, n, base, out);
+            case simd_level::avx2:
+                return ministl::avx2_packed_decode(words, bit, bits, n, base, out);
+            default:
+                break;
+            }
+        }
+#endif
+        ministl::scalar_packed_decode(words, bit, bits, n, base, out);
+    }
+
+    /********************************************packed_vector*********************************************/
+    template <unsigned Bits>
+    class packed_vector
+    {
+        static_assert(Bits >= 1 && Bits <= 64, "packed_vector requires 1 <= Bits <= 64");
+
+    public:
+        typedef uint64_t                                            value_type;
+        typedef uint64_t                                            word_type;
+        typedef size_t                                              size_type;
+        typedef ministl::vector<word_type, aligned_allocator<word_type, 64>> storage_type;
+
+        static constexpr unsigned   bits = Bits;
+        static constexpr value_type max_value = Bits == 64 ? ~uint64_t(0) : (uint64_t(1) << (Bits % 64)) - 1;
+
+    private:
+        storage_type words_;   // 末尾多一个全 0 的填充字
+        size_type    size_;
+
+    public:
+        packed_vector() : words_(1, 0), size_(0) {}
+
+        explicit packed_vector(size_type n, value_type value = 0) : words_(packed_words(n, Bits) + 1, 0), size_(0)
+        {
+            check_value(value);
+            if (value != 0)
+            {
+                for (size_type i = 0; i < n; ++i)
+                    ministl::packed_store(words_.data(), i * Bits, Bits, value);
+            }
+            size_ = n;
+        }
+
+        packed_vector(std::initializer_list<value_type> list) : packed_vector()
+        {
+            append(list.begin(), list.end());
+        }
+
+        template <class Iter, typename std::enable_if<ministl::is_input_iterator<Iter>::value, int>::type = 0>
+        packed_vector(Iter first, Iter last) : packed_vector()
+        {
+            append(first, last);
+        }
+
+        packed_vector(const packed_vector&) = default;
+        packed_vector& operator=(const packed_vector&) = default;
+
+        packed_vector(packed_vector&& rhs) noexcept : words_(ministl::move(rhs.words_)), size_(rhs.size_)
+        {
+            rhs.words_ = storage_type(1, 0);
+            rhs.size_ = 0;
+        }
+
+        packed_vector& operator=(packed_vector&& rhs) noexcept
+        {
+            if (this != &rhs)
+            {
+                words_ = ministl::move(rhs.words_);
+                size_ = rhs.size_;
+                rhs.words_ = storage_type(1, 0);
+                rhs.size_ = 0;
+            }
+            return *this;
+        }
+
+    public:
+        // 容量相关操作
+        bool      empty()    const noexcept { return size_ == 0; }
+        size_type size()     const noexcept { return size_; }
+        size_type capacity() const noexcept { return (words_.capacity() - 1) * 64 / Bits; }
+        size_type size_in_bytes() const noexcept { return words_.size() * sizeof(word_type); }
+
+        void reserve(size_type n) { words_.reserve(packed_words(n, Bits) + 1); }
+
+        const word_type* data() const noexcept { return words_.data(); }
+
+        // 访问元素相关操作
+        value_type operator[](size_type n) const
+        {
+            MINISTL_DEBUG(n < size_);
+            return ministl::packed_load(words_.data(), n * Bits, Bits);
+        }
+
+        value_type at(size_type n) const
+        {
+            THROW_OUT_OF_RANGE_IF(!(n < size_), "packed_vector::at() subscript out of range");
+            return (*this)[n];
+        }
+
+        value_type front() const { return (*this)[0]; }
+        value_type back()  const { return (*this)[size_ - 1]; }
+
+        void set(size_type n, value_type value)
+        {
+            MINISTL_DEBUG(n < size_);
+            check_value(value);
+            ministl::packed_store(words_.data(), n * Bits, Bits, value);
+        }
+
+        // 修改容器相关操作
+        void push_back(value_type value)
+        {
+            check_value(value);
+            grow_to(size_ + 1);
+            ministl::packed_store(words_.data(), size_ * Bits, Bits, value);
+            ++size_;
+        }
+
+        void pop_back()
+        {
+            MINISTL_DEBUG(!empty());
+            --size_;
+            ministl::packed_store(words_.data(), size_ * Bits, Bits, 0);
+        }
+
+        // 追加编码：前向迭代器先检查全部值，再一次扩容、逐个写入
+        template <class Iter>
+        void append(Iter first, Iter last)
+        {
+            append_aux(first, last, iterator_category(first));
+        }
+
+        void resize(size_type n, value_type value = 0)
+        {
+            check_value(value);
+            if (n < size_)
+            {
+                clear_from(n);
+                size_ = n;
+                return;
+            }
+            grow_to(n);
+            if (value != 0)
+            {
+                for (size_type i = size_; i < n; ++i)
+                    ministl::packed_store(words_.data(), i * Bits, Bits, value);
+            }
+            size_ = n;
+        }
+
+        void clear()
+        {
+            clear_from(0);
+            size_ = 0;
+        }
+
+        void swap(packed_vector& rhs) noexcept
+        {
+            words_.swap(rhs.words_);
+            ministl::swap(size_, rhs.size_);
+        }
+
+        // 批量解码 [first, first + n) 到 out
+        void decode(size_type first, size_type n, value_type* out) const
+        {
+            THROW_OUT_OF_RANGE_IF(first > size_ || n > size_ - first, "packed_vector::decode() out of range");
+            ministl::packed_decode(words_.data(), first * Bits, Bits, n, 0, out);
+        }
+
+        // 批量解码全部元素到 out，out 的大小被调整为 size()
+        template <class Alloc>
+        void decode(ministl::vector<value_type, Alloc>& out) const
+        {
+            out.resize(size_);
+            decode(0, size_, out.data());
+        }
+
+        bool equal(const packed_vector& rhs) const noexcept
+        {
+            return size_ == rhs.size_ &&
+                   std::memcmp(words_.data(), rhs.words_.data(), packed_words(size_, Bits) * sizeof(word_type)) == 0;
+        }
+
+    private:
+        static void check_value(value_type value)
+        {
+            THROW_OUT_OF_RANGE_IF(value > max_value, "packed_vector value does not fit in Bits");
+        }
+
+        template <class Iter>
+        void append_aux(Iter first, Iter last, input_iterator_tag)
+        {
+            for (; first != last; ++first)
+                push_back(static_cast<value_type>(*first));
+        }
+
+        template <class Iter>
+        void append_aux(Iter first, Iter last, forward_iterator_tag)
+        {
+            size_type n = 0;
+            for (Iter it = first; it != last; ++it, ++n)
+                check_value(static_cast<value_type>(*it));
+            grow_to(size_ + n);
+            ministl::packed_encode(words_.data(), size_ * Bits, Bits, first, n, 0);
+            size_ += n;
+        }
+
+        // 保证能容纳 n 个元素，并保留末尾的填充字
+        void grow_to(size_type n)
+        {
+            const size_type need = packed_words(n, Bits) + 1;
+            if (need > words_.size())
+                words_.resize(need, 0);
+        }
+
+        // 把第 n 个元素起的所有位清零，维持 size() 之后全 0
+        void clear_from(size_type n) noexcept
+        {
+            const size_type bit = n * Bits;
+            const size_type idx = bit / 64;
+            if (bit % 64 != 0)
+                words_[idx] &= (word_type(1) << (bit % 64)) - 1;
+            else
+                words_[idx] = 0;
+            for (size_type i = idx + 1; i < words_.size(); ++i)
+                words_[i] = 0;
+        }
+    };
+
+    template <unsigned Bits>
+    constexpr typename packed_vector<Bits>::value_type packed_vector<Bits>::max_value;
+
+    template <unsigned Bits>
+    bool operator==(const packed_vector<Bits>& lhs, const packed_vector<Bits>& rhs) { return lhs.equal(rhs); }
+
+    template <unsigned Bits>
+    bool operator!=(const packed_vector<Bits>& lhs, const packed_vector<Bits>& rhs) { return !lhs.equal(rhs); }
+
+    template <unsigned Bits>
+    void swap(packed_vector<Bits>& lhs, packed_vector<Bits>& rhs) noexcept { lhs.swap(rhs); }
+
+    /**********************************************for_vector**********************************************/
+    class for_vector
+    {
+    public:
+        typedef uint64_t value_type;
+        typedef uint64_t word_type;
+        typedef size_t   size_type;
+        typedef ministl::vector<word_type, aligned_allocator<word_type, 64>> storage_type;
+
+        static constexpr size_type block_size = 128;
+        static constexpr size_type npos = static_cast<size_type>(-1);
+
+    private:
+        storage_type                words_;     // 所有已编码的块，末尾多一个全 0 的填充字
+        ministl::vector<value_type> bases_;     // 每块的最小值
+        ministl::vector<size_type>  offsets_;   // 每块在 words_ 中的起始字
+        ministl::vector<uint8_t>    widths_;    // 每块的位宽
+        value_type                  tail_[block_size];   // 尚未编码的尾块
+        size_type                   tail_size_;
+
+    public:
+        for_vector() : words_(1, 0), tail_size_(0) {}
+
+        for_vector(std::initializer_list<value_type> list) : for_vector()
+        {
+            append(list.begin(), list.end());
+        }
+
+        template <class Iter, typename std::enable_if<ministl::is_input_iterator<Iter>::value, int>::type = 0>
+        for_vector(Iter first, Iter last) : for_vector()
+        {
+            append(first, last);
+        }
+
+    public:
+        // 容量相关操作
+        bool      empty()       const noexcept { return size() == 0; }
+        size_type size()        const noexcept { return bases_.size() * block_size + tail_size_; }
+        size_type block_count() const noexcept { return bases_.size(); }
+
+        // 已编码部分与块元数据占用的字节数，不含未编码的尾块
+        size_type size_in_bytes() const noexcept
+        {
+            return words_.size() * sizeof(word_type) + bases_.size() * sizeof(value_type) +
+                   offsets_.size() * sizeof(size_type) + widths_.size() * sizeof(uint8_t);
+        }
+
+        // 访问元素相关操作
+        value_type operator[](size_type n) const
+        {
+            MINISTL_DEBUG(n < size());
+            const size_type b = n / block_size;
+            if (b == bases_.size())
+                return tail_[n % block_size];
+            return bases_[b] + ministl::packed_load(words_.data() + offsets_[b], (n % block_size) * widths_[b],
+                                                    widths_[b]);
+        }
+
+        value_type at(size_type n) const
+        {
+            THROW_OUT_OF_RANGE_IF(!(n < size()), "for_vector::at() subscript out of range");
+            return (*this)[n];
+        }
+
+        value_type front() const { return (*this)[0]; }
+        value_type back()  const { return (*this)[size() - 1]; }
+
+        // 流式追加：写入尾块，满一块时编码
+        void push_back(value_type value)
+        {
+            tail_[tail_size_++] = value;
+            if (tail_size_ == block_size)
+                flush_block();
+        }
+
+        template <class Iter>
+        void append(Iter first, Iter last)
+        {
+            for (; first != last; ++first)
+                push_back(static_cast<value_type>(*first));
+        }
+
+        void clear()
+        {
+            words_.assign(1, 0);
+            bases_.clear();
+            offsets_.clear();
+            widths_.clear();
+            tail_size_ = 0;
+        }
+
+        // 批量解码 [first, first + n) 到 out
+        void decode(size_type first, size_type n, value_type* out) const
+        {
+            THROW_OUT_OF_RANGE_IF(first > size() || n > size() - first, "for_vector::decode() out of range");
+            while (n != 0)
+            {
+                const size_type b = first / block_size;
+                const size_type in_block = first % block_size;
+                const size_type count = ministl::min(n, block_size - in_block);
+                if (b == bases_.size())
+                    std::memcpy(out, tail_ + in_block, count * sizeof(value_type));
+                else
+                    ministl::packed_decode(words_.data() + offsets_[b], in_block * widths_[b], widths_[b], count,
+                                           bases_[b], out);
+                first += count;
+                out += count;
+                n -= count;
+            }
+        }
+
+        template <class Alloc>
+        void decode(ministl::vector<value_type, Alloc>& out) const
+        {
+            out.resize(size());
+            decode(0, size(), out.data());
+        }
+
+        // 第一个不小于 value 的元素的下标，要求序列递增；不存在时返回 size()
+        size_type lower_bound(value_type value) const
+        {
+            // 最后一个 base < value 的块之前的元素都小于 value
+            const value_type* bases = bases_.data();
+            const size_type lo = static_cast<size_type>(
+                    ministl::branchless_lower_bound(bases, bases + bases_.size(), value) - bases);
+            if (lo == bases_.size() && tail_size_ != 0 && (lo == 0 || tail_[0] < value))
+            {
+                // 答案在未编码的尾块中
+                size_type i = 0;
+                while (i < tail_size_ && tail_[i] < value)
+                    ++i;
+                return lo * block_size + i;
+            }
+            if (lo == 0)
+                return 0;
+            // 答案在块 lo - 1 中或恰为块 lo 的首元素，块内比较 value - base 即可
+            const size_type b = lo - 1;
+            const uint64_t* words = words_.data() + offsets_[b];
+            const unsigned width = widths_[b];
+            const value_type delta = value - bases_[b];
+            size_type first = 0;
+            for (size_type len = block_size; len > 1; len -= len / 2)
+            {
+                const size_type mid = first + len / 2;
+                first = ministl::packed_load(words, mid * width, width) < delta ? mid : first;
+            }
+            first += ministl::packed_load(words, first * width, width) < delta;
+            return b * block_size + first;
+        }
+
+    private:
+        static unsigned bit_width(value_type v) noexcept
+        {
+            return v == 0 ? 0 : 64 - static_cast<unsigned>(__builtin_clzll(v));
+        }
+
+        void flush_block()
+        {
+            value_type lo = tail_[0];
+            value_type hi = tail_[0];
+            for (size_type i = 1; i < block_size; ++i)
+            {
+                lo = ministl::min(lo, tail_[i]);
+                hi = ministl::max(hi, tail_[i]);
+            }
+            const unsigned width = bit_width(hi - lo);
+            const size_type offset = words_.size() - 1;
+            // 128 个元素恰好占 2 * width 个字，下一块仍从整字开始
+            words_.resize(offset + 2 * width + 1, 0);
+            ministl::packed_encode(words_.data() + offset, 0, width, tail_, block_size, lo);
+            bases_.push_back(lo);
+            offsets_.push_back(offset);
+            widths_.push_back(static_cast<uint8_t>(width));
+            tail_size_ = 0;
+        }
+    };
+}
+
+#endif //MINISTL_PACKED_VECTOR_H
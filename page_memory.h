@@ -0,0 +1,192 @@
+#ifndef MINISTL_PAGE_MEMORY_H
+#define MINISTL_PAGE_MEMORY_H
+
+// This header wraps the operating system's page level memory interface
+// 向操作系统按页申请、释放内存，大页提示以及预缺页、mlock 等接口，供各类特殊分配器和容器使用
+// 非 Linux 平台下退化为 ::operator new / ::operator delete
+
+#include <cstddef>
+#include <new>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace ministl
+{
+    // 透明大页 / hugetlbfs 大页的大小，x86-64 与 aarch64 默认均为 2MB
+    constexpr size_t huge_page_size = static_cast<size_t>(2) << 20;
+
+    // 系统普通页大小
+    inline size_t page_size() noexcept
+    {
+#if defined(__linux__)
+        static const size_t size = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+        return size;
+#else
+        return 4096;
+#endif
+    }
+
+    // 向上取整到 align 的倍数，align 须为 2 的幂
+    inline size_t round_up(size_t bytes, size_t align) noexcept
+    {
+        return (bytes + align - 1) & ~(align - 1);
+    }
+
+    // 以页为单位申请 bytes 大小、按 align 对齐的匿名内存，失败抛出 std::bad_alloc
+    // 多申请 align 字节，再把首尾多余的部分归还给系统
+    inline void* map_pages(size_t bytes, size_t align = 0)
+    {
+#if defined(__linux__)
+        if (align <= page_size())
+        {
+            void* p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (p == MAP_FAILED)
+                throw std::bad_alloc();
+            return p;
+        }
+        const size_t total = bytes + align;
+        void* raw = ::mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw == MAP_FAILED)
+            throw std::bad_alloc();
+        char* base = static_cast<char*>(raw);
+        char* aligned = reinterpret_cast<char*>(round_up(reinterpret_cast<size_t>(base), align));
+        const size_t head = static_cast<size_t>(aligned - base);
+        const size_t tail = total - head - bytes;
+        if (head != 0)
+            ::munmap(base, head);
+        if (tail != 0)
+            ::munmap(aligned + bytes, tail);
+        return aligned;
+#else
+        (void)align;
+        return ::operator new(bytes);
+#endif
+    }
+
+    // 归还 map_pages 得到的内存，bytes 须与申请时一致
+    inline void unmap_pages(void* ptr, size_t bytes) noexcept
+    {
+#if defined(__linux__)
+        ::munmap(ptr, bytes);
+#else
+        (void)bytes;
+        ::operator delete(ptr);
+#endif
+    }
+
+    // 提示内核用透明大页支撑 [ptr, ptr + bytes)，内核不支持时忽略
+    inline bool advise_huge_pages(void* ptr, size_t bytes) noexcept
+    {
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+        return ::madvise(ptr, bytes, MADV_HUGEPAGE) == 0;
+#else
+        (void)ptr;
+        (void)bytes;
+        return false;
+#endif
+    }
+
+    // 从 hugetlbfs 预留的大页池中申请内存，bytes 须为 huge_page_size 的倍数
+    // 大页池为空或系统不支持时返回 nullptr，由调用方回退
+    inline void* map_hugetlb_pages(size_t bytes) noexcept
+    {
+#if defined(__linux__) && defined(MAP_HUGETLB)
+        int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB;
+#if defined(MAP_HUGE_SHIFT)
+        flags |= 21 << MAP_HUGE_SHIFT;     //2MB
+#endif
+        void* p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, flags, -1, 0);
+        return p == MAP_FAILED ? nullptr : p;
+#else
+        (void)bytes;
+        return nullptr;
+#endif
+    }
+
+    // 以写的方式逐页访问 [ptr, ptr + bytes)，仅用于尚未构造对象的空间
+    inline void touch_pages(void* ptr, size_t bytes) noexcept
+    {
+        if (bytes == 0)
+            return;
+        const size_t step = page_size();
+        char* first = static_cast<char*>(ptr);
+        char* last = first + bytes;
+        for (char* p = first; p < last; p = reinterpret_cast<char*>(round_up(reinterpret_cast<size_t>(p) + 1, step)))
+            *static_cast<volatile char*>(p) = 0;
+    }
+
+    // 由内核预先建立 [ptr, ptr + bytes) 的可写页表项（Linux 5.14+ 的 MADV_POPULATE_WRITE），
+    // 不改变内存内容；内核不支持时返回 false
+    inline bool populate_pages(void* ptr, size_t bytes) noexcept
+    {
+#if defined(__linux__) && defined(MADV_POPULATE_WRITE)
+        if (bytes == 0)
+            return true;
+        // madvise 要求起始地址按页对齐，向内收缩到完整的页，首尾不完整的页交给 touch_pages
+        const size_t step = page_size();
+        char* first = reinterpret_cast<char*>(round_up(reinterpret_cast<size_t>(ptr), step));
+        char* last = reinterpret_cast<char*>((reinterpret_cast<size_t>(ptr) + bytes) & ~(step - 1));
+        if (first >= last)
+            return false;
+        return ::madvise(first, static_cast<size_t>(last - first), MADV_POPULATE_WRITE) == 0;
+#else
+        (void)ptr;
+        (void)bytes;
+        return false;
+#endif
+    }
+
+    // 把 [ptr, ptr + bytes) 锁定在物理内存中，超出 RLIMIT_MEMLOCK 等失败时返回 false
+    inline bool lock_pages(void* ptr, size_t bytes) noexcept
+    {
+#if defined(__linux__)
+        return bytes == 0 || ::mlock(ptr, bytes) == 0;
+#else
+        (void)ptr;
+        (void)bytes;
+        return false;
+#endif
+    }
+
+    // 解除 lock_pages 加的锁定，须在归还这段内存之前调用
+    // mlock 不计次数：与 [ptr, ptr + bytes) 共享页面的其他锁定也会一并解除
+    inline void unlock_pages(void* ptr, size_t bytes) noexcept
+    {
+#if defined(__linux__)
+        if (bytes != 0)
+            ::munlock(ptr, bytes);
+#else
+        (void)ptr;
+        (void)bytes;
+#endif
+    }
+
+    // 预缺页选项，可以按位组合
+    enum prefault_flags : unsigned
+    {
+        prefault_default = 0,       //只预缺页
+        prefault_lock    = 1u << 0  //预缺页后 mlock 锁定，避免被换出；调用方须在释放前 unlock_pages
+    };
+
+    // 在 [ptr, ptr + bytes) 上提前触发缺页，之后首次写入不再陷入内核
+    // 返回 false 表示 mlock 失败，预缺页本身总会完成
+    inline bool prefault_pages(void* ptr, size_t bytes, unsigned flags = prefault_default)
+    {
+        if (bytes == 0)
+            return true;
+        if (!populate_pages(ptr, bytes))
+            touch_pages(ptr, bytes);
+        else
+        {
+            // 首尾不完整的页
+            touch_pages(ptr, 1);
+            touch_pages(static_cast<char*>(ptr) + bytes - 1, 1);
+        }
+        return (flags & prefault_lock) ? lock_pages(ptr, bytes) : true;
+    }
+}
+
+#endif //MINISTL_PAGE_MEMORY_H
@@ -0,0 +1,722 @@
+#ifndef MINISTL_PARALLEL_ALGO_H
+#define MINISTL_PARALLEL_ALGO_H
+
+// 这个头文件包含以执行策略为第一个参数的并行算法重载：
+// copy, move, fill, fill_n, equal, mismatch, transform, reduce, transform_reduce, sort, stable_sort
+
+// notes:
+// 只有随机访问区间会被拆分，其他迭代器退化为对应的串行版本。
+// 区间按固定字节数(parallel_chunk_bytes)切块，块长是缓存行的整数倍，相邻块的写入不会共享缓存行；
+// 总字节数低于 parallel_serial_cutoff 时直接串行执行，避免任务调度的开销。
+// 块通过 default_thread_pool() 上的 parallel_for 分发，任务抛出的第一个异常会在调用线程重新抛出。
+// reduce / transform_reduce 要求 binary_op 满足结合律与交换律，结果按块的顺序合并。
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#include "algo.h"
+#include "algobase.h"
+#include "execution.h"
+#include "memory.h"
+#include "functional.h"
+#include "iterator.h"
+#include "numeric.h"
+#include "thread_pool.h"
+#include "util.h"
+
+namespace ministl
+{
+    // 低于该字节数的区间串行执行
+    constexpr size_t parallel_serial_cutoff = 256 * 1024;
+    // 每块的目标字节数，保证一块数据能留在 L2 中
+    constexpr size_t parallel_chunk_bytes = 64 * 1024;
+    constexpr size_t parallel_cache_line = 64;
+
+    // 块长需要是 step 的整数倍，step * elem_bytes 才是缓存行的整数倍
+    constexpr size_t parallel_line_step(size_t elem_bytes)
+    {
+        return (elem_bytes & (~elem_bytes + 1)) >= parallel_cache_line
+               ? 1 : parallel_cache_line / (elem_bytes & (~elem_bytes + 1));
+    }
+
+    constexpr size_t parallel_round_chunk(size_t raw, size_t step)
+    {
+        return raw < step ? step : raw - raw % step;
+    }
+
+    template <class T>
+    constexpr size_t parallel_chunk_elems()
+    {
+        return parallel_round_chunk(parallel_chunk_bytes / sizeof(T), parallel_line_step(sizeof(T)));
+    }
+
+    template <class Policy>
+    struct is_unsequenced_policy : public m_bool_constant<
+            std::is_same<typename std::decay<Policy>::type, execution::parallel_unsequenced_policy>::value> {};
+
+    template <class Policy>
+    struct is_sequenced_policy : public m_bool_constant<
+            std::is_same<typename std::decay<Policy>::type, execution::sequenced_policy>::value> {};
+
+    // 不满足 ministl 迭代器要求的类型(例如标准库容器的迭代器)一律视为非随机访问
+    template <class Iter, bool = has_iterator_category<iterator_traits<Iter>>::value>
+    struct parallel_random_iter : public m_bool_constant<is_random_access_iterator<Iter>::value> {};
+
+    template <class Iter>
+    struct parallel_random_iter<Iter, false> : public m_false_type {};
+
+    // 所有迭代器都是随机访问迭代器时才进行拆分
+    template <class Iter1, class Iter2 = Iter1, class Iter3 = Iter1>
+    m_bool_constant<parallel_random_iter<Iter1>::value &&
+                    parallel_random_iter<Iter2>::value &&
+                    parallel_random_iter<Iter3>::value>
+    parallel_random_tag()
+    {
+        return m_bool_constant<parallel_random_iter<Iter1>::value &&
+                               parallel_random_iter<Iter2>::value &&
+                               parallel_random_iter<Iter3>::value>();
+    }
+
+    template <class Policy>
+    bool parallel_worth(size_t n, size_t elem_bytes)
+    {
+        return !is_sequenced_policy<Policy>::value && n * elem_bytes >= parallel_serial_cutoff;
+    }
+
+    // 把 [0, n) 切成长度为 chunk 的块，并行调用 body(block, lo, hi)
+    template <class Body>
+    void parallel_blocks(size_t n, size_t chunk, const Body& body)
+    {
+        const size_t blocks = (n + chunk - 1) / chunk;
+        ministl::parallel_for(static_cast<size_t>(0), blocks, [n, chunk, &body](size_t lo, size_t hi) {
+            for (size_t b = lo; b < hi; ++b)
+                body(b, b * chunk, ministl::min(n, (b + 1) * chunk));
+        });
+    }
+
+    // 默认的相等比较，允许两个序列的元素类型不同
+    struct parallel_equal_pred
+    {
+        template <class T, class U>
+        bool operator()(const T& lhs, const U& rhs) const { return lhs == rhs; }
+    };
+
+    /***************************************************copy************************************************/
+    template <class Policy, class InputIter, class OutputIter>
+    OutputIter parallel_copy_cat(InputIter first, InputIter last, OutputIter result, m_false_type)
+    {
+        return ministl::copy(first, last, result);
+    }
+
+    template <class Policy, class RandomIter1, class RandomIter2>
+    RandomIter2 parallel_copy_cat(RandomIter1 first, RandomIter1 last, RandomIter2 result, m_true_type)
+    {
+        typedef typename iterator_traits<RandomIter2>::value_type value_type;
+        const size_t n = static_cast<size_t>(last - first);
+        if (!parallel_worth<Policy>(n, sizeof(value_type)))
+            return ministl::copy(first, last, result);
+        parallel_blocks(n, parallel_chunk_elems<value_type>(), [first, result](size_t, size_t lo, size_t hi) {
+            ministl::copy(first + lo, first + hi, result + lo);
+        });
+        return result + n;
+    }
+
+    template <class Policy, class InputIter, class OutputIter>
+    typename std::enable_if<is_execution_policy_decay<Policy>::value, OutputIter>::type
+    copy(Policy&&, InputIter first, InputIter last, OutputIter result)
+    {
+        return parallel_copy_cat<Policy>(first, last, result, parallel_random_tag<InputIter, OutputIter>());
+    }
+
+    /***************************************************move************************************************/
+    template <class Policy, class InputIter, class OutputIter>
+    OutputIter parallel_move_cat(InputIter first, InputIter last, OutputIter result, m_false_type)
+    {
+        return ministl::move(first, last, result);
+    }
+
+    template <class Policy, class RandomIter1, class RandomIter2>
+    RandomIter2 parallel_move_cat(RandomIter1 first, RandomIter1 last, RandomIter2 result, m_true_type)
+    {
+        typedef typename iterator_traits<RandomIter2>::value_type value_type;
+        const size_t n = static_cast<size_t>(last - first);
+        if (!parallel_worth<Policy>(n, sizeof(value_type)))
+            return ministl::move(first, last, result);
+        parallel_blocks(n, parallel_chunk_elems<value_type>(), [first, result](size_t, size_t lo, size_t hi) {
+            ministl::move(first + lo, first + hi, result + lo);
+        });
+        return result + n;
+    }
+
+    template <class Policy, class InputIter, class OutputIter>
+    typename std::enable_if<is_execution_policy_decay<Policy>::value, OutputIter>::type
+    move(Policy&&, InputIter first, InputIter last, OutputIter result)
+    {
+        return parallel_move_cat<Policy>(first, last, result, parallel_random_tag<InputIter, OutputIter>());
+    }
+
+    /**************************************************fill_n***********************************************/
+    template <class Policy, class OutputIter, class Size, class T>
+    OutputIter parallel_fill_n_cat(OutputIter first, Size n, const T& value, m_false_type)
+    {
+        return ministl::fill_n(first, n, value);
+    }
+
+    template <class Policy, class RandomIter, class Size, class T>
+    RandomIter parallel_fill_n_cat(RandomIter first, Size n, const T& value, m_true_type)
+    {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        if (!(n > Size(0)))
+            return first;
+        const size_t count = static_cast<size_t>(n);
+        if (!parallel_worth<Policy>(count, sizeof(value_type)))
+            return ministl::fill_n(first, count, value);
+        parallel_blocks(count, parallel_chunk_elems<value_type>(), [first, &value](size_t, size_t lo, size_t hi) {
+            ministl::fill_n(first + lo, hi - lo, value);
+        });
+        return first + count;
+    }
+
+    template <class Policy, class OutputIter, class Size, class T>
+    typename std::enable_if<is_execution_policy_decay<Policy>::value, OutputIter>::type
+    fill_n(Policy&&, OutputIter first, Size n, const T& value)
+    {
+        return parallel_fill_n_cat<Policy>(first, n, value, parallel_random_tag<OutputIter>());
+    }
+
+    /***************************************************fill************************************************/
+    template <class Policy, class ForwardIter, class T>
+    void parallel_fill_cat(ForwardIter first, ForwardIter last, const T& value, m_false_type)
+    {
+        ministl::fill(first, last, value);
+    }
+
+    template <class Policy, class RandomIter, class T>
+    void parallel_fill_cat(RandomIter first, RandomIter last, const T& value, m_true_type)
+    {
+        parallel_fill_n_cat<Policy>(first, last - first, value, m_true_type());
+    }
+
+    template <class Policy, class ForwardIter, class T>
+    typename std::enable_if<is_execution_policy_decay<Policy>::value>::type
+    fill(Policy&&, ForwardIter first, ForwardIter last, const T& value)
+    {
+        parallel_fill_cat<Policy>(first, last, value, parallel_random_tag<ForwardIter>());
+    }
+
+    /**************************************************equal************************************************/
+    /*******************任一块发现不相等后置位标志，尚未开始的块直接跳过******************************************/
+    /*******************************************************************************************************/
+    template <class Policy, class InputIter1, class InputIter2, class Compared>
+    bool parallel_equal_cat(InputIter1 first1, InputIter1 last1, InputIter2 first2, Compared comp, m_false_type)
+    {
+        return ministl::equal(first1, last1, first2, comp);
+    }
+
+    template <class Policy, class RandomIter1, class RandomIter2, class Compared>
+    bool parallel_equal_cat(RandomIter1 first1, RandomIter1 last1, RandomIter2 first2, Compared comp, m_true_type)
+    {
+        typedef typename iterator_traits<RandomIter1>::value_type value_type;
+        const size_t n = static_cast<size_t>(last1 - first1);
+        if (!parallel_worth<Policy>(n, sizeof(value_type)))
+            return ministl::equal(first1, last1, first2, comp);
+        std::atomic<bool> differ(false);
+        parallel_blocks(n, parallel_chunk_elems<value_type>(),
+                        [first1, first2, &comp, &differ](size_t, size_t lo, size_t hi) {
+            if (differ.load(std::memory_order_relaxed))
+                return;
+            if (!ministl::equal(first1 + lo, first1 + hi, first2 + lo, comp))
+                differ.store(true, std::memory_order_relaxed);
+        });
+        return !differ.load(std::memory_order_relaxed);
+    }
+
+    template <class Policy, class InputIter1, class InputIter2, class Compared>
+    typename std::enable_if<is_execution_policy_decay<Policy>::value, bool>::type
+    equal(Policy&&, InputIter1 first1, InputIter1 last1, InputIter2 first2, Compared comp)
+    {
+        return parallel_equal_cat<Policy>(first1, last1, first2, comp,
+                                          parallel_random_tag<InputIter1, InputIter2>());
+    }
+
+    template <class Policy, class InputIter1, class InputIter2>
+    typename std::enable_if<is_execution_policy_decay<Policy>::value, bool>::type
+    equal(Policy&& policy, InputIter1 first1, InputIter1 last1, InputIter2 first2)
+    {
+        return ministl::equal(ministl::forward<Policy>(policy), first1, last1, first2, parallel_equal_pred());
+    }
+
+    /*************************************************mismatch**********************************************/
+    /*******************以原子变量记录目前最靠前的失配下标，起点在其之后的块直接跳过*********************************/
+    /*******************************************************************************************************/
+    template <class Policy, class InputIter1, class InputIter2, class Compared>
+    ministl::pair<InputIter1, InputIter2>
+    parallel_mismatch_cat(InputIter1 first1, InputIter1 last1, InputIter2 first2, Compared comp, m_false_type)
+    {
+        return ministl::mismatch(first1, last1, first2, comp);
+    }
+
+    template <class Policy, class RandomIter1, class RandomIter2, class Compared>
+    ministl::pair<RandomIter1, RandomIter2>
+    parallel_mismatch_cat(RandomIter1 first1, RandomIter1 last1, RandomIter2 first2, Compared comp, m_true_type)
+    {
+        typedef typename iterator_traits<RandomIter1>::value_type value_type;
+        const size_t n = static_cast<size_t>(last1 - first1);
+        if (!parallel_worth<Policy>(n, sizeof(value_type)))
+            return ministl::mismatch(first1, last1, first2, comp);
+        std::atomic<size_t> found(n);
+        parallel_blocks(n, parallel_chunk_elems<value_type>(),
+                        [first1, first2, &comp, &found](size_t, size_t lo, size_t hi) {
+            if (lo >= found.load(std::memory_order_relaxed))
+                return;
+            const size_t pos = static_cast<size_t>(
+                    ministl::mismatch(first1 + lo, first1 + hi, first2 + lo, comp).first - first1);
+            if (pos == hi)
+                return;
+            size_t cur = found.load(std::memory_order_relaxed);
+            while (pos < cur && !found.compare_exchange_weak(cur, pos, std::memory_order_relaxed))
+                ;
+        });
+        const size_t pos = found.load(std::memory_order_relaxed);
+        return ministl::pair<RandomIter1, RandomIter2>(first1 + pos, first2 + pos);
+    }
+
+    template <class Policy, class InputIter1, class InputIter2, class Compared>
+    typename std::enable_if<is_execution_policy_decay<Policy>::value, ministl::pair<InputIter1, InputIter2>>::type
+    mismatch(Policy&&, InputIter1 first1, InputIter1 last1, InputIter2 first2, Compared comp)
+    {
+        return parallel_mismatch_cat<Policy>(first1, last1, first2, comp,
+                                             parallel_random_tag<InputIter1, InputIter2>());
+    }
+
+    template <class Policy, class InputIter1, class InputIter2>
+    typename std::enable_if<is_execution_policy_decay<Policy>::value, ministl::pair<InputIter1, InputIter2>>::type
+    mismatch(Policy&& policy, InputIter1 first1, InputIter1 last1, InputIter2 first2)
+    {
+        return ministl::mismatch(ministl::forward<Policy>(policy), first1, last1, first2, parallel_equal_pred());
+    }
+
+    /*************************************************transform*********************************************/
+    template <class Policy, class InputIter, class OutputIter, class UnaryOperation>
+    OutputIter parallel_transform_cat(InputIter first, InputIter last, OutputIter result,
+                                      UnaryOperation unary_op, m_false_type)
+    {
+        return ministl::transform(first, last, result, unary_op);
+    }
+
+    template <class Policy, class RandomIter1, class RandomIter2, class UnaryOperation>
+    RandomIter2 parallel_transform_cat(RandomIter1 first, RandomIter1 last, RandomIter2 result,
+                                       UnaryOperation unary_op, m_true_type)
+    {
+        typedef typename iterator_traits<RandomIter2>::value_type value_type;
+        const size_t n = static_cast<size_t>(last - first);
+        if (!parallel_worth<Policy>(n, sizeof(value_type)))
+            return ministl::transform(first, last, result, unary_op);
+        parallel_blocks(n, parallel_chunk_elems<value_type>(),
+                        [first, result, &unary_op](size_t, size_t lo, size_t hi) {
+            ministl::transform(first + lo, first + hi, result + lo, unary_op);
+        });
+        return result + n;
+    }
+
+    template <class Policy, class InputIter, class OutputIter, class UnaryOperation>
+    typename std::enable_if<is_execution_policy_decay<Policy>::value, OutputIter>::type
+    transform(Policy&&, InputIter first, InputIter last, OutputIter result, UnaryOperation unary_op)
+    {
+        return parallel_transform_cat<Policy>(first, last, result, unary_op,
+                                              parallel_random_tag<InputIter, OutputIter>());
+    }
+
+    template <class Policy, class InputIter1, class InputIter2, class OutputIter, class BinaryOperation>
+    OutputIter parallel_transform2_cat(InputIter1 first1, InputIter1 last1, InputIter2 first2,
+                                       OutputIter result, BinaryOperation binary_op, m_false_type)
+    {
+        return ministl::transform(first1, last1, first2, result, binary_op);
+    }
+
+    template <class Policy, class RandomIter1, class RandomIter2, class RandomIter3, class BinaryOperation>
+    RandomIter3 parallel_transform2_cat(RandomIter1 first1, RandomIter1 last1, RandomIter2 first2,
+                                        RandomIter3 result, BinaryOperation binary_op, m_true_type)
+    {
+        typedef typename iterator_traits<RandomIter3>::value_type value_type;
+        const size_t n = static_cast<size_t>(last1 - first1);
+        if (!parallel_worth<Policy>(n, sizeof(value_type)))
+            return ministl::transform(first1, last1, first2, result, binary_op);
+        parallel_blocks(n, parallel_chunk_elems<value_type>(),
+                        [first1, first2, result, &binary_op](size_t, size_t lo, size_t hi) {
+            ministl::transform(first1 + lo, first1 + hi, first2 + lo, result + lo, binary_op);
+        });
+        return result + n;
+    }
+
+    template <class Policy, class InputIter1, class InputIter2, class OutputIter, class BinaryOperation>
+    typename std::enable_if<is_execution_policy_decay<Policy>::value, OutputIter>::type
+    transform(Policy&&, InputIter1 first1, InputIter1 last1, InputIter2 first2,
+              OutputIter result, BinaryOperation binary_op)
+    {
+        return parallel_transform2_cat<Policy>(first1, last1, first2, result, binary_op,
+                                               parallel_random_tag<InputIter1, InputIter2, OutputIter>());
+    }
+
+    /**********************************************reduce 的分块实现******************************************/
+    // 块内归约 [lo, hi)，hi > lo，load(i) 给出第 i 个待归约的值
+    template <class T, class BinaryOp, class Load>
+    T parallel_fold(size_t lo, size_t hi, const BinaryOp& op, const Load& load, m_false_type)
+    {
+        T acc = load(lo);
+        for (size_t i = lo + 1; i < hi; ++i)
+            acc = op(ministl::move(acc), load(i));
+        return acc;
+    }
+
+    // unseq 版本使用 4 个独立的累加器，打破循环携带的依赖链，便于编译器向量化
+    template <class T, class BinaryOp, class Load>
+    T parallel_fold(size_t lo, size_t hi, const BinaryOp& op, const Load& load, m_true_type)
+    {
+        if (hi - lo < 8)
+            return parallel_fold<T>(lo, hi, op, load, m_false_type());
+        T acc0 = load(lo);
+        T acc1 = load(lo + 1);
+        T acc2 = load(lo + 2);
+        T acc3 = load(lo + 3);
+        size_t i = lo + 4;
+        for (; i + 4 <= hi; i += 4)
+        {
+            acc0 = op(ministl::move(acc0), load(i));
+            acc1 = op(ministl::move(acc1), load(i + 1));
+            acc2 = op(ministl::move(acc2), load(i + 2));
+            acc3 = op(ministl::move(acc3), load(i + 3));
+        }
+        acc0 = op(op(ministl::move(acc0), ministl::move(acc1)), op(ministl::move(acc2), ministl::move(acc3)));
+        for (; i < hi; ++i)
+            acc0 = op(ministl::move(acc0), load(i));
+        return acc0;
+    }
+
+    // 每块的部分结果写入 partial[block]，最后在调用线程按块的顺序与 init 合并
+    template <class Policy, class T, class BinaryOp, class Load>
+    T parallel_reduce_blocks(size_t n, size_t elem_bytes, size_t chunk, T init,
+                             const BinaryOp& op, const Load& load)
+    {
+        typedef is_unsequenced_policy<Policy> unseq;
+        if (n == 0)
+            return init;
+        if (!parallel_worth<Policy>(n, elem_bytes))
+            return op(ministl::move(init), parallel_fold<T>(0, n, op, load, unseq()));
+        std::vector<T> partial((n + chunk - 1) / chunk, init);
+        parallel_blocks(n, chunk, [&partial, &op, &load](size_t block, size_t lo, size_t hi) {
+            partial[block] = parallel_fold<T>(lo, hi, op, load, unseq());
+        });
+        for (size_t b = 0; b < partial.size(); ++b)
+            init = op(ministl::move(init), ministl::move(partial[b]));
+        return init;
+    }
+
+    /**************************************************reduce***********************************************/
+    template <class Policy, class InputIter, class T, class BinaryOp>
+    T parallel_reduce_cat(InputIter first, InputIter last, T init, BinaryOp binary_op, m_false_type)
+    {
+        return ministl::reduce(first, last, init, binary_op);
+    }
+
+    template <class Policy, class RandomIter, class T, class BinaryOp>
+    T parallel_reduce_cat(RandomIter first, RandomIter last, T init, BinaryOp binary_op, m_true_type)
+    {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        if (is_sequenced_policy<Policy>::value)
+            return ministl::reduce(first, last, init, binary_op);
+        return parallel_reduce_blocks<Policy>(static_cast<size_t>(last - first), sizeof(value_type),
+                                              parallel_chunk_elems<value_type>(), init, binary_op,
+                                              [first](size_t i) -> const value_type& { return first[i]; });
+    }
+
+    template <class Policy, class InputIter, class T, class BinaryOp>
+    typename std::enable_if<is_execution_policy_decay<Policy>::value, T>::type
+    reduce(Policy&&, InputIter first, InputIter last, T init, BinaryOp binary_op)
+    {
+        return parallel_reduce_cat<Policy>(first, last, init, binary_op, parallel_random_tag<InputIter>());
+    }
+
+    template <class Policy, class InputIter, class T>
+    typename std::enable_if<is_execution_policy_decay<Policy>::value, T>::type
+    reduce(Policy&& policy, InputIter first, InputIter last, T init)
+    {
+        return ministl::reduce(ministl::forward<Policy>(policy), first, last, init, ministl::plus<T>());
+    }
+
+    template <class Policy, class InputIter>
+    typename std::enable_if<is_execution_policy_decay<Policy>::value,
+            typename iterator_traits<InputIter>::value_type>::type
+    reduce(Policy&& policy, InputIter first, InputIter last)
+    {
+        typedef typename iterator_traits<InputIter>::value_type value_type;
+        return ministl::reduce(ministl::forward<Policy>(policy), first, last, value_type(),
+                               ministl::plus<value_type>());
+    }
+
+    /**********************************************transform_reduce*****************************************/
+    template <class Policy, class InputIter, class T, class BinaryOp, class UnaryOp>
+    T parallel_transform_reduce_cat(InputIter first, InputIter last, T init, BinaryOp reduce_op,
+                                    UnaryOp unary_op, m_false_type)
+    {
+        return ministl::transform_reduce(first, last, init, reduce_op, unary_op);
+    }
+
+    template <class Policy, class RandomIter, class T, class BinaryOp, class UnaryOp>
+    T parallel_transform_reduce_cat(RandomIter first, RandomIter last, T init, BinaryOp reduce_op,
+                                    UnaryOp unary_op, m_true_type)
+    {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        if (is_sequenced_policy<Policy>::value)
+            return ministl::transform_reduce(first, last, init, reduce_op, unary_op);
+        return parallel_reduce_blocks<Policy>(static_cast<size_t>(last - first), sizeof(value_type),
+                                              parallel_chunk_elems<value_type>(), init, reduce_op,
+                                              [first, &unary_op](size_t i) { return unary_op(first[i]); });
+    }
+
+    template <class Policy, class InputIter1, class InputIter2, class T, class BinaryOp1, class BinaryOp2>
+    T parallel_transform_reduce2_cat(InputIter1 first1, InputIter1 last1, InputIter2 first2, T init,
+                                     BinaryOp1 reduce_op, BinaryOp2 transform_op, m_false_type)
+    {
+        return ministl::transform_reduce(first1, last1, first2, init, reduce_op, transform_op);
+    }
+
+    template <class Policy, class RandomIter1, class RandomIter2, class T, class BinaryOp1, class BinaryOp2>
+    T parallel_transform_reduce2_cat(RandomIter1 first1, RandomIter1 last1, RandomIter2 first2, T init,
+                                     BinaryOp1 reduce_op, BinaryOp2 transform_op, m_true_type)
+    {
+        typedef typename iterator_traits<RandomIter1>::value_type value_type;
+        if (is_sequenced_policy<Policy>::value)
+            return ministl::transform_reduce(first1, last1, first2, init, reduce_op, transform_op);
+        return parallel_reduce_blocks<Policy>(static_cast<size_t>(last1 - first1), sizeof(value_type),
+                                              parallel_chunk_elems<value_type>(), init, reduce_op,
+                                              [first1, first2, &transform_op](size_t i) {
+                                                  return transform_op(first1[i], first2[i]);
+                                              });
+    }
+
+    template <class Policy, class InputIter, class T, class BinaryOp, class UnaryOp>
+    typename std::enable_if<is_execution_policy_decay<Policy>::value, T>::type
+    transform_reduce(Policy&&, InputIter first, InputIter last, T init, BinaryOp reduce_op, UnaryOp unary_op)
+    {
+        return parallel_transform_reduce_cat<Policy>(first, last, init, reduce_op, unary_op,
+                                                     parallel_random_tag<InputIter>());
+    }
+
+    template <class Policy, class InputIter1, class InputIter2, class T, class BinaryOp1, class BinaryOp2>
+    typename std::enable_if<is_execution_policy_decay<Policy>::value, T>::type
+    transform_reduce(Policy&&, InputIter1 first1, InputIter1 last1, InputIter2 first2, T init,
+                     BinaryOp1 reduce_op, BinaryOp2 transform_op)
+    {
+        return parallel_transform_reduce2_cat<Policy>(first1, last1, first2, init, reduce_op, transform_op,
+                                                      parallel_random_tag<InputIter1, InputIter2>());
+    }
+
+    template <class Policy, class InputIter1, class InputIter2, class T>
+    typename std::enable_if<is_execution_policy_decay<Policy>::value, T>::type
+    transform_reduce(Policy&& policy, InputIter1 first1, InputIter1 last1, InputIter2 first2, T init)
+    {
+        return ministl::transform_reduce(ministl::forward<Policy>(policy), first1, last1, first2, init,
+                                         ministl::plus<T>(), ministl::multiplies<T>());
+    }
+
+    /**********************************************parallel_sort********************************************/
+    // notes:
+    // 并行归并排序：区间切成约 4 * 线程数 块，各块并行排序(stable 时用缓冲区中对应的一段做 stable_sort_adaptive)，
+    // 之后逐轮两两归并，在原区间与 temporary_buffer 之间来回移动。
+    // 每次归并再以二分查找把两段切成互不相交的两半，用 parallel_invoke 递归地并行归并，
+    // 最后几轮块数少于线程数时依然能用满所有线程。归并时相等元素总是先取左段，因此 stable 时整体稳定。
+    // 申请不到足够的临时空间时退回串行的 sort / stable_sort。
+    // 比较操作抛出异常时，异常传给调用者，区间中的元素处于有效但未指定的状态。
+    /*******************************************************************************************************/
+    enum class sort_stability { unstable, stable };
+
+    // 每块至少的元素数，归并时短于该长度的两段直接串行归并
+    constexpr size_t parallel_sort_min_block = static_cast<size_t>(1) << 15;
+    constexpr size_t parallel_merge_cutoff = static_cast<size_t>(1) << 14;
+
+    template <class Iter1, class Iter2, class OutputIter, class Compared>
+    void parallel_move_merge(Iter1 first1, Iter1 last1, Iter2 first2, Iter2 last2, OutputIter result,
+                             const Compared& comp, thread_pool& pool)
+    {
+        const size_t len1 = static_cast<size_t>(last1 - first1);
+        const size_t len2 = static_cast<size_t>(last2 - first2);
+        if (len1 + len2 <= parallel_merge_cutoff)
+        {
+            ministl::move_merge(first1, last1, first2, last2, result, comp);
+            return;
+        }
+        // 左半部分的元素都不大于右半部分，且与第一段相等的第二段元素都在右半部分
+        Iter1 mid1 = first1;
+        Iter2 mid2 = first2;
+        if (len1 >= len2)
+        {
+            mid1 = first1 + len1 / 2;
+            mid2 = ministl::lower_bound(first2, last2, *mid1, comp);
+        }
+        else
+        {
+            mid2 = first2 + len2 / 2;
+            mid1 = ministl::upper_bound(first1, last1, *mid2, comp);
+        }
+        const OutputIter result_mid = result + ((mid1 - first1) + (mid2 - first2));
+        ministl::parallel_invoke(
+                [&]() { ministl::parallel_move_merge(first1, mid1, first2, mid2, result, comp, pool); },
+                [&]() { ministl::parallel_move_merge(mid1, last1, mid2, last2, result_mid, comp, pool); },
+                pool);
+    }
+
+    // 把 src 中长为 width 的有序段两两归并到 dst
+    template <class SrcIter, class DstIter, class Compared>
+    void parallel_merge_round(SrcIter src, DstIter dst, size_t n, size_t width,
+                              const Compared& comp, thread_pool& pool)
+    {
+        const size_t pairs = (n + 2 * width - 1) / (2 * width);
+        ministl::parallel_for(static_cast<size_t>(0), pairs, static_cast<size_t>(1),
+                              [=, &comp, &pool](size_t lo, size_t hi) {
+            for (size_t p = lo; p < hi; ++p)
+            {
+                const size_t first = p * 2 * width;
+                const size_t mid = ministl::min(first + width, n);
+                const size_t last = ministl::min(first + 2 * width, n);
+                ministl::parallel_move_merge(src + first, src + mid, src + mid, src + last, dst + first, comp, pool);
+            }
+        }, pool);
+    }
+
+    // block_sort(first, last, scratch, scratch_size) 对一块排序，scratch 为缓冲区中与该块等长的一段，
+    // 不分块时 scratch 为空指针
+    template <class RandomIter, class Compared, class BlockSort>
+    void parallel_merge_sort(RandomIter first, RandomIter last, const Compared& comp,
+                             const BlockSort& block_sort, thread_pool& pool)
+    {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        const size_t n = static_cast<size_t>(last - first);
+        const size_t blocks = ministl::min(4 * (pool.size() + 1), n / parallel_sort_min_block);
+        if (blocks < 2)
+        {
+            block_sort(first, last, static_cast<value_type*>(nullptr), static_cast<ptrdiff_t>(0));
+            return;
+        }
+        temporary_buffer<RandomIter, value_type> buf(first, last);
+        if (buf.begin() == nullptr || static_cast<size_t>(buf.size()) != n)
+        {
+            block_sort(first, last, static_cast<value_type*>(nullptr), static_cast<ptrdiff_t>(0));
+            return;
+        }
+        value_type* const buffer = buf.begin();
+        const size_t width = (n + blocks - 1) / blocks;
+        ministl::parallel_for(static_cast<size_t>(0), blocks, static_cast<size_t>(1),
+                              [=, &block_sort](size_t lo, size_t hi) {
+            for (size_t b = lo; b < hi; ++b)
+            {
+                const size_t begin = ministl::min(b * width, n);
+                const size_t end = ministl::min(begin + width, n);
+                block_sort(first + begin, first + end, buffer + begin, static_cast<ptrdiff_t>(end - begin));
+            }
+        }, pool);
+
+        bool in_buffer = false;
+        for (size_t w = width; w < n; w *= 2)
+        {
+            if (in_buffer)
+                ministl::parallel_merge_round(buffer, first, n, w, comp, pool);
+            else
+                ministl::parallel_merge_round(first, buffer, n, w, comp, pool);
+            in_buffer = !in_buffer;
+        }
+        if (in_buffer)
+        {
+            const size_t chunk = parallel_chunk_elems<value_type>();
+            ministl::parallel_for(static_cast<size_t>(0), (n + chunk - 1) / chunk, static_cast<size_t>(0),
+                                  [=](size_t lo, size_t hi) {
+                ministl::move(buffer + lo * chunk, buffer + ministl::min(hi * chunk, n), first + lo * chunk);
+            }, pool);
+        }
+    }
+
+    template <class RandomIter, class Compared>
+    void parallel_sort(RandomIter first, RandomIter last, Compared comp,
+                       sort_stability stability = sort_stability::unstable,
+                       thread_pool& pool = default_thread_pool())
+    {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        if (last - first < 2)
+            return;
+        if (stability == sort_stability::stable)
+        {
+            ministl::parallel_merge_sort(first, last, comp,
+                    [&comp](RandomIter lo, RandomIter hi, value_type* scratch, ptrdiff_t scratch_size) {
+                        if (scratch == nullptr)
+                            ministl::stable_sort(lo, hi, comp);
+                        else
+                            ministl::stable_sort_adaptive(lo, hi, scratch, scratch_size, comp);
+                    }, pool);
+        }
+        else
+        {
+            ministl::parallel_merge_sort(first, last, comp,
+                    [&comp](RandomIter lo, RandomIter hi, value_type*, ptrdiff_t) {
+                        ministl::sort(lo, hi, comp);
+                    }, pool);
+        }
+    }
+
+    // 不带比较操作的版本：块内使用 ministl::sort(first, last)，可以自动选择基数排序
+    template <class RandomIter>
+    void parallel_sort(RandomIter first, RandomIter last,
+                       sort_stability stability = sort_stability::unstable,
+                       thread_pool& pool = default_thread_pool())
+    {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        if (stability == sort_stability::stable || last - first < 2)
+        {
+            ministl::parallel_sort(first, last, ministl::less<value_type>(), stability, pool);
+            return;
+        }
+        ministl::parallel_merge_sort(first, last, ministl::less<value_type>(),
+                [](RandomIter lo, RandomIter hi, value_type*, ptrdiff_t) { ministl::sort(lo, hi); }, pool);
+    }
+
+    template <class Policy, class RandomIter, class Compared>
+    typename std::enable_if<is_execution_policy_decay<Policy>::value>::type
+    sort(Policy&&, RandomIter first, RandomIter last, Compared comp)
+    {
+        if (is_sequenced_policy<Policy>::value)
+            ministl::sort(first, last, comp);
+        else
+            ministl::parallel_sort(first, last, comp, sort_stability::unstable);
+    }
+
+    template <class Policy, class RandomIter>
+    typename std::enable_if<is_execution_policy_decay<Policy>::value>::type
+    sort(Policy&&, RandomIter first, RandomIter last)
+    {
+        if (is_sequenced_policy<Policy>::value)
+            ministl::sort(first, last);
+        else
+            ministl::parallel_sort(first, last, sort_stability::unstable);
+    }
+
+    template <class Policy, class RandomIter, class Compared>
+    typename std::enable_if<is_execution_policy_decay<Policy>::value>::type
+    stable_sort(Policy&&, RandomIter first, RandomIter last, Compared comp)
+    {
+        if (is_sequenced_policy<Policy>::value)
+            ministl::stable_sort(first, last, comp);
+        else
+            ministl::parallel_sort(first, last, comp, sort_stability::stable);
+    }
+
+    template <class Policy, class RandomIter>
+    typename std::enable_if<is_execution_policy_decay<Policy>::value>::type
+    stable_sort(Policy&& policy, RandomIter first, RandomIter last)
+    {
+        typedef typename iterator_traits<RandomIter>::value_type value_type;
+        ministl::stable_sort(ministl::forward<Policy>(policy), first, last, ministl::less<value_type>());
+    }
+}
+
+#endif //MINISTL_PARALLEL_ALGO_H
@@ -0,0 +1,149 @@
+#ifndef MINISTL_PARALLEL_DISPATCH_H
+#define MINISTL_PARALLEL_DISPATCH_H
+
+// This header declares how vector hands uninitialized construction to a parallel runner
+// vector 的并行构造、复制与搬移只经过这里的函数指针，不依赖线程池，普通的 vector 用户不需要包含 thread_pool.h
+
+// notes:
+// 并行执行的函数(parallel_runner)由 parallel_uninitialized.h 提供：
+//   * 构造函数标签 parallel_init 携带它，只有包含了 parallel_uninitialized.h 才能使用该标签
+//   * set_parallel_vector_threshold 在设置全局阈值的同时登记它
+// 没有登记时 vector 始终串行构造。各分段以类型擦除的 ctx 与静态函数描述，
+// fn(ctx, offset, count) 构造 [offset, offset + count)，失败时清理本段并抛出异常；undo 析构已成功的分段
+
+#include <atomic>
+#include <cstddef>
+
+#include "uninitialized.h"
+
+namespace ministl
+{
+    typedef void (*parallel_segment_fn)(void* ctx, size_t offset, size_t count);
+
+    // 在 [0, n) 的各分段上调用 fn，elem_bytes 为单个元素的字节数，用来决定分段大小
+    typedef void (*parallel_runner)(size_t n, size_t elem_bytes, void* ctx,
+                                    parallel_segment_fn fn, parallel_segment_fn undo);
+
+    // 构造函数标签：以并行 first-touch 的方式初始化元素，常量 parallel_init 定义在 parallel_uninitialized.h
+    struct parallel_init_t
+    {
+        parallel_runner run;
+    };
+
+    /***************************************vector 的全局并行阈值******************************************/
+    // 元素总字节数不小于阈值时，vector 的构造、复制与重新分配时的搬移并行执行；0 表示关闭（默认）
+    inline std::atomic<size_t>& parallel_vector_threshold_value() noexcept
+    {
+        static std::atomic<size_t> threshold(0);
+        return threshold;
+    }
+
+    // 由 set_parallel_vector_threshold 登记的并行执行函数
+    inline std::atomic<parallel_runner>& parallel_vector_runner() noexcept
+    {
+        static std::atomic<parallel_runner> run(nullptr);
+        return run;
+    }
+
+    inline size_t parallel_vector_threshold() noexcept
+    {
+        return parallel_vector_threshold_value().load(std::memory_order_relaxed);
+    }
+
+    // n 个 T 达到阈值时返回并行执行的函数，否则返回 nullptr
+    template <class T>
+    parallel_runner parallel_vector_runner_for(size_t n) noexcept
+    {
+        const size_t threshold = parallel_vector_threshold();
+        if (threshold == 0 || n * sizeof(T) < threshold)
+            return nullptr;
+        return parallel_vector_runner().load(std::memory_order_acquire);
+    }
+
+    template <class T>
+    bool parallel_vector_enabled(size_t n) noexcept
+    {
+        return parallel_vector_runner_for<T>(n) != nullptr;
+    }
+
+    /*****************************************各分段的构造操作**********************************************/
+    template <class T>
+    struct uninitialized_fill_segment
+    {
+        T*       first;
+        const T* value;
+
+        static void run(void* ctx, size_t offset, size_t count)
+        {
+            const uninitialized_fill_segment& s = *static_cast<uninitialized_fill_segment*>(ctx);
+            ministl::uninitialized_fill_n(s.first + offset, count, *s.value);
+        }
+
+        static void undo(void* ctx, size_t offset, size_t count)
+        {
+            const uninitialized_fill_segment& s = *static_cast<uninitialized_fill_segment*>(ctx);
+            ministl::destroy(s.first + offset, s.first + offset + count);
+        }
+    };
+
+    // Move 为 true 时移动，否则复制
+    template <class RandomIter, class T, bool Move>
+    struct uninitialized_copy_segment
+    {
+        RandomIter first;
+        T*         result;
+
+        static void run(void* ctx, size_t offset, size_t count)
+        {
+            const uninitialized_copy_segment& s = *static_cast<uninitialized_copy_segment*>(ctx);
+            construct_range(s.first + offset, s.first + offset + count, s.result + offset, m_bool_constant<Move>());
+        }
+
+        static void undo(void* ctx, size_t offset, size_t count)
+        {
+            const uninitialized_copy_segment& s = *static_cast<uninitialized_copy_segment*>(ctx);
+            ministl::destroy(s.result + offset, s.result + offset + count);
+        }
+
+    private:
+        static void construct_range(RandomIter first, RandomIter last, T* result, m_true_type)
+        {
+            ministl::uninitialized_move(first, last, result);
+        }
+
+        static void construct_range(RandomIter first, RandomIter last, T* result, m_false_type)
+        {
+            ministl::uninitialized_copy(first, last, result);
+        }
+    };
+
+    /*********************************以 run 并行填充、复制、移动到未初始化空间************************************/
+    template <class T, class Size>
+    T* run_uninitialized_fill_n(parallel_runner run, T* first, Size n, const T& value)
+    {
+        typedef uninitialized_fill_segment<T> segment;
+        segment s = { first, &value };
+        run(static_cast<size_t>(n), sizeof(T), &s, &segment::run, &segment::undo);
+        return first + n;
+    }
+
+    template <class RandomIter, class T>
+    T* run_uninitialized_copy(parallel_runner run, RandomIter first, RandomIter last, T* result)
+    {
+        typedef uninitialized_copy_segment<RandomIter, T, false> segment;
+        segment s = { first, result };
+        run(static_cast<size_t>(last - first), sizeof(T), &s, &segment::run, &segment::undo);
+        return result + (last - first);
+    }
+
+    template <class RandomIter, class T>
+    T* run_uninitialized_move(parallel_runner run, RandomIter first, RandomIter last, T* result)
+    {
+        typedef uninitialized_copy_segment<RandomIter, T, true> segment;
+        segment s = { first, result };
+        run(static_cast<size_t>(last - first), sizeof(T), &s, &segment::run, &segment::undo);
+        return result + (last - first);
+    }
+}
+
+#endif //MINISTL_PARALLEL_DISPATCH_H
@@ -0,0 +1,140 @@
+#ifndef MINISTL_PARALLEL_UNINITIALIZED_H
+#define MINISTL_PARALLEL_UNINITIALIZED_H
+
+// This header is used to construct elements for the uninitialized space with multiple threads
+// 大块未初始化空间的并行构造、复制与移动：区间切成按页对齐的连续分段，由 default_thread_pool() 并行处理，
+// 页面因此由之后处理同一区间的线程首次访问（first-touch），在 NUMA 机器上落在该线程所在的节点
+
+// notes:
+// 异常保证：各分段只析构自己已构造的部分，任一分段抛出异常时，
+// 其余成功的分段也会被析构，之后把第一个异常重新抛给调用方，[result, result + n) 回到未初始化状态
+// 并行移动失败时，源区间中已被移动的元素处于 moved-from 状态，与串行的 uninitialized_move 相同
+// vector 的并行模式是可选的：构造函数的 parallel_init 标签，或以 set_parallel_vector_threshold 设置的全局阈值；
+// 两者都经 parallel_dispatch.h 把 run_segments_on_pool 交给 vector，vector.h 本身不包含线程池
+
+#include <atomic>
+#include <exception>
+#include <type_traits>
+#include <vector>
+
+#include "uninitialized.h"
+#include "page_memory.h"
+#include "parallel_dispatch.h"
+#include "thread_pool.h"
+
+namespace ministl
+{
+    // 每个分段至少负责的字节数，更小的区间串行处理
+    constexpr size_t parallel_init_min_bytes = static_cast<size_t>(4) << 20;
+
+    // 把 n 个大小为 elem_bytes 的元素切分成至多 4 * 并行线程数 段，段边界按页对齐
+    inline size_t parallel_init_chunk(size_t n, size_t elem_bytes) noexcept
+    {
+        const size_t bytes = n * elem_bytes;
+        const size_t parts = ministl::min(4 * (default_thread_pool().size() + 1), bytes / parallel_init_min_bytes);
+        if (parts <= 1)
+            return n;
+        const size_t chunk_bytes = round_up((bytes + parts - 1) / parts, ministl::page_size());
+        return ministl::max(chunk_bytes / elem_bytes, static_cast<size_t>(1));
+    }
+
+    template <class T>
+    size_t parallel_init_chunk(size_t n) noexcept
+    {
+        return parallel_init_chunk(n, sizeof(T));
+    }
+
+    // 在 [0, n) 上以线程池并行调用 fn(offset, count)，fn 须在失败时清理自己构造的部分并抛出异常
+    // 任一分段失败时对成功的分段调用 undo(offset, count)，然后重新抛出第一个异常
+    template <class Fn, class Undo>
+    void parallel_uninitialized_for(size_t n, size_t chunk, Fn fn, Undo undo)
+    {
+        if (chunk >= n)
+        {
+            fn(static_cast<size_t>(0), n);
+            return;
+        }
+        const size_t parts = (n + chunk - 1) / chunk;
+        std::vector<std::exception_ptr> errors(parts);
+        // 每段一个任务，段内的异常就地捕获，不会中断其他分段
+        ministl::parallel_for(static_cast<size_t>(0), parts, static_cast<size_t>(1),
+                              [&](size_t lo, size_t hi) {
+            for (size_t i = lo; i < hi; ++i)
+            {
+                const size_t offset = i * chunk;
+                try
+                {
+                    fn(offset, ministl::min(chunk, n - offset));
+                }
+                catch (...)
+                {
+                    errors[i] = std::current_exception();
+                }
+            }
+        });
+
+        std::exception_ptr first_error;
+        for (size_t i = 0; i < parts; ++i)
+        {
+            if (errors[i] && !first_error)
+                first_error = errors[i];
+        }
+        if (first_error)
+        {
+            for (size_t i = 0; i < parts; ++i)
+            {
+                if (!errors[i])
+                    undo(i * chunk, ministl::min(chunk, n - i * chunk));
+            }
+            std::rethrow_exception(first_error);
+        }
+    }
+
+    // parallel_runner 的线程池实现，由 parallel_init 标签与 set_parallel_vector_threshold 交给 vector
+    inline void run_segments_on_pool(size_t n, size_t elem_bytes, void* ctx,
+                                     parallel_segment_fn fn, parallel_segment_fn undo)
+    {
+        parallel_uninitialized_for(n, parallel_init_chunk(n, elem_bytes),
+                                   [ctx, fn](size_t offset, size_t count) { fn(ctx, offset, count); },
+                                   [ctx, undo](size_t offset, size_t count) { undo(ctx, offset, count); });
+    }
+
+    // 构造函数标签：以并行 first-touch 的方式初始化元素
+    constexpr parallel_init_t parallel_init = { &run_segments_on_pool };
+
+    // 设置 vector 的全局并行阈值(字节)，0 表示关闭
+    inline void set_parallel_vector_threshold(size_t bytes) noexcept
+    {
+        parallel_vector_runner().store(&run_segments_on_pool, std::memory_order_release);
+        parallel_vector_threshold_value().store(bytes, std::memory_order_relaxed);
+    }
+
+    /**************************************parallel_uninitialized_fill_n*********************************/
+    /***************************************在 [first,first + n)上并行填充value******************************/
+    /***************************************************************************************************/
+    template <class T, class Size>
+    T* parallel_uninitialized_fill_n(T* first, Size n, const T& value)
+    {
+        return ministl::run_uninitialized_fill_n(&run_segments_on_pool, first, n, value);
+    }
+
+    /***************************************parallel_uninitialized_copy*********************************/
+    /***************************把 [first, last) 并行复制到以 result 为起始处的未初始化空间********************/
+    /***************************************************************************************************/
+    template <class RandomIter, class T>
+    T* parallel_uninitialized_copy(RandomIter first, RandomIter last, T* result)
+    {
+        return ministl::run_uninitialized_copy(&run_segments_on_pool, first, last, result);
+    }
+
+    /***************************************parallel_uninitialized_move*********************************/
+    /***************************把 [first, last) 并行移动到以 result 为起始处的未初始化空间********************/
+    /***************************************************************************************************/
+    template <class RandomIter, class T>
+    T* parallel_uninitialized_move(RandomIter first, RandomIter last, T* result)
+    {
+        return ministl::run_uninitialized_move(&run_segments_on_pool, first, last, result);
+    }
+}
+
+#endif //MINISTL_PARALLEL_UNINITIALIZED_H
@@ -0,0 +1,1194 @@
+#ifndef MINISTL_PERSISTENT_VECTOR_H
+#define MINISTL_PERSISTENT_VECTOR_H
+
+// 这个头文件包含三个模板类 rrb_tree / persistent_vector / transient_vector
+// rrb_tree          : relaxed radix balanced tree，persistent_vector 与 transient_vector 的底层实现
+// persistent_vector : 持久化(不可变)的 vector，每次修改返回一个新版本，新旧版本共享没有改动的节点
+// transient_vector  : persistent_vector 的可变形式，用于批量修改，改完再通过 persistent() 得到新版本
+
+// notes:
+// 结构：
+//   32 叉树，叶子存放 32 个元素，内部节点存放 32 个子节点。末尾不满 32 个的元素放在树外的 tail 中，
+//   push_back / pop_back 大多只改动 tail，tail 满了才整块挂进树里。
+//   规则(regular)节点除最后一个子节点外都是满的，按下标的 5 位一组直接算出子节点；
+//   拼接与切片会产生不满的子节点，这样的节点是 relaxed 节点，另外保存各子节点的累计元素个数，
+//   查找时先用 i >> shift 估计下标，再向后修正。
+// 共享：
+//   节点带原子引用计数，一个版本只持有 root 与 tail 的引用，拷贝一个版本是 O(1) 的。
+//   修改时从根复制到目标叶子(path copying)：路径上引用计数为 1 的节点只属于当前版本，原地修改，否则复制一份。
+//   persistent_vector 的修改先拷贝出新版本，路径上的节点至少被两个版本引用，总是复制；
+//   transient_vector 只在第一次碰到共享节点时复制，之后在自己的节点上原地修改，批量修改不会逐次复制。
+// 复杂度：
+//   operator[] / set / update 为 O(log32 n)，push_back / pop_back 均摊 O(1)、最坏 O(log32 n)；
+//   take / drop / slice 为 O(log32 n)；concat 沿两棵树相接的边界逐层合并，每层至多重排 64 个节点，
+//   合并后每层的节点数不超过最优个数加 2(rrb_extras)，查找时的修正步数保持很小。
+// 线程安全：
+//   多个线程可以同时读取、拷贝、修改(得到新版本)与销毁共享节点的不同版本；一个 transient_vector 只能由一个线程使用。
+// 异常保证：
+//   persistent_vector 的修改操作满足强异常保证；transient_vector 的修改操作满足基本异常保证
+
+#include <atomic>
+#include <cstddef>
+#include <initializer_list>
+#include <type_traits>
+
+#include "algobase.h"
+#include "allocator.h"
+#include "exception.h"
+#include "iterator.h"
+#include "uninitialized.h"
+#include "util.h"
+#include "vector.h"
+
+namespace ministl
+{
+    constexpr size_t rrb_bits      = 5;
+    constexpr size_t rrb_branches  = size_t(1) << rrb_bits;
+    // 拼接时，每层的节点数最多比最优个数多 rrb_extras 个；子节点数已有 rrb_branches - rrb_invariant 个以上的节点不参与重排
+    constexpr size_t rrb_extras    = 2;
+    constexpr size_t rrb_invariant = 1;
+
+    template <class T>
+    class rrb_tree
+    {
+    public:
+        typedef T                                               value_type;
+        typedef const T*                                        const_pointer;
+        typedef const T&                                        const_reference;
+        typedef size_t                                          size_type;
+        typedef ptrdiff_t                                       difference_type;
+
+    private:
+        struct node
+        {
+            std::atomic<size_type> refs;
+            size_type              count;    // 叶子为元素个数，内部节点为子节点个数
+            size_type              shift;    // 叶子为 0，父节点比子节点大 rrb_bits
+            bool                   relaxed;  // sizes 是否有效
+        };
+
+        struct leaf_node : public node
+        {
+            typename std::aligned_storage<sizeof(T), alignof(T)>::type slots[rrb_branches];
+
+            T*       data()       noexcept { return reinterpret_cast<T*>(slots); }
+            const T* data() const noexcept { return reinterpret_cast<const T*>(slots); }
+        };
+
+        struct inner_node : public node
+        {
+            node*     child[rrb_branches];
+            size_type sizes[rrb_branches];   // relaxed 节点中，前 i + 1 个子节点的元素个数之和
+        };
+
+        typedef ministl::allocator<T>          data_allocator;
+        typedef ministl::allocator<leaf_node>  leaf_allocator;
+        typedef ministl::allocator<inner_node> inner_allocator;
+
+        // 持有一个节点的引用，异常发生时释放已经新建的节点
+        class node_holder
+        {
+        private:
+            node* p_;
+
+        public:
+            explicit node_holder(node* p = nullptr) noexcept : p_(p) {}
+            node_holder(const node_holder&) = delete;
+            node_holder& operator=(const node_holder&) = delete;
+            ~node_holder() { release(p_); }
+
+            node* get() const noexcept { return p_; }
+            void  reset(node* p) noexcept { release(p_); p_ = p; }
+            node* take() noexcept
+            {
+                node* p = p_;
+                p_ = nullptr;
+                return p;
+            }
+        };
+
+        node*      root_;   // 树为空时为 nullptr，可能直接是一个叶子
+        leaf_node* tail_;   // size_ == 0 时为 nullptr，否则至少有一个元素
+        size_type  size_;
+
+    public:
+        // 构造、复制、移动、析构函数
+        rrb_tree() noexcept : root_(nullptr), tail_(nullptr), size_(0) {}
+
+        rrb_tree(const rrb_tree& rhs) noexcept : root_(rhs.root_), tail_(rhs.tail_), size_(rhs.size_)
+        {
+            retain(root_);
+            retain(tail_);
+        }
+
+        rrb_tree(rrb_tree&& rhs) noexcept : root_(rhs.root_), tail_(rhs.tail_), size_(rhs.size_)
+        {
+            rhs.root_ = nullptr;
+            rhs.tail_ = nullptr;
+            rhs.size_ = 0;
+        }
+
+        rrb_tree& operator=(const rrb_tree& rhs) noexcept
+        {
+            rrb_tree tmp(rhs);
+            swap(tmp);
+            return *this;
+        }
+
+        rrb_tree& operator=(rrb_tree&& rhs) noexcept
+        {
+            rrb_tree tmp(ministl::move(rhs));
+            swap(tmp);
+            return *this;
+        }
+
+        ~rrb_tree()
+        {
+            release(root_);
+            release(tail_);
+        }
+
+    public:
+        // 容量、访问相关操作
+        bool      empty() const noexcept { return size_ == 0; }
+        size_type size()  const noexcept { return size_; }
+
+        const_reference get(size_type i) const noexcept
+        {
+            const size_type offset = tail_offset();
+            if (i >= offset)
+                return tail_->data()[i - offset];
+            const node* n = root_;
+            while (n->shift != 0)
+            {
+                const inner_node* in = static_cast<const inner_node*>(n);
+                n = in->child[child_index(in, i)];
+            }
+            return static_cast<const leaf_node*>(n)->data()[i];
+        }
+
+        // 返回包含第 i 个元素的叶子的元素数组，该叶子覆盖下标 [first, last)
+        const_pointer leaf_for(size_type i, size_type& first, size_type& last) const noexcept
+        {
+            const leaf_node* l = find_leaf(i, first);
+            last = first + l->count;
+            return l->data();
+        }
+
+        // 按顺序对每个叶子调用 f(first, last)
+        template <class F>
+        void for_each_chunk(F& f) const
+        {
+            if (root_ != nullptr)
+                visit(root_, f);
+            if (tail_ != nullptr)
+                f(tail_->data(), tail_->data() + tail_->count);
+        }
+
+        // 修改相关操作，只改动引用计数为 1 的节点，其余的先复制
+        template <class... Args>
+        void emplace_back(Args&&... args)
+        {
+            if (tail_ != nullptr && tail_->count < rrb_branches)
+            {
+                editable_tail();
+                data_allocator::construct(tail_->data() + tail_->count, ministl::forward<Args>(args)...);
+                ++tail_->count;
+                ++size_;
+                return;
+            }
+            // 参数可能引用旧 tail 中的元素，先构造出新的 tail，再把旧 tail 挂进树里
+            leaf_node* l = new_leaf();
+            node_holder guard(l);
+            data_allocator::construct(l->data(), ministl::forward<Args>(args)...);
+            l->count = 1;
+            if (tail_ != nullptr)
+                push_leaf(tail_, tail_offset());
+            tail_ = static_cast<leaf_node*>(guard.take());
+            ++size_;
+        }
+
+        template <class Iter>
+        void append(Iter first, Iter last)
+        {
+            append_range(first, last, typename ministl::iterator_traits<Iter>::iterator_category());
+        }
+
+        template <class V>
+        void set(size_type i, V&& value)
+        {
+            const size_type offset = tail_offset();
+            if (i >= offset)
+            {
+                editable_tail();
+                tail_->data()[i - offset] = ministl::forward<V>(value);
+                return;
+            }
+            node** slot = &root_;
+            while ((*slot)->shift != 0)
+            {
+                inner_node* in = editable_inner(*slot);
+                slot = &in->child[child_index(in, i)];
+            }
+            editable_leaf(*slot)->data()[i] = ministl::forward<V>(value);
+        }
+
+        // 只保留前 n 个元素
+        void take(size_type n)
+        {
+            if (n >= size_)
+                return;
+            if (n == 0)
+            {
+                clear();
+                return;
+            }
+            const size_type offset = tail_offset();
+            if (n > offset)
+            {
+                editable_tail();
+                data_allocator::destroy(tail_->data() + (n - offset), tail_->data() + tail_->count);
+                tail_->count = n - offset;
+                size_ = n;
+                return;
+            }
+            // 包含第 n - 1 个元素的叶子成为新的 tail，树只保留它之前的部分
+            size_type first = 0;
+            leaf_node* l = find_leaf(n - 1, first);
+            node_holder new_tail(first + l->count == n ? retained(l) : copy_leaf(l->data(), n - first));
+            node* new_root = first == 0 ? nullptr : slice_right(root_, first);
+            release(root_);
+            release(tail_);
+            root_ = new_root;
+            tail_ = static_cast<leaf_node*>(new_tail.take());
+            size_ = n;
+            collapse_root();
+        }
+
+        // 去掉前 n 个元素
+        void drop(size_type n)
+        {
+            if (n == 0)
+                return;
+            if (n >= size_)
+            {
+                clear();
+                return;
+            }
+            const size_type offset = tail_offset();
+            if (n >= offset)
+            {
+                leaf_node* t = copy_leaf(tail_->data() + (n - offset), size_ - n);
+                release(root_);
+                release(tail_);
+                root_ = nullptr;
+                tail_ = t;
+            }
+            else
+            {
+                node* r = slice_left(root_, offset, n);
+                release(root_);
+                root_ = r;
+                collapse_root();
+            }
+            size_ -= n;
+        }
+
+        // 在末尾接上 rhs 的全部元素
+        void concat(const rrb_tree& rhs)
+        {
+            if (rhs.size_ == 0)
+                return;
+            rrb_tree right(rhs);   // rhs 可能就是 *this
+            if (size_ == 0)
+            {
+                swap(right);
+                return;
+            }
+            if (right.root_ == nullptr)
+            {
+                append(right.tail_->data(), right.tail_->data() + right.tail_->count);
+                return;
+            }
+            // 先把左边的 tail 挂进树里，再合并两棵树，右边的 tail 成为新的 tail
+            rrb_tree left(*this);
+            left.push_leaf(left.tail_, left.tail_offset());
+            left.tail_ = nullptr;
+            node* merged = concat_trees(left.root_, right.root_);
+            release(root_);
+            release(tail_);
+            root_ = merged;
+            tail_ = right.tail_;
+            right.tail_ = nullptr;
+            size_ += right.size_;
+            collapse_root();
+        }
+
+        void clear() noexcept
+        {
+            release(root_);
+            release(tail_);
+            root_ = nullptr;
+            tail_ = nullptr;
+            size_ = 0;
+        }
+
+        void swap(rrb_tree& rhs) noexcept
+        {
+            ministl::swap(root_, rhs.root_);
+            ministl::swap(tail_, rhs.tail_);
+            ministl::swap(size_, rhs.size_);
+        }
+
+        bool same_as(const rrb_tree& rhs) const noexcept
+        {
+            return root_ == rhs.root_ && tail_ == rhs.tail_ && size_ == rhs.size_;
+        }
+
+    private:
+        /*****************************************节点的分配与释放*******************************************/
+        static void retain(node* n) noexcept
+        {
+            if (n != nullptr)
+                n->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        static node* retained(node* n) noexcept
+        {
+            retain(n);
+            return n;
+        }
+
+        static void release(node* n) noexcept
+        {
+            if (n == nullptr || n->refs.fetch_sub(1, std::memory_order_acq_rel) != 1)
+                return;
+            if (n->shift == 0)
+            {
+                leaf_node* l = static_cast<leaf_node*>(n);
+                data_allocator::destroy(l->data(), l->data() + l->count);
+                l->~leaf_node();
+                leaf_allocator::deallocate(l);
+            }
+            else
+            {
+                inner_node* in = static_cast<inner_node*>(n);
+                for (size_type i = 0; i < in->count; ++i)
+                    release(in->child[i]);
+                in->~inner_node();
+                inner_allocator::deallocate(in);
+            }
+        }
+
+        static void init_node(node* n, size_type shift) noexcept
+        {
+            n->refs.store(1, std::memory_order_relaxed);
+            n->count = 0;
+            n->shift = shift;
+            n->relaxed = false;
+        }
+
+        static leaf_node* new_leaf()
+        {
+            leaf_node* l = ::new (static_cast<void*>(leaf_allocator::allocate(1))) leaf_node;
+            init_node(l, 0);
+            return l;
+        }
+
+        static inner_node* new_inner(size_type shift)
+        {
+            inner_node* in = ::new (static_cast<void*>(inner_allocator::allocate(1))) inner_node;
+            init_node(in, shift);
+            return in;
+        }
+
+        template <class Iter>
+        static leaf_node* copy_leaf(Iter first, size_type n)
+        {
+            leaf_node* l = new_leaf();
+            node_holder guard(l);
+            ministl::uninitialized_copy(first, first + n, l->data());
+            l->count = n;
+            return static_cast<leaf_node*>(guard.take());
+        }
+
+        static inner_node* copy_inner(const inner_node* n)
+        {
+            inner_node* in = new_inner(n->shift);
+            for (size_type i = 0; i < n->count; ++i)
+                in->child[i] = retained(n->child[i]);
+            if (n->relaxed)
+                ministl::copy(n->sizes, n->sizes + n->count, in->sizes);
+            in->count = n->count;
+            in->relaxed = n->relaxed;
+            return in;
+        }
+
+        // slot 指向的节点被共享时换成一份独占的拷贝；复制失败时 slot 不变
+        static leaf_node* editable_leaf(node*& slot)
+        {
+            leaf_node* l = static_cast<leaf_node*>(slot);
+            if (l->refs.load(std::memory_order_acquire) != 1)
+            {
+                leaf_node* c = copy_leaf(l->data(), l->count);
+                release(l);
+                slot = l = c;
+            }
+            return l;
+        }
+
+        static inner_node* editable_inner(node*& slot)
+        {
+            inner_node* in = static_cast<inner_node*>(slot);
+            if (in->refs.load(std::memory_order_acquire) != 1)
+            {
+                inner_node* c = copy_inner(in);
+                release(in);
+                slot = in = c;
+            }
+            return in;
+        }
+
+        void editable_tail()
+        {
+            node* slot = tail_;
+            tail_ = editable_leaf(slot);
+        }
+
+        /*****************************************查找与尺寸*******************************************/
+        size_type tail_offset() const noexcept { return size_ - (tail_ == nullptr ? 0 : tail_->count); }
+
+        static size_type node_size(const node* n) noexcept
+        {
+            size_type size = 0;
+            while (n->shift != 0)
+            {
+                const inner_node* in = static_cast<const inner_node*>(n);
+                if (in->relaxed)
+                    return size + in->sizes[in->count - 1];
+                size += (in->count - 1) << in->shift;
+                n = in->child[in->count - 1];
+            }
+            return size + n->count;
+        }
+
+        // 前 k + 1 个子节点的元素个数之和，size 为 n 的元素个数
+        static size_type size_through(const inner_node* n, size_type size, size_type k) noexcept
+        {
+            if (n->relaxed)
+                return n->sizes[k];
+            return k + 1 == n->count ? size : (k + 1) << n->shift;
+        }
+
+        // 返回第 i 个元素所在的子节点，i 改为在该子节点中的下标
+        static size_type child_index(const inner_node* n, size_type& i) noexcept
+        {
+            size_type idx = i >> n->shift;
+            if (n->relaxed)
+            {
+                // 每个子节点至多 2^shift 个元素，估计值不会越过真正的下标
+                while (n->sizes[idx] <= i)
+                    ++idx;
+                if (idx != 0)
+                    i -= n->sizes[idx - 1];
+            }
+            else
+            {
+                i -= idx << n->shift;
+            }
+            return idx;
+        }
+
+        leaf_node* find_leaf(size_type i, size_type& first) const noexcept
+        {
+            const size_type offset = tail_offset();
+            if (i >= offset)
+            {
+                first = offset;
+                return tail_;
+            }
+            first = i;
+            node* n = root_;
+            while (n->shift != 0)
+            {
+                inner_node* in = static_cast<inner_node*>(n);
+                n = in->child[child_index(in, i)];
+            }
+            first -= i;
+            return static_cast<leaf_node*>(n);
+        }
+
+        // 由子节点重新计算 sizes，除最后一个外子节点都是满的时为规则节点
+        static void finalize_inner(inner_node* n) noexcept
+        {
+            const size_type full = size_type(1) << n->shift;
+            size_type total = 0;
+            bool regular = true;
+            for (size_type i = 0; i < n->count; ++i)
+            {
+                const size_type s = node_size(n->child[i]);
+                regular = regular && (i + 1 == n->count || s == full);
+                total += s;
+                n->sizes[i] = total;
+            }
+            n->relaxed = !regular;
+        }
+
+        static void make_relaxed(inner_node* n, size_type size) noexcept
+        {
+            for (size_type i = 0; i < n->count; ++i)
+                n->sizes[i] = size_through(n, size, i);
+            n->relaxed = true;
+        }
+
+        template <class F>
+        static void visit(const node* n, F& f)
+        {
+            if (n->shift == 0)
+            {
+                const leaf_node* l = static_cast<const leaf_node*>(n);
+                f(l->data(), l->data() + l->count);
+                return;
+            }
+            const inner_node* in = static_cast<const inner_node*>(n);
+            for (size_type i = 0; i < in->count; ++i)
+                visit(in->child[i], f);
+        }
+
+        /*****************************************在末尾挂上叶子*******************************************/
+        // 树的最右侧路径上还有没满的内部节点
+        static bool can_push(const node* n) noexcept
+        {
+            while (n->shift != 0)
+            {
+                const inner_node* in = static_cast<const inner_node*>(n);
+                if (in->count < rrb_branches)
+                    return true;
+                n = in->child[in->count - 1];
+            }
+            return false;
+        }
+
+        // 一条从 shift 层到叶子 l 的单链
+        static node* new_path(leaf_node* l, size_type shift)
+        {
+            if (shift == 0)
+                return l;
+            inner_node* in = new_inner(shift);
+            node_holder guard(in);
+            in->child[0] = new_path(l, shift - rrb_bits);
+            in->count = 1;
+            return guard.take();
+        }
+
+        // 把叶子 l 挂到树的末尾，tree_size 为树中的元素个数；成功后树接管 l 的引用
+        void push_leaf(leaf_node* l, size_type tree_size)
+        {
+            if (root_ == nullptr)
+            {
+                root_ = l;
+                return;
+            }
+            if (can_push(root_))
+            {
+                push_leaf(root_, tree_size, l);
+                return;
+            }
+            // 根已经满了，树长高一层
+            const size_type shift = root_->shift + rrb_bits;
+            inner_node* r = new_inner(shift);
+            node_holder guard(r);
+            node* path = new_path(l, shift - rrb_bits);
+            guard.take();
+            r->child[0] = root_;
+            r->child[1] = path;
+            r->count = 2;
+            if (tree_size != (size_type(1) << shift))
+            {
+                r->relaxed = true;
+                r->sizes[0] = tree_size;
+                r->sizes[1] = tree_size + l->count;
+            }
+            root_ = r;
+        }
+
+        static void push_leaf(node*& slot, size_type size, leaf_node* l)
+        {
+            inner_node* in = editable_inner(slot);
+            const size_type last = in->count - 1;
+            const size_type last_size = size - (last == 0 ? 0 : size_through(in, size, last - 1));
+            if (in->shift > rrb_bits && can_push(in->child[last]))
+            {
+                push_leaf(in->child[last], last_size, l);
+            }
+            else
+            {
+                node* path = new_path(l, in->shift - rrb_bits);
+                // 最后一个子节点不满时，新的子节点接在它后面，下标不能再直接算出
+                if (!in->relaxed && last_size != (size_type(1) << in->shift))
+                    make_relaxed(in, size);
+                in->child[in->count++] = path;
+            }
+            if (in->relaxed)
+                in->sizes[in->count - 1] = size + l->count;
+        }
+
+        template <class Iter>
+        void append_range(Iter first, Iter last, ministl::input_iterator_tag)
+        {
+            for (; first != last; ++first)
+                emplace_back(*first);
+        }
+
+        // 随机访问的区间整块复制到叶子中
+        template <class Iter>
+        void append_range(Iter first, Iter last, ministl::random_access_iterator_tag)
+        {
+            while (first != last)
+            {
+                const size_type rest = static_cast<size_type>(last - first);
+                if (tail_ != nullptr && tail_->count < rrb_branches)
+                {
+                    editable_tail();
+                    const size_type n = ministl::min(rest, rrb_branches - tail_->count);
+                    ministl::uninitialized_copy(first, first + n, tail_->data() + tail_->count);
+                    tail_->count += n;
+                    size_ += n;
+                    first += n;
+                }
+                else
+                {
+                    const size_type n = ministl::min(rest, rrb_branches);
+                    node_holder l(copy_leaf(first, n));
+                    if (tail_ != nullptr)
+                        push_leaf(tail_, tail_offset());
+                    tail_ = static_cast<leaf_node*>(l.take());
+                    size_ += n;
+                    first += n;
+                }
+            }
+        }
+
+        /*****************************************切片*******************************************/
+        // 根只有一个子节点时，用子节点代替根
+        void collapse_root() noexcept
+        {
+            while (root_ != nullptr && root_->shift != 0 && root_->count == 1)
+            {
+                node* c = retained(static_cast<inner_node*>(root_)->child[0]);
+                release(root_);
+                root_ = c;
+            }
+        }
+
+        // 返回只含 n 的前 end 个元素的节点，0 < end <= n 的元素个数
+        static node* slice_right(node* n, size_type end)
+        {
+            if (n->shift == 0)
+            {
+                leaf_node* l = static_cast<leaf_node*>(n);
+                return end == l->count ? retained(l) : copy_leaf(l->data(), end);
+            }
+            inner_node* in = static_cast<inner_node*>(n);
+            size_type i = end - 1;
+            const size_type idx = child_index(in, i);
+            node_holder c(slice_right(in->child[idx], i + 1));
+            inner_node* r = new_inner(in->shift);
+            for (size_type k = 0; k < idx; ++k)
+                r->child[k] = retained(in->child[k]);
+            r->child[idx] = c.take();
+            r->count = idx + 1;
+            if (in->relaxed)
+            {
+                ministl::copy(in->sizes, in->sizes + idx, r->sizes);
+                r->sizes[idx] = end;
+                r->relaxed = true;
+            }
+            return r;
+        }
+
+        // 返回去掉 n 的前 from 个元素的节点，size 为 n 的元素个数，from < size
+        static node* slice_left(node* n, size_type size, size_type from)
+        {
+            if (from == 0)
+                return retained(n);
+            if (n->shift == 0)
+            {
+                leaf_node* l = static_cast<leaf_node*>(n);
+                return copy_leaf(l->data() + from, l->count - from);
+            }
+            inner_node* in = static_cast<inner_node*>(n);
+            size_type i = from;
+            const size_type idx = child_index(in, i);
+            const size_type child_size = size_through(in, size, idx) - (from - i);
+            node_holder c(slice_left(in->child[idx], child_size, i));
+            inner_node* r = new_inner(in->shift);
+            r->child[0] = c.take();
+            r->sizes[0] = child_size - i;
+            for (size_type k = idx + 1; k < in->count; ++k)
+            {
+                r->child[k - idx] = retained(in->child[k]);
+                r->sizes[k - idx] = size_through(in, size, k) - from;
+            }
+            r->count = in->count - idx;
+            r->relaxed = true;
+            return r;
+        }
+
+        /*****************************************拼接*******************************************/
+        // 合并两棵树，返回高度为 max(l, r) + 1 的节点，它有一个或两个子节点
+        static node* concat_trees(node* l, node* r)
+        {
+            node* all[2 * rrb_branches];
+            size_type n = 0;
+            if (l->shift == 0 && r->shift == 0)
+            {
+                // 两个叶子由上一层的 rebalance 重排元素
+                inner_node* pair = new_inner(rrb_bits);
+                pair->child[0] = retained(l);
+                pair->child[1] = retained(r);
+                pair->count = 2;
+                finalize_inner(pair);
+                return pair;
+            }
+            inner_node* li = l->shift >= r->shift ? static_cast<inner_node*>(l) : nullptr;
+            inner_node* ri = r->shift >= l->shift ? static_cast<inner_node*>(r) : nullptr;
+            node_holder mid(concat_trees(li != nullptr ? li->child[li->count - 1] : l,
+                                         ri != nullptr ? ri->child[0] : r));
+            if (li != nullptr)
+            {
+                for (size_type i = 0; i + 1 < li->count; ++i)
+                    all[n++] = li->child[i];
+            }
+            const inner_node* m = static_cast<const inner_node*>(mid.get());
+            for (size_type i = 0; i < m->count; ++i)
+                all[n++] = m->child[i];
+            if (ri != nullptr)
+            {
+                for (size_type i = 1; i < ri->count; ++i)
+                    all[n++] = ri->child[i];
+            }
+            return rebalance(all, n);
+        }
+
+        // all 中的节点同高，重新分配它们的元素(或子节点)使节点数不超过最优个数加 rrb_extras，
+        // 返回高两层的节点，它有一个或两个子节点
+        static node* rebalance(node* const* all, size_type n)
+        {
+            const size_type shift = all[0]->shift;
+            size_type plan[2 * rrb_branches];
+            size_type total = 0;
+            for (size_type i = 0; i < n; ++i)
+            {
+                plan[i] = all[i]->count;
+                total += plan[i];
+            }
+            const size_type optimal = (total + rrb_branches - 1) / rrb_branches;
+            size_type len = n;
+            size_type i = 0;
+            while (len > optimal + rrb_extras)
+            {
+                // 找到一个不够满的节点，把它的内容依次挤进后面的节点，然后去掉它
+                while (plan[i] > rrb_branches - rrb_invariant)
+                    ++i;
+                size_type remaining = plan[i];
+                do
+                {
+                    MINISTL_DEBUG(i + 1 < len);
+                    const size_type merged = ministl::min(remaining + plan[i + 1], rrb_branches);
+                    plan[i] = merged;
+                    remaining = remaining + plan[i + 1] - merged;
+                    ++i;
+                } while (remaining > 0);
+                for (size_type j = i; j + 1 < len; ++j)
+                    plan[j] = plan[j + 1];
+                --len;
+                --i;
+            }
+
+            // 按计划依次搬运，大小没变且没有错位的节点直接共享
+            node_holder built[2 * rrb_branches];
+            size_type src = 0;
+            size_type offset = 0;
+            for (size_type k = 0; k < len; ++k)
+            {
+                if (offset == 0 && all[src]->count == plan[k])
+                {
+                    built[k].reset(retained(all[src++]));
+                    continue;
+                }
+                if (shift == 0)
+                {
+                    leaf_node* l = new_leaf();
+                    built[k].reset(l);
+                    while (l->count < plan[k])
+                    {
+                        const leaf_node* s = static_cast<const leaf_node*>(all[src]);
+                        const size_type m = ministl::min(plan[k] - l->count, s->count - offset);
+                        ministl::uninitialized_copy(s->data() + offset, s->data() + offset + m, l->data() + l->count);
+                        l->count += m;
+                        offset += m;
+                        if (offset == s->count)
+                        {
+                            ++src;
+                            offset = 0;
+                        }
+                    }
+                }
+                else
+                {
+                    inner_node* in = new_inner(shift);
+                    built[k].reset(in);
+                    while (in->count < plan[k])
+                    {
+                        const inner_node* s = static_cast<const inner_node*>(all[src]);
+                        in->child[in->count++] = retained(s->child[offset++]);
+                        if (offset == s->count)
+                        {
+                            ++src;
+                            offset = 0;
+                        }
+                    }
+                    finalize_inner(in);
+                }
+            }
+
+            inner_node* pair = new_inner(shift + 2 * rrb_bits);
+            node_holder guard(pair);
+            for (size_type first = 0; first < len; first += rrb_branches)
+            {
+                inner_node* in = new_inner(shift + rrb_bits);
+                pair->child[pair->count++] = in;
+                const size_type last = ministl::min(len, first + rrb_branches);
+                for (size_type k = first; k < last; ++k)
+                    in->child[in->count++] = built[k].take();
+                finalize_inner(in);
+            }
+            finalize_inner(pair);
+            return guard.take();
+        }
+    };
+
+    /*****************************************************************************************/
+    // persistent_vector 与 transient_vector 的只读迭代器，缓存当前所在的叶子
+    template <class T>
+    class rrb_iterator : public ministl::iterator<ministl::random_access_iterator_tag, T, ptrdiff_t, const T*, const T&>
+    {
+    public:
+        typedef const T*      pointer;
+        typedef const T&      reference;
+        typedef size_t        size_type;
+        typedef ptrdiff_t     difference_type;
+        typedef rrb_iterator  self;
+
+    private:
+        const rrb_tree<T>* tree_;
+        size_type          index_;
+        mutable const T*   leaf_;
+        mutable size_type  first_;   // leaf_ 覆盖下标 [first_, last_)
+        mutable size_type  last_;
+
+    public:
+        rrb_iterator() noexcept : tree_(nullptr), index_(0), leaf_(nullptr), first_(0), last_(0) {}
+        rrb_iterator(const rrb_tree<T>* tree, size_type index) noexcept
+                : tree_(tree), index_(index), leaf_(nullptr), first_(0), last_(0) {}
+
+        reference operator*() const
+        {
+            // index_ < first_ 时无符号减法回绕，同样会重新定位
+            if (index_ - first_ >= last_ - first_)
+                leaf_ = tree_->leaf_for(index_, first_, last_);
+            return leaf_[index_ - first_];
+        }
+        pointer   operator->() const { return &(operator*()); }
+        reference operator[](difference_type n) const { return *(*this + n); }
+
+        self& operator++()    { ++index_; return *this; }
+        self  operator++(int) { self tmp = *this; ++index_; return tmp; }
+        self& operator--()    { --index_; return *this; }
+        self  operator--(int) { self tmp = *this; --index_; return tmp; }
+
+        self& operator+=(difference_type n) { index_ += n; return *this; }
+        self& operator-=(difference_type n) { index_ -= n; return *this; }
+        self  operator+(difference_type n) const { self tmp = *this; return tmp += n; }
+        self  operator-(difference_type n) const { self tmp = *this; return tmp -= n; }
+
+        difference_type operator-(const self& rhs) const
+        {
+            return static_cast<difference_type>(index_) - static_cast<difference_type>(rhs.index_);
+        }
+
+        bool operator==(const self& rhs) const { return index_ == rhs.index_; }
+        bool operator!=(const self& rhs) const { return index_ != rhs.index_; }
+        bool operator< (const self& rhs) const { return index_ <  rhs.index_; }
+        bool operator> (const self& rhs) const { return index_ >  rhs.index_; }
+        bool operator<=(const self& rhs) const { return index_ <= rhs.index_; }
+        bool operator>=(const self& rhs) const { return index_ >= rhs.index_; }
+    };
+
+    template <class T>
+    rrb_iterator<T> operator+(ptrdiff_t n, const rrb_iterator<T>& it) { return it + n; }
+
+    /*****************************************************************************************/
+    template <class T> class transient_vector;
+
+    template <class T>
+    class persistent_vector
+    {
+        friend class transient_vector<T>;
+
+    public:
+        typedef T                                               value_type;
+        typedef const T*                                        pointer;
+        typedef const T*                                        const_pointer;
+        typedef const T&                                        reference;
+        typedef const T&                                        const_reference;
+        typedef size_t                                          size_type;
+        typedef ptrdiff_t                                       difference_type;
+
+        typedef rrb_iterator<T>                                 iterator;
+        typedef rrb_iterator<T>                                 const_iterator;
+
+    private:
+        rrb_tree<T> tree_;
+
+        explicit persistent_vector(rrb_tree<T>&& tree) noexcept : tree_(ministl::move(tree)) {}
+
+    public:
+        // 构造、复制、移动、析构函数
+        persistent_vector() noexcept {}
+
+        explicit persistent_vector(size_type n) : persistent_vector(n, value_type()) {}
+
+        persistent_vector(size_type n, const value_type& value)
+        {
+            for (size_type i = 0; i < n; ++i)
+                tree_.emplace_back(value);
+        }
+
+        template <class Iter, typename std::enable_if<ministl::is_input_iterator<Iter>::value, int>::type = 0>
+        persistent_vector(Iter first, Iter last) { tree_.append(first, last); }
+
+        persistent_vector(std::initializer_list<value_type> list) { tree_.append(list.begin(), list.end()); }
+
+        // 从 vector 整块复制，每 32 个元素复制一次
+        template <class Alloc>
+        explicit persistent_vector(const ministl::vector<T, Alloc>& v) { tree_.append(v.begin(), v.end()); }
+
+    public:
+        // 迭代器相关操作
+        const_iterator begin()  const noexcept { return const_iterator(&tree_, 0); }
+        const_iterator end()    const noexcept { return const_iterator(&tree_, size()); }
+        const_iterator cbegin() const noexcept { return begin(); }
+        const_iterator cend()   const noexcept { return end(); }
+
+        // 容量、访问相关操作
+        bool      empty()    const noexcept { return tree_.empty(); }
+        size_type size()     const noexcept { return tree_.size(); }
+        size_type max_size() const noexcept { return static_cast<size_type>(-1) / sizeof(T); }
+
+        const_reference operator[](size_type n) const
+        {
+            MINISTL_DEBUG(n < size());
+            return tree_.get(n);
+        }
+
+        const_reference at(size_type n) const
+        {
+            THROW_OUT_OF_RANGE_IF(!(n < size()), "persistent_vector::at() subscript out of range");
+            return tree_.get(n);
+        }
+
+        const_reference front() const { return tree_.get(0); }
+        const_reference back()  const { return tree_.get(size() - 1); }
+
+        // 修改相关操作，均返回新版本，*this 不变
+        persistent_vector push_back(const value_type& value) const
+        {
+            rrb_tree<T> t(tree_);
+            t.emplace_back(value);
+            return persistent_vector(ministl::move(t));
+        }
+
+        persistent_vector push_back(value_type&& value) const
+        {
+            rrb_tree<T> t(tree_);
+            t.emplace_back(ministl::move(value));
+            return persistent_vector(ministl::move(t));
+        }
+
+        persistent_vector pop_back() const
+        {
+            MINISTL_DEBUG(!empty());
+            return take(size() - 1);
+        }
+
+        persistent_vector set(size_type n, const value_type& value) const
+        {
+            THROW_OUT_OF_RANGE_IF(!(n < size()), "persistent_vector::set() subscript out of range");
+            rrb_tree<T> t(tree_);
+            t.set(n, value);
+            return persistent_vector(ministl::move(t));
+        }
+
+        // 第 n 个元素换成 f(旧值)
+        template <class F>
+        persistent_vector update(size_type n, F f) const
+        {
+            THROW_OUT_OF_RANGE_IF(!(n < size()), "persistent_vector::update() subscript out of range");
+            rrb_tree<T> t(tree_);
+            t.set(n, f(tree_.get(n)));
+            return persistent_vector(ministl::move(t));
+        }
+
+        // 前 n 个元素
+        persistent_vector take(size_type n) const
+        {
+            rrb_tree<T> t(tree_);
+            t.take(n);
+            return persistent_vector(ministl::move(t));
+        }
+
+        // 去掉前 n 个元素
+        persistent_vector drop(size_type n) const
+        {
+            rrb_tree<T> t(tree_);
+            t.drop(n);
+            return persistent_vector(ministl::move(t));
+        }
+
+        // 下标 [first, last) 的元素
+        persistent_vector slice(size_type first, size_type last) const
+        {
+            MINISTL_DEBUG(first <= last);
+            rrb_tree<T> t(tree_);
+            t.take(last);
+            t.drop(first);
+            return persistent_vector(ministl::move(t));
+        }
+
+        persistent_vector concat(const persistent_vector& rhs) const
+        {
+            rrb_tree<T> t(tree_);
+            t.concat(rhs.tree_);
+            return persistent_vector(ministl::move(t));
+        }
+
+        // 转换相关操作
+        transient_vector<T> transient() const { return transient_vector<T>(*this); }
+
+        ministl::vector<T> to_vector() const
+        {
+            ministl::vector<T> v;
+            v.reserve(size());
+            auto append = [&v](const T* first, const T* last) { v.insert(v.end(), first, last); };
+            tree_.for_each_chunk(append);
+            return v;
+        }
+
+        void swap(persistent_vector& rhs) noexcept { tree_.swap(rhs.tree_); }
+
+        // 两个版本是否共享同一份数据，此时一定相等
+        bool identical(const persistent_vector& rhs) const noexcept { return tree_.same_as(rhs.tree_); }
+    };
+
+    /*****************************************************************************************/
+    template <class T>
+    class transient_vector
+    {
+    public:
+        typedef T                                               value_type;
+        typedef const T&                                        const_reference;
+        typedef size_t                                          size_type;
+        typedef ptrdiff_t                                       difference_type;
+
+        typedef rrb_iterator<T>                                 const_iterator;
+
+    private:
+        rrb_tree<T> tree_;
+
+    public:
+        transient_vector() noexcept {}
+        explicit transient_vector(const persistent_vector<T>& v) noexcept : tree_(v.tree_) {}
+
+        // 得到当前内容的一个版本；之后仍可继续修改，碰到与该版本共享的节点时先复制
+        persistent_vector<T> persistent() const { return persistent_vector<T>(rrb_tree<T>(tree_)); }
+
+        const_iterator begin() const noexcept { return const_iterator(&tree_, 0); }
+        const_iterator end()   const noexcept { return const_iterator(&tree_, size()); }
+
+        bool      empty() const noexcept { return tree_.empty(); }
+        size_type size()  const noexcept { return tree_.size(); }
+
+        const_reference operator[](size_type n) const
+        {
+            MINISTL_DEBUG(n < size());
+            return tree_.get(n);
+        }
+
+        const_reference at(size_type n) const
+        {
+            THROW_OUT_OF_RANGE_IF(!(n < size()), "transient_vector::at() subscript out of range");
+            return tree_.get(n);
+        }
+
+        const_reference front() const { return tree_.get(0); }
+        const_reference back()  const { return tree_.get(size() - 1); }
+
+        template <class... Args>
+        void emplace_back(Args&&... args) { tree_.emplace_back(ministl::forward<Args>(args)...); }
+
+        void push_back(const value_type& value) { tree_.emplace_back(value); }
+        void push_back(value_type&& value)      { tree_.emplace_back(ministl::move(value)); }
+
+        template <class Iter, typename std::enable_if<ministl::is_input_iterator<Iter>::value, int>::type = 0>
+        void append(Iter first, Iter last) { tree_.append(first, last); }
+
+        void append(const persistent_vector<T>& v) { tree_.concat(v.tree_); }
+
+        void pop_back()
+        {
+            MINISTL_DEBUG(!empty());
+            tree_.take(size() - 1);
+        }
+
+        void set(size_type n, const value_type& value)
+        {
+            MINISTL_DEBUG(n < size());
+            tree_.set(n, value);
+        }
+
+        void set(size_type n, value_type&& value)
+        {
+            MINISTL_DEBUG(n < size());
+            tree_.set(n, ministl::move(value));
+        }
+
+        void take(size_type n) { tree_.take(n); }
+        void drop(size_type n) { tree_.drop(n); }
+        void clear() noexcept  { tree_.clear(); }
+    };
+
+    /*****************************************************************************************/
+
+    template <class T>
+    bool operator==(const persistent_vector<T>& lhs, const persistent_vector<T>& rhs)
+    {
+        return lhs.identical(rhs) ||
+               (lhs.size() == rhs.size() && ministl::equal(lhs.begin(), lhs.end(), rhs.begin()));
+    }
+
+    template <class T>
+    bool operator!=(const persistent_vector<T>& lhs, const persistent_vector<T>& rhs) { return !(lhs == rhs); }
+
+    template <class T>
+    persistent_vector<T> operator+(const persistent_vector<T>& lhs, const persistent_vector<T>& rhs)
+    {
+        return lhs.concat(rhs);
+    }
+
+    template <class T>
+    void swap(persistent_vector<T>& lhs, persistent_vector<T>& rhs) noexcept { lhs.swap(rhs); }
+}
+
+#endif //MINISTL_PERSISTENT_VECTOR_H
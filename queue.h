@@ -0,0 +1,186 @@
+#ifndef MINISTL_QUEUE_H
+#define MINISTL_QUEUE_H
+
+// 这个头文件包含一个模板类 priority_queue
+// priority_queue : 优先队列，底层为 d 叉堆，默认容器为 vector
+
+// notes:
+// Arity 为堆的叉数，默认 4。一个节点的子节点连续存放，sizeof(T) * Arity 不超过 64 字节时
+// 下溯每层只扫描一两条 cache line，树高也只有二叉堆的一半(Arity = 4)或三分之一(Arity = 8)。
+// 批量操作：
+//   * 用已有容器构造时整体 O(n) 建堆，而不是逐个 push
+//   * push_range 一次追加一段元素，追加量不少于原有元素个数时整体重新建堆，否则逐个上溯
+//   * pop_n 依次把最大的 n 个元素换到容器尾部，按出队顺序写到 result，最后一次性从容器中删除
+
+#include <initializer_list>
+
+#include "functional.h"
+#include "heap_algo.h"
+#include "vector.h"
+
+namespace ministl
+{
+    template <class T, class Container = ministl::vector<T>,
+              class Compare = ministl::less<typename Container::value_type>, size_t Arity = 4>
+    class priority_queue
+    {
+        static_assert(Arity >= 2, "priority_queue's arity must be at least 2");
+
+    public:
+        typedef Container                           container_type;
+        typedef Compare                             value_compare;
+        typedef typename Container::value_type      value_type;
+        typedef typename Container::size_type       size_type;
+        typedef typename Container::reference       reference;
+        typedef typename Container::const_reference const_reference;
+
+        static constexpr size_t arity = Arity;
+
+    private:
+        container_type c_;
+        value_compare  comp_;
+
+    public:
+        priority_queue() = default;
+
+        explicit priority_queue(const Compare& comp) : c_(), comp_(comp) {}
+
+        priority_queue(const Compare& comp, const Container& c) : c_(c), comp_(comp)
+        {
+            ministl::dary_make_heap<Arity>(c_.begin(), c_.end(), comp_);
+        }
+
+        priority_queue(const Compare& comp, Container&& c) : c_(ministl::move(c)), comp_(comp)
+        {
+            ministl::dary_make_heap<Arity>(c_.begin(), c_.end(), comp_);
+        }
+
+        template <class Iter, typename std::enable_if<ministl::is_input_iterator<Iter>::value, int>::type = 0>
+        priority_queue(Iter first, Iter last, const Compare& comp = Compare()) : c_(first, last), comp_(comp)
+        {
+            ministl::dary_make_heap<Arity>(c_.begin(), c_.end(), comp_);
+        }
+
+        priority_queue(std::initializer_list<value_type> list, const Compare& comp = Compare())
+                : c_(list), comp_(comp)
+        {
+            ministl::dary_make_heap<Arity>(c_.begin(), c_.end(), comp_);
+        }
+
+        priority_queue(const priority_queue&) = default;
+        priority_queue(priority_queue&&) = default;
+        priority_queue& operator=(const priority_queue&) = default;
+        priority_queue& operator=(priority_queue&&) = default;
+
+        priority_queue& operator=(std::initializer_list<value_type> list)
+        {
+            c_ = list;
+            ministl::dary_make_heap<Arity>(c_.begin(), c_.end(), comp_);
+            return *this;
+        }
+
+        ~priority_queue() = default;
+
+    public:
+        // 访问元素相关操作
+        const_reference top() const
+        {
+            MINISTL_DEBUG(!empty());
+            return c_.front();
+        }
+
+        // 容量相关操作
+        bool      empty() const noexcept { return c_.empty(); }
+        size_type size()  const noexcept { return c_.size(); }
+
+        // 修改容器相关操作
+        template <class ...Args>
+        void emplace(Args&& ...args)
+        {
+            c_.emplace_back(ministl::forward<Args>(args)...);
+            ministl::dary_push_heap<Arity>(c_.begin(), c_.end(), comp_);
+        }
+
+        void push(const value_type& value)
+        {
+            c_.push_back(value);
+            ministl::dary_push_heap<Arity>(c_.begin(), c_.end(), comp_);
+        }
+
+        void push(value_type&& value)
+        {
+            c_.push_back(ministl::move(value));
+            ministl::dary_push_heap<Arity>(c_.begin(), c_.end(), comp_);
+        }
+
+        template <class Iter, typename std::enable_if<ministl::is_input_iterator<Iter>::value, int>::type = 0>
+        void push_range(Iter first, Iter last)
+        {
+            const size_type old_size = c_.size();
+            c_.insert(c_.end(), first, last);
+            const size_type added = c_.size() - old_size;
+            if (added >= old_size)
+            {
+                ministl::dary_make_heap<Arity>(c_.begin(), c_.end(), comp_);
+                return;
+            }
+            for (size_type n = old_size + 1; n <= c_.size(); ++n)
+                ministl::dary_push_heap<Arity>(c_.begin(), c_.begin() + n, comp_);
+        }
+
+        void pop()
+        {
+            MINISTL_DEBUG(!empty());
+            ministl::dary_pop_heap<Arity>(c_.begin(), c_.end(), comp_);
+            c_.pop_back();
+        }
+
+        // 取出最大的 min(n, size()) 个元素，按出队顺序写到 result，返回写完之后的 result
+        template <class OutputIter>
+        OutputIter pop_n(size_type n, OutputIter result)
+        {
+            n = ministl::min(n, c_.size());
+            const auto last = c_.end();
+            const auto tail = last - n;
+            for (auto heap_end = last; heap_end != tail; --heap_end)
+                ministl::dary_pop_heap<Arity>(c_.begin(), heap_end, comp_);
+            // 先出队的元素在更靠后的位置
+            for (auto it = last; it != tail;)
+                *result++ = ministl::move(*--it);
+            c_.erase(tail, last);
+            return result;
+        }
+
+        void clear() { c_.clear(); }
+
+        void swap(priority_queue& rhs) noexcept
+        {
+            ministl::swap(c_, rhs.c_);
+            ministl::swap(comp_, rhs.comp_);
+        }
+
+    public:
+        friend bool operator==(const priority_queue& lhs, const priority_queue& rhs)
+        {
+            return lhs.c_ == rhs.c_;
+        }
+
+        friend bool operator!=(const priority_queue& lhs, const priority_queue& rhs)
+        {
+            return lhs.c_ != rhs.c_;
+        }
+    };
+
+    template <class T, class Container, class Compare, size_t Arity>
+    constexpr size_t priority_queue<T, Container, Compare, Arity>::arity;
+
+    // 重载 ministl 的 swap
+    template <class T, class Container, class Compare, size_t Arity>
+    void swap(priority_queue<T, Container, Compare, Arity>& lhs,
+              priority_queue<T, Container, Compare, Arity>& rhs) noexcept
+    {
+        lhs.swap(rhs);
+    }
+}
+
+#endif //MINISTL_QUEUE_H
@@ -0,0 +1,158 @@
+#ifndef MINISTL_RCU_VECTOR_H
+#define MINISTL_RCU_VECTOR_H
+
+// 这个头文件包含一个模板类 rcu_vector
+// rcu_vector : 读多写少的 vector，读者无锁地取得快照，写者复制、修改后原子地发布新版本(read-copy-update)
+
+// notes:
+// 当前版本是堆上的一个 vector<T>，由一个原子指针发布：
+//   * 读者：read() 进入 epoch 临界区再读取指针，返回的 snapshot 析构之前一直有效，通过它读取元素与读 vector 相同。
+//     读者不加锁，也不修改任何共享的计数器，多个读者之间没有缓存行争用
+//   * 写者：update(f) 持有写锁，复制当前版本，在副本上调用 f，再用一次原子交换发布；
+//     被替换下来的版本交给 epoch_domain::retire，等所有可能持有它的读者离开临界区后释放
+// 写者之间串行，每次修改复制整个 vector，适合低频更新，多处修改应放在同一个 update 中。
+// snapshot 只应短暂持有，长期持有会推迟所有旧版本的回收；销毁 rcu_vector 时不能有读者持有它的快照。
+// 异常保证：
+//   update 中 f 或复制抛出异常时，当前版本不变
+
+#include <atomic>
+#include <initializer_list>
+#include <mutex>
+
+#include "epoch.h"
+#include "exception.h"
+#include "util.h"
+#include "vector.h"
+
+namespace ministl
+{
+    template <class T>
+    class rcu_vector
+    {
+    public:
+        typedef T                                               value_type;
+        typedef ministl::vector<T>                              vector_type;
+        typedef const T&                                        const_reference;
+        typedef size_t                                          size_type;
+        typedef typename vector_type::const_iterator            const_iterator;
+
+        // 读者持有的快照，析构时离开临界区
+        class snapshot
+        {
+        private:
+            const vector_type* v_;
+
+        public:
+            explicit snapshot(const std::atomic<vector_type*>& current) : v_(nullptr)
+            {
+                epoch_domain::instance().enter();
+                v_ = current.load(std::memory_order_acquire);
+            }
+
+            snapshot(snapshot&& rhs) noexcept : v_(rhs.v_) { rhs.v_ = nullptr; }
+            snapshot(const snapshot&) = delete;
+            snapshot& operator=(const snapshot&) = delete;
+            snapshot& operator=(snapshot&&) = delete;
+
+            ~snapshot()
+            {
+                if (v_ != nullptr)
+                    epoch_domain::instance().leave();
+            }
+
+            const vector_type& operator*()  const noexcept { return *v_; }
+            const vector_type* operator->() const noexcept { return v_; }
+
+            const_iterator  begin() const noexcept { return v_->begin(); }
+            const_iterator  end()   const noexcept { return v_->end(); }
+            bool            empty() const noexcept { return v_->empty(); }
+            size_type       size()  const noexcept { return v_->size(); }
+            const_reference operator[](size_type n) const { return (*v_)[n]; }
+        };
+
+    private:
+        std::atomic<vector_type*> current_;
+        std::mutex                write_lock_;
+
+    public:
+        // 构造、析构函数
+        rcu_vector() : current_(new vector_type()) {}
+
+        explicit rcu_vector(const vector_type& v) : current_(new vector_type(v)) {}
+
+        explicit rcu_vector(vector_type&& v) : current_(new vector_type(ministl::move(v))) {}
+
+        rcu_vector(std::initializer_list<value_type> list) : current_(new vector_type(list)) {}
+
+        rcu_vector(const rcu_vector&) = delete;
+        rcu_vector& operator=(const rcu_vector&) = delete;
+
+        ~rcu_vector() { delete current_.load(std::memory_order_acquire); }
+
+    public:
+        // 读取相关操作
+        snapshot read() const { return snapshot(current_); }
+
+        vector_type copy() const
+        {
+            snapshot s = read();
+            return *s;
+        }
+
+        size_type size() const { return read().size(); }
+
+        // 修改相关操作，每次调用发布一个新版本
+        template <class F>
+        void update(F f)
+        {
+            std::lock_guard<std::mutex> guard(write_lock_);
+            vector_type* next = new vector_type(*current_.load(std::memory_order_relaxed));
+            try
+            {
+                f(*next);
+            }
+            catch (...)
+            {
+                delete next;
+                throw;
+            }
+            publish(next);
+        }
+
+        void store(const vector_type& v)
+        {
+            vector_type* next = new vector_type(v);
+            std::lock_guard<std::mutex> guard(write_lock_);
+            publish(next);
+        }
+
+        void store(vector_type&& v)
+        {
+            vector_type* next = new vector_type(ministl::move(v));
+            std::lock_guard<std::mutex> guard(write_lock_);
+            publish(next);
+        }
+
+        void push_back(const value_type& value)
+        {
+            update([&value](vector_type& v) { v.push_back(value); });
+        }
+
+        void set(size_type n, const value_type& value)
+        {
+            update([n, &value](vector_type& v) {
+                THROW_OUT_OF_RANGE_IF(!(n < v.size()), "rcu_vector::set() subscript out of range");
+                v[n] = value;
+            });
+        }
+
+    private:
+        void publish(vector_type* next)
+        {
+            vector_type* old = current_.exchange(next, std::memory_order_seq_cst);
+            epoch_domain::instance().retire(old);
+        }
+    };
+}
+
+#endif //MINISTL_RCU_VECTOR_H
@@ -0,0 +1,451 @@
+#ifndef MINISTL_RING_BUFFER_H
+#define MINISTL_RING_BUFFER_H
+
+// 这个头文件包含一个模板类 ring_buffer
+// ring_buffer : 容量固定为 2 的幂的无锁环形队列，用于流水线各阶段之间传递元素
+//   ring_spsc : 单生产者单消费者(默认)
+//   ring_mpsc : 多生产者单消费者，每个槽位带一个序号
+
+// notes:
+// head_ 与 tail_ 是只增不减的计数，对容量取模(按位与 mask_)得到槽位，二者各占一条缓存行，
+// 元素存放在一段连续的空间中，批量操作按环的边界至多切成两段，整段复制或移动，
+// 可平凡复制的类型走 algobase.h 中的 memmove 路径。
+//   * ring_spsc：生产者只写 tail_，消费者只写 head_，各自缓存对方的计数，只在缓存显示已满 / 已空时才重新读取，
+//     正常情况下两边不会互相读取对方的缓存行
+//   * ring_mpsc：参考 Vyukov 的有界队列，槽位 i 的序号为 i 时表示空闲，为 i + 1 时表示元素已就绪。
+//     生产者以 CAS 推进 tail_ 占用槽位，构造元素后写入序号发布；批量写入时依据 head_ 算出空闲槽位数，一次占用一段。
+//     消费者只有一个，依据序号判断元素是否就绪，取出后把序号设为 i + capacity 交还给下一轮的生产者
+// try_* 不等待，返回是否成功或实际处理的元素个数；push / pop / push_n / pop_n 在队列满 / 空时自旋，之后让出 CPU。
+// size() 只是一个近似值，多生产者模式下包含已占用但尚未发布的槽位。
+// C++11 的 new 表达式不保证超过 alignof(std::max_align_t) 的对齐，ring_buffer 因此提供类内的 operator new / delete，
+// 经 aligned_allocator 按 64 字节对齐；栈上与静态存储的对象由编译器保证对齐。
+// 作为成员嵌入其他堆上对象、放置 new 或经其他途径分配(如 C++11 下的 std::make_shared)时不经过这里，须自行保证 64 字节对齐。
+// 异常保证：
+//   ring_spsc 的写入满足强异常保证，元素构造失败时队列不变
+//   ring_mpsc 要求 T 的移动构造不抛出异常：可能抛出异常的构造先在局部完成，再占用槽位移动进去，
+//   try_emplace 在这种情况下若队列已满，参数可能已经被使用
+//   try_pop 满足强异常保证；try_pop_n 要求 T 的移动赋值不抛出异常
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <type_traits>
+
+#include "algobase.h"
+#include "aligned_allocator.h"
+#include "exception.h"
+#include "uninitialized.h"
+#include "util.h"
+
+namespace ministl
+{
+    // 生产者模式
+    struct ring_spsc {};
+    struct ring_mpsc {};
+
+    template <class T, class Mode = ring_spsc>
+    class ring_buffer
+    {
+        static_assert(std::is_same<Mode, ring_spsc>::value || std::is_same<Mode, ring_mpsc>::value,
+                      "ring_buffer's mode must be ring_spsc or ring_mpsc");
+        static_assert(!std::is_same<Mode, ring_mpsc>::value || std::is_nothrow_move_constructible<T>::value,
+                      "ring_buffer<T, ring_mpsc> requires a nothrow move constructor");
+
+    public:
+        typedef T                                       value_type;
+        typedef T&                                      reference;
+        typedef const T&                                const_reference;
+        typedef size_t                                  size_type;
+
+    private:
+        typedef ministl::aligned_allocator<T, 64>       data_allocator;
+        typedef ministl::aligned_allocator<char, 64>    byte_allocator;
+        typedef std::is_same<Mode, ring_mpsc>           multi_producer;
+
+        // 构造后不再修改
+        T*                          slots_;
+        std::atomic<size_type>*     seq_;           // 只在 ring_mpsc 下分配
+        size_type                   mask_;
+
+        // 消费者一侧
+        alignas(64) std::atomic<size_type> head_;
+        size_type                   tail_cache_;    // 消费者缓存的 tail_，只在 ring_spsc 下使用
+
+        // 生产者一侧
+        alignas(64) std::atomic<size_type> tail_;
+        size_type                   head_cache_;    // 生产者缓存的 head_，只在 ring_spsc 下使用
+
+    public:
+        // 构造、析构函数，capacity 向上取整为 2 的幂
+        explicit ring_buffer(size_type capacity)
+                : slots_(nullptr), seq_(nullptr), mask_(0), head_(0), tail_cache_(0), tail_(0), head_cache_(0)
+        {
+            THROW_LENGTH_ERROR_IF(capacity == 0 || capacity > max_capacity(),
+                                  "ring_buffer<T>'s capacity must be in [1, max_capacity()]");
+            size_type cap = 1;
+            while (cap < capacity)
+                cap <<= 1;
+            mask_ = cap - 1;
+            slots_ = data_allocator::allocate(cap);
+            if (multi_producer::value)
+            {
+                try
+                {
+                    seq_ = new std::atomic<size_type>[cap];
+                }
+                catch (...)
+                {
+                    data_allocator::deallocate(slots_, cap);
+                    throw;
+                }
+                for (size_type i = 0; i < cap; ++i)
+                    seq_[i].store(i, std::memory_order_relaxed);
+            }
+        }
+
+        ring_buffer(const ring_buffer&) = delete;
+        ring_buffer& operator=(const ring_buffer&) = delete;
+
+        // 堆上分配时保证 head_ / tail_ 各占一条缓存行
+        static void* operator new(size_t bytes)     { return byte_allocator::allocate(bytes); }
+        static void* operator new[](size_t bytes)   { return byte_allocator::allocate(bytes); }
+        static void operator delete(void* p) noexcept   { byte_allocator::deallocate(static_cast<char*>(p)); }
+        static void operator delete[](void* p) noexcept { byte_allocator::deallocate(static_cast<char*>(p)); }
+        static void* operator new(size_t, void* p) noexcept   { return p; }
+        static void operator delete(void*, void*) noexcept    {}
+
+        // 析构时不能有线程在读写
+        ~ring_buffer()
+        {
+            const size_type t = tail_.load(std::memory_order_acquire);
+            for (size_type h = head_.load(std::memory_order_relaxed); h != t; ++h)
+                ministl::destroy(slots_ + (h & mask_));
+            delete[] seq_;
+            data_allocator::deallocate(slots_, capacity());
+        }
+
+    public:
+        // 容量相关操作
+        size_type capacity() const noexcept { return mask_ + 1; }
+
+        static constexpr size_type max_capacity() noexcept
+        {
+            return (static_cast<size_type>(-1) / 2 + 1) / sizeof(T);
+        }
+
+        size_type size() const noexcept
+        {
+            // 先读 head_ 再读 tail_，差值不会为负
+            const size_type h = head_.load(std::memory_order_acquire);
+            const size_type t = tail_.load(std::memory_order_acquire);
+            return ministl::min(t - h, capacity());
+        }
+
+        bool empty() const noexcept { return size() == 0; }
+        bool full()  const noexcept { return size() == capacity(); }
+
+        // 生产者操作
+        template <class ...Args>
+        bool try_emplace(Args&& ...args)
+        {
+            return emplace_impl(multi_producer(), ministl::forward<Args>(args)...);
+        }
+
+        bool try_push(const value_type& value) { return try_emplace(value); }
+        bool try_push(value_type&& value)      { return try_emplace(ministl::move(value)); }
+
+        void push(const value_type& value)
+        {
+            for (unsigned spins = 0; !try_push(value); )
+                backoff(spins);
+        }
+
+        void push(value_type&& value)
+        {
+            for (unsigned spins = 0; !try_push(ministl::move(value)); )
+                backoff(spins);
+        }
+
+        // 写入 [first, first + n) 的前若干个元素，受空闲槽位数限制，返回写入的个数
+        size_type try_push_n(const value_type* first, size_type n)
+        {
+            return push_n_impl(multi_producer(), first, n);
+        }
+
+        // 写入全部 n 个元素，空闲槽位不够时分批等待
+        void push_n(const value_type* first, size_type n)
+        {
+            for (unsigned spins = 0; n != 0; )
+            {
+                const size_type k = try_push_n(first, n);
+                if (k == 0)
+                {
+                    backoff(spins);
+                    continue;
+                }
+                first += k;
+                n -= k;
+                spins = 0;
+            }
+        }
+
+        // 消费者操作
+        bool try_pop(value_type& out)
+        {
+            return pop_impl(multi_producer(), out);
+        }
+
+        void pop(value_type& out)
+        {
+            for (unsigned spins = 0; !try_pop(out); )
+                backoff(spins);
+        }
+
+        // 把至多 n 个元素移动到 [result, result + n)，返回取出的个数
+        size_type try_pop_n(value_type* result, size_type n)
+        {
+            static_assert(std::is_nothrow_move_assignable<T>::value,
+                          "ring_buffer<T>::try_pop_n requires a nothrow move assignment");
+            return pop_n_impl(multi_producer(), result, n);
+        }
+
+        // 等到至少有一个元素，再取出至多 n 个，返回取出的个数
+        size_type pop_n(value_type* result, size_type n)
+        {
+            if (n == 0)
+                return 0;
+            for (unsigned spins = 0; ; backoff(spins))
+            {
+                const size_type k = try_pop_n(result, n);
+                if (k != 0)
+                    return k;
+            }
+        }
+
+    private:
+        static void backoff(unsigned& spins)
+        {
+            if (++spins > 64)
+                std::this_thread::yield();
+        }
+
+        /***************************************ring_spsc**********************************************/
+
+        template <class ...Args>
+        bool emplace_impl(std::false_type, Args&& ...args)
+        {
+            const size_type t = tail_.load(std::memory_order_relaxed);
+            if (t - head_cache_ == capacity())
+            {
+                head_cache_ = head_.load(std::memory_order_acquire);
+                if (t - head_cache_ == capacity())
+                    return false;
+            }
+            ministl::construct(slots_ + (t & mask_), ministl::forward<Args>(args)...);
+            tail_.store(t + 1, std::memory_order_release);
+            return true;
+        }
+
+        size_type push_n_impl(std::false_type, const value_type* first, size_type n)
+        {
+            const size_type t = tail_.load(std::memory_order_relaxed);
+            size_type avail = capacity() - (t - head_cache_);
+            if (avail < n)
+            {
+                head_cache_ = head_.load(std::memory_order_acquire);
+                avail = capacity() - (t - head_cache_);
+            }
+            const size_type k = ministl::min(n, avail);
+            if (k == 0)
+                return 0;
+            copy_in(t, first, k);
+            tail_.store(t + k, std::memory_order_release);
+            return k;
+        }
+
+        bool pop_impl(std::false_type, value_type& out)
+        {
+            const size_type h = head_.load(std::memory_order_relaxed);
+            if (h == tail_cache_)
+            {
+                tail_cache_ = tail_.load(std::memory_order_acquire);
+                if (h == tail_cache_)
+                    return false;
+            }
+            T* p = slots_ + (h & mask_);
+            out = ministl::move(*p);
+            ministl::destroy(p);
+            head_.store(h + 1, std::memory_order_release);
+            return true;
+        }
+
+        size_type pop_n_impl(std::false_type, value_type* result, size_type n)
+        {
+            const size_type h = head_.load(std::memory_order_relaxed);
+            if (tail_cache_ - h < n)
+                tail_cache_ = tail_.load(std::memory_order_acquire);
+            const size_type k = ministl::min(n, tail_cache_ - h);
+            if (k == 0)
+                return 0;
+            move_out(h, result, k);
+            head_.store(h + k, std::memory_order_release);
+            return k;
+        }
+
+        /***************************************ring_mpsc**********************************************/
+
+        // 占用一个槽位，队列已满时返回 false
+        bool claim_one(size_type& pos)
+        {
+            pos = tail_.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                const size_type seq = seq_[pos & mask_].load(std::memory_order_acquire);
+                const ptrdiff_t diff = static_cast<ptrdiff_t>(seq - pos);
+                if (diff == 0)
+                {
+                    if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed,
+                                                    std::memory_order_relaxed))
+                        return true;
+                }
+                else if (diff < 0)
+                {
+                    return false;
+                }
+                else
+                {
+                    pos = tail_.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        template <class ...Args>
+        bool emplace_impl(std::true_type, Args&& ...args)
+        {
+            return emplace_mpsc(std::integral_constant<bool,
+                    std::is_nothrow_constructible<T, Args&&...>::value>(), ministl::forward<Args>(args)...);
+        }
+
+        // 构造不会抛出异常，占用槽位后就地构造
+        template <class ...Args>
+        bool emplace_mpsc(std::true_type, Args&& ...args)
+        {
+            size_type pos = 0;
+            if (!claim_one(pos))
+                return false;
+            ministl::construct(slots_ + (pos & mask_), ministl::forward<Args>(args)...);
+            seq_[pos & mask_].store(pos + 1, std::memory_order_release);
+            return true;
+        }
+
+        // 构造可能抛出异常，先在局部构造，失败时还没有占用槽位
+        template <class ...Args>
+        bool emplace_mpsc(std::false_type, Args&& ...args)
+        {
+            T value(ministl::forward<Args>(args)...);
+            return emplace_mpsc(std::true_type(), ministl::move(value));
+        }
+
+        size_type push_n_impl(std::true_type, const value_type* first, size_type n)
+        {
+            return push_n_mpsc(std::integral_constant<bool,
+                    std::is_nothrow_copy_constructible<T>::value>(), first, n);
+        }
+
+        // 依据 head_ 算出空闲槽位数，一次 CAS 占用一段，整段复制后按顺序发布
+        size_type push_n_mpsc(std::true_type, const value_type* first, size_type n)
+        {
+            size_type pos = tail_.load(std::memory_order_relaxed);
+            size_type k = 0;
+            for (;;)
+            {
+                // head_ 之前的槽位都已被消费者交还；pos 过期时 pos - h 会大于容量，重新读取
+                const size_type used = pos - head_.load(std::memory_order_acquire);
+                if (used > capacity())
+                {
+                    pos = tail_.load(std::memory_order_relaxed);
+                    continue;
+                }
+                k = ministl::min(n, capacity() - used);
+                if (k == 0)
+                    return 0;
+                if (tail_.compare_exchange_weak(pos, pos + k, std::memory_order_relaxed,
+                                                std::memory_order_relaxed))
+                    break;
+            }
+            copy_in(pos, first, k);
+            for (size_type i = 0; i < k; ++i)
+                seq_[(pos + i) & mask_].store(pos + i + 1, std::memory_order_release);
+            return k;
+        }
+
+        // 复制可能抛出异常，逐个写入
+        size_type push_n_mpsc(std::false_type, const value_type* first, size_type n)
+        {
+            size_type k = 0;
+            while (k < n && try_push(first[k]))
+                ++k;
+            return k;
+        }
+
+        bool pop_impl(std::true_type, value_type& out)
+        {
+            const size_type h = head_.load(std::memory_order_relaxed);
+            const size_type i = h & mask_;
+            if (seq_[i].load(std::memory_order_acquire) != h + 1)
+                return false;
+            out = ministl::move(slots_[i]);
+            ministl::destroy(slots_ + i);
+            seq_[i].store(h + capacity(), std::memory_order_release);
+            head_.store(h + 1, std::memory_order_release);
+            return true;
+        }
+
+        size_type pop_n_impl(std::true_type, value_type* result, size_type n)
+        {
+            const size_type h = head_.load(std::memory_order_relaxed);
+            size_type k = 0;
+            while (k < n && seq_[(h + k) & mask_].load(std::memory_order_acquire) == h + k + 1)
+                ++k;
+            if (k == 0)
+                return 0;
+            move_out(h, result, k);
+            for (size_type i = 0; i < k; ++i)
+                seq_[(h + i) & mask_].store(h + i + capacity(), std::memory_order_release);
+            head_.store(h + k, std::memory_order_release);
+            return k;
+        }
+
+        /***************************************整段复制 / 移动*******************************************/
+
+        // 把 [first, first + k) 复制到从 pos 开始的 k 个槽位，至多两段；失败时析构已复制的部分
+        void copy_in(size_type pos, const value_type* first, size_type k)
+        {
+            T* const dst = slots_ + (pos & mask_);
+            const size_type len = ministl::min(k, capacity() - (pos & mask_));
+            ministl::uninitialized_copy(first, first + len, dst);
+            try
+            {
+                ministl::uninitialized_copy(first + len, first + k, slots_);
+            }
+            catch (...)
+            {
+                ministl::destroy(dst, dst + len);
+                throw;
+            }
+        }
+
+        // 把从 pos 开始的 k 个元素移动到 [result, result + k)，并析构槽位中的元素
+        void move_out(size_type pos, value_type* result, size_type k)
+        {
+            T* const src = slots_ + (pos & mask_);
+            const size_type len = ministl::min(k, capacity() - (pos & mask_));
+            ministl::move(src, src + len, result);
+            ministl::destroy(src, src + len);
+            ministl::move(slots_, slots_ + (k - len), result + len);
+            ministl::destroy(slots_, slots_ + (k - len));
+        }
+    };
+}
+
+#endif //MINISTL_RING_BUFFER_H
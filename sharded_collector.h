@@ -0,0 +1,223 @@
+#ifndef MINISTL_SHARDED_COLLECTOR_H
+#define MINISTL_SHARDED_COLLECTOR_H
+
+// 这个头文件包含一个模板类 sharded_collector
+// sharded_collector : 按线程分片的收集器，各线程追加到自己的 vector，最后由 merge() 合并成一个连续的 vector
+
+// notes:
+// 收集阶段每个线程只写自己的分片(线程第一次写入时领取)，追加与单线程的 vector::push_back 相同，
+// 不加锁也没有共享的原子计数器；分片按缓存行对齐，相邻分片的 vector 头部不会落在同一缓存行。
+// merge() 先求各分片大小的前缀和，得到每个分片在结果中的偏移，结果空间只分配一次，
+// 再把 [0, total) 切成连续的分段，由 default_thread_pool() 并行把元素移动到结果中（分段可以跨越分片），
+// 之后析构各分片中被移走的元素，分片保留容量供下一轮收集复用。
+// 结果中各分片按领取顺序排列，同一线程追加的元素保持追加顺序。
+// merge()、size()、clear() 要求此时没有线程在追加，通常在收集阶段的线程全部 join 之后调用。
+// 每个线程缓存最近使用的一个收集器对应的分片，同一线程交替写多个收集器时，切换需要加锁查找一次。
+// 异常保证：
+//   merge 中元素的移动抛出异常时，结果 vector 不变，已经被移动的源元素处于 moved-from 状态
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "aligned_allocator.h"
+#include "algo.h"
+#include "parallel_uninitialized.h"
+#include "util.h"
+#include "vector.h"
+
+namespace ministl
+{
+    template <class T>
+    class sharded_collector
+    {
+    public:
+        typedef T                                       value_type;
+        typedef ministl::vector<T>                      vector_type;
+        typedef size_t                                  size_type;
+
+    private:
+        struct alignas(64) shard
+        {
+            vector_type     items;
+            std::thread::id owner;
+
+            explicit shard(std::thread::id id) : items(), owner(id) {}
+        };
+
+        typedef ministl::aligned_allocator<shard, 64> shard_allocator;
+
+        // 当前线程最近使用的收集器编号及其分片；编号不会复用，收集器销毁后缓存自然失效
+        struct thread_cache
+        {
+            uint64_t id;
+            shard*   s;
+        };
+
+        uint64_t            id_;
+        mutable std::mutex  lock_;
+        std::vector<shard*> shards_;
+
+    public:
+        // 构造、析构函数
+        sharded_collector() : id_(next_id()) {}
+
+        sharded_collector(const sharded_collector&) = delete;
+        sharded_collector& operator=(const sharded_collector&) = delete;
+
+        ~sharded_collector()
+        {
+            for (shard* s : shards_)
+            {
+                s->~shard();
+                shard_allocator::deallocate(s);
+            }
+        }
+
+    public:
+        // 当前线程的分片，可以直接在上面调用 vector 的追加操作
+        vector_type& local() { return local_shard()->items; }
+
+        // 追加相关操作，只写当前线程的分片
+        void push_back(const value_type& value) { local_shard()->items.push_back(value); }
+        void push_back(value_type&& value)      { local_shard()->items.push_back(ministl::move(value)); }
+
+        template <class ...Args>
+        void emplace_back(Args&& ...args)
+        {
+            local_shard()->items.emplace_back(ministl::forward<Args>(args)...);
+        }
+
+        template <class Iter, typename std::enable_if<ministl::is_input_iterator<Iter>::value, int>::type = 0>
+        void append(Iter first, Iter last)
+        {
+            vector_type& items = local_shard()->items;
+            items.insert(items.end(), first, last);
+        }
+
+        // 以下操作要求没有线程在追加
+        size_type size() const
+        {
+            std::lock_guard<std::mutex> guard(lock_);
+            size_type n = 0;
+            for (const shard* s : shards_)
+                n += s->items.size();
+            return n;
+        }
+
+        bool empty() const { return size() == 0; }
+
+        size_type shard_count() const
+        {
+            std::lock_guard<std::mutex> guard(lock_);
+            return shards_.size();
+        }
+
+        void clear()
+        {
+            std::lock_guard<std::mutex> guard(lock_);
+            for (shard* s : shards_)
+                s->items.clear();
+        }
+
+        // 把所有分片的元素移动到一个新的 vector 中，分片随后为空
+        vector_type merge()
+        {
+            vector_type result;
+            merge_into(result);
+            return result;
+        }
+
+        // 把所有分片的元素移动到 out 的尾部
+        void merge_into(vector_type& out)
+        {
+            std::lock_guard<std::mutex> guard(lock_);
+            const size_type parts = shards_.size();
+            ministl::vector<size_type> offsets(parts + 1, 0);
+            for (size_type k = 0; k < parts; ++k)
+                offsets[k + 1] = offsets[k] + shards_[k]->items.size();
+            const size_type total = offsets[parts];
+            out.append_uninitialized(total, [this, &offsets, total](T* dst) {
+                ministl::parallel_uninitialized_for(total, ministl::parallel_init_chunk<T>(total),
+                        [this, &offsets, dst](size_type offset, size_type len) {
+                            relocate_range(offsets, offset, len, dst);
+                        },
+                        [dst](size_type offset, size_type len) {
+                            ministl::destroy(dst + offset, dst + offset + len);
+                        });
+            });
+            for (shard* s : shards_)
+                s->items.clear();
+        }
+
+    private:
+        static uint64_t next_id() noexcept
+        {
+            static std::atomic<uint64_t> next(1);
+            return next.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        static thread_cache& cache() noexcept
+        {
+            static thread_local thread_cache c = { 0, nullptr };
+            return c;
+        }
+
+        shard* local_shard()
+        {
+            thread_cache& c = cache();
+            if (c.id == id_)
+                return c.s;
+            const std::thread::id self = std::this_thread::get_id();
+            std::lock_guard<std::mutex> guard(lock_);
+            shard* found = nullptr;
+            for (shard* s : shards_)
+            {
+                if (s->owner == self)
+                {
+                    found = s;
+                    break;
+                }
+            }
+            if (found == nullptr)
+            {
+                shards_.reserve(shards_.size() + 1);
+                found = ::new (static_cast<void*>(shard_allocator::allocate(1))) shard(self);
+                shards_.push_back(found);
+            }
+            c.id = id_;
+            c.s = found;
+            return found;
+        }
+
+        // 把结果中 [offset, offset + len) 对应的元素从各分片移动到 dst + offset，失败时析构本段已移动的部分
+        void relocate_range(const ministl::vector<size_type>& offsets, size_type offset, size_type len, T* dst)
+        {
+            size_type k = static_cast<size_type>(
+                    ministl::upper_bound(offsets.begin(), offsets.end(), offset) - offsets.begin()) - 1;
+            T* const first = dst + offset;
+            T* cur = first;
+            try
+            {
+                while (len > 0)
+                {
+                    const size_type n = ministl::min(len, offsets[k + 1] - offset);
+                    T* src = shards_[k]->items.begin() + (offset - offsets[k]);
+                    cur = ministl::uninitialized_move(src, src + n, cur);
+                    offset += n;
+                    len -= n;
+                    ++k;
+                }
+            }
+            catch (...)
+            {
+                ministl::destroy(first, cur);
+                throw;
+            }
+        }
+    };
+}
+
+#endif //MINISTL_SHARDED_COLLECTOR_H
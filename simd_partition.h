@@ -0,0 +1,546 @@
+#ifndef MINISTL_SIMD_PARTITION_H
+#define MINISTL_SIMD_PARTITION_H
+
+// This header contains the vectorized pivot partition used by nth_element and partial_sort
+// 以枢轴值把算术类型的连续区间分成两段，返回左段的长度。
+// x86 上按运行时检测到的指令集选择 AVX-512 (压缩存储) 或 AVX2 (查表置换后整向量存储) 版本，
+// 其余平台、其余类型以及较短的区间使用标量版本
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "functional.h"
+#include "type_traits.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define MINISTL_SIMD_X86 1
+#include <immintrin.h>
+#define MINISTL_TARGET_AVX2   __attribute__((target("avx2,popcnt")))
+#define MINISTL_TARGET_AVX512 __attribute__((target("avx512f,avx2,popcnt")))
+#define MINISTL_FLATTEN_AVX2   __attribute__((target("avx2,popcnt"), flatten))
+#define MINISTL_FLATTEN_AVX512 __attribute__((target("avx512f,avx2,popcnt"), flatten))
+#else
+#define MINISTL_SIMD_X86 0
+#endif
+
+namespace ministl
+{
+    /*********************************************simd_level***********************************************/
+    // 运行时检测到的指令集，set_simd_level_limit 可以把它限制到较低的级别(测试与基准时对比各版本)
+    /*******************************************************************************************************/
+    enum class simd_level { none = 0, avx2 = 1, avx512 = 2 };
+
+    inline simd_level detect_simd_level() noexcept
+    {
+#if MINISTL_SIMD_X86
+        static const simd_level level = __builtin_cpu_supports("avx512f") ? simd_level::avx512 :
+                                        __builtin_cpu_supports("avx2") ? simd_level::avx2 : simd_level::none;
+        return level;
+#else
+        return simd_level::none;
+#endif
+    }
+
+    inline std::atomic<int>& simd_level_limit_value() noexcept
+    {
+        static std::atomic<int> limit(static_cast<int>(simd_level::avx512));
+        return limit;
+    }
+
+    inline void set_simd_level_limit(simd_level level) noexcept
+    {
+        simd_level_limit_value().store(static_cast<int>(level), std::memory_order_relaxed);
+    }
+
+    inline simd_level active_simd_level() noexcept
+    {
+        const int limit = simd_level_limit_value().load(std::memory_order_relaxed);
+        const int detected = static_cast<int>(detect_simd_level());
+        return static_cast<simd_level>(detected < limit ? detected : limit);
+    }
+
+    /**********************************************pivot_cmp***********************************************/
+    // 放到左段的元素：lt 为 x < pivot，le 为 !(pivot < x)，gt 为 pivot < x，ge 为 !(x < pivot)
+    /*******************************************************************************************************/
+    enum class pivot_cmp { lt, le, gt, ge };
+
+    template <pivot_cmp Cmp>
+    struct pivot_pred;
+
+    template <>
+    struct pivot_pred<pivot_cmp::lt>
+    {
+        template <class T>
+        static bool left(const T& x, const T& pivot) noexcept { return x < pivot; }
+    };
+
+    template <>
+    struct pivot_pred<pivot_cmp::le>
+    {
+        template <class T>
+        static bool left(const T& x, const T& pivot) noexcept { return !(pivot < x); }
+    };
+
+    template <>
+    struct pivot_pred<pivot_cmp::gt>
+    {
+        template <class T>
+        static bool left(const T& x, const T& pivot) noexcept { return pivot < x; }
+    };
+
+    template <>
+    struct pivot_pred<pivot_cmp::ge>
+    {
+        template <class T>
+        static bool left(const T& x, const T& pivot) noexcept { return !(x < pivot); }
+    };
+
+    // 对 ministl::less / greater 的算术类型开启向量化分区，其余比较操作使用通用算法
+    template <class T>
+    struct simd_partition_type : public m_bool_constant<
+            std::is_same<T, int32_t>::value || std::is_same<T, uint32_t>::value ||
+            std::is_same<T, int64_t>::value || std::is_same<T, uint64_t>::value ||
+            std::is_same<T, float>::value || std::is_same<T, double>::value> {};
+
+    template <class RandomIter, class Compared>
+    struct simd_partitionable : public m_false_type {};
+
+    template <class T>
+    struct simd_partitionable<T*, ministl::less<T>> : public simd_partition_type<T> {};
+
+    template <class T>
+    struct simd_partitionable<T*, ministl::greater<T>> : public simd_partition_type<T> {};
+
+    // 比较操作对应的“小于”与“不大于”
+    template <class Compared>
+    struct pivot_cmp_of
+    {
+        static constexpr pivot_cmp strict = pivot_cmp::lt;
+        static constexpr pivot_cmp inclusive = pivot_cmp::le;
+    };
+
+    template <class T>
+    struct pivot_cmp_of<ministl::greater<T>>
+    {
+        static constexpr pivot_cmp strict = pivot_cmp::gt;
+        static constexpr pivot_cmp inclusive = pivot_cmp::ge;
+    };
+
+    /*******************************************scalar_pivot_partition**************************************/
+    template <pivot_cmp Cmp, class T>
+    size_t scalar_pivot_partition(T* first, T* last, T pivot) noexcept
+    {
+        T* left = first;
+        T* right = last;
+        while (true)
+        {
+            while (left < right && pivot_pred<Cmp>::left(*left, pivot))
+                ++left;
+            while (left < right && !pivot_pred<Cmp>::left(*(right - 1), pivot))
+                --right;
+            if (right - left < 2)
+                break;
+            --right;
+            const T tmp = *left;
+            *left = *right;
+            *right = tmp;
+            ++left;
+        }
+        return static_cast<size_t>(left - first);
+    }
+
+#if MINISTL_SIMD_X86
+    /********************************************simd_partition_kernel**************************************/
+    // notes:
+    // 先把首尾各 simd_partition_unroll 个向量的元素暂存起来，空出位置。之后每次从剩余空位较少的一端
+    // 连续读入 simd_partition_unroll 个向量，左段元素写到左写指针处，右段元素写到右写指针之前。
+    // 两端空位之和保持不变，从空位较少的一端读入后两侧都有足够的空位，写入不会覆盖尚未读取的元素；
+    // 一次读入多个向量是为了摊薄“读哪一端”这个难以预测的分支。
+    // 最后剩余的元素与暂存的元素一起逐个放置，正好填满中间的空位。
+    // Block::apply 只经由指针读写内存：未内联时，不同目标指令集的函数之间传递向量值的调用约定不一致
+    /*******************************************************************************************************/
+    constexpr size_t simd_partition_unroll = 4;
+
+    template <class Block, pivot_cmp Cmp, class T>
+    size_t simd_partition_kernel(T* first, T* last, T pivot) noexcept
+    {
+        const ptrdiff_t width = static_cast<ptrdiff_t>(Block::width);
+        const ptrdiff_t stride = static_cast<ptrdiff_t>(simd_partition_unroll) * width;
+        if (last - first < 2 * stride)
+            return ministl::scalar_pivot_partition<Cmp>(first, last, pivot);
+        T rest[(2 * simd_partition_unroll + 1) * Block::width];
+        for (ptrdiff_t i = 0; i < stride; ++i)
+        {
+            rest[i] = first[i];
+            rest[stride + i] = last[i - stride];
+        }
+        T* read_l = first + stride;
+        T* read_r = last - stride;
+        T* write_l = first;
+        T* write_r = last;
+        while (read_r - read_l >= width)
+        {
+            const bool from_left = read_l - write_l <= write_r - read_r;
+            const ptrdiff_t count = read_r - read_l >= stride ? stride : width;
+            for (ptrdiff_t k = 0; k < count; k += width)
+            {
+                const T* src = nullptr;
+                if (from_left)
+                {
+                    src = read_l;
+                    read_l += width;
+                }
+                else
+                {
+                    read_r -= width;
+                    src = read_r;
+                }
+                const ptrdiff_t left = static_cast<ptrdiff_t>(Block::template apply<Cmp>(src, pivot, write_l, write_r));
+                write_l += left;
+                write_r -= width - left;
+            }
+        }
+        const ptrdiff_t remain = read_r - read_l;
+        for (ptrdiff_t i = 0; i < remain; ++i)
+            rest[2 * stride + i] = read_l[i];
+        for (ptrdiff_t i = 0; i < remain + 2 * stride; ++i)
+        {
+            if (pivot_pred<Cmp>::left(rest[i], pivot))
+                *write_l++ = rest[i];
+            else
+                *--write_r = rest[i];
+        }
+        return static_cast<size_t>(write_l - first);
+    }
+
+    // 由 x < pivot 与 pivot < x 的车道掩码得到 Cmp 对应的掩码
+    template <pivot_cmp Cmp, size_t Lanes>
+    inline unsigned pivot_mask(unsigned x_less_pivot, unsigned pivot_less_x) noexcept
+    {
+        return Cmp == pivot_cmp::lt ? x_less_pivot :
+               Cmp == pivot_cmp::gt ? pivot_less_x :
+               Cmp == pivot_cmp::le ? (~pivot_less_x & ((1u << Lanes) - 1)) : (~x_less_pivot & ((1u << Lanes) - 1));
+    }
+
+    // 各车道在置换后的位置：掩码为 1 的车道依次排在前面，其余排在后面，每个下标占一个字节
+    template <size_t Lanes>
+    struct simd_permute_table
+    {
+        uint64_t index[1u << Lanes];
+
+        simd_permute_table() noexcept
+        {
+            for (unsigned mask = 0; mask < (1u << Lanes); ++mask)
+            {
+                unsigned char order[8] = {0};
+                size_t k = 0;
+                for (unsigned lane = 0; lane < Lanes; ++lane)
+                    if (mask & (1u << lane))
+                        order[k++] = static_cast<unsigned char>(lane);
+                for (unsigned lane = 0; lane < Lanes; ++lane)
+                    if (!(mask & (1u << lane)))
+                        order[k++] = static_cast<unsigned char>(lane);
+                uint64_t packed = 0;
+                for (unsigned i = 0; i < 8; ++i)
+                {
+                    // 64 位车道由两个相邻的 32 位车道组成
+                    const unsigned lane32 = Lanes == 8 ? order[i] : 2u * order[i / 2] + (i & 1u);
+                    packed |= static_cast<uint64_t>(lane32) << (8 * i);
+                }
+                index[mask] = packed;
+            }
+        }
+    };
+
+    template <size_t Lanes>
+    const uint64_t* simd_permute_index() noexcept
+    {
+        static const simd_permute_table<Lanes> table;
+        return table.index;
+    }
+
+    /**********************************************avx2_lanes**********************************************/
+    // less(a, b) 返回 a < b 的车道掩码，无符号整数翻转符号位后做有符号比较
+    /*******************************************************************************************************/
+    template <class T>
+    struct avx2_lanes;
+
+    template <class T>
+    struct avx2_int32_lanes
+    {
+        typedef T       value_type;
+        typedef __m256i vector_type;
+        static constexpr size_t width = 8;
+        MINISTL_TARGET_AVX2 static __m256i load(const T* p) noexcept
+        { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+        MINISTL_TARGET_AVX2 static void store(T* p, __m256i v) noexcept
+        { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+        MINISTL_TARGET_AVX2 static __m256i permute(__m256i v, uint64_t index) noexcept
+        { return _mm256_permutevar8x32_epi32(v, _mm256_cvtepu8_epi32(_mm_cvtsi64_si128(static_cast<long long>(index)))); }
+    };
+
+    template <>
+    struct avx2_lanes<int32_t> : public avx2_int32_lanes<int32_t>
+    {
+        MINISTL_TARGET_AVX2 static __m256i set1(int32_t x) noexcept { return _mm256_set1_epi32(x); }
+        MINISTL_TARGET_AVX2 static unsigned less(__m256i a, __m256i b) noexcept
+        { return static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(b, a)))); }
+    };
+
+    template <>
+    struct avx2_lanes<uint32_t> : public avx2_int32_lanes<uint32_t>
+    {
+        MINISTL_TARGET_AVX2 static __m256i set1(uint32_t x) noexcept { return _mm256_set1_epi32(static_cast<int>(x)); }
+        MINISTL_TARGET_AVX2 static unsigned less(__m256i a, __m256i b) noexcept
+        {
+            const __m256i sign = _mm256_set1_epi32(static_cast<int>(0x80000000u));
+            return static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(
+                    _mm256_cmpgt_epi32(_mm256_xor_si256(b, sign), _mm256_xor_si256(a, sign)))));
+        }
+    };
+
+    template <class T>
+    struct avx2_int64_lanes
+    {
+        typedef T       value_type;
+        typedef __m256i vector_type;
+        static constexpr size_t width = 4;
+        MINISTL_TARGET_AVX2 static __m256i load(const T* p) noexcept
+        { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+        MINISTL_TARGET_AVX2 static void store(T* p, __m256i v) noexcept
+        { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+        MINISTL_TARGET_AVX2 static __m256i permute(__m256i v, uint64_t index) noexcept
+        { return _mm256_permutevar8x32_epi32(v, _mm256_cvtepu8_epi32(_mm_cvtsi64_si128(static_cast<long long>(index)))); }
+    };
+
+    template <>
+    struct avx2_lanes<int64_t> : public avx2_int64_lanes<int64_t>
+    {
+        MINISTL_TARGET_AVX2 static __m256i set1(int64_t x) noexcept { return _mm256_set1_epi64x(x); }
+        MINISTL_TARGET_AVX2 static unsigned less(__m256i a, __m256i b) noexcept
+        { return static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(b, a)))); }
+    };
+
+    template <>
+    struct avx2_lanes<uint64_t> : public avx2_int64_lanes<uint64_t>
+    {
+        MINISTL_TARGET_AVX2 static __m256i set1(uint64_t x) noexcept
+        { return _mm256_set1_epi64x(static_cast<long long>(x)); }
+        MINISTL_TARGET_AVX2 static unsigned less(__m256i a, __m256i b) noexcept
+        {
+            const __m256i sign = _mm256_set1_epi64x(static_cast<long long>(0x8000000000000000ull));
+            return static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(
+                    _mm256_cmpgt_epi64(_mm256_xor_si256(b, sign), _mm256_xor_si256(a, sign)))));
+        }
+    };
+
+    template <>
+    struct avx2_lanes<float>
+    {
+        typedef float  value_type;
+        typedef __m256 vector_type;
+        static constexpr size_t width = 8;
+        MINISTL_TARGET_AVX2 static __m256 load(const float* p) noexcept { return _mm256_loadu_ps(p); }
+        MINISTL_TARGET_AVX2 static void store(float* p, __m256 v) noexcept { _mm256_storeu_ps(p, v); }
+        MINISTL_TARGET_AVX2 static __m256 set1(float x) noexcept { return _mm256_set1_ps(x); }
+        MINISTL_TARGET_AVX2 static unsigned less(__m256 a, __m256 b) noexcept
+        { return static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_LT_OQ))); }
+        MINISTL_TARGET_AVX2 static __m256 permute(__m256 v, uint64_t index) noexcept
+        { return _mm256_permutevar8x32_ps(v, _mm256_cvtepu8_epi32(_mm_cvtsi64_si128(static_cast<long long>(index)))); }
+    };
+
+    template <>
+    struct avx2_lanes<double>
+    {
+        typedef double  value_type;
+        typedef __m256d vector_type;
+        static constexpr size_t width = 4;
+        MINISTL_TARGET_AVX2 static __m256d load(const double* p) noexcept { return _mm256_loadu_pd(p); }
+        MINISTL_TARGET_AVX2 static void store(double* p, __m256d v) noexcept { _mm256_storeu_pd(p, v); }
+        MINISTL_TARGET_AVX2 static __m256d set1(double x) noexcept { return _mm256_set1_pd(x); }
+        MINISTL_TARGET_AVX2 static unsigned less(__m256d a, __m256d b) noexcept
+        { return static_cast<unsigned>(_mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_LT_OQ))); }
+        MINISTL_TARGET_AVX2 static __m256d permute(__m256d v, uint64_t index) noexcept
+        {
+            const __m256i idx = _mm256_cvtepu8_epi32(_mm_cvtsi64_si128(static_cast<long long>(index)));
+            return _mm256_castps_pd(_mm256_permutevar8x32_ps(_mm256_castpd_ps(v), idx));
+        }
+    };
+
+    /*********************************************avx512_lanes*********************************************/
+    template <class T>
+    struct avx512_lanes;
+
+    template <>
+    struct avx512_lanes<int32_t>
+    {
+        typedef int32_t value_type;
+        typedef __m512i vector_type;
+        static constexpr size_t width = 16;
+        MINISTL_TARGET_AVX512 static __m512i load(const int32_t* p) noexcept { return _mm512_loadu_si512(p); }
+        MINISTL_TARGET_AVX512 static void store(int32_t* p, __m512i v) noexcept { _mm512_storeu_si512(p, v); }
+        MINISTL_TARGET_AVX512 static __m512i set1(int32_t x) noexcept { return _mm512_set1_epi32(x); }
+        MINISTL_TARGET_AVX512 static unsigned less(__m512i a, __m512i b) noexcept
+        { return _mm512_cmplt_epi32_mask(a, b); }
+        MINISTL_TARGET_AVX512 static void compress(int32_t* p, unsigned mask, __m512i v) noexcept
+        { _mm512_mask_compressstoreu_epi32(p, static_cast<__mmask16>(mask), v); }
+    };
+
+    template <>
+    struct avx512_lanes<uint32_t>
+    {
+        typedef uint32_t value_type;
+        typedef __m512i  vector_type;
+        static constexpr size_t width = 16;
+        MINISTL_TARGET_AVX512 static __m512i load(const uint32_t* p) noexcept { return _mm512_loadu_si512(p); }
+        MINISTL_TARGET_AVX512 static void store(uint32_t* p, __m512i v) noexcept { _mm512_storeu_si512(p, v); }
+        MINISTL_TARGET_AVX512 static __m512i set1(uint32_t x) noexcept
+        { return _mm512_set1_epi32(static_cast<int>(x)); }
+        MINISTL_TARGET_AVX512 static unsigned less(__m512i a, __m512i b) noexcept
+        { return _mm512_cmplt_epu32_mask(a, b); }
+        MINISTL_TARGET_AVX512 static void compress(uint32_t* p, unsigned mask, __m512i v) noexcept
+        { _mm512_mask_compressstoreu_epi32(p, static_cast<__mmask16>(mask), v); }
+    };
+
+    template <>
+    struct avx512_lanes<int64_t>
+    {
+        typedef int64_t value_type;
+        typedef __m512i vector_type;
+        static constexpr size_t width = 8;
+        MINISTL_TARGET_AVX512 static __m512i load(const int64_t* p) noexcept { return _mm512_loadu_si512(p); }
+        MINISTL_TARGET_AVX512 static void store(int64_t* p, __m512i v) noexcept { _mm512_storeu_si512(p, v); }
+        MINISTL_TARGET_AVX512 static __m512i set1(int64_t x) noexcept { return _mm512_set1_epi64(x); }
+        MINISTL_TARGET_AVX512 static unsigned less(__m512i a, __m512i b) noexcept
+        { return _mm512_cmplt_epi64_mask(a, b); }
+        MINISTL_TARGET_AVX512 static void compress(int64_t* p, unsigned mask, __m512i v) noexcept
+        { _mm512_mask_compressstoreu_epi64(p, static_cast<__mmask8>(mask), v); }
+    };
+
+    template <>
+    struct avx512_lanes<uint64_t>
+    {
+        typedef uint64_t value_type;
+        typedef __m512i  vector_type;
+        static constexpr size_t width = 8;
+        MINISTL_TARGET_AVX512 static __m512i load(const uint64_t* p) noexcept { return _mm512_loadu_si512(p); }
+        MINISTL_TARGET_AVX512 static void store(uint64_t* p, __m512i v) noexcept { _mm512_storeu_si512(p, v); }
+        MINISTL_TARGET_AVX512 static __m512i set1(uint64_t x) noexcept
+        { return _mm512_set1_epi64(static_cast<long long>(x)); }
+        MINISTL_TARGET_AVX512 static unsigned less(__m512i a, __m512i b) noexcept
+        { return _mm512_cmplt_epu64_mask(a, b); }
+        MINISTL_TARGET_AVX512 static void compress(uint64_t* p, unsigned mask, __m512i v) noexcept
+        { _mm512_mask_compressstoreu_epi64(p, static_cast<__mmask8>(mask), v); }
+    };
+
+    template <>
+    struct avx512_lanes<float>
+    {
+        typedef float  value_type;
+        typedef __m512 vector_type;
+        static constexpr size_t width = 16;
+        MINISTL_TARGET_AVX512 static __m512 load(const float* p) noexcept { return _mm512_loadu_ps(p); }
+        MINISTL_TARGET_AVX512 static void store(float* p, __m512 v) noexcept { _mm512_storeu_ps(p, v); }
+        MINISTL_TARGET_AVX512 static __m512 set1(float x) noexcept { return _mm512_set1_ps(x); }
+        MINISTL_TARGET_AVX512 static unsigned less(__m512 a, __m512 b) noexcept
+        { return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ); }
+        MINISTL_TARGET_AVX512 static void compress(float* p, unsigned mask, __m512 v) noexcept
+        { _mm512_mask_compressstoreu_ps(p, static_cast<__mmask16>(mask), v); }
+    };
+
+    template <>
+    struct avx512_lanes<double>
+    {
+        typedef double  value_type;
+        typedef __m512d vector_type;
+        static constexpr size_t width = 8;
+        MINISTL_TARGET_AVX512 static __m512d load(const double* p) noexcept { return _mm512_loadu_pd(p); }
+        MINISTL_TARGET_AVX512 static void store(double* p, __m512d v) noexcept { _mm512_storeu_pd(p, v); }
+        MINISTL_TARGET_AVX512 static __m512d set1(double x) noexcept { return _mm512_set1_pd(x); }
+        MINISTL_TARGET_AVX512 static unsigned less(__m512d a, __m512d b) noexcept
+        { return _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ); }
+        MINISTL_TARGET_AVX512 static void compress(double* p, unsigned mask, __m512d v) noexcept
+        { _mm512_mask_compressstoreu_pd(p, static_cast<__mmask8>(mask), v); }
+    };
+
+    /*********************************************partition_block*****************************************/
+    // apply 把 src 处的一个向量分开：左段元素写到 write_l 起，右段元素写到 write_r 之前，返回左段元素个数
+    /*******************************************************************************************************/
+    template <class T>
+    struct avx2_block
+    {
+        typedef avx2_lanes<T> lanes;
+        static constexpr size_t width = lanes::width;
+
+        // 置换后左段元素在前、右段元素在后，整向量分别写到两个写指针处，多写的部分落在空位中
+        template <pivot_cmp Cmp>
+        MINISTL_TARGET_AVX2 static size_t apply(const T* src, T pivot, T* write_l, T* write_r) noexcept
+        {
+            const typename lanes::vector_type v = lanes::load(src);
+            const typename lanes::vector_type p = lanes::set1(pivot);
+            const unsigned m = ministl::pivot_mask<Cmp, width>(lanes::less(v, p), lanes::less(p, v));
+            const typename lanes::vector_type q = lanes::permute(v, simd_permute_index<width>()[m]);
+            lanes::store(write_l, q);
+            lanes::store(write_r - width, q);
+            return static_cast<size_t>(__builtin_popcount(m));
+        }
+    };
+
+    template <class T>
+    struct avx512_block
+    {
+        typedef avx512_lanes<T> lanes;
+        static constexpr size_t width = lanes::width;
+
+        template <pivot_cmp Cmp>
+        MINISTL_TARGET_AVX512 static size_t apply(const T* src, T pivot, T* write_l, T* write_r) noexcept
+        {
+            const typename lanes::vector_type v = lanes::load(src);
+            const typename lanes::vector_type p = lanes::set1(pivot);
+            const unsigned m = ministl::pivot_mask<Cmp, width>(lanes::less(v, p), lanes::less(p, v));
+            const size_t count = static_cast<size_t>(__builtin_popcount(m));
+            lanes::compress(write_l, m, v);
+            lanes::compress(write_r - (width - count), ~m & ((1u << width) - 1), v);
+            return count;
+        }
+    };
+
+    // 入口函数带有目标指令集属性，flatten 把内核与各辅助函数全部内联进来
+    template <pivot_cmp Cmp, class T>
+    MINISTL_FLATTEN_AVX2 size_t avx2_pivot_partition(T* first, T* last, T pivot) noexcept
+    {
+        return ministl::simd_partition_kernel<avx2_block<T>, Cmp>(first, last, pivot);
+    }
+
+    template <pivot_cmp Cmp, class T>
+    MINISTL_FLATTEN_AVX512 size_t avx512_pivot_partition(T* first, T* last, T pivot) noexcept
+    {
+        return ministl::simd_partition_kernel<avx512_block<T>, Cmp>(first, last, pivot);
+    }
+#endif
+
+    /*********************************************pivot_partition******************************************/
+    // 把 [first, last) 中满足 Cmp 的元素放到左边，返回左段的长度，元素的相对顺序不保证
+    /*******************************************************************************************************/
+    template <pivot_cmp Cmp, class T>
+    size_t pivot_partition(T* first, T* last, T pivot) noexcept
+    {
+        static_assert(simd_partition_type<T>::value, "pivot_partition requires a 32/64-bit arithmetic type");
+#if MINISTL_SIMD_X86
+        switch (ministl::active_simd_level())
+        {
+            case simd_level::avx512:
+                return ministl::avx512_pivot_partition<Cmp>(first, last, pivot);
+            case simd_level::avx2:
+                return ministl::avx2_pivot_partition<Cmp>(first, last, pivot);
+            default:
+                break;
+        }
+#endif
+        return ministl::scalar_pivot_partition<Cmp>(first, last, pivot);
+    }
+}
+
+#endif //MINISTL_SIMD_PARTITION_H
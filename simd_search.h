@@ -0,0 +1,165 @@
+#ifndef MINISTL_SIMD_SEARCH_H
+#define MINISTL_SIMD_SEARCH_H
+
+// This header contains the vectorized lower_bound used by flat_map for small integral keys
+
+// notes:
+// 二分查找的每一步都依赖上一步的比较结果，最后几层的候选区间已经落在一两条 cache line 内，
+// 逐层比较只是在串行地等待一次次的比较与访存。simd_lower_bound 先用无分支二分把候选区间缩小到
+// 一个 64 字节的窗口，再一次性比较整个窗口，用 popcount 数出小于 key 的元素个数，
+// 省去最后 log2(窗口长度) 层相互依赖的比较。
+// 只对 ministl::less 的 32/64 位整数开启；有序区间比窗口还短、或运行时没有 AVX2 时退回 branchless_lower_bound
+
+#include "algo.h"
+#include "simd_partition.h"
+
+namespace ministl
+{
+    template <class T>
+    struct simd_search_type : public m_bool_constant<
+            std::is_same<T, int32_t>::value || std::is_same<T, uint32_t>::value ||
+            std::is_same<T, int64_t>::value || std::is_same<T, uint64_t>::value> {};
+
+    template <class T, class Compared>
+    struct simd_searchable : public m_false_type {};
+
+    template <class T>
+    struct simd_searchable<T, ministl::less<T>> : public simd_search_type<T> {};
+
+    // 比较窗口的字节数
+    constexpr size_t simd_search_window = 64;
+
+#if MINISTL_SIMD_X86
+    /*****************************************count_less**************************************************/
+    // 统计 [p, p + 64 / sizeof(T)) 中小于 key 的元素个数。无符号数先翻转符号位，再做有符号比较
+    /*******************************************************************************************************/
+    MINISTL_TARGET_AVX2 inline unsigned avx2_count_less(const int32_t* p, int32_t key) noexcept
+    {
+        const __m256i k = _mm256_set1_epi32(key);
+        const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 8));
+        const unsigned lo = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(k, a))));
+        const unsigned hi = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(k, b))));
+        return static_cast<unsigned>(__builtin_popcount(lo | (hi << 8)));
+    }
+
+    MINISTL_TARGET_AVX2 inline unsigned avx2_count_less(const uint32_t* p, uint32_t key) noexcept
+    {
+        const __m256i bias = _mm256_set1_epi32(INT32_MIN);
+        const __m256i k = _mm256_xor_si256(_mm256_set1_epi32(static_cast<int32_t>(key)), bias);
+        const __m256i a = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)), bias);
+        const __m256i b = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 8)), bias);
+        const unsigned lo = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(k, a))));
+        const unsigned hi = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(k, b))));
+        return static_cast<unsigned>(__builtin_popcount(lo | (hi << 8)));
+    }
+
+    MINISTL_TARGET_AVX2 inline unsigned avx2_count_less(const int64_t* p, int64_t key) noexcept
+    {
+        const __m256i k = _mm256_set1_epi64x(key);
+        const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+        const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 4));
+        const unsigned lo = static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(k, a))));
+        const unsigned hi = static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(k, b))));
+        return static_cast<unsigned>(__builtin_popcount(lo | (hi << 4)));
+    }
+
+    MINISTL_TARGET_AVX2 inline unsigned avx2_count_less(const uint64_t* p, uint64_t key) noexcept
+    {
+        const __m256i bias = _mm256_set1_epi64x(INT64_MIN);
+        const __m256i k = _mm256_xor_si256(_mm256_set1_epi64x(static_cast<int64_t>(key)), bias);
+        const __m256i a = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)), bias);
+        const __m256i b = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 4)), bias);
+        const unsigned lo = static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(k, a))));
+        const unsigned hi = static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(k, b))));
+        return static_cast<unsigned>(__builtin_popcount(lo | (hi << 4)));
+    }
+
+    MINISTL_TARGET_AVX512 inline unsigned avx512_count_less(const int32_t* p, int32_t key) noexcept
+    {
+        const __mmask16 m = _mm512_cmplt_epi32_mask(_mm512_loadu_si512(p), _mm512_set1_epi32(key));
+        return static_cast<unsigned>(__builtin_popcount(m));
+    }
+
+    MINISTL_TARGET_AVX512 inline unsigned avx512_count_less(const uint32_t* p, uint32_t key) noexcept
+    {
+        const __mmask16 m = _mm512_cmplt_epu32_mask(_mm512_loadu_si512(p), _mm512_set1_epi32(static_cast<int32_t>(key)));
+        return static_cast<unsigned>(__builtin_popcount(m));
+    }
+
+    MINISTL_TARGET_AVX512 inline unsigned avx512_count_less(const int64_t* p, int64_t key) noexcept
+    {
+        const __mmask8 m = _mm512_cmplt_epi64_mask(_mm512_loadu_si512(p), _mm512_set1_epi64(key));
+        return static_cast<unsigned>(__builtin_popcount(m));
+    }
+
+    MINISTL_TARGET_AVX512 inline unsigned avx512_count_less(const uint64_t* p, uint64_t key) noexcept
+    {
+        const __mmask8 m = _mm512_cmplt_epu64_mask(_mm512_loadu_si512(p), _mm512_set1_epi64(static_cast<int64_t>(key)));
+        return static_cast<unsigned>(__builtin_popcount(m));
+    }
+
+    /***************************************window_lower_bound*********************************************/
+    // 二分保持“结果落在 [first, first + len] 内”，缩小到 len <= window 后，first 之前的元素都小于 key，
+    // 窗口 [start, start + window) 覆盖 [first, 结果)，窗口内小于 key 的个数就是结果到 start 的距离。
+    // 窗口越过区间末尾时整体左移，移进来的元素同样小于 key。要求 n >= window
+    /*******************************************************************************************************/
+    template <class T>
+    MINISTL_FLATTEN_AVX2 size_t avx2_lower_bound(const T* data, size_t n, T key) noexcept
+    {
+        const size_t window = simd_search_window / sizeof(T);
+        const T* first = data;
+        size_t len = n;
+        while (len > window)
+        {
+            const size_t half = len / 2;
+            first = first[half] < key ? first + half : first;
+            len -= half;
+        }
+        const T* start = first + window <= data + n ? first : data + n - window;
+        return static_cast<size_t>(start - data) + avx2_count_less(start, key);
+    }
+
+    template <class T>
+    MINISTL_FLATTEN_AVX512 size_t avx512_lower_bound(const T* data, size_t n, T key) noexcept
+    {
+        const size_t window = simd_search_window / sizeof(T);
+        const T* first = data;
+        size_t len = n;
+        while (len > window)
+        {
+            const size_t half = len / 2;
+            first = first[half] < key ? first + half : first;
+            len -= half;
+        }
+        const T* start = first + window <= data + n ? first : data + n - window;
+        return static_cast<size_t>(start - data) + avx512_count_less(start, key);
+    }
+#endif
+
+    /*****************************************simd_lower_bound*********************************************/
+    // 返回有序区间 [data, data + n) 中第一个不小于 key 的元素的下标
+    /*******************************************************************************************************/
+    template <class T>
+    size_t simd_lower_bound(const T* data, size_t n, T key) noexcept
+    {
+        static_assert(simd_search_type<T>::value, "simd_lower_bound requires a 32 or 64 bit integer key");
+#if MINISTL_SIMD_X86
+        if (n >= simd_search_window / sizeof(T))
+        {
+            switch (active_simd_level())
+            {
+            case simd_level::avx512:
+                return ministl::avx512_lower_bound(data, n, key);
+            case simd_level::avx2:
+                return ministl::avx2_lower_bound(data, n, key);
+            default:
+                break;
+            }
+        }
+#endif
+        return static_cast<size_t>(ministl::branchless_lower_bound(data, data + n, key, ministl::less<T>()) - data);
+    }
+}
+
+#endif //MINISTL_SIMD_SEARCH_H
@@ -0,0 +1,609 @@
+#ifndef MINISTL_SOA_VECTOR_H
+#define MINISTL_SOA_VECTOR_H
+
+// 这个头文件包含一个模板类 soa_vector
+// soa_vector : 结构数组(structure of arrays)，每个字段各自存放在一段连续的数组中
+
+// notes:
+// vector<Record> 的扫描即使只读一两个字段，也要把整条记录读进缓存；soa_vector<Ts...> 把第 I 个字段
+// 存放在第 I 列，所有列共用同一个 size 与 capacity，扩容沿用 vector 的 growth_capacity，
+// 每一列通过 aligned_allocator<T, 64> 申请，起始地址按 cache line 对齐，方便编译器向量化列扫描。
+// 访问方式：
+//   * column<I>() 返回第 I 列的 span，只扫描某几个字段时直接遍历 span
+//   * operator[] 与 zip 迭代器返回引用代理 soa_reference，get<I>() 取得各字段的引用，
+//     可以转换为 std::tuple<Ts...>，对它赋值会写回各列
+// 异常保证：
+//   扩容时每一列按 move_if_noexcept 的规则搬迁：移动构造可能抛出异常且可以复制的列改为复制，
+//   这些列先搬，移动不抛出异常的列最后才移走，
+//   因此 push_back / emplace_back 满足强异常保证，除非某一列的移动构造可能抛出异常又不能复制；
+//   其余修改操作满足基本异常保证。
+//   任何使容量改变的操作都会使全部迭代器、引用与 span 失效
+
+#include <initializer_list>
+#include <tuple>
+
+#include "aligned_allocator.h"
+#include "algobase.h"
+#include "exception.h"
+#include "iterator.h"
+#include "span.h"
+#include "uninitialized.h"
+#include "util.h"
+#include "vector.h"
+
+namespace ministl
+{
+    // C++11 没有 std::index_sequence，用来展开各列
+    template <size_t... I>
+    struct soa_index_sequence {};
+
+    template <size_t N, size_t... I>
+    struct make_soa_index_sequence : public make_soa_index_sequence<N - 1, N - 1, I...> {};
+
+    template <size_t... I>
+    struct make_soa_index_sequence<0, I...>
+    {
+        typedef soa_index_sequence<I...> type;
+    };
+
+    template <class... Ts>
+    struct soa_max_sizeof;
+
+    template <class T>
+    struct soa_max_sizeof<T> : public m_integral_constant<size_t, sizeof(T)> {};
+
+    template <class T, class... Ts>
+    struct soa_max_sizeof<T, Ts...> : public m_integral_constant<size_t,
+            (sizeof(T) > soa_max_sizeof<Ts...>::value ? sizeof(T) : soa_max_sizeof<Ts...>::value)> {};
+
+    /*******************************************soa_reference**********************************************/
+    // 一行的引用代理：持有各列元素的引用
+    /*******************************************************************************************************/
+    template <class... Ts>
+    class soa_reference
+    {
+    public:
+        typedef std::tuple<typename std::remove_const<Ts>::type...> value_type;
+
+    private:
+        typedef typename make_soa_index_sequence<sizeof...(Ts)>::type indices;
+        std::tuple<Ts&...> refs_;
+
+    public:
+        explicit soa_reference(Ts&... refs) noexcept : refs_(refs...) {}
+
+        soa_reference(const soa_reference&) = default;
+
+        // 赋值写回各列，而不是重新绑定引用
+        soa_reference& operator=(const soa_reference& rhs)
+        {
+            refs_ = rhs.refs_;
+            return *this;
+        }
+
+        soa_reference& operator=(const value_type& value)
+        {
+            refs_ = value;
+            return *this;
+        }
+
+        soa_reference& operator=(value_type&& value)
+        {
+            refs_ = ministl::move(value);
+            return *this;
+        }
+
+        operator value_type() const { return value_type(refs_); }
+
+        template <size_t I>
+        typename std::tuple_element<I, std::tuple<Ts&...>>::type get() const noexcept
+        {
+            return std::get<I>(refs_);
+        }
+
+        const std::tuple<Ts&...>& as_tuple() const noexcept { return refs_; }
+
+        // 交换两行的内容
+        void swap(soa_reference rhs) const { swap_aux(rhs, indices()); }
+
+        friend bool operator==(const soa_reference& lhs, const soa_reference& rhs) { return lhs.refs_ == rhs.refs_; }
+        friend bool operator!=(const soa_reference& lhs, const soa_reference& rhs) { return !(lhs == rhs); }
+
+    private:
+        template <size_t... I>
+        void swap_aux(soa_reference& rhs, soa_index_sequence<I...>) const
+        {
+            int expand[] = {0, (ministl::swap(std::get<I>(refs_), std::get<I>(rhs.refs_)), 0)...};
+            (void)expand;
+        }
+    };
+
+    // 代理通常是临时对象，按值接受，通过 ADL 调用：swap(*it1, *it2)
+    template <class... Ts>
+    void swap(soa_reference<Ts...> lhs, soa_reference<Ts...> rhs)
+    {
+        lhs.swap(rhs);
+    }
+
+    /*******************************************soa_iterator***********************************************/
+    // zip 迭代器：记录容器与行号，解引用得到该行的 soa_reference
+    /*******************************************************************************************************/
+    template <class Vector, class Ref>
+    class soa_iterator
+    {
+        template <class, class> friend class soa_iterator;
+
+    public:
+        typedef ministl::random_access_iterator_tag         iterator_category;
+        typedef typename std::remove_const<Vector>::type::value_type value_type;
+        typedef Ref                                         reference;
+        typedef void                                        pointer;
+        typedef ptrdiff_t                                   difference_type;
+        typedef soa_iterator<Vector, Ref>                   self;
+
+    private:
+        Vector* v_;
+        size_t  i_;
+
+    public:
+        soa_iterator() noexcept : v_(nullptr), i_(0) {}
+        soa_iterator(Vector* v, size_t i) noexcept : v_(v), i_(i) {}
+
+        // iterator 可以转换为 const_iterator
+        template <class V, class R, typename std::enable_if<
+                std::is_convertible<V*, Vector*>::value && !std::is_same<V, Vector>::value, int>::type = 0>
+        soa_iterator(const soa_iterator<V, R>& other) noexcept : v_(other.v_), i_(other.i_) {}
+
+        size_t index() const noexcept { return i_; }
+
+        reference operator*() const { return (*v_)[i_]; }
+        reference operator[](difference_type n) const { return (*v_)[i_ + n]; }
+
+        self& operator++()    { ++i_; return *this; }
+        self  operator++(int) { self tmp = *this; ++i_; return tmp; }
+        self& operator--()    { --i_; return *this; }
+        self  operator--(int) { self tmp = *this; --i_; return tmp; }
+
+        self& operator+=(difference_type n) { i_ += n; return *this; }
+        self& operator-=(difference_type n) { i_ -= n; return *this; }
+        self  operator+(difference_type n) const { return self(v_, i_ + n); }
+        self  operator-(difference_type n) const { return self(v_, i_ - n); }
+        friend self operator+(difference_type n, const self& it) { return it + n; }
+
+        friend difference_type operator-(const self& lhs, const self& rhs)
+        {
+            return static_cast<difference_type>(lhs.i_) - static_cast<difference_type>(rhs.i_);
+        }
+
+        friend bool operator==(const self& lhs, const self& rhs) { return lhs.i_ == rhs.i_; }
+        friend bool operator!=(const self& lhs, const self& rhs) { return lhs.i_ != rhs.i_; }
+        friend bool operator< (const self& lhs, const self& rhs) { return lhs.i_ <  rhs.i_; }
+        friend bool operator> (const self& lhs, const self& rhs) { return lhs.i_ >  rhs.i_; }
+        friend bool operator<=(const self& lhs, const self& rhs) { return lhs.i_ <= rhs.i_; }
+        friend bool operator>=(const self& lhs, const self& rhs) { return lhs.i_ >= rhs.i_; }
+    };
+
+    /********************************************soa_vector************************************************/
+    template <class... Ts>
+    class soa_vector
+    {
+        static_assert(sizeof...(Ts) > 0, "soa_vector needs at least one column");
+
+    public:
+        typedef std::tuple<Ts...>                                   value_type;
+        typedef soa_reference<Ts...>                                reference;
+        typedef soa_reference<const Ts...>                          const_reference;
+        typedef size_t                                              size_type;
+        typedef ptrdiff_t                                           difference_type;
+        typedef soa_iterator<soa_vector, reference>                 iterator;
+        typedef soa_iterator<const soa_vector, const_reference>     const_iterator;
+
+        static constexpr size_t column_count = sizeof...(Ts);
+
+        template <size_t I>
+        using column_type = typename std::tuple_element<I, value_type>::type;
+
+        template <size_t I>
+        using column_allocator = ministl::aligned_allocator<column_type<I>, 64>;
+
+    private:
+        typedef typename make_soa_index_sequence<sizeof...(Ts)>::type indices;
+
+        std::tuple<Ts*...> columns_;
+        size_type          size_;
+        size_type          capacity_;
+
+    public:
+        soa_vector() noexcept : columns_(static_cast<Ts*>(nullptr)...), size_(0), capacity_(0) {}
+
+        explicit soa_vector(size_type n) : soa_vector()
+        {
+            resize(n);
+        }
+
+        soa_vector(size_type n, const value_type& value) : soa_vector()
+        {
+            resize(n, value);
+        }
+
+        soa_vector(std::initializer_list<value_type> list) : soa_vector()
+        {
+            reserve(list.size());
+            for (const value_type& value : list)
+                push_back(value);
+        }
+
+        soa_vector(const soa_vector& rhs) : soa_vector()
+        {
+            reserve(rhs.size_);
+            copy_columns(rhs, indices());
+        }
+
+        soa_vector(soa_vector&& rhs) noexcept
+                : columns_(rhs.columns_), size_(rhs.size_), capacity_(rhs.capacity_)
+        {
+            rhs.columns_ = std::tuple<Ts*...>(static_cast<Ts*>(nullptr)...);
+            rhs.size_ = 0;
+            rhs.capacity_ = 0;
+        }
+
+        soa_vector& operator=(const soa_vector& rhs)
+        {
+            if (this != &rhs)
+            {
+                soa_vector tmp(rhs);
+                swap(tmp);
+            }
+            return *this;
+        }
+
+        soa_vector& operator=(soa_vector&& rhs) noexcept
+        {
+            soa_vector tmp(ministl::move(rhs));
+            swap(tmp);
+            return *this;
+        }
+
+        ~soa_vector()
+        {
+            destroy_rows(0, size_, indices());
+            deallocate_columns(columns_, capacity_, indices());
+        }
+
+    public:
+        // 迭代器相关操作
+        iterator       begin()        noexcept { return iterator(this, 0); }
+        const_iterator begin()  const noexcept { return const_iterator(this, 0); }
+        iterator       end()          noexcept { return iterator(this, size_); }
+        const_iterator end()    const noexcept { return const_iterator(this, size_); }
+        const_iterator cbegin() const noexcept { return begin(); }
+        const_iterator cend()   const noexcept { return end(); }
+
+        // 容量相关操作
+        bool      empty()    const noexcept { return size_ == 0; }
+        size_type size()     const noexcept { return size_; }
+        size_type capacity() const noexcept { return capacity_; }
+        size_type max_size() const noexcept { return static_cast<size_type>(-1) / soa_max_sizeof<Ts...>::value; }
+
+        void reserve(size_type n)
+        {
+            if (n <= capacity_)
+                return;
+            THROW_LENGTH_ERROR_IF(n > max_size(), "n can not larger than max_size() in soa_vector<Ts...>::reserve(n)");
+            reallocate(n, indices());
+        }
+
+        void shrink_to_fit()
+        {
+            if (size_ < capacity_)
+                reallocate(size_, indices());
+        }
+
+        // 访问元素相关操作
+        reference operator[](size_type n)
+        {
+            MINISTL_DEBUG(n < size_);
+            return row<reference>(columns_, n, indices());
+        }
+
+        const_reference operator[](size_type n) const
+        {
+            MINISTL_DEBUG(n < size_);
+            return row<const_reference>(columns_, n, indices());
+        }
+
+        reference at(size_type n)
+        {
+            THROW_OUT_OF_RANGE_IF(!(n < size_), "soa_vector<Ts...>::at() subscript out of range");
+            return (*this)[n];
+        }
+
+        const_reference at(size_type n) const
+        {
+            THROW_OUT_OF_RANGE_IF(!(n < size_), "soa_vector<Ts...>::at() subscript out of range");
+            return (*this)[n];
+        }
+
+        reference       front()       { return (*this)[0]; }
+        const_reference front() const { return (*this)[0]; }
+        reference       back()        { return (*this)[size_ - 1]; }
+        const_reference back()  const { return (*this)[size_ - 1]; }
+
+        // 第 I 列
+        template <size_t I>
+        column_type<I>* data() noexcept { return std::get<I>(columns_); }
+
+        template <size_t I>
+        const column_type<I>* data() const noexcept { return std::get<I>(columns_); }
+
+        template <size_t I>
+        span<column_type<I>> column() noexcept { return span<column_type<I>>(std::get<I>(columns_), size_); }
+
+        template <size_t I>
+        span<const column_type<I>> column() const noexcept
+        {
+            return span<const column_type<I>>(std::get<I>(columns_), size_);
+        }
+
+        // 修改容器相关操作
+        void push_back(const value_type& value)
+        {
+            grow_if_full();
+            construct_row<0>(size_, value, m_bool_constant<column_count == 0>());
+            ++size_;
+        }
+
+        void push_back(value_type&& value)
+        {
+            grow_if_full();
+            construct_row<0>(size_, ministl::move(value), m_bool_constant<column_count == 0>());
+            ++size_;
+        }
+
+        // 每一列一个参数
+        template <class... Args>
+        void emplace_back(Args&&... args)
+        {
+            static_assert(sizeof...(Args) == sizeof...(Ts), "soa_vector::emplace_back takes one argument per column");
+            grow_if_full();
+            construct_row<0>(size_, std::forward_as_tuple(ministl::forward<Args>(args)...),
+                             m_bool_constant<column_count == 0>());
+            ++size_;
+        }
+
+        void pop_back()
+        {
+            MINISTL_DEBUG(!empty());
+            --size_;
+            destroy_rows(size_, size_ + 1, indices());
+        }
+
+        iterator erase(const_iterator pos)
+        {
+            return erase(pos, pos + 1);
+        }
+
+        iterator erase(const_iterator first, const_iterator last)
+        {
+            MINISTL_DEBUG(first <= last && last <= end());
+            const size_type from = first.index();
+            const size_type to = last.index();
+            if (from != to)
+            {
+                move_rows_down(from, to, indices());
+                destroy_rows(size_ - (to - from), size_, indices());
+                size_ -= to - from;
+            }
+            return iterator(this, from);
+        }
+
+        void resize(size_type new_size)
+        {
+            resize(new_size, value_type());
+        }
+
+        void resize(size_type new_size, const value_type& value)
+        {
+            if (new_size < size_)
+            {
+                destroy_rows(new_size, size_, indices());
+                size_ = new_size;
+                return;
+            }
+            reserve(new_size);
+            for (; size_ < new_size; ++size_)
+                construct_row<0>(size_, value, m_bool_constant<column_count == 0>());
+        }
+
+        void clear() noexcept
+        {
+            destroy_rows(0, size_, indices());
+            size_ = 0;
+        }
+
+        void swap(soa_vector& rhs) noexcept
+        {
+            ministl::swap(columns_, rhs.columns_);
+            ministl::swap(size_, rhs.size_);
+            ministl::swap(capacity_, rhs.capacity_);
+        }
+
+        bool equal(const soa_vector& rhs) const
+        {
+            return size_ == rhs.size_ && equal_columns(rhs, indices());
+        }
+
+    private:
+        void grow_if_full()
+        {
+            if (size_ == capacity_)
+                reallocate(ministl::growth_capacity(capacity_, static_cast<size_type>(1), max_size()), indices());
+        }
+
+        template <class Ref, class Columns, size_t... I>
+        static Ref row(const Columns& columns, size_type n, soa_index_sequence<I...>)
+        {
+            return Ref(std::get<I>(columns)[n]...);
+        }
+
+        // 依次在各列的 pos 处构造 std::get<I>(t)，某一列抛出异常时析构已构造的前几列
+        template <size_t I, class Tuple>
+        void construct_row(size_type, Tuple&&, m_true_type) {}
+
+        template <size_t I, class Tuple>
+        void construct_row(size_type pos, Tuple&& t, m_false_type)
+        {
+            column_allocator<I>::construct(std::get<I>(columns_) + pos, std::get<I>(ministl::forward<Tuple>(t)));
+            try
+            {
+                construct_row<I + 1>(pos, ministl::forward<Tuple>(t), m_bool_constant<I + 1 == column_count>());
+            }
+            catch (...)
+            {
+                column_allocator<I>::destroy(std::get<I>(columns_) + pos);
+                throw;
+            }
+        }
+
+        template <size_t... I>
+        void destroy_rows(size_type first, size_type last, soa_index_sequence<I...>) noexcept
+        {
+            int expand[] = {0, (column_allocator<I>::destroy(std::get<I>(columns_) + first,
+                                                             std::get<I>(columns_) + last), 0)...};
+            (void)expand;
+        }
+
+        template <size_t... I>
+        static void deallocate_columns(const std::tuple<Ts*...>& columns, size_type cap,
+                                       soa_index_sequence<I...>) noexcept
+        {
+            int expand[] = {0, (std::get<I>(columns) == nullptr ? (void)0
+                                : column_allocator<I>::deallocate(std::get<I>(columns), cap), 0)...};
+            (void)expand;
+        }
+
+        // 第 I 列搬到新的空间：移动构造不抛出异常或者不能复制时移动，否则复制，失败时原有元素不变
+        template <class T>
+        static void relocate_column(T* first, T* last, T* result)
+        {
+            relocate_column(first, last, result, m_bool_constant<std::is_nothrow_move_constructible<T>::value ||
+                                                                 !std::is_copy_constructible<T>::value>());
+        }
+
+        template <class T>
+        static void relocate_column(T* first, T* last, T* result, m_true_type)
+        {
+            ministl::uninitialized_move(first, last, result);
+        }
+
+        template <class T>
+        static void relocate_column(T* first, T* last, T* result, m_false_type)
+        {
+            ministl::uninitialized_copy(first, last, result);
+        }
+
+        // 各列搬到新的空间：先搬可能抛出异常的列(复制，或者不能复制而移动可能抛出异常)，最后移动不抛出异常的列，
+        // 因此任何一列抛出异常时还没有列被移走，析构已搬好的列并释放新空间即可，原有元素保持不变(见 relocate_column)
+        template <size_t... I>
+        void reallocate(size_type new_cap, soa_index_sequence<I...>)
+        {
+            std::tuple<Ts*...> fresh(static_cast<Ts*>(nullptr)...);
+            bool done[sizeof...(Ts)] = {};
+            try
+            {
+                int alloc[] = {0, (std::get<I>(fresh) = column_allocator<I>::allocate(new_cap), 0)...};
+                int risky[] = {0, (std::is_nothrow_move_constructible<column_type<I>>::value ? (void)0
+                                   : (relocate_column(std::get<I>(columns_), std::get<I>(columns_) + size_,
+                                                      std::get<I>(fresh)), (void)(done[I] = true)), 0)...};
+                int safe[] = {0, (std::is_nothrow_move_constructible<column_type<I>>::value
+                                  ? (relocate_column(std::get<I>(columns_), std::get<I>(columns_) + size_,
+                                                     std::get<I>(fresh)), (void)(done[I] = true)) : (void)0, 0)...};
+                (void)alloc;
+                (void)risky;
+                (void)safe;
+            }
+            catch (...)
+            {
+                int destroy[] = {0, (done[I] ? column_allocator<I>::destroy(std::get<I>(fresh),
+                                                                            std::get<I>(fresh) + size_)
+                                             : (void)0, 0)...};
+                (void)destroy;
+                deallocate_columns(fresh, new_cap, indices());
+                throw;
+            }
+            destroy_rows(0, size_, indices());
+            deallocate_columns(columns_, capacity_, indices());
+            columns_ = fresh;
+            capacity_ = new_cap;
+        }
+
+        // 构造函数中调用，空间已足够；某一列复制失败时析构已复制的列，之后由析构函数释放空间
+        template <size_t... I>
+        void copy_columns(const soa_vector& rhs, soa_index_sequence<I...>)
+        {
+            size_t copied = 0;
+            try
+            {
+                int copy[] = {0, (ministl::uninitialized_copy(std::get<I>(rhs.columns_),
+                                                              std::get<I>(rhs.columns_) + rhs.size_,
+                                                              std::get<I>(columns_)), ++copied, 0)...};
+                (void)copy;
+            }
+            catch (...)
+            {
+                int destroy[] = {0, (I < copied ? column_allocator<I>::destroy(std::get<I>(columns_),
+                                                                               std::get<I>(columns_) + rhs.size_)
+                                                : (void)0, 0)...};
+                (void)destroy;
+                deallocate_columns(columns_, capacity_, indices());
+                columns_ = std::tuple<Ts*...>(static_cast<Ts*>(nullptr)...);
+                capacity_ = 0;
+                throw;
+            }
+            size_ = rhs.size_;
+        }
+
+        template <size_t... I>
+        void move_rows_down(size_type from, size_type to, soa_index_sequence<I...>)
+        {
+            int expand[] = {0, (ministl::move(std::get<I>(columns_) + to, std::get<I>(columns_) + size_,
+                                              std::get<I>(columns_) + from), 0)...};
+            (void)expand;
+        }
+
+        template <size_t... I>
+        bool equal_columns(const soa_vector& rhs, soa_index_sequence<I...>) const
+        {
+            bool same = true;
+            int expand[] = {0, (same = same && ministl::equal(std::get<I>(columns_), std::get<I>(columns_) + size_,
+                                                              std::get<I>(rhs.columns_)), 0)...};
+            (void)expand;
+            return same;
+        }
+    };
+
+    template <class... Ts>
+    constexpr size_t soa_vector<Ts...>::column_count;
+
+    /*****************************************************************************************/
+
+    template <class... Ts>
+    bool operator==(const soa_vector<Ts...>& lhs, const soa_vector<Ts...>& rhs)
+    {
+        return lhs.equal(rhs);
+    }
+
+    template <class... Ts>
+    bool operator!=(const soa_vector<Ts...>& lhs, const soa_vector<Ts...>& rhs)
+    {
+        return !lhs.equal(rhs);
+    }
+
+    template <class... Ts>
+    void swap(soa_vector<Ts...>& lhs, soa_vector<Ts...>& rhs) noexcept
+    {
+        lhs.swap(rhs);
+    }
+}
+
+#endif //MINISTL_SOA_VECTOR_H
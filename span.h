@@ -0,0 +1,110 @@
+#ifndef MINISTL_SPAN_H
+#define MINISTL_SPAN_H
+
+// 这个头文件包含一个模板类 span
+// span : 对一段连续内存的非拥有视图，只记录首地址与长度
+
+// notes:
+// 只提供动态长度(dynamic extent)的版本，接口与 C++20 std::span 的常用部分一致。
+// span 不管理所指对象的生命周期，底层容器扩容或析构后 span 失效
+
+#include <cstddef>
+
+#include "exception.h"
+#include "iterator.h"
+#include "type_traits.h"
+
+namespace ministl
+{
+    template <class T>
+    class span
+    {
+    public:
+        typedef T                                           element_type;
+        typedef typename std::remove_cv<T>::type            value_type;
+        typedef size_t                                      size_type;
+        typedef ptrdiff_t                                   difference_type;
+        typedef T*                                          pointer;
+        typedef const T*                                    const_pointer;
+        typedef T&                                          reference;
+        typedef const T&                                    const_reference;
+        typedef T*                                          iterator;
+        typedef ministl::reverse_iterator<iterator>         reverse_iterator;
+
+    private:
+        T*        data_;
+        size_type size_;
+
+    public:
+        constexpr span() noexcept : data_(nullptr), size_(0) {}
+        constexpr span(T* data, size_type size) noexcept : data_(data), size_(size) {}
+        constexpr span(T* first, T* last) noexcept : data_(first), size_(static_cast<size_type>(last - first)) {}
+
+        template <size_t N>
+        constexpr span(T (&arr)[N]) noexcept : data_(arr), size_(N) {}
+
+        // 任何提供 data() 与 size() 的连续容器
+        template <class Container, typename std::enable_if<
+                std::is_convertible<decltype(std::declval<Container&>().data()), T*>::value, int>::type = 0>
+        span(Container& c) noexcept : data_(c.data()), size_(static_cast<size_type>(c.size())) {}
+
+        // span<U> 可以转换为 span<const U>
+        template <class U, typename std::enable_if<
+                !std::is_same<U, T>::value && std::is_convertible<U(*)[], T(*)[]>::value, int>::type = 0>
+        constexpr span(const span<U>& other) noexcept : data_(other.data()), size_(other.size()) {}
+
+    public:
+        // 迭代器相关操作
+        constexpr iterator begin()   const noexcept { return data_; }
+        constexpr iterator end()     const noexcept { return data_ + size_; }
+        reverse_iterator   rbegin()  const noexcept { return reverse_iterator(end()); }
+        reverse_iterator   rend()    const noexcept { return reverse_iterator(begin()); }
+
+        // 容量相关操作
+        constexpr size_type size()       const noexcept { return size_; }
+        constexpr size_type size_bytes() const noexcept { return size_ * sizeof(T); }
+        constexpr bool      empty()      const noexcept { return size_ == 0; }
+
+        // 访问元素相关操作
+        reference operator[](size_type n) const
+        {
+            MINISTL_DEBUG(n < size_);
+            return data_[n];
+        }
+
+        reference front() const
+        {
+            MINISTL_DEBUG(size_ != 0);
+            return data_[0];
+        }
+
+        reference back() const
+        {
+            MINISTL_DEBUG(size_ != 0);
+            return data_[size_ - 1];
+        }
+
+        constexpr pointer data() const noexcept { return data_; }
+
+        // 子视图
+        span first(size_type n) const
+        {
+            MINISTL_DEBUG(n <= size_);
+            return span(data_, n);
+        }
+
+        span last(size_type n) const
+        {
+            MINISTL_DEBUG(n <= size_);
+            return span(data_ + (size_ - n), n);
+        }
+
+        span subspan(size_type offset, size_type n = static_cast<size_type>(-1)) const
+        {
+            MINISTL_DEBUG(offset <= size_);
+            return span(data_ + offset, n == static_cast<size_type>(-1) ? size_ - offset : n);
+        }
+    };
+}
+
+#endif //MINISTL_SPAN_H
@@ -0,0 +1,38 @@
+#ifndef MINISTL_T_ALIGNED_ALLOCATOR_H
+#define MINISTL_T_ALIGNED_ALLOCATOR_H
+#include <iostream>
+#include <string>
+#include "test.h"
+#include "../vector.h"
+#include "../aligned_allocator.h"
+
+void aligned_allocator_test()
+{
+    typedef ministl::aligned_allocator<double, 64>  alloc64;
+    typedef ministl::aligned_allocator<char, 4096>  alloc4k;
+
+    std::cout << "[===============================================================]\n";
+    std::cout << "[------------ Run allocator test : aligned_allocator ------------]\n";
+    std::cout << "[-------------------------- API test ---------------------------]\n";
+    static_assert(ministl::vector<double, alloc64>::alignment == 64, "alignment is exposed at compile time");
+    static_assert(ministl::vector<char, alloc4k>::alignment == 4096, "alignment is exposed at compile time");
+    static_assert(ministl::vector<double>::alignment == alignof(std::max_align_t), "default alignment");
+
+    ministl::vector<double, alloc64> v1;
+    ministl::vector<char, alloc4k> v2(3, 'a');
+    for (int i = 0; i < 10000; ++i)
+    {
+        v1.push_back(i);
+        EXPECT_TRUE(reinterpret_cast<size_t>(v1.data()) % 64 == 0);
+    }
+    v1.shrink_to_fit();
+    EXPECT_TRUE(reinterpret_cast<size_t>(v1.data()) % 64 == 0 && v1[9999] == 9999);
+    v2.insert(v2.begin(), 5000, 'b');
+    EXPECT_TRUE(reinterpret_cast<size_t>(v2.data()) % 4096 == 0 && v2.size() == 5003);
+    FUN_VALUE(v1.alignment);
+    FUN_VALUE(v2.alignment);
+    FUN_VALUE(reinterpret_cast<size_t>(v1.data()) % 64);
+
+    std::cout << "[------------ End allocator test : aligned_allocator ------------]\n";
+}
+#endif //MINISTL_T_ALIGNED_ALLOCATOR_H
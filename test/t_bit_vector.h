@@ -0,0 +1,306 @@
+#ifndef MINISTL_T_BIT_VECTOR_H
+#define MINISTL_T_BIT_VECTOR_H
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "test.h"
+#include "../bit_vector.h"
+
+bool bit_vector_matches(const ministl::bit_vector& bv, const std::vector<bool>& expected)
+{
+    if (bv.size() != expected.size())
+        return false;
+    size_t ones = 0;
+    for (size_t i = 0; i < expected.size(); ++i)
+    {
+        if (bv[i] != expected[i])
+            return false;
+        ones += expected[i];
+    }
+    return bv.count() == ones;
+}
+
+// find_first / find_next 依次枚举出的位与逐位扫描一致
+bool bit_vector_find_ok(const ministl::bit_vector& bv)
+{
+    size_t pos = bv.find_first();
+    for (size_t i = 0; i < bv.size(); ++i)
+    {
+        if (bv[i])
+        {
+            if (pos != i)
+                return false;
+            pos = bv.find_next(pos);
+        }
+    }
+    return pos == ministl::bit_vector::npos;
+}
+
+// rank 对每个位置、select 对每个 1 和 0 都与逐位扫描一致
+bool bit_rank_select_ok(const ministl::bit_vector& bv)
+{
+    ministl::bit_rank_select rs(bv);
+    size_t ones = 0;
+    for (size_t i = 0; i <= bv.size(); ++i)
+    {
+        if (rs.rank1(i) != ones || rs.rank0(i) != i - ones)
+            return false;
+        if (i == bv.size())
+            break;
+        if (bv[i] ? rs.select1(ones) != i : rs.select0(i - ones) != i)
+            return false;
+        ones += bv[i];
+    }
+    return rs.ones() == ones && rs.select1(ones) == ministl::bit_rank_select::npos &&
+           rs.select0(bv.size() - ones) == ministl::bit_rank_select::npos;
+}
+
+ministl::bit_vector random_bits(size_t n, unsigned density, std::mt19937_64& rng)
+{
+    ministl::bit_vector bv(n);
+    for (size_t i = 0; i < n; ++i)
+        bv[i] = rng() % 100 < density;
+    return bv;
+}
+
+void bit_vector_test()
+{
+    std::cout << "[===============================================================]\n";
+    std::cout << "[--------------- Run container test : bit_vector ---------------]\n";
+    std::cout << "[-------------------------- API test ---------------------------]\n";
+    std::mt19937_64 rng(42);
+
+    ministl::bit_vector b1;
+    ministl::bit_vector b2(70, true);
+    ministl::bit_vector b3{true, false, true, true};
+    EXPECT_TRUE(b1.empty() && b1.none() && b2.size() == 70 && b2.all() && b2.count() == 70);
+    EXPECT_TRUE(b3.size() == 4 && b3[0] && !b3[1] && b3.count() == 3 && b3.find_first() == 0);
+    FUN_VALUE(b2.word_count());
+    FUN_VALUE(b3.count());
+    b3[1] = b3[0];
+    b3.flip(0).reset(2).set(5 % 4);
+    EXPECT_TRUE(!b3[0] && b3[1] && !b3[2] && b3[3] && ~b3[0]);
+    b3.push_back(true);
+    b3.pop_back();
+    b3.pop_back();
+    EXPECT_TRUE(b3.size() == 3 && b3.count() == 1 && b3.find_next(1) == ministl::bit_vector::npos);
+    b2.resize(130, false);
+    EXPECT_TRUE(b2.count() == 70 && b2.find_next(69) == ministl::bit_vector::npos);
+    b2.resize(200, true);
+    b2.resize(150);
+    EXPECT_TRUE(b2.count() == 90 && !b2.test(75) && b2.test(149) && b2.find_next(69) == 130);
+    b2.flip();
+    EXPECT_TRUE(b2.count() == 60 && b2.find_first() == 70);
+    b2.reset_range(0, 150).set_range(63, 129).flip_range(64, 65);
+    EXPECT_TRUE(b2.count() == 65 && b2.find_first() == 63 && b2.find_next(63) == 65);
+    bool thrown = false;
+    try
+    {
+        b2.at(150) = true;
+    }
+    catch (const std::out_of_range&)
+    {
+        thrown = true;
+    }
+    EXPECT_TRUE(thrown);
+    thrown = false;
+    try
+    {
+        b2 &= b3;
+    }
+    catch (const std::length_error&)
+    {
+        thrown = true;
+    }
+    EXPECT_TRUE(thrown);
+    ministl::bit_vector b4 = ~b2;
+    EXPECT_TRUE((b2 & b4).none() && (b2 | b4).all() && (b2 ^ b4).all() && b4 != b2);
+    b4.and_not(b2);
+    EXPECT_TRUE(b4 == ~b2);
+    ministl::swap(b1, b4);
+    EXPECT_TRUE(b4.empty() && b1.size() == 150);
+    b1.clear();
+    EXPECT_TRUE(b1.empty() && b1.find_first() == ministl::bit_vector::npos);
+
+    // 随机的单个位与区间操作，结果与 std::vector<bool> 一致
+    {
+        ministl::bit_vector bv;
+        std::vector<bool> expected;
+        for (int round = 0; round < 3000; ++round)
+        {
+            const unsigned op = static_cast<unsigned>(rng() % 8);
+            if (op < 3 || expected.empty())
+            {
+                const bool b = rng() % 2 != 0;
+                bv.push_back(b);
+                expected.push_back(b);
+            }
+            else if (op == 3)
+            {
+                bv.pop_back();
+                expected.pop_back();
+            }
+            else if (op == 4)
+            {
+                const size_t n = static_cast<size_t>(rng() % 300);
+                const bool b = rng() % 2 != 0;
+                bv.resize(n, b);
+                expected.resize(n, b);
+            }
+            else
+            {
+                size_t first = static_cast<size_t>(rng() % (expected.size() + 1));
+                size_t last = static_cast<size_t>(rng() % (expected.size() + 1));
+                if (first > last)
+                    ministl::swap(first, last);
+                for (size_t i = first; i < last; ++i)
+                    expected[i] = op == 5 ? true : op == 6 ? false : !expected[i];
+                if (op == 5)
+                    bv.set_range(first, last);
+                else if (op == 6)
+                    bv.reset_range(first, last);
+                else
+                    bv.flip_range(first, last);
+            }
+        }
+        EXPECT_TRUE(bit_vector_matches(bv, expected) && bit_vector_find_ok(bv));
+    }
+
+    // 每一级指令集：count 与按位运算与标量结果一致，长度覆盖不足一个向量与非整字
+    const char* levels[] = {"scalar", "avx2", "avx512"};
+    ministl::vector<ministl::bit_vector> lhs, rhs;
+    for (size_t n : {0, 1, 63, 64, 65, 255, 511, 513, 1000, 4097})
+    {
+        lhs.push_back(random_bits(n, 50, rng));
+        rhs.push_back(random_bits(n, 30, rng));
+    }
+    for (int level = 0; level <= static_cast<int>(ministl::detect_simd_level()); ++level)
+    {
+        ministl::set_simd_level_limit(static_cast<ministl::simd_level>(level));
+        FUN_VALUE(levels[level]);
+        bool ok = true;
+        for (size_t k = 0; k < lhs.size(); ++k)
+        {
+            const ministl::bit_vector& a = lhs[k];
+            const ministl::bit_vector& b = rhs[k];
+            ok = ok && a.count() == ministl::scalar_bits_count(a.data(), a.word_count());
+            const ministl::bit_vector x = a & b, o = a | b, e = a ^ b;
+            for (size_t i = 0; ok && i < a.size(); ++i)
+                ok = x[i] == (a[i] && b[i]) && o[i] == (a[i] || b[i]) && e[i] == (a[i] != b[i]);
+        }
+        EXPECT_TRUE(ok);
+    }
+    ministl::set_simd_level_limit(ministl::simd_level::avx512);
+
+    // rank / select：稀疏、稠密、全 0、全 1，长度跨越多个超级块
+    EXPECT_TRUE(bit_rank_select_ok(ministl::bit_vector()));
+    EXPECT_TRUE(bit_rank_select_ok(random_bits(1000, 50, rng)));
+    EXPECT_TRUE(bit_rank_select_ok(random_bits(200000, 1, rng)));
+    EXPECT_TRUE(bit_rank_select_ok(random_bits(200000, 99, rng)));
+    EXPECT_TRUE(bit_rank_select_ok(ministl::bit_vector(131072)));
+    EXPECT_TRUE(bit_rank_select_ok(ministl::bit_vector(131072 + 7, true)));
+    {
+        uint64_t w = 0;
+        bool ok = true;
+        for (int round = 0; ok && round < 10000; ++round)
+        {
+            w = rng() & rng();
+            unsigned k = 0;
+            for (unsigned i = 0; i < 64; ++i)
+                if ((w >> i) & 1)
+                    ok = ok && ministl::bit_select64(w, k++) == i;
+        }
+        EXPECT_TRUE(ok);
+    }
+
+#if PERFORMANCE_TEST_ON
+    std::cout << "[--------------------- Performance Testing ---------------------]\n";
+#if LARGER_TEST_DATA_ON
+    const size_t len = 1000000000;
+#else
+    const size_t len = 64000000;
+#endif
+    ministl::bit_vector filter = random_bits(len, 50, rng);
+    const ministl::bit_vector other = random_bits(len, 25, rng);
+    std::cout << " " << len << " rows: bit_vector " << (filter.size_in_bytes() >> 20) << " MB, vector<char> "
+              << (len >> 20) << " MB\n";
+    {
+        ministl::vector<char> flags(len, 0);
+        for (size_t i = 0; i < len; ++i)
+            flags[i] = filter[i];
+        ministl::test::timer t;
+        size_t ones = 0;
+        for (size_t i = 0; i < len; ++i)
+            ones += flags[i] != 0;
+        ministl::test::print_time("vector<char> count", len, t.elapsed_ms());
+        EXPECT_TRUE(ones == filter.count());
+    }
+    const size_t expected_ones = ministl::scalar_bits_count(filter.data(), filter.word_count());
+    for (int level = 0; level <= static_cast<int>(ministl::detect_simd_level()); ++level)
+    {
+        ministl::set_simd_level_limit(static_cast<ministl::simd_level>(level));
+        size_t ones = 0;
+        ministl::test::timer t;
+        for (int r = 0; r < 10; ++r)
+            ones += filter.count();
+        ministl::test::print_time(std::string("bit_vector count x10 ") + levels[level], len, t.elapsed_ms());
+        EXPECT_TRUE(ones == 10 * expected_ones);
+        ministl::bit_vector x(filter);
+        t.reset();
+        x &= other;
+        x |= filter;
+        x ^= other;
+        ministl::test::print_time(std::string("bit_vector &= |= ^= ") + levels[level], len, t.elapsed_ms());
+        EXPECT_TRUE(x == (filter ^ other));
+    }
+    ministl::set_simd_level_limit(ministl::simd_level::avx512);
+    {
+        ministl::test::timer t;
+        size_t visited = 0;
+        for (size_t pos = filter.find_first(); pos != ministl::bit_vector::npos; pos = filter.find_next(pos))
+            ++visited;
+        ministl::test::print_time("bit_vector find_next scan", len, t.elapsed_ms());
+        EXPECT_TRUE(visited == expected_ones);
+    }
+    {
+        ministl::test::timer t;
+        ministl::bit_rank_select rs(filter);
+        ministl::test::print_time("bit_rank_select build", len, t.elapsed_ms());
+        std::cout << " rank/select index: " << (rs.size_in_bytes() >> 10) << " KB\n";
+        const size_t queries = 2000000;
+        ministl::vector<size_t> pos(queries, 0);
+        for (size_t i = 0; i < queries; ++i)
+            pos[i] = static_cast<size_t>(rng() % len);
+        t.reset();
+        size_t sum = 0;
+        for (size_t i = 0; i < queries; ++i)
+            sum += rs.rank1(pos[i]);
+        ministl::test::print_time("bit_rank_select rank1", queries, t.elapsed_ms());
+        t.reset();
+        size_t naive = 0;
+        for (size_t i = 0; i < 200; ++i)
+            naive += ministl::bits_count(filter.data(), pos[i] / 64) +
+                     ministl::bit_popcount64(filter.data()[pos[i] / 64] & ((uint64_t(1) << (pos[i] % 64)) - 1));
+        ministl::test::print_time("naive rank by popcount scan", 200, t.elapsed_ms());
+        size_t check = 0;
+        for (size_t i = 0; i < 200; ++i)
+            check += rs.rank1(pos[i]);
+        EXPECT_TRUE(naive == check && sum != 0);
+        t.reset();
+        bool ok = true;
+        for (size_t i = 0; i < queries; ++i)
+        {
+            const size_t k = pos[i] % expected_ones;
+            const size_t p = rs.select1(k);
+            ok = ok && filter[p];
+            sum += p;
+        }
+        ministl::test::print_time("bit_rank_select select1", queries, t.elapsed_ms());
+        EXPECT_TRUE(ok && rs.rank1(rs.select1(12345)) == 12345);
+    }
+#endif
+    std::cout << "[--------------- End container test : bit_vector ---------------]\n";
+}
+#endif //MINISTL_T_BIT_VECTOR_H
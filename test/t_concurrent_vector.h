@@ -0,0 +1,236 @@
+#ifndef MINISTL_T_CONCURRENT_VECTOR_H
+#define MINISTL_T_CONCURRENT_VECTOR_H
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include "test.h"
+#include "../concurrent_vector.h"
+
+size_t concurrent_producer_threads()
+{
+    const size_t hw = static_cast<size_t>(std::thread::hardware_concurrency());
+    return hw < 4 ? 4 : (hw > 64 ? 64 : hw);
+}
+
+// 生产者并发追加 (线程号, 序号)，并把最新元素的下标发布出去；读者读取已发布的元素，
+// 同时检查增长前取得的元素地址一直不变
+bool concurrent_vector_append_ok(size_t per_thread)
+{
+    const size_t producers = concurrent_producer_threads();
+    ministl::concurrent_vector<uint64_t> cv;
+    const uint64_t* first = &*cv.push_back(uint64_t(-1));
+    std::vector<std::atomic<size_t>> published(producers);
+    for (auto& p : published)
+        p.store(0);
+    std::atomic<size_t> done(0);
+    std::atomic<bool> ok(true);
+    ministl::vector<std::thread> threads;
+    for (size_t t = 0; t < producers; ++t)
+    {
+        threads.push_back(std::thread([&cv, &published, &done, t, per_thread]() {
+            for (size_t s = 0; s < per_thread; ++s)
+            {
+                const size_t i = s % 8 == 7 ? cv.grow_by(3, (t << 32) | s).index()
+                                            : cv.push_back((t << 32) | s).index();
+                published[t].store(i + 1, std::memory_order_release);
+            }
+            done.fetch_add(1);
+        }));
+    }
+    std::thread reader([&]() {
+        while (done.load() != producers)
+        {
+            for (size_t t = 0; t < producers; ++t)
+            {
+                const size_t i = published[t].load(std::memory_order_acquire);
+                if (i != 0 && (cv[i - 1] >> 32) != t)
+                    ok = false;
+            }
+            if (cv[0] != uint64_t(-1) || &cv[0] != first)
+                ok = false;
+        }
+    });
+    for (std::thread& th : threads)
+        th.join();
+    reader.join();
+    // 每个生产者的元素各出现一次(grow_by 的三份算一次)，且按序号递增的顺序出现
+    const size_t grown = per_thread / 8;
+    if (cv.size() != 1 + producers * (per_thread + 2 * grown) || &cv[0] != first)
+        return false;
+    ministl::vector<uint64_t> next(producers, 0);
+    for (size_t i = 1; i < cv.size(); ++i)
+    {
+        const size_t t = static_cast<size_t>(cv[i] >> 32);
+        const uint64_t s = cv[i] & 0xFFFFFFFFu;
+        if (t >= producers)
+            return false;
+        if (s == next[t])
+            ++next[t];
+        else if (s + 1 != next[t] || s % 8 != 7)
+            return false;
+    }
+    for (size_t t = 0; t < producers; ++t)
+    {
+        if (next[t] != per_thread)
+            return false;
+    }
+    return ok;
+}
+
+// 单趟输入迭代器：所有副本共享同一个读取位置，遍历一次后即耗尽
+struct cv_single_pass : public ministl::iterator<ministl::input_iterator_tag, int>
+{
+    int* pos;
+    int last;
+
+    cv_single_pass(int* p, int n) : pos(p), last(n) {}
+    int operator*() const { return *pos; }
+    cv_single_pass& operator++()
+    {
+        ++*pos;
+        return *this;
+    }
+    bool at_end() const { return pos == nullptr || *pos == last; }
+    bool operator==(const cv_single_pass& rhs) const { return at_end() == rhs.at_end(); }
+    bool operator!=(const cv_single_pass& rhs) const { return !(*this == rhs); }
+};
+
+void concurrent_vector_test()
+{
+    std::cout << "[===============================================================]\n";
+    std::cout << "[----------- Run container test : concurrent_vector ------------]\n";
+    std::cout << "[-------------------------- API test ---------------------------]\n";
+    ministl::concurrent_vector<int> c1;
+    ministl::concurrent_vector<int> c2(5, 3);
+    ministl::concurrent_vector<int> c3{1, 2, 3, 4};
+    EXPECT_TRUE(c1.empty() && c2.size() == 5 && c2[4] == 3 && c3.front() == 1);
+    int* p = &c3[0];
+    for (int i = 0; i < 10000; ++i)
+        c3.push_back(i);
+    EXPECT_TRUE(p == &c3[0] && c3.size() == 10004 && c3[10003] == 9999 && c3.capacity() >= c3.size());
+    FUN_VALUE(c3.capacity());
+    auto it = c3.grow_by({7, 8, 9});
+    EXPECT_TRUE(*it == 7 && it[2] == 9 && c3.end() - it == 3);
+    {
+        int cursor = 0;
+        ministl::concurrent_vector<int> c4;
+        c4.grow_by(cv_single_pass(&cursor, 5), cv_single_pass(nullptr, 0));
+        EXPECT_TRUE(c4.size() == 5 && c4[0] == 0 && c4[4] == 4 && cursor == 5);
+    }
+    c3.grow_to_at_least(20000);
+    EXPECT_TRUE(c3.size() == 20000 && c3[19999] == 0);
+    c3.grow_to_at_least(10);
+    EXPECT_TRUE(c3.size() == 20000);
+    ministl::vector<int> v = c3.to_vector();
+    EXPECT_TRUE(v.size() == 20000 && v[4] == 0 && v[10006] == 9);
+    ministl::concurrent_vector<int> c4(c3);
+    EXPECT_TRUE(c4 == c3 && &c4[0] != &c3[0]);
+    c1 = ministl::move(c4);
+    c3.clear();
+    EXPECT_TRUE(c1.size() == 20000 && c4.empty() && c3.empty() && c3.capacity() >= 20000);
+    c3.reserve(100000);
+    EXPECT_TRUE(c3.capacity() >= 100000);
+    bool thrown = false;
+    try
+    {
+        c3.at(0);
+    }
+    catch (const std::out_of_range&)
+    {
+        thrown = true;
+    }
+    EXPECT_TRUE(thrown);
+    {
+        // 构造失败的位置改为默认构造，size 与存活对象个数保持一致
+        typedef ministl::test::counted<ministl::test::throw_on_value> elem;
+        ministl::concurrent_vector<elem> ct;
+        ct.emplace_back(1);
+        int values[] = {2, -1, 3};
+        thrown = false;
+        try
+        {
+            ct.grow_by(values, values + 3);
+        }
+        catch (const std::runtime_error&)
+        {
+            thrown = true;
+        }
+        EXPECT_TRUE(thrown && ct.size() == 4 && elem::live == 4 && ct[1].value == 2 && ct[2].value == 0);
+    }
+    EXPECT_TRUE(ministl::test::counted<ministl::test::throw_on_value>::live == 0);
+    EXPECT_TRUE(concurrent_vector_append_ok(20000));
+
+#if PERFORMANCE_TEST_ON
+    std::cout << "[--------------------- Performance Testing ---------------------]\n";
+#if LARGER_TEST_DATA_ON
+    const size_t per_thread = 10000000;
+#else
+    const size_t per_thread = 1000000;
+#endif
+    const size_t producers = concurrent_producer_threads();
+    std::cout << " producers : " << producers << "\n";
+    {
+        ministl::vector<uint64_t> locked;
+        std::mutex lock;
+        ministl::test::timer t;
+        ministl::vector<std::thread> threads;
+        for (size_t r = 0; r < producers; ++r)
+        {
+            threads.push_back(std::thread([&locked, &lock, per_thread, r]() {
+                for (size_t i = 0; i < per_thread; ++i)
+                {
+                    std::lock_guard<std::mutex> guard(lock);
+                    locked.push_back(r * per_thread + i);
+                }
+            }));
+        }
+        for (std::thread& th : threads)
+            th.join();
+        ministl::test::print_time("mutex + vector push_back", producers * per_thread, t.elapsed_ms());
+        EXPECT_TRUE(locked.size() == producers * per_thread);
+    }
+    {
+        ministl::concurrent_vector<uint64_t> cv;
+        ministl::test::timer t;
+        ministl::vector<std::thread> threads;
+        for (size_t r = 0; r < producers; ++r)
+        {
+            threads.push_back(std::thread([&cv, per_thread, r]() {
+                for (size_t i = 0; i < per_thread; ++i)
+                    cv.push_back(r * per_thread + i);
+            }));
+        }
+        for (std::thread& th : threads)
+            th.join();
+        ministl::test::print_time("concurrent_vector push_back", producers * per_thread, t.elapsed_ms());
+        EXPECT_TRUE(cv.size() == producers * per_thread);
+    }
+    {
+        ministl::concurrent_vector<uint64_t> cv;
+        ministl::test::timer t;
+        ministl::vector<std::thread> threads;
+        for (size_t r = 0; r < producers; ++r)
+        {
+            threads.push_back(std::thread([&cv, per_thread, r]() {
+                uint64_t batch[64];
+                for (size_t i = 0; i < per_thread; i += 64)
+                {
+                    for (size_t j = 0; j < 64; ++j)
+                        batch[j] = r * per_thread + i + j;
+                    cv.grow_by(batch, batch + ministl::min(static_cast<size_t>(64), per_thread - i));
+                }
+            }));
+        }
+        for (std::thread& th : threads)
+            th.join();
+        ministl::test::print_time("concurrent_vector grow_by(64)", producers * per_thread, t.elapsed_ms());
+        EXPECT_TRUE(cv.size() == producers * per_thread);
+    }
+#endif
+    std::cout << "[----------- End container test : concurrent_vector ------------]\n";
+}
+#endif //MINISTL_T_CONCURRENT_VECTOR_H
@@ -0,0 +1,169 @@
+#ifndef MINISTL_T_COW_VECTOR_H
+#define MINISTL_T_COW_VECTOR_H
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <thread>
+#include "test.h"
+#include "../cow_vector.h"
+
+// 多个线程同时拷贝、读取、销毁同一份快照，部分线程在自己的副本上写入
+bool cow_vector_concurrent_ok()
+{
+    const ministl::cow_vector<uint64_t> table(4096, 7);
+    std::atomic<bool> ok(true);
+    ministl::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.push_back(std::thread([&table, &ok, t]() {
+            for (int round = 0; round < 2000; ++round)
+            {
+                ministl::cow_vector<uint64_t> copy(table);
+                uint64_t sum = 0;
+                for (uint64_t v : copy)
+                    sum += v;
+                if (sum != 4096 * 7)
+                    ok = false;
+                if (t % 2 == 1 && round % 16 == 0)
+                {
+                    copy.set(0, 100);
+                    copy.push_back(1);
+                    if (copy.shared() || copy[0] != 100 || copy.size() != 4097)
+                        ok = false;
+                }
+            }
+        }));
+    }
+    for (std::thread& th : threads)
+        th.join();
+    return ok && table.use_count() == 1 && table[0] == 7 && table.size() == 4096;
+}
+
+// 只读扫描 rounds 遍并计时
+template <class Container>
+uint64_t cow_scan_time(const std::string& name, const Container& c, size_t rounds)
+{
+    ministl::test::timer t;
+    uint64_t sum = 0;
+    for (size_t r = 0; r < rounds; ++r)
+        for (size_t i = 0; i < c.size(); ++i)
+            sum += c[i] ^ r;
+    ministl::test::print_time(name, rounds * c.size(), t.elapsed_ms());
+    return sum;
+}
+
+void cow_vector_test()
+{
+    std::cout << "[===============================================================]\n";
+    std::cout << "[-------------- Run container test : cow_vector ----------------]\n";
+    std::cout << "[-------------------------- API test ---------------------------]\n";
+    ministl::cow_vector<int> c1;
+    ministl::cow_vector<int> c2(5, 3);
+    ministl::cow_vector<int> c3{1, 2, 3, 4};
+    ministl::vector<int> v{9, 8, 7};
+    ministl::cow_vector<int> c4(v.begin(), v.end());
+    const ministl::cow_vector<int>& cc3 = c3;
+    EXPECT_TRUE(c1.empty() && c1.use_count() == 0 && c2.size() == 5 && cc3.back() == 4 && c4.front() == 9);
+    FUN_VALUE(c3.use_count());
+    FUN_VALUE(c4.size());
+
+    // 拷贝共享缓冲区，修改时才复制
+    ministl::cow_vector<int> c5(c3);
+    const ministl::cow_vector<int>& cc5 = c5;
+    EXPECT_TRUE(c5.use_count() == 2 && c3.shared() && cc5.data() == cc3.data() && c5 == c3);
+    c5.set(0, 10);
+    EXPECT_TRUE(!c5.shared() && !c3.shared() && cc3[0] == 1 && cc5[0] == 10 && c5 != c3);
+    ministl::cow_vector<int> c6 = c3;
+    c6.push_back(5);
+    EXPECT_TRUE(c3.size() == 4 && c6.size() == 5 && c6.back() == 5 && c3.use_count() == 1);
+    c6 = c3;
+    c6.pop_back();
+    c6.erase(c6.cbegin());
+    EXPECT_TRUE(c3.size() == 4 && c6.size() == 2 && c6[0] == 2 && c3 < c6);
+    c6 = c3;
+    c6.resize(6, 1);
+    c6.resize(5);
+    EXPECT_TRUE(c3.size() == 4 && c6.size() == 5 && c6.back() == 1);
+    c6 = c3;
+    c6.push_back(c6[1]);
+    EXPECT_TRUE(c6.back() == 2 && c3.size() == 4);
+
+    // 交出可写引用后不再共享，之后的拷贝是深拷贝
+    ministl::cow_vector<int> c7(c3);
+    int& r = c7[2];
+    ministl::cow_vector<int> c8(c7);
+    r = 30;
+    EXPECT_TRUE(c3[2] == 3 && c7[2] == 30 && c8[2] == 3 && !c7.shared() && !c8.shared());
+    for (int& x : c7)
+        x += 1;
+    EXPECT_TRUE(c7[0] == 2 && c3[0] == 1);
+    bool thrown = false;
+    try
+    {
+        c3.at(4);
+    }
+    catch (const std::out_of_range&)
+    {
+        thrown = true;
+    }
+    EXPECT_TRUE(thrown);
+
+    // 非平凡的元素类型
+    ministl::cow_vector<std::string> s1{"a", "bb", "ccc"};
+    ministl::cow_vector<std::string> s2(s1);
+    s2.push_back("dddd");
+    s2.set(0, "A");
+    ministl::cow_vector<std::string> s3(ministl::move(s2));
+    EXPECT_TRUE(s1[0] == "a" && s1.size() == 3 && s2.empty() && s3.size() == 4 && s3[0] == "A");
+    s3.reserve(100);
+    EXPECT_TRUE(s3.capacity() >= 100 && s3.back() == "dddd");
+    s3 = {"x"};
+    s1.clear();
+    ministl::swap(s1, s3);
+    EXPECT_TRUE(s1.size() == 1 && s3.empty());
+    EXPECT_TRUE(cow_vector_concurrent_ok());
+
+#if PERFORMANCE_TEST_ON
+    std::cout << "[--------------------- Performance Testing ---------------------]\n";
+    // 每个请求拷贝一份路由表，只读
+#if LARGER_TEST_DATA_ON
+    const size_t table_size = 100000;
+    const size_t requests = 100000;
+#else
+    const size_t table_size = 10000;
+    const size_t requests = 100000;
+#endif
+    ministl::vector<uint64_t> vtable(table_size, 0);
+    for (size_t i = 0; i < table_size; ++i)
+        vtable[i] = i * 2654435761u;
+    const ministl::cow_vector<uint64_t> ctable(vtable.begin(), vtable.end());
+    // 只读扫描的开销与 vector 相同
+    const ministl::vector<uint64_t>& cvtable = vtable;
+    const uint64_t vector_sum = cow_scan_time("vector scan", cvtable, 1000);
+    EXPECT_TRUE(cow_scan_time("cow_vector scan", ctable, 1000) == vector_sum);
+    uint64_t expected = 0;
+    {
+        ministl::test::timer t;
+        for (size_t i = 0; i < requests; ++i)
+        {
+            const ministl::vector<uint64_t> snapshot(vtable);
+            expected += snapshot[i % table_size];
+        }
+        ministl::test::print_time("vector copy per request", requests, t.elapsed_ms());
+    }
+    {
+        ministl::test::timer t;
+        uint64_t sum = 0;
+        for (size_t i = 0; i < requests; ++i)
+        {
+            const ministl::cow_vector<uint64_t> snapshot(ctable);
+            sum += snapshot[i % table_size];
+        }
+        ministl::test::print_time("cow_vector copy per request", requests, t.elapsed_ms());
+        EXPECT_TRUE(sum == expected);
+    }
+#endif
+    std::cout << "[-------------- End container test : cow_vector ----------------]\n";
+}
+#endif //MINISTL_T_COW_VECTOR_H
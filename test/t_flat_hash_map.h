@@ -0,0 +1,224 @@
+#ifndef MINISTL_T_FLAT_HASH_MAP_H
+#define MINISTL_T_FLAT_HASH_MAP_H
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include "test.h"
+#include "../flat_hash_map.h"
+#include "../flat_hash_set.h"
+
+template <class Map, class StdMap>
+bool flat_hash_map_matches_std(const Map& m, const StdMap& expected)
+{
+    if (m.size() != expected.size())
+        return false;
+    size_t visited = 0;
+    for (auto it = m.begin(); it != m.end(); ++it, ++visited)
+    {
+        auto pos = expected.find(it->first);
+        if (pos == expected.end() || !(pos->second == it->second))
+            return false;
+    }
+    return visited == expected.size();
+}
+
+// 插入、命中、未命中与删除各 n 次，键为均匀随机的 64 位整数
+void flat_hash_map_bench(size_t n, std::mt19937_64& rng, bool with_std)
+{
+    ministl::vector<uint64_t> keys(n, 0);
+    ministl::vector<uint64_t> misses(n, 0);
+    for (size_t i = 0; i < n; ++i)
+    {
+        keys[i] = rng() | 1;
+        misses[i] = rng() & ~static_cast<uint64_t>(1);
+    }
+    {
+        ministl::flat_hash_map<uint64_t, uint64_t> m;
+        ministl::test::timer t;
+        for (size_t i = 0; i < n; ++i)
+            m.insert(ministl::pair<const uint64_t, uint64_t>(keys[i], i));
+        ministl::test::print_time("flat_hash_map insert", n, t.elapsed_ms());
+    }
+    ministl::flat_hash_map<uint64_t, uint64_t> m;
+    {
+        ministl::test::timer t;
+        m.reserve(n);
+        for (size_t i = 0; i < n; ++i)
+            m.insert(ministl::pair<const uint64_t, uint64_t>(keys[i], i));
+        ministl::test::print_time("flat_hash_map reserve + insert", n, t.elapsed_ms());
+    }
+    {
+        ministl::test::timer t;
+        uint64_t sum = 0;
+        for (size_t i = 0; i < n; ++i)
+            sum += m.find(keys[i])->second;
+        ministl::test::print_time("flat_hash_map lookup hit", n, t.elapsed_ms());
+        EXPECT_TRUE(sum == static_cast<uint64_t>(n) * (n - 1) / 2);
+    }
+    {
+        ministl::test::timer t;
+        size_t found = 0;
+        for (size_t i = 0; i < n; ++i)
+            found += m.count(misses[i]);
+        ministl::test::print_time("flat_hash_map lookup miss", n, t.elapsed_ms());
+        EXPECT_TRUE(found == 0);
+    }
+    {
+        ministl::test::timer t;
+        size_t erased = 0;
+        for (size_t i = 0; i < n; ++i)
+            erased += m.erase(keys[i]);
+        ministl::test::print_time("flat_hash_map erase", n, t.elapsed_ms());
+        EXPECT_TRUE(erased == n && m.empty());
+    }
+    if (!with_std)
+        return;
+    std::unordered_map<uint64_t, uint64_t> s;
+    {
+        ministl::test::timer t;
+        s.reserve(n);
+        for (size_t i = 0; i < n; ++i)
+            s.insert(std::make_pair(keys[i], i));
+        ministl::test::print_time("std::unordered_map reserve + insert", n, t.elapsed_ms());
+    }
+    {
+        ministl::test::timer t;
+        uint64_t sum = 0;
+        for (size_t i = 0; i < n; ++i)
+            sum += s.find(keys[i])->second;
+        ministl::test::print_time("std::unordered_map lookup hit", n, t.elapsed_ms());
+        EXPECT_TRUE(sum == static_cast<uint64_t>(n) * (n - 1) / 2);
+    }
+    {
+        ministl::test::timer t;
+        size_t found = 0;
+        for (size_t i = 0; i < n; ++i)
+            found += s.count(misses[i]);
+        ministl::test::print_time("std::unordered_map lookup miss", n, t.elapsed_ms());
+        EXPECT_TRUE(found == 0);
+    }
+    {
+        ministl::test::timer t;
+        for (size_t i = 0; i < n; ++i)
+            s.erase(keys[i]);
+        ministl::test::print_time("std::unordered_map erase", n, t.elapsed_ms());
+        EXPECT_TRUE(s.empty());
+    }
+}
+
+void flat_hash_map_test()
+{
+    std::cout << "[===============================================================]\n";
+    std::cout << "[------------- Run container test : flat_hash_map --------------]\n";
+    std::cout << "[-------------------------- API test ---------------------------]\n";
+    std::mt19937_64 rng(39);
+    typedef ministl::pair<const int, std::string> item;
+
+    ministl::flat_hash_map<int, std::string> m1;
+    ministl::flat_hash_map<int, std::string> m2{item(3, "c"), item(1, "a"), item(2, "b"), item(1, "x")};
+    EXPECT_TRUE(m1.empty() && m1.begin() == m1.end() && m1.find(1) == m1.end() && m1.erase(1) == 0);
+    EXPECT_TRUE(m2.size() == 3 && m2.at(1) == "a" && m2.count(2) == 1 && !m2.contains(4));
+    FUN_VALUE(m2.capacity());
+    m1[7] = "seven";
+    m1[2] = "two";
+    EXPECT_TRUE(m1.insert(item(5, "five")).second && !m1.insert(item(5, "FIVE")).second);
+    EXPECT_TRUE(m1.try_emplace(9, 3, 'n').first->second == "nnn" && !m1.emplace(9, "x").second);
+    EXPECT_TRUE(!m1.insert_or_assign(7, std::string("SEVEN")).second && m1[7] == "SEVEN");
+    EXPECT_TRUE(m1.insert_or_assign(8, "eight").second && m1.size() == 5);
+    m1.insert(m2.begin(), m2.end());
+    EXPECT_TRUE(m1.size() == 7 && m1[2] == "two" && m1[3] == "c");
+    auto pos = m1.erase(m1.find(3));
+    EXPECT_TRUE(m1.size() == 6 && !m1.contains(3) && (pos == m1.end() || m1.contains(pos->first)));
+    for (auto it = m2.begin(); it != m2.end(); ++it)
+        it->second += "!";
+    const ministl::flat_hash_map<int, std::string>& cm2 = m2;
+    EXPECT_TRUE(cm2.at(3) == "c!" && cm2.find(2)->second == "b!");
+    bool thrown = false;
+    try
+    {
+        cm2.at(100);
+    }
+    catch (const std::out_of_range&)
+    {
+        thrown = true;
+    }
+    EXPECT_TRUE(thrown);
+    ministl::flat_hash_map<int, std::string> m3(m1);
+    EXPECT_TRUE(m3 == m1 && m3 != m2);
+    ministl::swap(m1, m2);
+    EXPECT_TRUE(m1.size() == 3 && m2.size() == 6 && m2 == m3);
+    m3 = ministl::move(m1);
+    EXPECT_TRUE(m3.size() == 3 && m1.empty());
+    m2.erase(m2.begin(), m2.end());
+    EXPECT_TRUE(m2.empty() && m2.begin() == m2.end());
+    m3.clear();
+    EXPECT_TRUE(m3.empty() && m3.begin() == m3.end() && m3.capacity() != 0);
+
+    ministl::flat_hash_set<std::string> s1{"a", "b", "c", "a"};
+    EXPECT_TRUE(s1.size() == 3 && s1.contains("b") && !s1.insert("c").second && s1.erase("a") == 1);
+    ministl::flat_hash_set<int> s2;
+    s2.reserve(1000);
+    const size_t cap = s2.capacity();
+    for (int i = 0; i < 1000; ++i)
+        s2.insert(i);
+    EXPECT_TRUE(s2.size() == 1000 && s2.capacity() == cap);
+    s2.rehash(0);
+    EXPECT_TRUE(s2.size() == 1000 && s2.capacity() == cap);
+    for (int i = 0; i < 990; ++i)
+        s2.erase(i);
+    s2.rehash(0);
+    EXPECT_TRUE(s2.size() == 10 && s2.capacity() == 15 && s2.contains(995));
+
+    // 随机插入与删除，结果与 std::unordered_map 一致
+    {
+        ministl::flat_hash_map<int, int> m;
+        std::unordered_map<int, int> expected;
+        for (int i = 0; i < 200000; ++i)
+        {
+            const int key = static_cast<int>(rng() % 20000);
+            if (rng() % 3 == 0)
+            {
+                EXPECT_TRUE(m.erase(key) == expected.erase(key));
+            }
+            else
+            {
+                EXPECT_TRUE(m.insert(ministl::pair<const int, int>(key, i)).second ==
+                            expected.insert(std::make_pair(key, i)).second);
+            }
+        }
+        EXPECT_TRUE(flat_hash_map_matches_std(m, expected));
+    }
+
+    // 元素个数不变、不断插入新键并删除旧键：墓碑靠就地 rehash 清除，容量不增长
+    {
+        ministl::flat_hash_map<std::string, int> m;
+        std::unordered_map<std::string, int> expected;
+        m.reserve(1000);
+        const size_t capacity = m.capacity();
+        for (int i = 0; i < 100000; ++i)
+        {
+            m.insert(ministl::pair<const std::string, int>(std::to_string(i), i));
+            expected.insert(std::make_pair(std::to_string(i), i));
+            if (i >= 1000)
+            {
+                m.erase(std::to_string(i - 1000));
+                expected.erase(std::to_string(i - 1000));
+            }
+        }
+        EXPECT_TRUE(m.capacity() == capacity && flat_hash_map_matches_std(m, expected));
+    }
+
+#if PERFORMANCE_TEST_ON
+    std::cout << "[--------------------- Performance Testing ---------------------]\n";
+    flat_hash_map_bench(1000000, rng, true);
+    flat_hash_map_bench(10000000, rng, false);
+#if LARGER_TEST_DATA_ON
+    flat_hash_map_bench(100000000, rng, false);
+#endif
+#endif
+    std::cout << "[------------- End container test : flat_hash_map --------------]\n";
+}
+#endif //MINISTL_T_FLAT_HASH_MAP_H
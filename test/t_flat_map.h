@@ -0,0 +1,227 @@
+#ifndef MINISTL_T_FLAT_MAP_H
+#define MINISTL_T_FLAT_MAP_H
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <random>
+#include <string>
+#include "test.h"
+#include "../flat_map.h"
+
+// simd_lower_bound 的结果与 std::lower_bound 一致，覆盖不足一个窗口、窗口越过末尾与极值
+template <class T>
+bool simd_lower_bound_ok(std::mt19937_64& rng)
+{
+    const T lo = std::numeric_limits<T>::min();
+    const T hi = std::numeric_limits<T>::max();
+    for (size_t n : {0, 1, 5, 15, 16, 17, 33, 100, 1000, 4099})
+    {
+        ministl::vector<T> v(n, T());
+        for (size_t i = 0; i < n; ++i)
+            v[i] = static_cast<T>(rng() % 64 == 0 ? (rng() % 2 ? lo : hi) : static_cast<T>(rng() % 5000));
+        std::sort(v.begin(), v.end());
+        for (size_t q = 0; q < 3000; ++q)
+        {
+            const T key = q < 3 ? (q == 0 ? lo : q == 1 ? hi : static_cast<T>(0))
+                                : (n != 0 && q % 2 ? v[rng() % n] : static_cast<T>(rng() % 5100));
+            const size_t expected = static_cast<size_t>(std::lower_bound(v.begin(), v.end(), key) - v.begin());
+            if (ministl::simd_lower_bound(v.data(), n, key) != expected)
+                return false;
+        }
+    }
+    return true;
+}
+
+template <class Map>
+bool flat_map_matches_std(const Map& m, const std::map<int, int>& expected)
+{
+    if (m.size() != expected.size())
+        return false;
+    auto it = expected.begin();
+    for (auto pos = m.begin(); pos != m.end(); ++pos, ++it)
+    {
+        if (pos->first != it->first || pos->second != it->second)
+            return false;
+    }
+    return true;
+}
+
+template <class Search>
+void flat_map_lookup_time(const std::string& name, size_t n, const ministl::vector<uint64_t>& queries,
+                          uint64_t expected_sum, Search search)
+{
+    ministl::test::timer t;
+    uint64_t sum = 0;
+    for (uint64_t q : queries)
+        sum += search(q);
+    ministl::test::print_time(name, n, t.elapsed_ms());
+    EXPECT_TRUE(sum == expected_sum);
+}
+
+void flat_map_lookup_bench(size_t n, std::mt19937_64& rng)
+{
+    const char* levels[] = {"scalar", "avx2", "avx512"};
+    ministl::vector<ministl::pair<uint64_t, uint64_t>> data(n, ministl::pair<uint64_t, uint64_t>(0, 0));
+    for (size_t i = 0; i < n; ++i)
+        data[i] = ministl::pair<uint64_t, uint64_t>(rng() % (4 * n), i);
+    ministl::flat_map<uint64_t, uint64_t> m(data.begin(), data.end());
+    std::map<uint64_t, uint64_t> tree;
+    for (size_t i = 0; i < n; ++i)
+        tree.insert(std::make_pair(data[i].first, data[i].second));
+    const size_t lookups = 2000000;
+    ministl::vector<uint64_t> queries(lookups, 0);
+    uint64_t expected_sum = 0;
+    for (size_t i = 0; i < lookups; ++i)
+    {
+        queries[i] = rng() % (4 * n);
+        auto it = tree.find(queries[i]);
+        expected_sum += it == tree.end() ? 0 : it->second + 1;
+    }
+    std::cout << " " << lookups << " lookups, map size = " << n << "\n";
+    flat_map_lookup_time("std::map::find", n, queries, expected_sum, [&tree](uint64_t q) {
+        auto it = tree.find(q);
+        return it == tree.end() ? 0 : it->second + 1;
+    });
+    for (int level = 0; level <= static_cast<int>(ministl::detect_simd_level()); ++level)
+    {
+        ministl::set_simd_level_limit(static_cast<ministl::simd_level>(level));
+        flat_map_lookup_time(std::string("flat_map::find ") + levels[level], n, queries, expected_sum,
+                             [&m](uint64_t q) {
+                                 auto it = m.find(q);
+                                 return it == m.end() ? 0 : it.value() + 1;
+                             });
+    }
+    ministl::set_simd_level_limit(ministl::simd_level::avx512);
+}
+
+void flat_map_test()
+{
+    std::cout << "[===============================================================]\n";
+    std::cout << "[---------------- Run container test : flat_map ----------------]\n";
+    std::cout << "[-------------------------- API test ---------------------------]\n";
+    std::mt19937_64 rng(38);
+    typedef ministl::pair<int, std::string> item;
+
+    ministl::flat_map<int, std::string> m1;
+    ministl::flat_map<int, std::string> m2{item(3, "c"), item(1, "a"), item(2, "b"), item(1, "x")};
+    ministl::flat_map<int, int> m3(ministl::vector<int>{5, 1, 5, 3}, ministl::vector<int>{50, 10, 51, 30});
+    EXPECT_TRUE(m1.empty() && m2.size() == 3 && m2.at(1) == "a" && m3.size() == 3 && m3.at(5) == 50);
+    FUN_VALUE(m2.begin()->second);
+    FUN_VALUE(m3.keys().size());
+    m1[7] = "seven";
+    m1[2] = "two";
+    EXPECT_TRUE(m1.insert(item(5, "five")).second && !m1.insert(item(5, "FIVE")).second);
+    EXPECT_TRUE(m1.try_emplace(9, 3, 'n').first.value() == "nnn" && !m1.emplace(9, "x").second);
+    EXPECT_TRUE(!m1.insert_or_assign(7, std::string("SEVEN")).second && m1[7] == "SEVEN");
+    EXPECT_TRUE(m1.keys() == ministl::vector<int>({2, 5, 7, 9}));
+    m1.insert_batch(m2.begin(), m2.end());
+    m1.insert({item(0, "zero"), item(8, "eight"), item(2, "dup")});
+    EXPECT_TRUE(m1.size() == 8 && m1[2] == "two" && m1[8] == "eight");
+    EXPECT_TRUE(m1.lower_bound(4).key() == 5 && m1.upper_bound(5).key() == 7 && m1.find(4) == m1.end());
+    EXPECT_TRUE(m1.count(3) == 1 && m1.contains(0) && !m1.contains(10));
+    EXPECT_TRUE(m1.erase(3) == 1 && m1.erase(3) == 0 && m1.erase(m1.begin())->first == 1);
+    m1.erase(m1.find(5), m1.end());
+    EXPECT_TRUE(m1.keys() == ministl::vector<int>({1, 2}) && m1.values().back() == "two");
+    for (auto it = m2.begin(); it != m2.end(); ++it)
+        it->second += "!";
+    const ministl::flat_map<int, std::string>& cm2 = m2;
+    EXPECT_TRUE(cm2.at(3) == "c!" && cm2.find(2)->second == "b!");
+    bool thrown = false;
+    try
+    {
+        cm2.at(100);
+    }
+    catch (const std::out_of_range&)
+    {
+        thrown = true;
+    }
+    EXPECT_TRUE(thrown);
+    ministl::swap(m1, m2);
+    EXPECT_TRUE(m1.size() == 3 && m2.size() == 2 && m1 != m2);
+    m2.clear();
+    EXPECT_TRUE(m2.empty() && m2.begin() == m2.end());
+
+    // 随机批量插入与删除，结果与 std::map 一致
+    {
+        ministl::flat_map<int, int> m;
+        std::map<int, int> expected;
+        size_t reallocs = 0;
+        for (int round = 0; round < 20; ++round)
+        {
+            const size_t cap = m.capacity();
+            ministl::vector<ministl::pair<int, int>> batch;
+            for (int i = 0; i < 500; ++i)
+            {
+                const int key = static_cast<int>(rng() % 5000);
+                batch.push_back(ministl::pair<int, int>(key, round * 1000 + i));
+                expected.insert(std::make_pair(key, round * 1000 + i));
+            }
+            m.insert_batch(batch.begin(), batch.end());
+            reallocs += m.capacity() != cap;
+            const int key = static_cast<int>(rng() % 5000);
+            EXPECT_TRUE(m.erase(key) == expected.erase(key));
+        }
+        // 归并复用已有容量，容量按几何级数增长
+        EXPECT_TRUE(flat_map_matches_std(m, expected) && reallocs <= 10);
+    }
+
+    // 向量化查找：每一级指令集、每种整数类型
+    const char* levels[] = {"scalar", "avx2", "avx512"};
+    for (int level = 0; level <= static_cast<int>(ministl::detect_simd_level()); ++level)
+    {
+        ministl::set_simd_level_limit(static_cast<ministl::simd_level>(level));
+        FUN_VALUE(levels[level]);
+        EXPECT_TRUE(simd_lower_bound_ok<int32_t>(rng));
+        EXPECT_TRUE(simd_lower_bound_ok<uint32_t>(rng));
+        EXPECT_TRUE(simd_lower_bound_ok<int64_t>(rng));
+        EXPECT_TRUE(simd_lower_bound_ok<uint64_t>(rng));
+    }
+    ministl::set_simd_level_limit(ministl::simd_level::avx512);
+
+#if PERFORMANCE_TEST_ON
+    std::cout << "[--------------------- Performance Testing ---------------------]\n";
+#if LARGER_TEST_DATA_ON
+    const size_t len = 10000000;
+#else
+    const size_t len = 1000000;
+#endif
+    ministl::vector<ministl::pair<uint64_t, uint64_t>> data(len, ministl::pair<uint64_t, uint64_t>(0, 0));
+    for (size_t i = 0; i < len; ++i)
+        data[i] = ministl::pair<uint64_t, uint64_t>(rng() % (4 * len), i);
+    // 批量构造 vs 逐个插入(逐个插入只测前 1/10)
+    {
+        ministl::test::timer t;
+        ministl::flat_map<uint64_t, uint64_t> m(data.begin(), data.end());
+        ministl::test::print_time("flat_map bulk build", len, t.elapsed_ms());
+    }
+    {
+        ministl::test::timer t;
+        ministl::flat_map<uint64_t, uint64_t> m;
+        for (size_t i = 0; i < len / 10; ++i)
+            m.insert(data[i]);
+        ministl::test::print_time("flat_map insert one by one", len / 10, t.elapsed_ms());
+    }
+    {
+        ministl::test::timer t;
+        ministl::flat_map<uint64_t, uint64_t> m;
+        for (size_t i = 0; i < len / 10; i += 1000)
+            m.insert_batch(data.begin() + i, data.begin() + ministl::min(i + 1000, len / 10));
+        ministl::test::print_time("flat_map insert_batch of 1000", len / 10, t.elapsed_ms());
+    }
+    {
+        ministl::test::timer t;
+        std::map<uint64_t, uint64_t> m;
+        for (size_t i = 0; i < len; ++i)
+            m.insert(std::make_pair(data[i].first, data[i].second));
+        ministl::test::print_time("std::map insert", len, t.elapsed_ms());
+    }
+
+    // 查找：放得进缓存的小表与远大于缓存的大表
+    for (size_t n : {static_cast<size_t>(4096), len})
+        flat_map_lookup_bench(n, rng);
+#endif
+    std::cout << "[---------------- End container test : flat_map ----------------]\n";
+}
+#endif //MINISTL_T_FLAT_MAP_H
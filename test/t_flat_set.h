@@ -0,0 +1,161 @@
+#ifndef MINISTL_T_FLAT_SET_H
+#define MINISTL_T_FLAT_SET_H
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <set>
+#include <string>
+#include "test.h"
+#include "../flat_set.h"
+
+// 两种布局下每个 lower_bound / find 的结果都与 std::set 一致
+template <class Layout>
+bool flat_set_matches_std(const ministl::vector<int>& keys, const ministl::vector<int>& queries)
+{
+    std::set<int> expected(keys.begin(), keys.end());
+    ministl::flat_set<int, ministl::less<int>, Layout> s(keys.begin(), keys.end());
+    if (s.size() != expected.size() || !std::equal(expected.begin(), expected.end(), s.begin()))
+        return false;
+    for (int q : queries)
+    {
+        auto it = expected.lower_bound(q);
+        auto pos = s.lower_bound(q);
+        if ((it == expected.end()) != (pos == s.end()) || (pos != s.end() && *pos != *it))
+            return false;
+        if (s.contains(q) != (expected.count(q) == 1))
+            return false;
+    }
+    return true;
+}
+
+template <class Search>
+void flat_set_lookup_time(const std::string& name, size_t n, const ministl::vector<uint32_t>& queries,
+                          size_t expected_hits, Search search)
+{
+    ministl::test::timer t;
+    size_t hits = 0;
+    for (uint32_t q : queries)
+        hits += search(q);
+    ministl::test::print_time(name, n, t.elapsed_ms());
+    EXPECT_TRUE(hits == expected_hits);
+}
+
+void flat_set_lookup_bench(size_t n, std::mt19937_64& rng)
+{
+    const size_t lookups = 1000000;
+    // 偶数键，查询一半命中一半落空
+    ministl::vector<uint32_t> keys(n, 0);
+    for (size_t i = 0; i < n; ++i)
+        keys[i] = static_cast<uint32_t>(2 * i);
+    ministl::vector<uint32_t> queries(lookups, 0);
+    size_t hits = 0;
+    for (size_t i = 0; i < lookups; ++i)
+    {
+        queries[i] = static_cast<uint32_t>(rng() % (2 * n));
+        hits += queries[i] % 2 == 0;
+    }
+    std::cout << " " << lookups << " lookups, set size = " << n << "\n";
+    if (n <= (1u << 20))
+    {
+        std::set<uint32_t> tree(keys.begin(), keys.end());
+        flat_set_lookup_time("std::set::find", n, queries, hits,
+                             [&tree](uint32_t q) { return tree.find(q) != tree.end(); });
+    }
+    const uint32_t* first = keys.begin();
+    const uint32_t* last = keys.end();
+    flat_set_lookup_time("std::lower_bound", n, queries, hits, [first, last](uint32_t q) {
+        const uint32_t* pos = std::lower_bound(first, last, q);
+        return pos != last && *pos == q;
+    });
+    ministl::flat_set<uint32_t> sorted(ministl::sorted_unique, ministl::vector<uint32_t>(keys));
+    flat_set_lookup_time("flat_set branchless", n, queries, hits,
+                         [&sorted](uint32_t q) { return sorted.contains(q); });
+    ministl::flat_set<uint32_t, ministl::less<uint32_t>, ministl::eytzinger_layout>
+            eytzinger(ministl::sorted_unique, ministl::vector<uint32_t>(keys));
+    flat_set_lookup_time("flat_set eytzinger", n, queries, hits,
+                         [&eytzinger](uint32_t q) { return eytzinger.contains(q); });
+}
+
+void flat_set_test()
+{
+    std::cout << "[===============================================================]\n";
+    std::cout << "[---------------- Run container test : flat_set ----------------]\n";
+    std::cout << "[-------------------------- API test ---------------------------]\n";
+    std::mt19937_64 rng(37);
+
+    ministl::flat_set<int> s1;
+    ministl::flat_set<int> s2{5, 3, 9, 3, 1, 5};
+    ministl::flat_set<int, ministl::greater<int>> s3(s2.begin(), s2.end());
+    ministl::flat_set<int> s4(ministl::vector<int>{4, 4, 2, 8});
+    ministl::flat_set<int, ministl::less<int>, ministl::eytzinger_layout> s5{7, 1, 4, 1, 9, 2};
+    EXPECT_TRUE(s1.empty() && s2.size() == 4 && s4.size() == 3 && s5.size() == 5);
+    EXPECT_TRUE(*s3.begin() == 9 && s3.nth(3) == 1);
+    COUT(s2);
+    COUT(s3);
+    FUN_AFTER(s1, s1.insert(3));
+    FUN_AFTER(s1, s1.insert(1));
+    FUN_AFTER(s1, s1.emplace(2));
+    EXPECT_TRUE(!s1.insert(2).second && s1.insert(0).second && s1.size() == 4);
+    FUN_AFTER(s1, s1.insert({7, 2, 6, 6, 5}));
+    FUN_AFTER(s1, s1.insert(s2.begin(), s2.end()));
+    EXPECT_TRUE(s1.size() == 8 && ministl::is_sorted(s1.begin(), s1.end()));
+    FUN_AFTER(s1, s1.erase(s1.begin()));
+    FUN_AFTER(s1, s1.erase(5));
+    FUN_AFTER(s1, s1.erase(s1.begin() + 3, s1.end() - 1));
+    EXPECT_TRUE(s1.erase(100) == 0 && s1 == ministl::flat_set<int>({1, 2, 3, 9}));
+    FUN_VALUE(*s2.lower_bound(4));
+    FUN_VALUE(*s2.upper_bound(5));
+    FUN_VALUE(s2.count(9));
+    FUN_VALUE(s2.index_of(s2.find(9)));
+    EXPECT_TRUE(s2.find(4) == s2.end() && s2.equal_range(5).second - s2.equal_range(5).first == 1);
+    FUN_AFTER(s5, s5.insert(3));
+    FUN_AFTER(s5, s5.erase(7));
+    EXPECT_TRUE(s5.contains(3) && !s5.contains(7) && *s5.lower_bound(8) == 9 && s5.lower_bound(10) == s5.end());
+    FUN_AFTER(s2, s2.swap(s4));
+    EXPECT_TRUE(s4.size() == 4 && s4 < s2 && s2 != s4);
+    ministl::vector<int> raw = s2.extract();
+    EXPECT_TRUE(s2.empty() && raw.size() == 3);
+    s2.clear();
+    s5.clear();
+    EXPECT_TRUE(s5.empty() && s5.find(1) == s5.end());
+
+    // 随机数据：两种布局的查找结果与 std::set 一致，覆盖完全二叉树的各种形状
+    for (size_t n : {0, 1, 2, 3, 7, 8, 100, 1000, 100003})
+    {
+        ministl::vector<int> keys(n, 0);
+        for (size_t i = 0; i < n; ++i)
+            keys[i] = static_cast<int>(rng() % (2 * n + 1));
+        ministl::vector<int> queries(2000, 0);
+        for (size_t i = 0; i < queries.size(); ++i)
+            queries[i] = static_cast<int>(rng() % (2 * n + 3)) - 1;
+        EXPECT_TRUE(flat_set_matches_std<ministl::sorted_layout>(keys, queries));
+        EXPECT_TRUE(flat_set_matches_std<ministl::eytzinger_layout>(keys, queries));
+    }
+
+    // 非平凡类型的批量插入与去重
+    {
+        ministl::flat_set<std::string> names{"delta", "alpha", "charlie"};
+        ministl::vector<std::string> more;
+        for (int i = 0; i < 500; ++i)
+            more.push_back(std::to_string(rng() % 300));
+        more.push_back("alpha");
+        names.insert(more.begin(), more.end());
+        std::set<std::string> expected(more.begin(), more.end());
+        expected.insert({"delta", "alpha", "charlie"});
+        EXPECT_TRUE(names.size() == expected.size() && std::equal(expected.begin(), expected.end(), names.begin()));
+    }
+
+#if PERFORMANCE_TEST_ON
+    std::cout << "[--------------------- Performance Testing ---------------------]\n";
+#if LARGER_TEST_DATA_ON
+    const size_t sizes[] = {1u << 12, 1u << 20, 1u << 24, 1u << 28};
+#else
+    const size_t sizes[] = {1u << 12, 1u << 20, 1u << 24};
+#endif
+    for (size_t n : sizes)
+        flat_set_lookup_bench(n, rng);
+#endif
+    std::cout << "[---------------- End container test : flat_set ----------------]\n";
+}
+#endif //MINISTL_T_FLAT_SET_H
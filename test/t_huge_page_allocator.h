@@ -0,0 +1,69 @@
+#ifndef MINISTL_T_HUGE_PAGE_ALLOCATOR_H
+#define MINISTL_T_HUGE_PAGE_ALLOCATOR_H
+#include <iostream>
+#include <string>
+#include "test.h"
+#include "../vector.h"
+#include "../huge_page_allocator.h"
+
+// 随机下标 gather：每次访问大概率落在不同的页上，考察 dTLB 的表现
+template <class Vec>
+void random_gather(const std::string& name, size_t n, size_t lookups)
+{
+    Vec v(n, 1.0);
+    uint64_t x = 88172645463325252ull;
+    double sum = 0;
+    ministl::test::timer t;
+    for (size_t i = 0; i < lookups; ++i)
+    {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        sum += v[x % n];
+    }
+    const double ms = t.elapsed_ms();
+    ministl::test::do_not_optimize(sum);
+    ministl::test::print_time(name, n, ms);
+}
+
+void huge_page_allocator_test()
+{
+    typedef ministl::huge_page_allocator<double>                                   thp_alloc;
+    typedef ministl::huge_page_allocator<double, ministl::huge_page_mode::hugetlb> hugetlb_alloc;
+
+    std::cout << "[===============================================================]\n";
+    std::cout << "[---------- Run allocator test : huge_page_allocator -----------]\n";
+    std::cout << "[-------------------------- API test ---------------------------]\n";
+    ministl::vector<double, thp_alloc> v1;
+    ministl::vector<double, hugetlb_alloc> v2(10, 2.0);
+    for (int i = 0; i < 1000000; ++i)
+        v1.push_back(i);
+    for (int i = 0; i < 1000000; i += 99999)
+        EXPECT_TRUE(v1[i] == i);
+    // 大块内存按大页取整且 2MB 对齐，小块内存照常分配
+    EXPECT_TRUE(v1.capacity() * sizeof(double) % ministl::huge_page_size == 0);
+    EXPECT_TRUE(reinterpret_cast<size_t>(v1.data()) % ministl::huge_page_size == 0);
+    EXPECT_TRUE(v2.capacity() == 16);
+    v2.reserve(300000);
+    EXPECT_TRUE(reinterpret_cast<size_t>(v2.data()) % ministl::huge_page_size == 0 && v2[9] == 2.0);
+    FUN_VALUE(v1.size());
+    FUN_VALUE(v1.capacity());
+    FUN_VALUE(v2.capacity());
+    v1.shrink_to_fit();
+    FUN_VALUE(v1.capacity());
+
+#if PERFORMANCE_TEST_ON
+    std::cout << "[--------------------- Performance Testing ---------------------]\n";
+#if LARGER_TEST_DATA_ON
+    const size_t n = (static_cast<size_t>(8) << 30) / sizeof(double);
+#else
+    const size_t n = (static_cast<size_t>(256) << 20) / sizeof(double);
+#endif
+    const size_t lookups = 1u << 24;
+    random_gather<ministl::vector<double>>("vector<double> gather", n, lookups);
+    random_gather<ministl::vector<double, thp_alloc>>("vector<double, thp> gather", n, lookups);
+    random_gather<ministl::vector<double, hugetlb_alloc>>("vector<double, hugetlb> gather", n, lookups);
+#endif
+    std::cout << "[---------- End allocator test : huge_page_allocator -----------]\n";
+}
+#endif //MINISTL_T_HUGE_PAGE_ALLOCATOR_H
@@ -0,0 +1,104 @@
+#ifndef MINISTL_T_INCREMENTAL_VECTOR_H
+#define MINISTL_T_INCREMENTAL_VECTOR_H
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include "test.h"
+#include "../incremental_vector.h"
+
+// 逐次记录 push_back 的耗时，输出延迟分布
+template <class Vec>
+void push_back_latency(const std::string& name, size_t n)
+{
+    std::vector<uint64_t> samples(n);
+    Vec v;
+    for (size_t i = 0; i < n; ++i)
+    {
+        ministl::test::timer t;
+        v.push_back(static_cast<int>(i));
+        samples[i] = t.elapsed_ns();
+    }
+    ministl::test::do_not_optimize(v);
+    ministl::test::print_latency(name, ministl::test::summarize(samples));
+}
+
+void incremental_vector_test()
+{
+    std::cout << "[===============================================================]\n";
+    std::cout << "[------------ Run container test : incremental_vector -----------]\n";
+    std::cout << "[-------------------------- API test ---------------------------]\n";
+    ministl::incremental_vector<int> v1;
+    ministl::incremental_vector<int> v2(5, 2);
+    ministl::incremental_vector<int> v3{ 1,2,3,4,5 };
+    ministl::incremental_vector<std::string> v4;
+
+    // 跨越多次扩容，并在搬迁途中检查元素
+    for (int i = 0; i < 1000; ++i)
+    {
+        v1.push_back(i);
+        EXPECT_TRUE(v1.back() == i);
+        EXPECT_TRUE(v1[i / 2] == i / 2);
+        v4.emplace_back(std::to_string(i));
+    }
+    EXPECT_TRUE(v1.size() == 1000);
+    for (int i = 0; i < 1000; ++i)
+        EXPECT_TRUE(v1[i] == i && v4[i] == std::to_string(i));
+
+    ministl::incremental_vector<std::string> v5(v4);
+    while (v4.size() > 10)
+        v4.pop_back();
+    EXPECT_TRUE(v4.back() == "9" && v5.size() == 1000 && v5[999] == "999");
+
+    {
+        // 搬迁旧元素失败时新元素被析构，容器内容不变
+        typedef ministl::test::counted<ministl::test::throw_on_move> elem;
+        ministl::incremental_vector<elem> ct;
+        ct.emplace_back(-1);
+        size_t before = 0;
+        bool thrown = false;
+        for (int i = 1; i < 100 && !thrown; ++i)
+        {
+            before = ct.size();
+            try
+            {
+                ct.emplace_back(i);
+            }
+            catch (const std::runtime_error&)
+            {
+                thrown = true;
+            }
+        }
+        EXPECT_TRUE(thrown && ct.size() == before && ct.migrating() && elem::live == static_cast<int>(before));
+        ct[0].value = 0;
+        ct.emplace_back(100);
+        EXPECT_TRUE(ct.size() == before + 1 && ct[0].value == 0 && ct.back().value == 100 &&
+                    elem::live == static_cast<int>(before + 1));
+    }
+    EXPECT_TRUE(ministl::test::counted<ministl::test::throw_on_move>::live == 0);
+
+    FUN_AFTER(v2, v2.push_back(3));
+    FUN_AFTER(v3, v3.pop_back());
+    FUN_VALUE(v1.migrating());
+    FUN_VALUE(v1.pending());
+    FUN_AFTER(v2, v2.finish_migration());
+    FUN_VALUE(*v1.data());
+    FUN_VALUE(v1.migrating());
+    FUN_VALUE(v1.size());
+    FUN_VALUE(v1.capacity());
+    FUN_AFTER(v3, v3.swap(v2));
+    FUN_AFTER(v3, v3.clear());
+    FUN_VALUE(v3.empty());
+
+#if PERFORMANCE_TEST_ON
+    std::cout << "[--------------------- Performance Testing ---------------------]\n";
+#if LARGER_TEST_DATA_ON
+    const size_t n = 1u << 28;
+#else
+    const size_t n = 1u << 22;
+#endif
+    push_back_latency<ministl::vector<int>>("vector::push_back", n);
+    push_back_latency<ministl::incremental_vector<int>>("incremental_vector::push_back", n);
+#endif
+    std::cout << "[------------ End container test : incremental_vector -----------]\n";
+}
+#endif //MINISTL_T_INCREMENTAL_VECTOR_H
@@ -0,0 +1,259 @@
+#ifndef MINISTL_T_NULLABLE_VECTOR_H
+#define MINISTL_T_NULLABLE_VECTOR_H
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "test.h"
+#include "../nullable_vector.h"
+
+// 测试中作为对照的 optional：值加一个标志，与 std::optional<T> 的布局相同
+template <class T>
+struct optional_like
+{
+    T    value;
+    bool valid;
+};
+
+// 归约与过滤的结果与逐个检查的结果一致
+template <class T>
+bool nullable_kernels_ok(const ministl::nullable_vector<T>& nv, const std::vector<optional_like<T>>& expected)
+{
+    typename ministl::nullable_vector<T>::sum_type sum = 0;
+    bool found = false;
+    T lo = T(), hi = T();
+    size_t matched = 0;
+    const T threshold = static_cast<T>(50);
+    for (const optional_like<T>& o : expected)
+    {
+        if (!o.valid)
+            continue;
+        sum += o.value;
+        lo = !found || o.value < lo ? o.value : lo;
+        hi = !found || o.value > hi ? o.value : hi;
+        found = true;
+        matched += o.value > threshold;
+    }
+    T mn = T(), mx = T();
+    if (nv.sum() != sum || nv.min_value(mn) != found || nv.max_value(mx) != found)
+        return false;
+    if (found && (mn != lo || mx != hi))
+        return false;
+    const ministl::bit_vector mask = nv.filter([threshold](T v) { return v > threshold; });
+    if (mask.size() != nv.size() || mask.count() != matched)
+        return false;
+    for (size_t i = 0; i < expected.size(); ++i)
+    {
+        if (mask[i] != (expected[i].valid && expected[i].value > threshold))
+            return false;
+    }
+    return true;
+}
+
+template <class T>
+bool nullable_vector_ops_ok(std::mt19937_64& rng, unsigned null_percent)
+{
+    ministl::nullable_vector<T> nv;
+    std::vector<optional_like<T>> expected;
+    for (int round = 0; round < 3000; ++round)
+    {
+        const unsigned op = static_cast<unsigned>(rng() % 10);
+        const T v = static_cast<T>(static_cast<int64_t>(rng() % 200) - 50);
+        const bool valid = rng() % 100 >= null_percent;
+        if (op < 5 || expected.empty())
+        {
+            nv.push_back(v, valid);
+            expected.push_back(optional_like<T>{valid ? v : T(), valid});
+        }
+        else if (op == 5)
+        {
+            nv.pop_back();
+            expected.pop_back();
+        }
+        else if (op == 6)
+        {
+            const size_t i = static_cast<size_t>(rng() % expected.size());
+            if (valid)
+                nv.set(i, v);
+            else
+                nv.set_null(i);
+            expected[i] = optional_like<T>{valid ? v : T(), valid};
+        }
+        else if (op == 7)
+        {
+            T batch[70];
+            bool flags[70];
+            const size_t n = static_cast<size_t>(rng() % 70);
+            for (size_t i = 0; i < n; ++i)
+            {
+                batch[i] = static_cast<T>(rng() % 100);
+                flags[i] = rng() % 100 >= null_percent;
+                expected.push_back(optional_like<T>{flags[i] ? batch[i] : T(), flags[i]});
+            }
+            nv.append(batch, flags, n);
+        }
+        else if (op == 8)
+        {
+            nv.push_null();
+            expected.push_back(optional_like<T>{T(), false});
+        }
+        else
+        {
+            const size_t n = static_cast<size_t>(rng() % 400);
+            nv.resize(n);
+            expected.resize(n, optional_like<T>{T(), false});
+        }
+    }
+    if (nv.size() != expected.size())
+        return false;
+    size_t nulls = 0;
+    for (size_t i = 0; i < expected.size(); ++i)
+    {
+        const T* p = nv.get(i);
+        if (nv.is_valid(i) != expected[i].valid || (p != nullptr) != expected[i].valid)
+            return false;
+        if (nv[i] != expected[i].value)
+            return false;
+        nulls += !expected[i].valid;
+    }
+    return nv.null_count() == nulls && nullable_kernels_ok(nv, expected);
+}
+
+void nullable_vector_test()
+{
+    std::cout << "[===============================================================]\n";
+    std::cout << "[------------ Run container test : nullable_vector -------------]\n";
+    std::cout << "[-------------------------- API test ---------------------------]\n";
+    std::mt19937_64 rng(44);
+
+    ministl::nullable_vector<int> n1;
+    ministl::nullable_vector<int> n2(3);
+    ministl::nullable_vector<int> n3{4, 5, 6};
+    EXPECT_TRUE(n1.empty() && n2.size() == 3 && n2.null_count() == 3 && n3.valid_count() == 3);
+    FUN_VALUE(n3.sum());
+    FUN_VALUE(n3.values().size());
+    n2.set(1, 7);
+    n3.set_null(0);
+    n3.push_back(9, false);
+    n3.push_null();
+    n3.push_back(-2);
+    EXPECT_TRUE(n2.value_or(0, -1) == -1 && n2.value_or(1, -1) == 7 && *n2.get(1) == 7 && n2.get(2) == nullptr);
+    EXPECT_TRUE(n3.size() == 6 && n3.null_count() == 3 && n3[3] == 0 && n3.sum() == 9);
+    int mn = 0, mx = 0;
+    EXPECT_TRUE(n3.min_value(mn) && mn == -2 && n3.max_value(mx) && mx == 6 && !n1.min_value(mn));
+    EXPECT_TRUE(n3.count_if([](int v) { return v >= 0; }) == 2);
+    EXPECT_TRUE(n3.filter([](int v) { return v < 0; }).find_first() == 5);
+    bool thrown = false;
+    try
+    {
+        n3.at(4);
+    }
+    catch (const std::runtime_error&)
+    {
+        thrown = true;
+    }
+    EXPECT_TRUE(thrown && n3.at(1) == 5);
+    ministl::nullable_vector<int> n4(n3);
+    n4.pop_back();
+    n4.push_back(-2);
+    EXPECT_TRUE(n4 == n3);
+    n4.set_null(5);
+    EXPECT_TRUE(n4 != n3);
+    ministl::swap(n1, n4);
+    n4.append(n3.values().data(), n3.size());
+    EXPECT_TRUE(n1.size() == 6 && n4.size() == 6 && n4.valid_count() == 6 && n4.sum() == 9);
+    n4.clear();
+    EXPECT_TRUE(n4.empty() && n4.sum() == 0);
+    {
+        // 多次小批量追加，容量按几何级数增长
+        const int vals[] = {1, 2, 3};
+        const bool flags[] = {true, false, true};
+        size_t reallocs = 0;
+        for (int round = 0; round < 1000; ++round)
+        {
+            const int* before = n4.values().data();
+            if (round % 2 == 0)
+                n4.append(vals, 3);
+            else
+                n4.append(vals, flags, 3);
+            reallocs += n4.values().data() != before;
+        }
+        EXPECT_TRUE(n4.size() == 3000 && n4.null_count() == 500 && n4.sum() == 5000 && reallocs < 30);
+        n4.clear();
+    }
+
+    // 每一级指令集、不同的 null 比例与元素类型
+    const char* levels[] = {"scalar", "avx2", "avx512"};
+    for (int level = 0; level <= static_cast<int>(ministl::detect_simd_level()); ++level)
+    {
+        ministl::set_simd_level_limit(static_cast<ministl::simd_level>(level));
+        FUN_VALUE(levels[level]);
+        for (unsigned null_percent : {0u, 10u, 50u, 97u, 100u})
+        {
+            EXPECT_TRUE(nullable_vector_ops_ok<int32_t>(rng, null_percent));
+            EXPECT_TRUE(nullable_vector_ops_ok<uint8_t>(rng, null_percent));
+            EXPECT_TRUE(nullable_vector_ops_ok<int64_t>(rng, null_percent));
+            EXPECT_TRUE(nullable_vector_ops_ok<double>(rng, null_percent));
+        }
+    }
+    ministl::set_simd_level_limit(ministl::simd_level::avx512);
+
+#if PERFORMANCE_TEST_ON
+    std::cout << "[--------------------- Performance Testing ---------------------]\n";
+#if LARGER_TEST_DATA_ON
+    const size_t len = 100000000;
+#else
+    const size_t len = 16000000;
+#endif
+    for (unsigned null_percent : {10u, 99u})
+    {
+        ministl::vector<optional_like<int32_t>> opt(len, optional_like<int32_t>{0, false});
+        ministl::nullable_vector<int32_t> nv;
+        nv.reserve(len);
+        // 成片的 null：一批 64 到 4096 个连续元素共享同一个 null 概率
+        for (size_t i = 0; i < len;)
+        {
+            const bool mostly_null = rng() % 100 < null_percent;
+            const size_t run = 64 + static_cast<size_t>(rng() % 4032);
+            for (size_t j = 0; j < run && i < len; ++j, ++i)
+            {
+                const int32_t v = static_cast<int32_t>(rng() % 1000);
+                opt[i] = optional_like<int32_t>{v, !mostly_null && rng() % 10 != 0};
+            }
+        }
+        {
+            ministl::test::timer t;
+            for (size_t i = 0; i < len; ++i)
+                nv.push_back(opt[i].value, opt[i].valid);
+            ministl::test::print_time("nullable_vector push_back", len, t.elapsed_ms());
+        }
+        std::cout << " ~" << null_percent << "% null runs: optional-like "
+                  << (len * sizeof(optional_like<int32_t>) >> 20) << " MB, nullable_vector "
+                  << ((len * 4 + nv.validity().size_in_bytes()) >> 20) << " MB\n";
+        int64_t expected = 0;
+        size_t expected_count = 0;
+        {
+            ministl::test::timer t;
+            for (size_t i = 0; i < len; ++i)
+            {
+                expected += opt[i].valid ? opt[i].value : 0;
+                expected_count += opt[i].valid && opt[i].value > 500;
+            }
+            ministl::test::print_time("optional-like sum + count_if", len, t.elapsed_ms());
+        }
+        for (int level = 0; level <= static_cast<int>(ministl::detect_simd_level()); ++level)
+        {
+            ministl::set_simd_level_limit(static_cast<ministl::simd_level>(level));
+            ministl::test::timer t;
+            const int64_t sum = nv.sum();
+            const size_t count = nv.count_if([](int32_t v) { return v > 500; });
+            ministl::test::print_time(std::string("nullable sum + count_if ") + levels[level], len, t.elapsed_ms());
+            EXPECT_TRUE(sum == expected && count == expected_count);
+        }
+        ministl::set_simd_level_limit(ministl::simd_level::avx512);
+    }
+#endif
+    std::cout << "[------------ End container test : nullable_vector -------------]\n";
+}
+#endif //MINISTL_T_NULLABLE_VECTOR_H
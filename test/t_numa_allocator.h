@@ -0,0 +1,101 @@
+#ifndef MINISTL_T_NUMA_ALLOCATOR_H
+#define MINISTL_T_NUMA_ALLOCATOR_H
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include "test.h"
+#include "../vector.h"
+#include "../numa_allocator.h"
+#include "../parallel_uninitialized.h"
+
+template <class Vec>
+void fill_init_time(const std::string& name, size_t n, bool parallel)
+{
+    ministl::test::timer t;
+    if (parallel)
+    {
+        Vec v(n, 1.0, ministl::parallel_init);
+        ministl::test::do_not_optimize(v[n - 1]);
+    }
+    else
+    {
+        Vec v(n, 1.0);
+        ministl::test::do_not_optimize(v[n - 1]);
+    }
+    ministl::test::print_time(name, n, t.elapsed_ms());
+}
+
+void numa_allocator_test()
+{
+    typedef ministl::numa_allocator<double, ministl::numa_policy::local>       local_alloc;
+    typedef ministl::numa_allocator<double, ministl::numa_policy::interleave>  interleave_alloc;
+    typedef ministl::numa_allocator<double, ministl::numa_policy::bind, 0>     bind0_alloc;
+    typedef ministl::numa_allocator<double, ministl::numa_policy::bind, 63>    bind63_alloc;
+
+    std::cout << "[===============================================================]\n";
+    std::cout << "[------------- Run allocator test : numa_allocator -------------]\n";
+    std::cout << "[-------------------------- API test ---------------------------]\n";
+    const size_t n = 1u << 20;
+    ministl::vector<double, local_alloc> v1(n, 1.0, ministl::parallel_init);
+    ministl::vector<double, interleave_alloc> v2(n, 2.0, ministl::parallel_init);
+    ministl::vector<double, bind0_alloc> v3(n, 3.0);
+    // 不存在的节点上 mbind 失败，退回默认策略
+    ministl::vector<double, bind63_alloc> v4(n, 4.0);
+    for (size_t i = 0; i < n; i += 4099)
+        EXPECT_TRUE(v1[i] == 1.0 && v2[i] == 2.0 && v3[i] == 3.0 && v4[i] == 4.0);
+    v4.push_back(5.0);
+    EXPECT_TRUE(v4.back() == 5.0 && v4.size() == n + 1);
+    FUN_VALUE(ministl::numa_node_count());
+    FUN_VALUE(v2.capacity());
+    FUN_VALUE(v4.capacity());
+
+    // 任一分段失败时，其他分段构造的对象全部析构，异常抛给调用方
+    {
+        const size_t count = 64;
+        typedef ministl::test::counted<ministl::test::throw_on_budget> elem;
+        elem src;
+        auto* buf = static_cast<elem*>(::operator new(count * sizeof(elem)));
+        elem::copy_budget = 40;
+        bool thrown = false;
+        try
+        {
+            ministl::parallel_uninitialized_for(count, 16,
+                    [buf, &src](size_t offset, size_t len) {
+                        auto cur = buf + offset;
+                        try
+                        {
+                            for (; len > 0; --len, ++cur)
+                                ministl::construct(cur, src);
+                        }
+                        catch (...)
+                        {
+                            ministl::destroy(buf + offset, cur);
+                            throw;
+                        }
+                    },
+                    [buf](size_t offset, size_t len) {
+                        ministl::destroy(buf + offset, buf + offset + len);
+                    });
+        }
+        catch (const std::runtime_error&)
+        {
+            thrown = true;
+        }
+        EXPECT_TRUE(thrown && elem::live == 1);
+        ::operator delete(buf);
+    }
+
+#if PERFORMANCE_TEST_ON
+    std::cout << "[--------------------- Performance Testing ---------------------]\n";
+#if LARGER_TEST_DATA_ON
+    const size_t m = (static_cast<size_t>(4) << 30) / sizeof(double);
+#else
+    const size_t m = (static_cast<size_t>(256) << 20) / sizeof(double);
+#endif
+    fill_init_time<ministl::vector<double, local_alloc>>("vector(n, value)", m, false);
+    fill_init_time<ministl::vector<double, local_alloc>>("vector(n, value, parallel_init)", m, true);
+    fill_init_time<ministl::vector<double, interleave_alloc>>("interleave vector(n, value)", m, false);
+#endif
+    std::cout << "[------------- End allocator test : numa_allocator -------------]\n";
+}
+#endif //MINISTL_T_NUMA_ALLOCATOR_H
@@ -0,0 +1,310 @@
+#ifndef MINISTL_T_PACKED_VECTOR_H
+#define MINISTL_T_PACKED_VECTOR_H
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "test.h"
+#include "../packed_vector.h"
+
+// 随机的 push_back / set / pop_back / resize / append，结果与 std::vector<uint64_t> 一致
+template <unsigned Bits>
+bool packed_vector_ops_ok(std::mt19937_64& rng)
+{
+    const uint64_t max_value = ministl::packed_vector<Bits>::max_value;
+    ministl::packed_vector<Bits> pv;
+    std::vector<uint64_t> expected;
+    for (int round = 0; round < 2000; ++round)
+    {
+        const unsigned op = static_cast<unsigned>(rng() % 8);
+        const uint64_t v = rng() & max_value;
+        if (op < 3 || expected.empty())
+        {
+            pv.push_back(v);
+            expected.push_back(v);
+        }
+        else if (op == 3)
+        {
+            pv.pop_back();
+            expected.pop_back();
+        }
+        else if (op == 4)
+        {
+            const size_t n = static_cast<size_t>(rng() % 200);
+            pv.resize(n, v);
+            expected.resize(n, v);
+        }
+        else if (op == 5)
+        {
+            ministl::vector<uint64_t> batch;
+            for (size_t i = static_cast<size_t>(rng() % 50); i > 0; --i)
+                batch.push_back(rng() & max_value);
+            pv.append(batch.begin(), batch.end());
+            expected.insert(expected.end(), batch.begin(), batch.end());
+        }
+        else
+        {
+            const size_t i = static_cast<size_t>(rng() % expected.size());
+            pv.set(i, v);
+            expected[i] = v;
+        }
+    }
+    if (pv.size() != expected.size())
+        return false;
+    ministl::vector<uint64_t> decoded;
+    pv.decode(decoded);
+    for (size_t i = 0; i < expected.size(); ++i)
+    {
+        if (pv[i] != expected[i] || decoded[i] != expected[i])
+            return false;
+    }
+    // size() 之后的位为 0：与重新构造的结果逐字相等
+    ministl::packed_vector<Bits> rebuilt(expected.data(), expected.data() + expected.size());
+    return pv == rebuilt;
+}
+
+// 对 0..64 的每个位宽，解码任意起点、任意长度的结果与逐个读取一致
+bool packed_decode_ok(std::mt19937_64& rng)
+{
+    for (unsigned bits = 0; bits <= 64; ++bits)
+    {
+        const size_t n = 300;
+        ministl::vector<uint64_t> words(ministl::packed_words(n, bits) + 1, 0);
+        ministl::vector<uint64_t> values(n, 0);
+        for (size_t i = 0; i < n; ++i)
+        {
+            values[i] = rng() & ministl::packed_mask(bits);
+            if (bits != 0)
+                ministl::packed_store(words.data(), i * bits, bits, values[i]);
+        }
+        for (int round = 0; round < 20; ++round)
+        {
+            const size_t first = static_cast<size_t>(rng() % n);
+            const size_t count = static_cast<size_t>(rng() % (n - first + 1));
+            const uint64_t base = rng() % 1000;
+            ministl::vector<uint64_t> out(count + 1, 7);
+            ministl::packed_decode(words.data(), first * bits, bits, count, base, out.data());
+            for (size_t i = 0; i < count; ++i)
+            {
+                if (out[i] != base + values[first + i])
+                    return false;
+            }
+            if (out[count] != 7)
+                return false;
+        }
+    }
+    return true;
+}
+
+void packed_vector_test()
+{
+    std::cout << "[===============================================================]\n";
+    std::cout << "[------------- Run container test : packed_vector --------------]\n";
+    std::cout << "[-------------------------- API test ---------------------------]\n";
+    std::mt19937_64 rng(43);
+
+    ministl::packed_vector<7> p1;
+    ministl::packed_vector<7> p2(100, 127);
+    ministl::packed_vector<20> p3{1, 2, 3, 1048575};
+    EXPECT_TRUE(p1.empty() && p2.size() == 100 && p2[99] == 127 && p3.back() == 1048575);
+    FUN_VALUE(p2.size_in_bytes());
+    FUN_VALUE(p3[2]);
+    p2.set(50, 0);
+    p2.resize(10);
+    p2.push_back(5);
+    EXPECT_TRUE(p2.size() == 11 && p2.back() == 5 && p2.front() == 127);
+    p2.resize(300);
+    EXPECT_TRUE(p2[11] == 0 && p2[299] == 0 && p2.at(10) == 5);
+    bool thrown = false;
+    try
+    {
+        p2.push_back(128);
+    }
+    catch (const std::out_of_range&)
+    {
+        thrown = true;
+    }
+    EXPECT_TRUE(thrown && p2.size() == 300);
+    thrown = false;
+    try
+    {
+        p3.at(4);
+    }
+    catch (const std::out_of_range&)
+    {
+        thrown = true;
+    }
+    EXPECT_TRUE(thrown);
+    ministl::swap(p1, p2);
+    EXPECT_TRUE(p1.size() == 300 && p2.empty() && p1 != p2);
+    p1.clear();
+    EXPECT_TRUE(p1 == p2);
+
+    EXPECT_TRUE(packed_vector_ops_ok<1>(rng));
+    EXPECT_TRUE(packed_vector_ops_ok<7>(rng));
+    EXPECT_TRUE(packed_vector_ops_ok<13>(rng));
+    EXPECT_TRUE(packed_vector_ops_ok<20>(rng));
+    EXPECT_TRUE(packed_vector_ops_ok<33>(rng));
+    EXPECT_TRUE(packed_vector_ops_ok<57>(rng));
+    EXPECT_TRUE(packed_vector_ops_ok<58>(rng));
+    EXPECT_TRUE(packed_vector_ops_ok<63>(rng));
+    EXPECT_TRUE(packed_vector_ops_ok<64>(rng));
+
+    // for_vector：递增序列、随机序列、常数序列，含未满一块的尾部
+    {
+        ministl::for_vector f1{5, 5, 9};
+        EXPECT_TRUE(f1.size() == 3 && f1[2] == 9 && f1.lower_bound(6) == 2 && f1.lower_bound(10) == 3);
+        for (int kind = 0; kind < 3; ++kind)
+        {
+            ministl::for_vector f;
+            std::vector<uint64_t> expected;
+            uint64_t v = rng() % 1000000;
+            const size_t n = 128 * 20 + 37;
+            for (size_t i = 0; i < n; ++i)
+            {
+                v = kind == 0 ? v + rng() % 100 : kind == 1 ? rng() : v;
+                f.push_back(v);
+                expected.push_back(v);
+            }
+            bool ok = f.size() == n && f.block_count() == 20;
+            ministl::vector<uint64_t> decoded;
+            f.decode(decoded);
+            for (size_t i = 0; ok && i < n; ++i)
+                ok = f[i] == expected[i] && decoded[i] == expected[i];
+            ministl::vector<uint64_t> part(300, 0);
+            f.decode(100, 300, part.data());
+            for (size_t i = 0; ok && i < 300; ++i)
+                ok = part[i] == expected[100 + i];
+            if (kind != 1)
+            {
+                for (int q = 0; ok && q < 2000; ++q)
+                {
+                    const uint64_t key = expected[0] + rng() % (expected.back() - expected[0] + 10);
+                    const size_t pos = static_cast<size_t>(
+                            std::lower_bound(expected.begin(), expected.end(), key) - expected.begin());
+                    ok = f.lower_bound(key) == pos;
+                }
+            }
+            EXPECT_TRUE(ok);
+        }
+    }
+
+    // 每一级指令集的批量解码
+    const char* levels[] = {"scalar", "avx2", "avx512"};
+    for (int level = 0; level <= static_cast<int>(ministl::detect_simd_level()); ++level)
+    {
+        ministl::set_simd_level_limit(static_cast<ministl::simd_level>(level));
+        FUN_VALUE(levels[level]);
+        EXPECT_TRUE(packed_decode_ok(rng));
+    }
+    ministl::set_simd_level_limit(ministl::simd_level::avx512);
+
+#if PERFORMANCE_TEST_ON
+    std::cout << "[--------------------- Performance Testing ---------------------]\n";
+#if LARGER_TEST_DATA_ON
+    const size_t len = 100000000;
+#else
+    const size_t len = 16000000;
+#endif
+    ministl::vector<uint64_t> column(len, 0);
+    for (size_t i = 0; i < len; ++i)
+        column[i] = rng() % (1u << 20);
+    uint64_t expected_sum = 0;
+    {
+        ministl::test::timer t;
+        for (size_t i = 0; i < len; ++i)
+            expected_sum += column[i];
+        ministl::test::print_time("vector<uint64_t> scan", len, t.elapsed_ms());
+    }
+    ministl::packed_vector<20> packed;
+    {
+        ministl::test::timer t;
+        packed.append(column.begin(), column.end());
+        ministl::test::print_time("packed_vector<20> append", len, t.elapsed_ms());
+    }
+    std::cout << " vector<uint64_t> " << (len * 8 >> 20) << " MB, packed_vector<20> "
+              << (packed.size_in_bytes() >> 20) << " MB\n";
+    {
+        ministl::test::timer t;
+        uint64_t sum = 0;
+        for (size_t i = 0; i < len; ++i)
+            sum += packed[i];
+        ministl::test::print_time("packed_vector<20> operator[]", len, t.elapsed_ms());
+        EXPECT_TRUE(sum == expected_sum);
+    }
+    // 按 4096 个元素一批解码后求和，模拟列扫描
+    ministl::vector<uint64_t> buffer(4096, 0);
+    for (int level = 0; level <= static_cast<int>(ministl::detect_simd_level()); ++level)
+    {
+        ministl::set_simd_level_limit(static_cast<ministl::simd_level>(level));
+        ministl::test::timer t;
+        uint64_t sum = 0;
+        for (size_t i = 0; i < len; i += buffer.size())
+        {
+            const size_t n = ministl::min(buffer.size(), len - i);
+            packed.decode(i, n, buffer.data());
+            for (size_t j = 0; j < n; ++j)
+                sum += buffer[j];
+        }
+        ministl::test::print_time(std::string("packed_vector<20> decode ") + levels[level], len,
+                                  t.elapsed_ms());
+        EXPECT_TRUE(sum == expected_sum);
+    }
+    ministl::set_simd_level_limit(ministl::simd_level::avx512);
+
+    // 递增的时间戳列
+    ministl::vector<uint64_t> stamps(len, 0);
+    uint64_t stamp = 1700000000000000ull;
+    for (size_t i = 0; i < len; ++i)
+        stamps[i] = stamp += rng() % 1000;
+    ministl::for_vector fv;
+    {
+        ministl::test::timer t;
+        fv.append(stamps.begin(), stamps.end());
+        ministl::test::print_time("for_vector append", len, t.elapsed_ms());
+    }
+    std::cout << " timestamps: vector<uint64_t> " << (len * 8 >> 20) << " MB, for_vector "
+              << (fv.size_in_bytes() >> 20) << " MB\n";
+    {
+        ministl::test::timer t;
+        uint64_t sum = 0;
+        for (size_t i = 0; i < len; i += buffer.size())
+        {
+            const size_t n = ministl::min(buffer.size(), len - i);
+            fv.decode(i, n, buffer.data());
+            for (size_t j = 0; j < n; ++j)
+                sum += buffer[j];
+        }
+        ministl::test::print_time("for_vector decode scan", len, t.elapsed_ms());
+        uint64_t expected = 0;
+        for (size_t i = 0; i < len; ++i)
+            expected += stamps[i];
+        EXPECT_TRUE(sum == expected);
+    }
+    {
+        const size_t queries = 1000000;
+        ministl::vector<size_t> pos(queries, 0);
+        for (size_t i = 0; i < queries; ++i)
+            pos[i] = static_cast<size_t>(rng() % len);
+        ministl::test::timer t;
+        bool ok = true;
+        for (size_t i = 0; i < queries; ++i)
+            ok = ok && fv[pos[i]] == stamps[pos[i]];
+        ministl::test::print_time("for_vector random access", queries, t.elapsed_ms());
+        t.reset();
+        for (size_t i = 0; i < queries; ++i)
+            ok = ok && fv.lower_bound(stamps[pos[i]]) <= pos[i];
+        ministl::test::print_time("for_vector lower_bound", queries, t.elapsed_ms());
+        t.reset();
+        for (size_t i = 0; i < queries; ++i)
+            ok = ok && ministl::branchless_lower_bound(stamps.begin(), stamps.end(), stamps[pos[i]]) - stamps.begin() <=
+                               static_cast<ptrdiff_t>(pos[i]);
+        ministl::test::print_time("vector<uint64_t> lower_bound", queries, t.elapsed_ms());
+        EXPECT_TRUE(ok);
+    }
+#endif
+    std::cout << "[------------- End container test : packed_vector --------------]\n";
+}
+#endif //MINISTL_T_PACKED_VECTOR_H
@@ -0,0 +1,142 @@
+#ifndef MINISTL_T_PARALLEL_ALGO_H
+#define MINISTL_T_PARALLEL_ALGO_H
+#include <cmath>
+#include <iostream>
+#include <list>
+#include <stdexcept>
+#include "test.h"
+#include "../vector.h"
+#include "../parallel_algo.h"
+
+void parallel_algo_test()
+{
+    std::cout << "[===============================================================]\n";
+    std::cout << "[------------- Run algorithm test : parallel_algo --------------]\n";
+    std::cout << "[-------------------------- API test ---------------------------]\n";
+    namespace ex = ministl::execution;
+    // 超过串行阈值，且长度不是块长的整数倍
+    const size_t n = 1000003;
+    ministl::vector<int> a(n, 0);
+    for (size_t i = 0; i < n; ++i)
+        a[i] = static_cast<int>(i % 1000);
+
+    // copy / move / fill / fill_n
+    {
+        ministl::vector<int> b(n, -1);
+        EXPECT_TRUE(ministl::copy(ex::par, a.begin(), a.end(), b.begin()) == b.end());
+        EXPECT_TRUE(a == b);
+        ministl::fill(ex::par_unseq, b.begin(), b.end(), 7);
+        EXPECT_TRUE(ministl::equal(ex::seq, b.begin(), b.end(), ministl::vector<int>(n, 7).begin()));
+        EXPECT_TRUE(ministl::fill_n(ex::par, b.begin(), 10, 3) == b.begin() + 10);
+        EXPECT_TRUE(b[9] == 3 && b[10] == 7);
+        ministl::move(ex::par, a.begin(), a.end(), b.begin());
+        EXPECT_TRUE(a == b);
+    }
+
+    // equal / mismatch 找到的是最靠前的失配位置
+    {
+        ministl::vector<int> b(a);
+        EXPECT_TRUE(ministl::equal(ex::par, a.begin(), a.end(), b.begin()));
+        EXPECT_TRUE(ministl::mismatch(ex::par, a.begin(), a.end(), b.begin()).first == a.end());
+        b[n - 5] = -1;
+        b[700001] = -1;
+        b[300001] = -1;
+        EXPECT_TRUE(!ministl::equal(ex::par, a.begin(), a.end(), b.begin()));
+        ministl::pair<int*, int*> mm = ministl::mismatch(ex::par_unseq, a.begin(), a.end(), b.begin());
+        EXPECT_TRUE(mm.first - a.begin() == 300001 && mm.second - b.begin() == 300001);
+    }
+
+    // transform / reduce / transform_reduce 与串行结果一致
+    {
+        ministl::vector<long> sq(n, 0);
+        ministl::transform(ex::par, a.begin(), a.end(), sq.begin(), [](int x) { return long(x) * x; });
+        EXPECT_TRUE(sq[999] == 999L * 999 && sq[n - 1] == long((n - 1) % 1000) * ((n - 1) % 1000));
+        ministl::vector<long> sum2(n, 0);
+        ministl::transform(ex::par, a.begin(), a.end(), sq.begin(), sum2.begin(), ministl::plus<long>());
+        EXPECT_TRUE(sum2[12] == 12 + 144);
+
+        const long serial = ministl::reduce(sq.begin(), sq.end(), 0L);
+        EXPECT_TRUE(ministl::reduce(ex::par, sq.begin(), sq.end(), 0L) == serial);
+        EXPECT_TRUE(ministl::reduce(ex::par_unseq, sq.begin(), sq.end()) == serial);
+        EXPECT_TRUE(ministl::reduce(ex::seq, sq.begin(), sq.end(), 5L) == serial + 5);
+        EXPECT_TRUE(ministl::transform_reduce(ex::par, a.begin(), a.end(), 0L, ministl::plus<long>(),
+                                              [](int x) { return long(x) * x; }) == serial);
+        EXPECT_TRUE(ministl::transform_reduce(ex::par_unseq, a.begin(), a.end(), a.begin(), 0L) == serial);
+    }
+
+    // 非随机访问迭代器退化为串行版本
+    {
+        std::list<int> l(100, 2);
+        EXPECT_TRUE(ministl::reduce(ex::par, l.begin(), l.end(), 0) == 200);
+        EXPECT_TRUE(ministl::transform_reduce(ex::par_unseq, l.begin(), l.end(), l.begin(), 0) == 400);
+    }
+
+    // 块内抛出的异常在调用线程重新抛出
+    {
+        bool thrown = false;
+        try
+        {
+            ministl::vector<int> b(n, 0);
+            ministl::transform(ex::par, a.begin(), a.end(), b.begin(), [](int x) {
+                if (x == 999)
+                    throw std::runtime_error("bad element");
+                return x;
+            });
+        }
+        catch (const std::runtime_error&)
+        {
+            thrown = true;
+        }
+        EXPECT_TRUE(thrown);
+    }
+    FUN_VALUE(ministl::parallel_chunk_elems<double>());
+    FUN_VALUE(ministl::parallel_chunk_elems<char[3]>());
+
+#if PERFORMANCE_TEST_ON
+    std::cout << "[--------------------- Performance Testing ---------------------]\n";
+#if LARGER_TEST_DATA_ON
+    const size_t len = 200000000;
+#else
+    const size_t len = 20000000;
+#endif
+    ministl::vector<double> x(len, 1.0);
+    ministl::vector<double> y(len, 0.0);
+    for (size_t i = 0; i < len; ++i)
+        x[i] = static_cast<double>(i % 97) * 0.5;
+    auto axpy = [](double v) { return 2.5 * v + 1.0; };
+    {
+        ministl::test::timer t;
+        ministl::transform(x.begin(), x.end(), y.begin(), axpy);
+        ministl::test::print_time("transform (serial)", len, t.elapsed_ms());
+    }
+    {
+        ministl::test::timer t;
+        ministl::transform(ex::par, x.begin(), x.end(), y.begin(), axpy);
+        ministl::test::print_time("transform (par)", len, t.elapsed_ms());
+    }
+    double s0 = 0, s1 = 0, s2 = 0;
+    {
+        ministl::test::timer t;
+        s0 = ministl::reduce(y.begin(), y.end(), 0.0);
+        ministl::test::print_time("reduce (serial)", len, t.elapsed_ms());
+    }
+    {
+        ministl::test::timer t;
+        s1 = ministl::reduce(ex::par, y.begin(), y.end(), 0.0);
+        ministl::test::print_time("reduce (par)", len, t.elapsed_ms());
+    }
+    {
+        ministl::test::timer t;
+        s2 = ministl::reduce(ex::par_unseq, y.begin(), y.end(), 0.0);
+        ministl::test::print_time("reduce (par_unseq)", len, t.elapsed_ms());
+    }
+    EXPECT_TRUE(std::fabs(s1 - s0) <= 1e-9 * s0 && std::fabs(s2 - s0) <= 1e-9 * s0);
+    {
+        ministl::test::timer t;
+        ministl::test::do_not_optimize(ministl::transform_reduce(ex::par_unseq, x.begin(), x.end(), y.begin(), 0.0));
+        ministl::test::print_time("dot (par_unseq)", len, t.elapsed_ms());
+    }
+#endif
+    std::cout << "[------------- End algorithm test : parallel_algo --------------]\n";
+}
+#endif //MINISTL_T_PARALLEL_ALGO_H
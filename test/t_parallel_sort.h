@@ -0,0 +1,113 @@
+#ifndef MINISTL_T_PARALLEL_SORT_H
+#define MINISTL_T_PARALLEL_SORT_H
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include "test.h"
+#include "../vector.h"
+#include "../parallel_algo.h"
+
+void parallel_sort_test()
+{
+    std::cout << "[===============================================================]\n";
+    std::cout << "[------------- Run algorithm test : parallel_sort --------------]\n";
+    std::cout << "[-------------------------- API test ---------------------------]\n";
+    namespace ex = ministl::execution;
+    std::mt19937_64 rng(7);
+    // 足够分成多块，且不是块长的整数倍
+    const size_t n = 1000003;
+    ministl::vector<int64_t> v(n, 0);
+    for (size_t i = 0; i < n; ++i)
+        v[i] = static_cast<int64_t>(rng() % 100000) - 50000;
+    std::vector<int64_t> expected(v.begin(), v.end());
+    std::sort(expected.begin(), expected.end());
+
+    {
+        ministl::vector<int64_t> a(v), b(v), c(v);
+        ministl::sort(ex::par, a.begin(), a.end());
+        ministl::sort(ex::par_unseq, b.begin(), b.end(), ministl::greater<int64_t>());
+        ministl::parallel_sort(c.begin(), c.end(), ministl::less<int64_t>(), ministl::sort_stability::unstable);
+        EXPECT_TRUE(std::equal(expected.begin(), expected.end(), a.begin()));
+        EXPECT_TRUE(std::equal(expected.rbegin(), expected.rend(), b.begin()));
+        EXPECT_TRUE(a == c);
+    }
+
+    // 稳定排序：按 key 排序后，相同 key 的元素保持原来的下标顺序
+    {
+        typedef ministl::pair<int, int> item;
+        ministl::vector<item> items(n, item(0, 0));
+        for (size_t i = 0; i < n; ++i)
+            items[i] = item(static_cast<int>(rng() % 1000), static_cast<int>(i));
+        ministl::stable_sort(ex::par, items.begin(), items.end(),
+                             [](const item& a, const item& b) { return a.first < b.first; });
+        bool ok = true;
+        for (size_t i = 1; i < n; ++i)
+            ok = ok && (items[i - 1].first < items[i].first ||
+                        (items[i - 1].first == items[i].first && items[i - 1].second < items[i].second));
+        EXPECT_TRUE(ok);
+    }
+
+    // 非平凡类型与独立的线程池
+    {
+        ministl::vector<std::string> s(200000, std::string());
+        for (size_t i = 0; i < s.size(); ++i)
+            s[i] = std::to_string(rng());
+        ministl::vector<std::string> t(s);
+        std::sort(t.begin(), t.end());
+        ministl::thread_pool pool(3);
+        ministl::parallel_sort(s.begin(), s.end(), ministl::less<std::string>(),
+                               ministl::sort_stability::stable, pool);
+        EXPECT_TRUE(s == t);
+    }
+
+    // 超过 INT_MAX 字节的区间同样拿到等长的缓冲区，parallel_merge_sort 不会退回单线程排序；
+    // 只申请不写入，不占用物理内存
+    {
+        const ptrdiff_t big = static_cast<ptrdiff_t>(INT_MAX / sizeof(uint64_t)) + 1;
+        ministl::pair<uint64_t*, ptrdiff_t> buf = ministl::get_temporary_buffer<uint64_t>(big);
+        EXPECT_TRUE(buf.first != nullptr && buf.second == big);
+        ministl::release_temporary_buffer(buf.first);
+    }
+
+#if PERFORMANCE_TEST_ON
+    std::cout << "[--------------------- Performance Testing ---------------------]\n";
+#if LARGER_TEST_DATA_ON
+    const size_t len = 500000000;
+#else
+    const size_t len = 20000000;
+#endif
+    ministl::vector<uint64_t> data(len, 0);
+    for (size_t i = 0; i < len; ++i)
+        data[i] = rng();
+    {
+        ministl::vector<uint64_t> w(data);
+        ministl::test::timer t;
+        ministl::sort(w.begin(), w.end());
+        ministl::test::print_time("serial sort", len, t.elapsed_ms());
+    }
+    // 扩展性：依次使用 1, 2, 4, ... 个工作线程，直到硬件线程数(至少测到 4)
+    const size_t hw = ministl::max(static_cast<size_t>(std::thread::hardware_concurrency()),
+                                   static_cast<size_t>(4));
+    for (size_t workers = 1; workers <= hw; workers *= 2)
+    {
+        ministl::thread_pool pool(workers);
+        ministl::vector<uint64_t> w(data);
+        ministl::test::timer t;
+        ministl::parallel_sort(w.begin(), w.end(), ministl::sort_stability::unstable, pool);
+        ministl::test::print_time("parallel_sort, workers = " + std::to_string(workers), len, t.elapsed_ms());
+        EXPECT_TRUE(ministl::is_sorted(w.begin(), w.end()));
+    }
+    {
+        ministl::vector<uint64_t> w(data);
+        ministl::test::timer t;
+        ministl::parallel_sort(w.begin(), w.end(), ministl::less<uint64_t>(), ministl::sort_stability::stable);
+        ministl::test::print_time("parallel stable sort", len, t.elapsed_ms());
+    }
+#endif
+    std::cout << "[------------- End algorithm test : parallel_sort --------------]\n";
+}
+#endif //MINISTL_T_PARALLEL_SORT_H
@@ -0,0 +1,105 @@
+#ifndef MINISTL_T_PARALLEL_VECTOR_H
+#define MINISTL_T_PARALLEL_VECTOR_H
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include "test.h"
+#include "../vector.h"
+#include "../parallel_uninitialized.h"
+
+void parallel_vector_test()
+{
+    std::cout << "[===============================================================]\n";
+    std::cout << "[------------- Run container test : parallel vector ------------]\n";
+    std::cout << "[-------------------------- API test ---------------------------]\n";
+    // 32MB，足够切成多个分段
+    const size_t n = static_cast<size_t>(4) << 20;
+    ministl::vector<double> src(n, 0.0);
+    for (size_t i = 0; i < n; ++i)
+        src[i] = static_cast<double>(i);
+
+    // 构造函数标签
+    {
+        ministl::vector<double> v1(src, ministl::parallel_init);
+        EXPECT_TRUE(v1 == src);
+        ministl::vector<double> v2(src.begin() + 1, src.end(), ministl::parallel_init);
+        EXPECT_TRUE(v2.size() == n - 1 && v2[0] == 1.0 && v2[n - 2] == src[n - 1]);
+        ministl::vector<std::string> s1(1 << 18, std::string(40, 'x'));
+        ministl::vector<std::string> s2(s1, ministl::parallel_init);
+        EXPECT_TRUE(s1 == s2);
+    }
+
+    // 全局阈值：超过阈值的复制与重新分配时的搬移并行执行
+    ministl::set_parallel_vector_threshold(static_cast<size_t>(1) << 20);
+    FUN_VALUE(ministl::parallel_vector_threshold());
+    {
+        ministl::vector<double> v1(src);
+        EXPECT_TRUE(v1 == src);
+        v1.reserve(2 * n);
+        EXPECT_TRUE(v1 == src && v1.capacity() >= 2 * n);
+        ministl::vector<double> v2(src);
+        v2.insert(v2.begin() + 3, 2 * n, -1.0);
+        EXPECT_TRUE(v2.size() == 3 * n && v2[2] == 2.0 && v2[3] == -1.0 && v2[2 * n + 3] == 3.0);
+        ministl::vector<std::string> s1(1 << 18, std::string(40, 'y'));
+        s1.shrink_to_fit();
+        s1.push_back("z");
+        EXPECT_TRUE(s1.size() == (1 << 18) + 1 && s1[1000] == std::string(40, 'y') && s1.back() == "z");
+    }
+    ministl::set_parallel_vector_threshold(0);
+
+    // 任一分段复制失败时，所有已构造的元素都被析构，异常传给调用方
+    {
+        const size_t m = static_cast<size_t>(16) << 20;
+        typedef ministl::test::counted<ministl::test::throw_on_budget> elem;
+        elem::copy_budget = static_cast<int>(m);
+        ministl::vector<elem> v(m);
+        const int alive = elem::live;
+        elem::copy_budget = static_cast<int>(m / 2);
+        bool thrown = false;
+        try
+        {
+            ministl::vector<elem> copy(v, ministl::parallel_init);
+        }
+        catch (const std::runtime_error&)
+        {
+            thrown = true;
+        }
+        EXPECT_TRUE(thrown && elem::live == alive);
+    }
+
+#if PERFORMANCE_TEST_ON
+    std::cout << "[--------------------- Performance Testing ---------------------]\n";
+#if LARGER_TEST_DATA_ON
+    const size_t m = (static_cast<size_t>(4) << 30) / sizeof(double);
+#else
+    const size_t m = (static_cast<size_t>(256) << 20) / sizeof(double);
+#endif
+    ministl::vector<double> big(m, 1.0);
+    {
+        ministl::test::timer t;
+        ministl::vector<double> v(big);
+        ministl::test::do_not_optimize(v[m - 1]);
+        ministl::test::print_time("vector(const vector&)", m, t.elapsed_ms());
+    }
+    {
+        ministl::test::timer t;
+        ministl::vector<double> v(big, ministl::parallel_init);
+        ministl::test::do_not_optimize(v[m - 1]);
+        ministl::test::print_time("vector(const vector&, parallel_init)", m, t.elapsed_ms());
+    }
+    {
+        ministl::test::timer t;
+        big.reserve(m + m / 2);
+        ministl::test::print_time("reserve (relocate)", m, t.elapsed_ms());
+    }
+    ministl::set_parallel_vector_threshold(static_cast<size_t>(64) << 20);
+    {
+        ministl::test::timer t;
+        big.reserve(2 * m);
+        ministl::test::print_time("reserve (parallel relocate)", m, t.elapsed_ms());
+    }
+    ministl::set_parallel_vector_threshold(0);
+#endif
+    std::cout << "[------------- End container test : parallel vector ------------]\n";
+}
+#endif //MINISTL_T_PARALLEL_VECTOR_H
@@ -0,0 +1,188 @@
+#ifndef MINISTL_T_PARTITION_H
+#define MINISTL_T_PARTITION_H
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <list>
+#include <random>
+#include <string>
+#include "test.h"
+#include "../vector.h"
+#include "../algo.h"
+
+// nth_element 之后 nth 处为排序后的元素，前面的都不大于它，后面的都不小于它；
+// partial_sort 之后前 k 个元素与完整排序的结果一致
+template <class T, class Compared>
+bool select_matches_std(const ministl::vector<T>& v, size_t k, Compared comp)
+{
+    std::vector<T> expected(v.begin(), v.end());
+    std::sort(expected.begin(), expected.end(), comp);
+    ministl::vector<T> a(v);
+    ministl::nth_element(a.begin(), a.begin() + k, a.end(), comp);
+    auto equivalent = [&comp](const T& x, const T& y) { return !comp(x, y) && !comp(y, x); };
+    if (!equivalent(a[k], expected[k]))
+        return false;
+    for (size_t i = 0; i < a.size(); ++i)
+    {
+        if ((i < k && comp(a[k], a[i])) || (i > k && comp(a[i], a[k])))
+            return false;
+    }
+    ministl::vector<T> b(v);
+    ministl::partial_sort(b.begin(), b.begin() + (k + 1), b.end(), comp);
+    return std::equal(expected.begin(), expected.begin() + (k + 1), b.begin(), equivalent);
+}
+
+template <class T>
+bool pivot_partition_ok(ministl::vector<T> v, T pivot)
+{
+    const size_t k = ministl::pivot_partition<ministl::pivot_cmp::lt>(v.begin(), v.end(), pivot);
+    for (size_t i = 0; i < v.size(); ++i)
+    {
+        if ((v[i] < pivot) != (i < k))
+            return false;
+    }
+    return true;
+}
+
+template <class T>
+void select_time(const std::string& name, size_t n, size_t k, std::mt19937_64& rng)
+{
+    ministl::vector<T> v(n, T());
+    for (size_t i = 0; i < n; ++i)
+        v[i] = static_cast<T>(static_cast<int64_t>(rng() % 1000000000) - 500000000);
+    const std::string top = " top-" + std::to_string(k);
+    {
+        ministl::vector<T> w(v);
+        ministl::test::timer t;
+        std::partial_sort(w.begin(), w.begin() + k, w.end());
+        ministl::test::print_time("std::partial_sort " + name + top, n, t.elapsed_ms());
+    }
+    {
+        ministl::vector<T> w(v);
+        ministl::test::timer t;
+        ministl::partial_sort(w.begin(), w.begin() + k, w.end());
+        ministl::test::print_time("ministl::partial_sort " + name + top, n, t.elapsed_ms());
+    }
+    {
+        ministl::vector<T> w(v);
+        ministl::test::timer t;
+        ministl::sort(w.begin(), w.end());
+        ministl::test::print_time("ministl::sort " + name, n, t.elapsed_ms());
+    }
+    {
+        ministl::vector<T> w(v);
+        ministl::test::timer t;
+        std::nth_element(w.begin(), w.begin() + n / 2, w.end());
+        ministl::test::print_time("std::nth_element " + name, n, t.elapsed_ms());
+    }
+    const char* levels[] = {"scalar", "avx2", "avx512"};
+    for (int level = 0; level <= static_cast<int>(ministl::detect_simd_level()); ++level)
+    {
+        ministl::set_simd_level_limit(static_cast<ministl::simd_level>(level));
+        ministl::vector<T> w(v);
+        ministl::test::timer t;
+        ministl::nth_element(w.begin(), w.begin() + n / 2, w.end());
+        ministl::test::print_time("ministl::nth_element " + name + " " + levels[level], n, t.elapsed_ms());
+    }
+    ministl::set_simd_level_limit(ministl::simd_level::avx512);
+}
+
+void partition_test()
+{
+    std::cout << "[===============================================================]\n";
+    std::cout << "[-------------- Run algorithm test : partition -----------------]\n";
+    std::cout << "[-------------------------- API test ---------------------------]\n";
+    std::mt19937_64 rng(36);
+
+    // partition 对双向迭代器也可用
+    {
+        ministl::vector<int> v{5, 2, 8, 1, 9, 4, 7, 3, 6};
+        int* mid = ministl::partition(v.begin(), v.end(), [](int x) { return x % 2 == 0; });
+        EXPECT_TRUE(mid - v.begin() == 4 && std::all_of(v.begin(), mid, [](int x) { return x % 2 == 0; }) &&
+                    std::none_of(mid, v.end(), [](int x) { return x % 2 == 0; }));
+        std::list<int> l{1, 2, 3, 4, 5, 6};
+        std::list<int>::iterator it = ministl::partition(l.begin(), l.end(), [](int x) { return x > 3; });
+        EXPECT_TRUE(std::distance(l.begin(), it) == 3 && *l.begin() > 3);
+        FUN_AFTER(v, ministl::partition(v.begin(), v.end(), [](int x) { return x < 5; }));
+    }
+
+    // 每一级指令集的向量化分区，覆盖不足一个、恰好几个向量等各种长度
+    const char* levels[] = {"scalar", "avx2", "avx512"};
+    FUN_VALUE(levels[static_cast<int>(ministl::detect_simd_level())]);
+    for (int level = 0; level <= static_cast<int>(ministl::detect_simd_level()); ++level)
+    {
+        ministl::set_simd_level_limit(static_cast<ministl::simd_level>(level));
+        bool ok = true;
+        for (size_t n = 0; n < 300; n += 7)
+        {
+            ministl::vector<int32_t> a(n, 0);
+            ministl::vector<uint64_t> b(n, 0);
+            ministl::vector<double> c(n, 0.0);
+            for (size_t i = 0; i < n; ++i)
+            {
+                a[i] = static_cast<int32_t>(rng() % 100) - 50;
+                b[i] = rng();
+                c[i] = static_cast<double>(rng() % 100);
+            }
+            ok = ok && pivot_partition_ok(a, static_cast<int32_t>(0)) &&
+                 pivot_partition_ok(b, static_cast<uint64_t>(1) << 63) && pivot_partition_ok(c, 50.0);
+        }
+        EXPECT_TRUE(ok);
+
+        const size_t n = 100003;
+        ministl::vector<float> f(n, 0.0f);
+        ministl::vector<int64_t> i64(n, 0);
+        ministl::vector<uint32_t> few(n, 0);
+        for (size_t i = 0; i < n; ++i)
+        {
+            f[i] = static_cast<float>(static_cast<int64_t>(rng() % 2000000) - 1000000) / 7.0f;
+            i64[i] = static_cast<int64_t>(rng());
+            few[i] = static_cast<uint32_t>(rng() % 3);
+        }
+        const size_t ks[] = {0, 1, 99, n / 2, n - 2, n - 1};
+        for (size_t k : ks)
+        {
+            EXPECT_TRUE(select_matches_std(f, k, ministl::less<float>()));
+            EXPECT_TRUE(select_matches_std(f, k, ministl::greater<float>()));
+            EXPECT_TRUE(select_matches_std(i64, k, ministl::less<int64_t>()));
+            EXPECT_TRUE(select_matches_std(few, k, ministl::less<uint32_t>()));
+        }
+    }
+    ministl::set_simd_level_limit(ministl::simd_level::avx512);
+
+    // 通用版本：自定义比较操作、非平凡类型与重复元素
+    {
+        const size_t n = 20011;
+        ministl::vector<int> v(n, 0);
+        ministl::vector<std::string> s(n, std::string());
+        for (size_t i = 0; i < n; ++i)
+        {
+            v[i] = static_cast<int>(rng() % 50);
+            s[i] = std::to_string(rng() % 1000);
+        }
+        auto by_mod7 = [](int a, int b) { return (a % 7) < (b % 7); };
+        EXPECT_TRUE(select_matches_std(v, n / 3, by_mod7));
+        EXPECT_TRUE(select_matches_std(s, 10, ministl::less<std::string>()));
+        EXPECT_TRUE(select_matches_std(s, n - 1, ministl::greater<std::string>()));
+        ministl::vector<int> small{3, 1, 2};
+        ministl::nth_element(small.begin(), small.begin() + 1, small.end());
+        EXPECT_TRUE(small[1] == 2);
+        ministl::partial_sort(small.begin(), small.end(), small.end());
+        EXPECT_TRUE(small == ministl::vector<int>({1, 2, 3}));
+    }
+
+#if PERFORMANCE_TEST_ON
+    std::cout << "[--------------------- Performance Testing ---------------------]\n";
+#if LARGER_TEST_DATA_ON
+    const size_t len = 100000000;
+#else
+    const size_t len = 10000000;
+#endif
+    select_time<float>("float", len, 100, rng);
+    select_time<float>("float", len, len / 10, rng);
+    select_time<int64_t>("int64", len, 100, rng);
+    select_time<int64_t>("int64", len, len / 10, rng);
+#endif
+    std::cout << "[-------------- End algorithm test : partition -----------------]\n";
+}
+#endif //MINISTL_T_PARTITION_H
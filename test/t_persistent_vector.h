@@ -0,0 +1,365 @@
+#ifndef MINISTL_T_PERSISTENT_VECTOR_H
+#define MINISTL_T_PERSISTENT_VECTOR_H
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "test.h"
+#include "../persistent_vector.h"
+
+template <class T>
+bool persistent_matches(const ministl::persistent_vector<T>& pv, const std::vector<int>& expected)
+{
+    if (pv.size() != expected.size())
+        return false;
+    for (size_t i = 0; i < expected.size(); ++i)
+    {
+        if (!(pv[i] == T(expected[i])))
+            return false;
+    }
+    size_t i = 0;
+    for (auto it = pv.begin(); it != pv.end(); ++it, ++i)
+    {
+        if (!(*it == T(expected[i])))
+            return false;
+    }
+    const ministl::vector<T> v = pv.to_vector();
+    for (i = 0; i < expected.size(); ++i)
+    {
+        if (!(v[i] == T(expected[i])))
+            return false;
+    }
+    return v.size() == expected.size();
+}
+
+// 在一组历史版本上随机地修改、切片、拼接，每个新版本都与 std::vector 对照，旧版本始终不变
+template <class T>
+bool persistent_random_ok(std::mt19937_64& rng, size_t rounds)
+{
+    std::vector<ministl::persistent_vector<T>> versions(1);
+    std::vector<std::vector<int>> expected(1);
+    for (size_t r = 0; r < rounds; ++r)
+    {
+        const size_t from = static_cast<size_t>(rng() % versions.size());
+        ministl::persistent_vector<T> pv = versions[from];
+        std::vector<int> e = expected[from];
+        const size_t n = e.size();
+        const unsigned op = static_cast<unsigned>(rng() % 9);
+        if (op == 0 || n == 0)
+        {
+            const size_t count = static_cast<size_t>(rng() % 3000);
+            ministl::transient_vector<T> t = pv.transient();
+            for (size_t i = 0; i < count; ++i)
+            {
+                const int v = static_cast<int>(rng() % 1000);
+                t.push_back(T(v));
+                e.push_back(v);
+            }
+            pv = t.persistent();
+        }
+        else if (op == 1)
+        {
+            const int v = static_cast<int>(rng() % 1000);
+            pv = pv.push_back(T(v));
+            e.push_back(v);
+        }
+        else if (op == 2)
+        {
+            const size_t i = static_cast<size_t>(rng() % n);
+            const int v = static_cast<int>(rng() % 1000);
+            pv = pv.set(i, T(v));
+            e[i] = v;
+        }
+        else if (op == 3)
+        {
+            pv = pv.pop_back();
+            e.pop_back();
+        }
+        else if (op == 4)
+        {
+            const size_t k = static_cast<size_t>(rng() % (n + 1));
+            pv = pv.take(k);
+            e.resize(k);
+        }
+        else if (op == 5)
+        {
+            const size_t k = static_cast<size_t>(rng() % (n + 1));
+            pv = pv.drop(k);
+            e.erase(e.begin(), e.begin() + static_cast<ptrdiff_t>(k));
+        }
+        else if (op == 6)
+        {
+            size_t first = static_cast<size_t>(rng() % (n + 1));
+            size_t last = static_cast<size_t>(rng() % (n + 1));
+            if (first > last)
+                std::swap(first, last);
+            pv = pv.slice(first, last);
+            e = std::vector<int>(e.begin() + static_cast<ptrdiff_t>(first), e.begin() + static_cast<ptrdiff_t>(last));
+        }
+        else if (op == 7)
+        {
+            const size_t other = static_cast<size_t>(rng() % versions.size());
+            pv = pv + versions[other];
+            e.insert(e.end(), expected[other].begin(), expected[other].end());
+        }
+        else
+        {
+            // transient 上混合修改，期间取出的版本不受之后修改的影响
+            ministl::transient_vector<T> t = pv.transient();
+            const size_t i = static_cast<size_t>(rng() % n);
+            t.set(i, T(-1));
+            e[i] = -1;
+            const ministl::persistent_vector<T> mid = t.persistent();
+            const std::vector<int> mid_expected = e;
+            t.push_back(T(-2));
+            t.set(0, T(-3));
+            t.drop(static_cast<size_t>(rng() % (n + 1)) / 2);
+            t.append(versions[0]);
+            if (!persistent_matches(mid, mid_expected))
+                return false;
+            pv = mid;
+        }
+        // 拼接会让长度成倍增长，过长时截断
+        if (e.size() > 60000)
+        {
+            pv = pv.take(50000);
+            e.resize(50000);
+        }
+        if (r % 16 == 0 && !persistent_matches(pv, e))
+            return false;
+        if (versions.size() < 32)
+        {
+            versions.push_back(pv);
+            expected.push_back(e);
+        }
+        else
+        {
+            const size_t slot = static_cast<size_t>(rng() % versions.size());
+            versions[slot] = pv;
+            expected[slot] = e;
+        }
+    }
+    for (size_t i = 0; i < versions.size(); ++i)
+    {
+        if (!persistent_matches(versions[i], expected[i]))
+            return false;
+    }
+    return true;
+}
+
+// 大量长短不一的片段依次拼接，树的各层都要经过重排
+bool persistent_concat_ok(std::mt19937_64& rng)
+{
+    ministl::persistent_vector<int> all;
+    std::vector<int> expected;
+    for (int piece = 0; piece < 3000; ++piece)
+    {
+        const size_t n = static_cast<size_t>(rng() % (piece % 10 == 0 ? 2000 : 70));
+        ministl::vector<int> part;
+        for (size_t i = 0; i < n; ++i)
+        {
+            part.push_back(static_cast<int>(rng() % 100000));
+            expected.push_back(part.back());
+        }
+        all = all + ministl::persistent_vector<int>(part);
+    }
+    if (!persistent_matches(all, expected))
+        return false;
+    // 拼接之后继续追加、修改与切片
+    ministl::persistent_vector<int> more = all;
+    for (int i = 0; i < 5000; ++i)
+    {
+        more = more.push_back(i);
+        expected.push_back(i);
+    }
+    for (int i = 0; i < 2000; ++i)
+    {
+        const size_t k = static_cast<size_t>(rng() % expected.size());
+        more = more.set(k, -i);
+        expected[k] = -i;
+    }
+    if (!persistent_matches(more, expected))
+        return false;
+    const size_t first = expected.size() / 3;
+    const size_t last = expected.size() - expected.size() / 5;
+    return persistent_matches(more.slice(first, last),
+                              std::vector<int>(expected.begin() + static_cast<ptrdiff_t>(first),
+                                               expected.begin() + static_cast<ptrdiff_t>(last)));
+}
+
+void persistent_vector_test()
+{
+    std::cout << "[===============================================================]\n";
+    std::cout << "[----------- Run container test : persistent_vector ------------]\n";
+    std::cout << "[-------------------------- API test ---------------------------]\n";
+    std::mt19937_64 rng(46);
+
+    ministl::persistent_vector<int> p1;
+    ministl::persistent_vector<int> p2(5, 3);
+    ministl::persistent_vector<int> p3{1, 2, 3, 4};
+    ministl::vector<int> v(100, 0);
+    for (size_t i = 0; i < v.size(); ++i)
+        v[i] = static_cast<int>(i);
+    ministl::persistent_vector<int> p4(v);
+    EXPECT_TRUE(p1.empty() && p2.size() == 5 && p3.back() == 4 && p4[99] == 99 && p4.front() == 0);
+    FUN_VALUE(p4.size());
+    FUN_VALUE(p3.concat(p2).size());
+
+    // 每次修改得到新版本，旧版本不变
+    ministl::persistent_vector<int> p5 = p3.push_back(5);
+    ministl::persistent_vector<int> p6 = p5.set(0, 10).update(1, [](int x) { return x * 10; });
+    EXPECT_TRUE(p3.size() == 4 && p5.size() == 5 && p5[0] == 1 && p6[0] == 10 && p6[1] == 20 && p5.back() == 5);
+    EXPECT_TRUE(p5.pop_back() == p3 && p6 != p5 && p3.identical(ministl::persistent_vector<int>(p3)));
+    EXPECT_TRUE(p4.take(40).size() == 40 && p4.drop(40).front() == 40 && p4.slice(10, 20)[9] == 19);
+    const ministl::persistent_vector<int> p7 = p4 + p3 + p4;
+    EXPECT_TRUE(p7.size() == 204 && p7[100] == 1 && p7[104] == 0 && p7.back() == 99);
+    ministl::vector<int> back = p7.slice(100, 110).to_vector();
+    EXPECT_TRUE(back.size() == 10 && back[0] == 1 && back[4] == 0 && back[9] == 5);
+    EXPECT_TRUE(ministl::persistent_vector<int>(back.begin(), back.end()).to_vector() == back);
+    bool thrown = false;
+    try
+    {
+        p3.at(4);
+    }
+    catch (const std::out_of_range&)
+    {
+        thrown = true;
+    }
+    EXPECT_TRUE(thrown);
+
+    // transient 批量修改
+    ministl::transient_vector<int> t = p4.transient();
+    for (int i = 0; i < 1000; ++i)
+        t.push_back(i);
+    t.set(0, -1);
+    t.pop_back();
+    t.append(v.begin(), v.end());
+    const ministl::persistent_vector<int> p8 = t.persistent();
+    t.set(1, -1);
+    EXPECT_TRUE(p4[0] == 0 && p8.size() == 1199 && p8[0] == -1 && p8[1] == 1 && t[1] == -1 && p8[1098] == 998);
+
+    EXPECT_TRUE(persistent_random_ok<int>(rng, 3000));
+    EXPECT_TRUE(persistent_concat_ok(rng));
+    {
+        // 记录存活对象个数，检查共享节点最终都被释放
+        typedef ministl::test::counted<> elem;
+        EXPECT_TRUE(persistent_random_ok<elem>(rng, 500));
+        ministl::persistent_vector<std::string> s1{"a", "bb", "ccc"};
+        ministl::persistent_vector<std::string> s2 = s1.push_back("dddd").set(0, "A");
+        EXPECT_TRUE(s1[0] == "a" && s2[0] == "A" && s2.size() == 4 && (s1 + s2).back() == "dddd");
+    }
+    EXPECT_TRUE(ministl::test::counted<>::live == 0);
+
+#if PERFORMANCE_TEST_ON
+    std::cout << "[--------------------- Performance Testing ---------------------]\n";
+#if LARGER_TEST_DATA_ON
+    const size_t n = 10000000;
+    const size_t history_n = 1000000;
+#else
+    const size_t n = 1000000;
+    const size_t history_n = 100000;
+#endif
+    const size_t versions = 200;
+    ministl::vector<uint64_t> base(n, 0);
+    for (size_t i = 0; i < n; ++i)
+        base[i] = i * 2654435761u;
+    const ministl::persistent_vector<uint64_t> pbase(base);
+    // 保存 versions 个历史版本，每个版本改动一个元素
+    const ministl::vector<uint64_t> table(base.begin(), base.begin() + history_n);
+    const ministl::persistent_vector<uint64_t> ptable(table);
+    uint64_t expected = 0;
+    {
+        ministl::test::timer timer;
+        ministl::vector<ministl::vector<uint64_t>> history;
+        history.push_back(table);
+        for (size_t k = 1; k < versions; ++k)
+        {
+            ministl::vector<uint64_t> next(history.back());
+            next[(k * 7919) % history_n] = k;
+            history.push_back(ministl::move(next));
+        }
+        ministl::test::print_time("vector history copy", versions, timer.elapsed_ms());
+        for (size_t k = 0; k < versions; ++k)
+            expected += history[k][(k * 7919) % history_n];
+    }
+    {
+        ministl::test::timer timer;
+        ministl::vector<ministl::persistent_vector<uint64_t>> history;
+        history.push_back(ptable);
+        for (size_t k = 1; k < versions; ++k)
+            history.push_back(history.back().set((k * 7919) % history_n, k));
+        ministl::test::print_time("persistent_vector history set", versions, timer.elapsed_ms());
+        uint64_t sum = 0;
+        for (size_t k = 0; k < versions; ++k)
+            sum += history[k][(k * 7919) % history_n];
+        EXPECT_TRUE(sum == expected);
+    }
+    {
+        ministl::test::timer timer;
+        ministl::vector<uint64_t> pushed;
+        for (size_t i = 0; i < n; ++i)
+            pushed.push_back(i);
+        ministl::test::print_time("vector push_back", n, timer.elapsed_ms());
+    }
+    {
+        ministl::test::timer timer;
+        ministl::transient_vector<uint64_t> pushed;
+        for (size_t i = 0; i < n; ++i)
+            pushed.push_back(i);
+        ministl::test::print_time("transient_vector push_back", n, timer.elapsed_ms());
+        EXPECT_TRUE(pushed.size() == n);
+    }
+    {
+        ministl::test::timer timer;
+        ministl::persistent_vector<uint64_t> pushed;
+        for (size_t i = 0; i < n; ++i)
+            pushed = pushed.push_back(i);
+        ministl::test::print_time("persistent_vector push_back", n, timer.elapsed_ms());
+        EXPECT_TRUE(pushed.size() == n);
+    }
+    ministl::vector<size_t> idx(n, 0);
+    for (size_t i = 0; i < n; ++i)
+        idx[i] = static_cast<size_t>(rng() % n);
+    {
+        ministl::test::timer timer;
+        uint64_t sum = 0;
+        for (size_t i : idx)
+            sum += base[i];
+        ministl::test::print_time("vector random read", n, timer.elapsed_ms());
+        ministl::test::do_not_optimize(sum);
+    }
+    {
+        ministl::test::timer timer;
+        uint64_t sum = 0;
+        for (size_t i : idx)
+            sum += pbase[i];
+        ministl::test::print_time("persistent_vector random read", n, timer.elapsed_ms());
+        ministl::test::do_not_optimize(sum);
+    }
+    {
+        ministl::test::timer timer;
+        uint64_t sum = 0;
+        for (uint64_t x : pbase)
+            sum += x;
+        ministl::test::print_time("persistent_vector scan", n, timer.elapsed_ms());
+        ministl::test::do_not_optimize(sum);
+    }
+    {
+        ministl::test::timer timer;
+        ministl::persistent_vector<uint64_t> cat;
+        for (size_t k = 0; k < 1000; ++k)
+            cat = cat + pbase.slice((k * 7919) % (n / 2), (k * 7919) % (n / 2) + n / 2);
+        ministl::test::print_time("persistent_vector slice + concat", 1000, timer.elapsed_ms());
+        EXPECT_TRUE(cat.size() == 1000 * (n / 2) && cat[n / 2] == base[7919]);
+    }
+    {
+        ministl::test::timer timer;
+        const ministl::vector<uint64_t> out = pbase.to_vector();
+        ministl::test::print_time("persistent_vector to_vector", n, timer.elapsed_ms());
+        EXPECT_TRUE(out == base);
+    }
+#endif
+    std::cout << "[----------- End container test : persistent_vector ------------]\n";
+}
+#endif //MINISTL_T_PERSISTENT_VECTOR_H
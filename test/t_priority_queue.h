@@ -0,0 +1,191 @@
+#ifndef MINISTL_T_PRIORITY_QUEUE_H
+#define MINISTL_T_PRIORITY_QUEUE_H
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <string>
+#include <vector>
+#include "test.h"
+#include "../algo.h"
+#include "../queue.h"
+
+// 随机 push / pop / pop_n / push_range，每一步的堆顶都与 std::priority_queue 一致
+template <size_t Arity>
+bool priority_queue_matches_std(std::mt19937_64& rng)
+{
+    ministl::priority_queue<int, ministl::vector<int>, ministl::greater<int>, Arity> q;
+    std::priority_queue<int, std::vector<int>, std::greater<int>> expected;
+    for (int i = 0; i < 20000; ++i)
+    {
+        const unsigned op = static_cast<unsigned>(rng() % 10);
+        if (op < 5)
+        {
+            const int value = static_cast<int>(rng() % 1000);
+            q.push(value);
+            expected.push(value);
+        }
+        else if (op < 8)
+        {
+            if (!expected.empty())
+            {
+                q.pop();
+                expected.pop();
+            }
+        }
+        else if (op == 8)
+        {
+            ministl::vector<int> out;
+            q.pop_n(rng() % 8, std::back_inserter(out));
+            for (int v : out)
+            {
+                if (expected.empty() || expected.top() != v)
+                    return false;
+                expected.pop();
+            }
+        }
+        else
+        {
+            // 批量大小有时超过队列长度，两条路径(整体建堆与逐个上溯)都会走到
+            ministl::vector<int> batch(static_cast<size_t>(rng() % 64), 0);
+            for (auto& v : batch)
+            {
+                v = static_cast<int>(rng() % 1000);
+                expected.push(v);
+            }
+            q.push_range(batch.begin(), batch.end());
+        }
+        if (q.size() != expected.size() || (!q.empty() && q.top() != expected.top()))
+            return false;
+    }
+    return true;
+}
+
+template <size_t Arity>
+void dary_heap_sort_check(std::mt19937_64& rng)
+{
+    ministl::vector<uint64_t> v(10007, 0);
+    for (auto& x : v)
+        x = rng() % 5000;
+    ministl::dary_make_heap<Arity>(v.begin(), v.end());
+    EXPECT_TRUE(ministl::dary_is_heap<Arity>(v.begin(), v.end()));
+    ministl::dary_sort_heap<Arity>(v.begin(), v.end());
+    EXPECT_TRUE(ministl::is_sorted(v.begin(), v.end()));
+}
+
+// 先 push 全部元素再逐个 pop，比较出队序列之和
+template <class Queue>
+void priority_queue_bench(const std::string& name, const ministl::vector<uint64_t>& data, uint64_t expected)
+{
+    ministl::test::timer t;
+    Queue q;
+    for (uint64_t x : data)
+        q.push(x);
+    uint64_t sum = 0;
+    uint64_t step = 0;
+    while (!q.empty())
+    {
+        sum += q.top() * (++step & 7);
+        q.pop();
+    }
+    ministl::test::print_time(name, data.size(), t.elapsed_ms());
+    EXPECT_TRUE(sum == expected);
+}
+
+void priority_queue_test()
+{
+    std::cout << "[===============================================================]\n";
+    std::cout << "[------------- Run container test : priority_queue -------------]\n";
+    std::cout << "[-------------------------- API test ---------------------------]\n";
+    std::mt19937_64 rng(40);
+
+    ministl::priority_queue<int> q1;
+    ministl::priority_queue<int> q2{3, 1, 4, 1, 5, 9, 2, 6};
+    ministl::priority_queue<int, ministl::vector<int>, ministl::less<int>, 8> q3(
+            ministl::less<int>(), ministl::vector<int>{7, 8, 9, 1});
+    EXPECT_TRUE(q1.empty() && q2.size() == 8 && q2.top() == 9 && q3.top() == 9);
+    FUN_VALUE(q2.arity);
+    q1.push(5);
+    q1.emplace(7);
+    q1.push(3);
+    EXPECT_TRUE(q1.top() == 7 && q1.size() == 3);
+    q1.pop();
+    EXPECT_TRUE(q1.top() == 5);
+    int top3[3] = {0, 0, 0};
+    q2.pop_n(3, top3);
+    EXPECT_TRUE(top3[0] == 9 && top3[1] == 6 && top3[2] == 5 && q2.size() == 5 && q2.top() == 4);
+    ministl::vector<int> rest;
+    q2.pop_n(100, std::back_inserter(rest));
+    EXPECT_TRUE(q2.empty() && rest == ministl::vector<int>({4, 3, 2, 1, 1}));
+    int more[] = {10, 0, 20};
+    q1.push_range(more, more + 3);
+    EXPECT_TRUE(q1.size() == 5 && q1.top() == 20);
+    ministl::priority_queue<std::string> qs(ministl::less<std::string>(),
+                                            ministl::vector<std::string>{"b", "d", "a", "c"});
+    EXPECT_TRUE(qs.top() == "d");
+    qs.pop();
+    EXPECT_TRUE(qs.top() == "c" && qs.size() == 3);
+    ministl::swap(q1, q2);
+    EXPECT_TRUE(q1.empty() && q2.size() == 5 && q2.top() == 20 && q1 != q2);
+    q2.clear();
+    EXPECT_TRUE(q1.empty() && q1 == q2);
+
+    EXPECT_TRUE(priority_queue_matches_std<2>(rng));
+    EXPECT_TRUE(priority_queue_matches_std<3>(rng));
+    EXPECT_TRUE(priority_queue_matches_std<4>(rng));
+    EXPECT_TRUE(priority_queue_matches_std<8>(rng));
+    dary_heap_sort_check<2>(rng);
+    dary_heap_sort_check<4>(rng);
+    dary_heap_sort_check<8>(rng);
+
+#if PERFORMANCE_TEST_ON
+    std::cout << "[--------------------- Performance Testing ---------------------]\n";
+#if LARGER_TEST_DATA_ON
+    const size_t len = 10000000;
+#else
+    const size_t len = 1000000;
+#endif
+    ministl::vector<uint64_t> data(len, 0);
+    for (auto& x : data)
+        x = rng();
+    uint64_t expected = 0;
+    {
+        ministl::vector<uint64_t> sorted(data);
+        ministl::sort(sorted.begin(), sorted.end());
+        uint64_t step = 0;
+        for (size_t i = len; i != 0; --i)
+            expected += sorted[i - 1] * (++step & 7);
+    }
+    priority_queue_bench<std::priority_queue<uint64_t>>("std::priority_queue push + pop", data, expected);
+    priority_queue_bench<ministl::priority_queue<uint64_t, ministl::vector<uint64_t>, ministl::less<uint64_t>, 2>>(
+            "priority_queue<2> push + pop", data, expected);
+    priority_queue_bench<ministl::priority_queue<uint64_t, ministl::vector<uint64_t>, ministl::less<uint64_t>, 4>>(
+            "priority_queue<4> push + pop", data, expected);
+    priority_queue_bench<ministl::priority_queue<uint64_t, ministl::vector<uint64_t>, ministl::less<uint64_t>, 8>>(
+            "priority_queue<8> push + pop", data, expected);
+
+    // 已有数据整体建堆 vs 逐个 push；pop_n 一次取出 1%
+    {
+        ministl::test::timer t;
+        ministl::priority_queue<uint64_t> q(ministl::less<uint64_t>{}, ministl::vector<uint64_t>(data));
+        ministl::test::print_time("priority_queue<4> make_heap", len, t.elapsed_ms());
+        ministl::vector<uint64_t> out;
+        out.reserve(len / 100);
+        ministl::test::timer t2;
+        q.pop_n(len / 100, std::back_inserter(out));
+        ministl::test::print_time("priority_queue<4> pop_n", len / 100, t2.elapsed_ms());
+        EXPECT_TRUE(out.size() == len / 100 && ministl::is_sorted(out.rbegin(), out.rend()));
+    }
+    {
+        ministl::test::timer t;
+        ministl::priority_queue<uint64_t> q;
+        for (uint64_t x : data)
+            q.push(x);
+        ministl::test::print_time("priority_queue<4> push one by one", len, t.elapsed_ms());
+    }
+#endif
+    std::cout << "[------------- End container test : priority_queue -------------]\n";
+}
+#endif //MINISTL_T_PRIORITY_QUEUE_H
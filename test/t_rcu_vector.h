@@ -0,0 +1,177 @@
+#ifndef MINISTL_T_RCU_VECTOR_H
+#define MINISTL_T_RCU_VECTOR_H
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "test.h"
+#include "../rcu_vector.h"
+
+size_t rcu_reader_threads()
+{
+    const size_t hw = static_cast<size_t>(std::thread::hardware_concurrency());
+    return hw < 4 ? 4 : (hw > 64 ? 64 : hw);
+}
+
+// 写者每次把全部元素改成新的版本号，读者看到的快照必须整体一致，且版本号不回退
+bool rcu_vector_consistent_ok()
+{
+    // 记录存活对象个数，检查旧版本最终都被释放
+    typedef ministl::test::counted<> elem;
+    const size_t n = 1024;
+    ministl::rcu_vector<elem> table(ministl::vector<elem>(n, elem(0)));
+    std::atomic<bool> stop(false);
+    std::atomic<bool> ok(true);
+    ministl::vector<std::thread> readers;
+    for (size_t t = 0; t < rcu_reader_threads(); ++t)
+    {
+        readers.push_back(std::thread([&table, &stop, &ok, n]() {
+            int64_t last = 0;
+            while (!stop.load(std::memory_order_relaxed))
+            {
+                auto s = table.read();
+                const int64_t version = s[0].value;
+                if (s.size() != n || version < last)
+                    ok = false;
+                for (size_t i = 0; i < n; i += 97)
+                {
+                    if (s[i].value != version)
+                        ok = false;
+                }
+                last = version;
+            }
+        }));
+    }
+    for (int64_t version = 1; version <= 300; ++version)
+    {
+        table.update([version](ministl::vector<elem>& v) {
+            for (auto& x : v)
+                x.value = version;
+        });
+        if (version % 16 == 0)
+            std::this_thread::yield();
+    }
+    stop = true;
+    for (std::thread& th : readers)
+        th.join();
+    ministl::epoch_domain::instance().synchronize();
+    return ok && table.read()[n - 1].value == 300 && elem::live == static_cast<int>(n) &&
+           ministl::epoch_domain::instance().pending() == 0;
+}
+
+// readers 个线程各做 reads 次随机读取，同时一个写者不断发布新版本，返回全部读取完成的时间
+template <class Read, class Write>
+double rcu_read_time(size_t readers, size_t reads, Read read, Write write)
+{
+    std::atomic<size_t> running(readers);
+    ministl::test::timer t;
+    ministl::vector<std::thread> threads;
+    for (size_t r = 0; r < readers; ++r)
+    {
+        threads.push_back(std::thread([&running, &read, reads, r]() {
+            uint64_t sum = 0;
+            uint64_t x = 0x9E3779B97F4A7C15ull * (r + 1);
+            for (size_t i = 0; i < reads; ++i)
+            {
+                x ^= x << 13;
+                x ^= x >> 7;
+                x ^= x << 17;
+                sum += read(static_cast<size_t>(x));
+            }
+            ministl::test::do_not_optimize(sum);
+            running.fetch_sub(1);
+        }));
+    }
+    uint64_t version = 0;
+    while (running.load() != 0)
+    {
+        write(++version);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    for (std::thread& th : threads)
+        th.join();
+    return t.elapsed_ms();
+}
+
+void rcu_vector_test()
+{
+    std::cout << "[===============================================================]\n";
+    std::cout << "[-------------- Run container test : rcu_vector ----------------]\n";
+    std::cout << "[-------------------------- API test ---------------------------]\n";
+    ministl::rcu_vector<int> r1;
+    ministl::rcu_vector<int> r2{1, 2, 3};
+    EXPECT_TRUE(r1.size() == 0 && r2.size() == 3);
+    {
+        auto s = r2.read();
+        r2.push_back(4);
+        r2.set(0, 10);
+        // 快照不受之后修改的影响
+        EXPECT_TRUE(s.size() == 3 && s[0] == 1 && r2.size() == 4 && r2.read()[0] == 10);
+        FUN_VALUE(s->back());
+    }
+    r2.update([](ministl::vector<int>& v) { v.erase(v.begin()); });
+    ministl::vector<int> c = r2.copy();
+    EXPECT_TRUE(c.size() == 3 && c[0] == 2 && c[2] == 4);
+    r2.store(ministl::vector<int>(5, 7));
+    int sum = 0;
+    for (int x : r2.read())
+        sum += x;
+    EXPECT_TRUE(sum == 35);
+    bool thrown = false;
+    try
+    {
+        r2.set(5, 0);
+    }
+    catch (const std::out_of_range&)
+    {
+        thrown = true;
+    }
+    EXPECT_TRUE(thrown && r2.size() == 5);
+    {
+        // 嵌套的临界区
+        ministl::epoch_guard outer;
+        auto s1 = r2.read();
+        auto s2 = r2.read();
+        EXPECT_TRUE(&*s1 == &*s2);
+    }
+    EXPECT_TRUE(rcu_vector_consistent_ok());
+    FUN_VALUE(ministl::epoch_domain::instance().pending());
+
+#if PERFORMANCE_TEST_ON
+    std::cout << "[--------------------- Performance Testing ---------------------]\n";
+#if LARGER_TEST_DATA_ON
+    const size_t reads = 10000000;
+#else
+    const size_t reads = 1000000;
+#endif
+    const size_t table_size = 4096;
+    const size_t readers = rcu_reader_threads();
+    std::cout << " readers : " << readers << ", writer publishes a new table every 1 ms\n";
+    {
+        ministl::vector<uint64_t> table(table_size, 1);
+        std::mutex lock;
+        const double ms = rcu_read_time(readers, reads,
+            [&](size_t i) {
+                std::lock_guard<std::mutex> guard(lock);
+                return table[i % table_size];
+            },
+            [&](uint64_t version) {
+                ministl::vector<uint64_t> next(table_size, version);
+                std::lock_guard<std::mutex> guard(lock);
+                table.swap(next);
+            });
+        ministl::test::print_time("mutex + vector read", readers * reads, ms);
+    }
+    {
+        ministl::rcu_vector<uint64_t> table(ministl::vector<uint64_t>(table_size, 1));
+        const double ms = rcu_read_time(readers, reads,
+            [&](size_t i) { return table.read()[i % table_size]; },
+            [&](uint64_t version) { table.store(ministl::vector<uint64_t>(table_size, version)); });
+        ministl::test::print_time("rcu_vector read", readers * reads, ms);
+    }
+#endif
+    std::cout << "[-------------- End container test : rcu_vector ----------------]\n";
+}
+#endif //MINISTL_T_RCU_VECTOR_H
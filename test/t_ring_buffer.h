@@ -0,0 +1,307 @@
+#ifndef MINISTL_T_RING_BUFFER_H
+#define MINISTL_T_RING_BUFFER_H
+#include <condition_variable>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include "test.h"
+#include "t_concurrent_vector.h"
+#include "../ring_buffer.h"
+
+// 一个生产者交替单个与批量写入 0..n-1，消费者交替单个与批量读取，顺序不变
+bool ring_buffer_spsc_ok(size_t n)
+{
+    ministl::ring_buffer<uint64_t> rb(64);
+    bool ok = true;
+    std::thread producer([&rb, n]() {
+        uint64_t batch[37];
+        for (uint64_t i = 0; i < n; )
+        {
+            if (i % 3 == 0)
+            {
+                rb.push(i++);
+                continue;
+            }
+            const size_t k = static_cast<size_t>(ministl::min(static_cast<uint64_t>(37), n - i));
+            for (size_t j = 0; j < k; ++j)
+                batch[j] = i + j;
+            rb.push_n(batch, k);
+            i += k;
+        }
+    });
+    uint64_t expected = 0;
+    uint64_t out[29];
+    while (expected < n)
+    {
+        if (expected % 2 == 0)
+        {
+            uint64_t x = 0;
+            rb.pop(x);
+            ok = ok && x == expected++;
+            continue;
+        }
+        const size_t k = rb.pop_n(out, 29);
+        for (size_t j = 0; j < k; ++j)
+            ok = ok && out[j] == expected++;
+    }
+    producer.join();
+    return ok && rb.empty();
+}
+
+// 多个生产者写入 (线程号, 序号)，部分以批量写入；每个生产者的元素全部出现且按序号递增
+bool ring_buffer_mpsc_ok(size_t per_thread)
+{
+    const size_t producers = concurrent_producer_threads();
+    ministl::ring_buffer<uint64_t, ministl::ring_mpsc> rb(256);
+    ministl::vector<std::thread> threads;
+    for (size_t t = 0; t < producers; ++t)
+    {
+        threads.push_back(std::thread([&rb, t, per_thread]() {
+            uint64_t batch[16];
+            for (size_t s = 0; s < per_thread; )
+            {
+                if (s % 5 != 0)
+                {
+                    rb.push((static_cast<uint64_t>(t) << 32) | s++);
+                    continue;
+                }
+                const size_t k = ministl::min(static_cast<size_t>(16), per_thread - s);
+                for (size_t j = 0; j < k; ++j)
+                    batch[j] = (static_cast<uint64_t>(t) << 32) | (s + j);
+                rb.push_n(batch, k);
+                s += k;
+            }
+        }));
+    }
+    ministl::vector<uint64_t> next(producers, 0);
+    bool ok = true;
+    uint64_t out[64];
+    for (size_t total = 0; total < producers * per_thread; )
+    {
+        const size_t k = rb.pop_n(out, 64);
+        for (size_t j = 0; j < k; ++j)
+        {
+            const size_t t = static_cast<size_t>(out[j] >> 32);
+            ok = ok && t < producers && (out[j] & 0xFFFFFFFFu) == next[t]++;
+        }
+        total += k;
+    }
+    for (std::thread& th : threads)
+        th.join();
+    return ok && rb.empty();
+}
+
+void ring_buffer_test()
+{
+    std::cout << "[===============================================================]\n";
+    std::cout << "[------------- Run container test : ring_buffer ----------------]\n";
+    std::cout << "[-------------------------- API test ---------------------------]\n";
+    ministl::ring_buffer<int> r1(5);
+    EXPECT_TRUE(r1.capacity() == 8 && r1.empty());
+    for (int i = 0; i < 8; ++i)
+        EXPECT_TRUE(r1.try_push(i));
+    EXPECT_TRUE(r1.full() && !r1.try_push(8));
+    int x = -1;
+    EXPECT_TRUE(r1.try_pop(x) && x == 0 && r1.size() == 7);
+    // 批量写入与读取跨越环的边界
+    int in[] = {10, 11, 12, 13};
+    int out[8] = {0};
+    EXPECT_TRUE(r1.try_push_n(in, 4) == 1 && r1.full());
+    EXPECT_TRUE(r1.try_pop_n(out, 5) == 5 && out[0] == 1 && out[4] == 5);
+    EXPECT_TRUE(r1.try_push_n(in + 1, 3) == 3 && r1.size() == 6);
+    EXPECT_TRUE(r1.try_pop_n(out, 8) == 6 && out[0] == 6 && out[2] == 10 && out[5] == 13 && r1.empty());
+    EXPECT_TRUE(!r1.try_pop(x) && r1.try_pop_n(out, 8) == 0);
+    FUN_VALUE(ministl::ring_buffer<int>::max_capacity());
+    {
+        ministl::ring_buffer<std::string, ministl::ring_mpsc> r2(4);
+        EXPECT_TRUE(r2.try_emplace(40, 'a') && r2.try_push(std::string("b")));
+        std::string strs[] = {"c", "d", "e"};
+        EXPECT_TRUE(r2.try_push_n(strs, 3) == 2 && r2.full());
+        std::string s;
+        EXPECT_TRUE(r2.try_pop(s) && s == std::string(40, 'a'));
+        std::string got[4];
+        EXPECT_TRUE(r2.try_pop_n(got, 4) == 3 && got[0] == "b" && got[2] == "d" && r2.empty());
+    }
+    {
+        // 跨越环的边界批量写入时复制失败，队列不变；析构时释放剩余元素
+        typedef ministl::test::counted<ministl::test::throw_on_copy> elem;
+        ministl::ring_buffer<elem> r3(4);
+        r3.push(elem(1));
+        r3.push(elem(2));
+        r3.push(elem(3));
+        elem first;
+        EXPECT_TRUE(r3.try_pop(first) && first.value == 1);
+        elem src[] = {elem(4), elem(-1)};
+        bool thrown = false;
+        try
+        {
+            r3.try_push_n(src, 2);
+        }
+        catch (const std::runtime_error&)
+        {
+            thrown = true;
+        }
+        EXPECT_TRUE(thrown && r3.size() == 2 && elem::live == 5);
+        ministl::ring_buffer<elem, ministl::ring_mpsc> r4(4);
+        EXPECT_TRUE(r4.try_push_n(src, 1) == 1);
+        thrown = false;
+        try
+        {
+            r4.try_push(src[1]);
+        }
+        catch (const std::runtime_error&)
+        {
+            thrown = true;
+        }
+        EXPECT_TRUE(thrown && r4.size() == 1 && elem::live == 6);
+    }
+    EXPECT_TRUE(ministl::test::counted<ministl::test::throw_on_copy>::live == 0);
+    {
+        // 堆上分配的 ring_buffer 同样按 64 字节对齐
+        bool aligned = true;
+        ministl::vector<ministl::ring_buffer<int>*> heap;
+        for (int i = 0; i < 16; ++i)
+        {
+            heap.push_back(new ministl::ring_buffer<int>(8));
+            aligned = aligned && reinterpret_cast<uintptr_t>(heap.back()) % 64 == 0;
+        }
+        ministl::ring_buffer<int, ministl::ring_mpsc>* arr = new ministl::ring_buffer<int, ministl::ring_mpsc>[0];
+        delete[] arr;
+        for (ministl::ring_buffer<int>* p : heap)
+            delete p;
+        EXPECT_TRUE(aligned);
+    }
+    EXPECT_TRUE(ring_buffer_spsc_ok(200000));
+    EXPECT_TRUE(ring_buffer_mpsc_ok(20000));
+
+#if PERFORMANCE_TEST_ON
+    std::cout << "[--------------------- Performance Testing ---------------------]\n";
+#if LARGER_TEST_DATA_ON
+    const size_t n = 100000000;
+#else
+    const size_t n = 10000000;
+#endif
+    const size_t batch = 64;
+    std::cout << " one producer hands " << n << " uint64 to one consumer, batch = " << batch << "\n";
+    {
+        // 生产者攒满一批后加锁追加，消费者等待条件变量后整体换出
+        ministl::vector<uint64_t> shared;
+        std::mutex lock;
+        std::condition_variable cv;
+        bool done = false;
+        ministl::test::timer t;
+        std::thread producer([&]() {
+            ministl::vector<uint64_t> local;
+            for (uint64_t i = 0; i < n; i += batch)
+            {
+                local.clear();
+                for (uint64_t j = i; j < i + batch && j < n; ++j)
+                    local.push_back(j);
+                {
+                    std::lock_guard<std::mutex> guard(lock);
+                    shared.insert(shared.end(), local.begin(), local.end());
+                }
+                cv.notify_one();
+            }
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                done = true;
+            }
+            cv.notify_one();
+        });
+        uint64_t sum = 0;
+        ministl::vector<uint64_t> taken;
+        for (;;)
+        {
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                cv.wait(guard, [&]() { return done || !shared.empty(); });
+                if (shared.empty() && done)
+                    break;
+                taken.swap(shared);
+            }
+            for (uint64_t v : taken)
+                sum += v;
+            taken.clear();
+        }
+        producer.join();
+        ministl::test::print_time("mutex + condvar + vector", n, t.elapsed_ms());
+        EXPECT_TRUE(sum == static_cast<uint64_t>(n) * (n - 1) / 2);
+    }
+    {
+        ministl::ring_buffer<uint64_t> rb(4096);
+        ministl::test::timer t;
+        std::thread producer([&rb, n]() {
+            for (uint64_t i = 0; i < n; ++i)
+                rb.push(i);
+        });
+        uint64_t sum = 0;
+        for (size_t i = 0; i < n; ++i)
+        {
+            uint64_t v = 0;
+            rb.pop(v);
+            sum += v;
+        }
+        producer.join();
+        ministl::test::print_time("ring_buffer<spsc> push / pop", n, t.elapsed_ms());
+        EXPECT_TRUE(sum == static_cast<uint64_t>(n) * (n - 1) / 2);
+    }
+    {
+        ministl::ring_buffer<uint64_t> rb(4096);
+        ministl::test::timer t;
+        std::thread producer([&rb, n, batch]() {
+            ministl::vector<uint64_t> local(batch);
+            for (uint64_t i = 0; i < n; i += batch)
+            {
+                const size_t k = static_cast<size_t>(ministl::min(static_cast<uint64_t>(batch), n - i));
+                for (size_t j = 0; j < k; ++j)
+                    local[j] = i + j;
+                rb.push_n(local.data(), k);
+            }
+        });
+        uint64_t sum = 0;
+        ministl::vector<uint64_t> taken(batch);
+        for (size_t got = 0; got < n; )
+        {
+            const size_t k = rb.pop_n(taken.data(), batch);
+            for (size_t j = 0; j < k; ++j)
+                sum += taken[j];
+            got += k;
+        }
+        producer.join();
+        ministl::test::print_time("ring_buffer<spsc> push_n / pop_n", n, t.elapsed_ms());
+        EXPECT_TRUE(sum == static_cast<uint64_t>(n) * (n - 1) / 2);
+    }
+    {
+        ministl::ring_buffer<uint64_t, ministl::ring_mpsc> rb(4096);
+        ministl::test::timer t;
+        std::thread producer([&rb, n, batch]() {
+            ministl::vector<uint64_t> local(batch);
+            for (uint64_t i = 0; i < n; i += batch)
+            {
+                const size_t k = static_cast<size_t>(ministl::min(static_cast<uint64_t>(batch), n - i));
+                for (size_t j = 0; j < k; ++j)
+                    local[j] = i + j;
+                rb.push_n(local.data(), k);
+            }
+        });
+        uint64_t sum = 0;
+        ministl::vector<uint64_t> taken(batch);
+        for (size_t got = 0; got < n; )
+        {
+            const size_t k = rb.pop_n(taken.data(), batch);
+            for (size_t j = 0; j < k; ++j)
+                sum += taken[j];
+            got += k;
+        }
+        producer.join();
+        ministl::test::print_time("ring_buffer<mpsc> push_n / pop_n", n, t.elapsed_ms());
+        EXPECT_TRUE(sum == static_cast<uint64_t>(n) * (n - 1) / 2);
+    }
+#endif
+    std::cout << "[------------- End container test : ring_buffer ----------------]\n";
+}
+#endif //MINISTL_T_RING_BUFFER_H
@@ -0,0 +1,197 @@
+#ifndef MINISTL_T_SHARDED_COLLECTOR_H
+#define MINISTL_T_SHARDED_COLLECTOR_H
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include "test.h"
+#include "t_concurrent_vector.h"
+#include "../sharded_collector.h"
+
+// 各线程追加 (线程号, 序号)，合并后每个线程的元素各出现一次，连续且保持追加顺序
+bool sharded_collector_merge_ok(size_t per_thread)
+{
+    const size_t producers = concurrent_producer_threads();
+    ministl::sharded_collector<uint64_t> collector;
+    ministl::vector<std::thread> threads;
+    for (size_t t = 0; t < producers; ++t)
+    {
+        threads.push_back(std::thread([&collector, t, per_thread]() {
+            for (size_t s = 0; s < per_thread; ++s)
+                collector.push_back((static_cast<uint64_t>(t) << 32) | s);
+        }));
+    }
+    for (std::thread& th : threads)
+        th.join();
+    if (collector.shard_count() != producers || collector.size() != producers * per_thread)
+        return false;
+    ministl::vector<uint64_t> merged = collector.merge();
+    if (merged.size() != producers * per_thread || !collector.empty())
+        return false;
+    ministl::vector<char> seen(producers, 0);
+    for (size_t i = 0; i < merged.size(); i += per_thread)
+    {
+        const size_t t = static_cast<size_t>(merged[i] >> 32);
+        if (t >= producers || seen[t])
+            return false;
+        seen[t] = 1;
+        for (size_t s = 0; s < per_thread; ++s)
+        {
+            if (merged[i + s] != ((static_cast<uint64_t>(t) << 32) | s))
+                return false;
+        }
+    }
+    return true;
+}
+
+void sharded_collector_test()
+{
+    std::cout << "[===============================================================]\n";
+    std::cout << "[----------- Run container test : sharded_collector ------------]\n";
+    std::cout << "[-------------------------- API test ---------------------------]\n";
+    ministl::sharded_collector<int> c1;
+    EXPECT_TRUE(c1.empty() && c1.shard_count() == 0 && c1.merge().empty());
+    c1.push_back(1);
+    c1.emplace_back(2);
+    int values[] = {3, 4, 5};
+    c1.append(values, values + 3);
+    c1.local().push_back(6);
+    EXPECT_TRUE(c1.shard_count() == 1 && c1.size() == 6);
+    {
+        // 同一线程交替写两个收集器
+        ministl::sharded_collector<int> c2;
+        for (int i = 0; i < 100; ++i)
+        {
+            c1.push_back(100 + i);
+            c2.push_back(i);
+        }
+        EXPECT_TRUE(c1.shard_count() == 1 && c2.shard_count() == 1 && c2.size() == 100);
+    }
+    std::thread([&c1]() { c1.push_back(-1); }).join();
+    EXPECT_TRUE(c1.shard_count() == 2 && c1.size() == 107);
+    ministl::vector<int> out{0};
+    c1.merge_into(out);
+    EXPECT_TRUE(out.size() == 108 && out[0] == 0 && out[1] == 1 && out[6] == 6 && out[7] == 100 &&
+                out[106] == 199 && out[107] == -1 && c1.empty());
+    FUN_VALUE(out.capacity());
+    c1.push_back(7);
+    EXPECT_TRUE(c1.merge() == ministl::vector<int>{7});
+    {
+        // 非平凡类型，分片足够大时并行移动
+        ministl::sharded_collector<std::string> cs;
+        std::thread([&cs]() {
+            for (int i = 0; i < (1 << 17); ++i)
+                cs.emplace_back(40, 'a');
+        }).join();
+        for (int i = 0; i < (1 << 17); ++i)
+            cs.emplace_back(40, 'b');
+        ministl::vector<std::string> v = cs.merge();
+        EXPECT_TRUE(v.size() == (1 << 18) && v.front() == std::string(40, 'a') && v.back() == std::string(40, 'b'));
+    }
+    {
+        // 移动失败时结果不变，已构造的元素全部析构
+        typedef ministl::test::counted<ministl::test::throw_on_move> elem;
+        ministl::sharded_collector<elem> ct;
+        for (int i = 0; i < 10; ++i)
+            ct.emplace_back(i == 6 ? -1 : i);
+        ministl::vector<elem> dst(2);
+        bool thrown = false;
+        try
+        {
+            ct.merge_into(dst);
+        }
+        catch (const std::runtime_error&)
+        {
+            thrown = true;
+        }
+        EXPECT_TRUE(thrown && dst.size() == 2 && ct.size() == 10 && elem::live == 12);
+    }
+    EXPECT_TRUE(ministl::test::counted<ministl::test::throw_on_move>::live == 0);
+    {
+        // 多轮合并到同一个 vector，容量按几何级数增长
+        ministl::sharded_collector<int> cr;
+        ministl::vector<int> acc;
+        size_t reallocs = 0;
+        for (int round = 0; round < 1000; ++round)
+        {
+            cr.push_back(round);
+            const size_t cap = acc.capacity();
+            cr.merge_into(acc);
+            reallocs += acc.capacity() != cap;
+        }
+        EXPECT_TRUE(acc.size() == 1000 && acc[999] == 999 && reallocs < 20);
+    }
+    EXPECT_TRUE(sharded_collector_merge_ok(20000));
+
+#if PERFORMANCE_TEST_ON
+    std::cout << "[--------------------- Performance Testing ---------------------]\n";
+#if LARGER_TEST_DATA_ON
+    const size_t per_thread = 10000000;
+#else
+    const size_t per_thread = 1000000;
+#endif
+    const size_t producers = concurrent_producer_threads();
+    std::cout << " producers : " << producers << ", time includes producing one contiguous vector\n";
+    {
+        ministl::vector<uint64_t> locked;
+        std::mutex lock;
+        ministl::test::timer t;
+        ministl::vector<std::thread> threads;
+        for (size_t r = 0; r < producers; ++r)
+        {
+            threads.push_back(std::thread([&locked, &lock, per_thread, r]() {
+                for (size_t i = 0; i < per_thread; ++i)
+                {
+                    std::lock_guard<std::mutex> guard(lock);
+                    locked.push_back(r * per_thread + i);
+                }
+            }));
+        }
+        for (std::thread& th : threads)
+            th.join();
+        ministl::test::print_time("mutex + vector push_back", producers * per_thread, t.elapsed_ms());
+        EXPECT_TRUE(locked.size() == producers * per_thread);
+    }
+    {
+        ministl::concurrent_vector<uint64_t> cv;
+        ministl::test::timer t;
+        ministl::vector<std::thread> threads;
+        for (size_t r = 0; r < producers; ++r)
+        {
+            threads.push_back(std::thread([&cv, per_thread, r]() {
+                for (size_t i = 0; i < per_thread; ++i)
+                    cv.push_back(r * per_thread + i);
+            }));
+        }
+        for (std::thread& th : threads)
+            th.join();
+        ministl::vector<uint64_t> v = cv.to_vector();
+        ministl::test::print_time("concurrent_vector + to_vector", producers * per_thread, t.elapsed_ms());
+        EXPECT_TRUE(v.size() == producers * per_thread);
+    }
+    {
+        ministl::sharded_collector<uint64_t> collector;
+        ministl::test::timer t;
+        ministl::vector<std::thread> threads;
+        for (size_t r = 0; r < producers; ++r)
+        {
+            threads.push_back(std::thread([&collector, per_thread, r]() {
+                for (size_t i = 0; i < per_thread; ++i)
+                    collector.push_back(r * per_thread + i);
+            }));
+        }
+        for (std::thread& th : threads)
+            th.join();
+        const double collect_ms = t.elapsed_ms();
+        ministl::vector<uint64_t> v = collector.merge();
+        const double total_ms = t.elapsed_ms();
+        ministl::test::print_time("sharded_collector + merge", producers * per_thread, total_ms);
+        ministl::test::print_time("sharded_collector merge only", producers * per_thread, total_ms - collect_ms);
+        EXPECT_TRUE(v.size() == producers * per_thread);
+    }
+#endif
+    std::cout << "[----------- End container test : sharded_collector ------------]\n";
+}
+#endif //MINISTL_T_SHARDED_COLLECTOR_H
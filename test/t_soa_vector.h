@@ -0,0 +1,214 @@
+#ifndef MINISTL_T_SOA_VECTOR_H
+#define MINISTL_T_SOA_VECTOR_H
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include "test.h"
+#include "../soa_vector.h"
+
+// 64 字节的实体记录，扫描时通常只读其中一两个字段
+struct entity_record
+{
+    double   x, y, z;
+    double   vx, vy, vz;
+    uint64_t id;
+    uint32_t flags;
+    float    mass;
+};
+
+typedef ministl::soa_vector<double, double, double, double, double, double, uint64_t, uint32_t, float> entity_columns;
+
+void soa_vector_test()
+{
+    std::cout << "[===============================================================]\n";
+    std::cout << "[-------------- Run container test : soa_vector ----------------]\n";
+    std::cout << "[-------------------------- API test ---------------------------]\n";
+    typedef ministl::soa_vector<int, std::string, double> table;
+    typedef std::tuple<int, std::string, double> row;
+
+    table t1;
+    table t2{row(1, "a", 1.5), row(2, "b", 2.5)};
+    table t3(3, row(7, "x", 0.5));
+    EXPECT_TRUE(t1.empty() && t2.size() == 2 && t3.size() == 3 && t3[2].get<1>() == "x");
+    t1.push_back(row(3, "c", 3.5));
+    t1.emplace_back(4, "dd", 4.5);
+    t1.emplace_back(5, std::string(3, 'e'), 5.5);
+    FUN_VALUE(t1.capacity());
+    EXPECT_TRUE(t1.size() == 3 && t1.front().get<0>() == 3 && t1.back().get<1>() == "eee");
+    EXPECT_TRUE(t1.column<0>().size() == 3 && t1.column<2>()[1] == 4.5 && t1.data<1>()[1] == "dd");
+    EXPECT_TRUE(reinterpret_cast<uintptr_t>(t1.data<2>()) % 64 == 0);
+    t1[0].get<1>() = "C";
+    t1[1] = row(40, "DD", 40.5);
+    row r = t1[1];
+    EXPECT_TRUE(std::get<0>(r) == 40 && std::get<1>(r) == "DD" && t1.at(0).get<1>() == "C");
+    for (auto& v : t1.column<0>())
+        v *= 10;
+    EXPECT_TRUE(t1[0].get<0>() == 30 && t1[2].get<0>() == 50);
+    int sum = 0;
+    for (auto it = t1.begin(); it != t1.end(); ++it)
+        sum += (*it).get<0>();
+    EXPECT_TRUE(sum == 30 + 400 + 50 && t1.end() - t1.begin() == 3);
+    for (auto first = t1.begin(), last = t1.end(); first < --last; ++first)
+        swap(*first, *last);
+    EXPECT_TRUE(t1[0].get<1>() == "eee" && t1[2].get<1>() == "C" && t1[2].get<2>() == 3.5);
+    swap(t1[0], t1[2]);
+    EXPECT_TRUE(t1[0].get<1>() == "C" && t1[2].get<0>() == 50);
+    t1.erase(t1.begin() + 1);
+    EXPECT_TRUE(t1.size() == 2 && t1[1].get<1>() == "eee");
+    table t4(t1);
+    EXPECT_TRUE(t4 == t1 && t4 != t2);
+    t4.pop_back();
+    t4.resize(3);
+    EXPECT_TRUE(t4.size() == 3 && t4[2].get<1>().empty() && t4[0].get<1>() == "C");
+    t4.shrink_to_fit();
+    EXPECT_TRUE(t4.capacity() == 3 && t4[0].get<0>() == 30);
+    ministl::swap(t4, t3);
+    EXPECT_TRUE(t4.size() == 3 && t4[0].get<1>() == "x" && t3[0].get<1>() == "C");
+    t3 = ministl::move(t2);
+    EXPECT_TRUE(t3.size() == 2 && t2.empty());
+    const table& ct3 = t3;
+    EXPECT_TRUE(ct3[1].get<1>() == "b" && ct3.column<0>().back() == 2 && (*ct3.begin()).get<2>() == 1.5);
+    bool thrown = false;
+    try
+    {
+        ct3.at(5);
+    }
+    catch (const std::out_of_range&)
+    {
+        thrown = true;
+    }
+    EXPECT_TRUE(thrown);
+    t3.clear();
+    EXPECT_TRUE(t3.empty() && t3.begin() == t3.end());
+
+    // 扩容时移动可能抛出异常的列改为复制，复制失败时原有元素不变
+    {
+        typedef ministl::test::counted<ministl::test::throw_on_move> move_throws;
+        ministl::soa_vector<int, move_throws> s1;
+        s1.reserve(2);
+        s1.emplace_back(1, 1);
+        s1.emplace_back(2, -1);
+        s1.emplace_back(3, 3);
+        EXPECT_TRUE(s1.size() == 3 && s1[1].get<1>().value == -1 && move_throws::live == 3);
+
+        typedef ministl::test::counted<ministl::test::throw_on_move | ministl::test::throw_on_copy> both_throw;
+        ministl::soa_vector<int, both_throw> s2;
+        s2.reserve(2);
+        s2.emplace_back(1, 1);
+        s2.emplace_back(2, -1);
+        thrown = false;
+        try
+        {
+            s2.emplace_back(3, 3);
+        }
+        catch (const std::runtime_error&)
+        {
+            thrown = true;
+        }
+        EXPECT_TRUE(thrown && s2.size() == 2 && s2.capacity() == 2 && s2[0].get<0>() == 1 &&
+                    s2[1].get<1>().value == -1 && both_throw::live == 2);
+
+        // 复制的列失败时，移动不抛出异常的非平凡列还没有被移走
+        ministl::soa_vector<std::string, both_throw> s3;
+        s3.reserve(2);
+        s3.emplace_back(std::string(40, 'a'), 1);
+        s3.emplace_back(std::string(40, 'b'), -1);
+        thrown = false;
+        try
+        {
+            s3.emplace_back(std::string(40, 'c'), 3);
+        }
+        catch (const std::runtime_error&)
+        {
+            thrown = true;
+        }
+        EXPECT_TRUE(thrown && s3.size() == 2 && s3[0].get<0>() == std::string(40, 'a') &&
+                    s3[1].get<0>() == std::string(40, 'b') && both_throw::live == 4);
+    }
+    EXPECT_TRUE(ministl::test::counted<ministl::test::throw_on_move>::live == 0);
+
+    // 大量插入后各列保持一致
+    {
+        ministl::soa_vector<uint32_t, uint64_t> big;
+        for (uint32_t i = 0; i < 100000; ++i)
+            big.emplace_back(i, static_cast<uint64_t>(i) * i);
+        bool ok = big.size() == 100000;
+        for (uint32_t i = 0; i < 100000 && ok; i += 997)
+            ok = big[i].get<0>() == i && big[i].get<1>() == static_cast<uint64_t>(i) * i;
+        EXPECT_TRUE(ok);
+    }
+
+#if PERFORMANCE_TEST_ON
+    std::cout << "[--------------------- Performance Testing ---------------------]\n";
+#if LARGER_TEST_DATA_ON
+    const size_t len = 16000000;
+#else
+    const size_t len = 4000000;
+#endif
+    std::mt19937_64 rng(41);
+    ministl::vector<entity_record> aos;
+    entity_columns soa;
+    aos.reserve(len);
+    soa.reserve(len);
+    for (size_t i = 0; i < len; ++i)
+    {
+        const entity_record e = {static_cast<double>(rng() % 1000), 1.0, 2.0, static_cast<double>(rng() % 7), 0.5, 0.25,
+                                 i, static_cast<uint32_t>(rng() % 4), 1.0f};
+        aos.push_back(e);
+        soa.emplace_back(e.x, e.y, e.z, e.vx, e.vy, e.vz, e.id, e.flags, e.mass);
+    }
+    // 只读一个字段
+    {
+        ministl::test::timer t;
+        double s = 0;
+        for (size_t i = 0; i < len; ++i)
+            s += aos[i].x;
+        ministl::test::print_time("AoS sum x", len, t.elapsed_ms());
+        ministl::test::timer t2;
+        double s2 = 0;
+        for (double x : soa.column<0>())
+            s2 += x;
+        ministl::test::print_time("SoA column<0> sum x", len, t2.elapsed_ms());
+        ministl::test::timer t3;
+        double s3 = 0;
+        for (auto it = soa.begin(); it != soa.end(); ++it)
+            s3 += (*it).get<0>();
+        ministl::test::print_time("SoA zip iterator sum x", len, t3.elapsed_ms());
+        EXPECT_TRUE(s == s2 && s == s3);
+    }
+    // 读两个字段写一个字段：x += vx
+    {
+        ministl::test::timer t;
+        for (size_t i = 0; i < len; ++i)
+            aos[i].x += aos[i].vx;
+        ministl::test::print_time("AoS x += vx", len, t.elapsed_ms());
+        ministl::test::timer t2;
+        double* x = soa.data<0>();
+        const double* vx = soa.data<3>();
+        for (size_t i = 0; i < len; ++i)
+            x[i] += vx[i];
+        ministl::test::print_time("SoA x += vx", len, t2.elapsed_ms());
+        EXPECT_TRUE(aos[len / 2].x == soa[len / 2].get<0>());
+    }
+    // 按条件统计：flags == 0 的个数
+    {
+        ministl::test::timer t;
+        size_t n = 0;
+        for (size_t i = 0; i < len; ++i)
+            n += aos[i].flags == 0;
+        ministl::test::print_time("AoS count flags", len, t.elapsed_ms());
+        ministl::test::timer t2;
+        size_t n2 = 0;
+        for (uint32_t f : soa.column<7>())
+            n2 += f == 0;
+        ministl::test::print_time("SoA count flags", len, t2.elapsed_ms());
+        EXPECT_TRUE(n == n2);
+    }
+#endif
+    std::cout << "[-------------- End container test : soa_vector ----------------]\n";
+}
+#endif //MINISTL_T_SOA_VECTOR_H
@@ -0,0 +1,240 @@
+#ifndef MINISTL_T_SORT_H
+#define MINISTL_T_SORT_H
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include "test.h"
+#include "../vector.h"
+#include "../algo.h"
+
+// 定长键类型：只按 id 排序
+struct sort_record
+{
+    uint32_t id;
+    uint32_t payload;
+};
+
+namespace ministl
+{
+    template <>
+    struct radix_traits<sort_record>
+    {
+        static constexpr bool value = true;
+        typedef uint32_t key_type;
+        static key_type key(const sort_record& r) noexcept { return r.id; }
+    };
+}
+
+// 检查 ministl::sort 与 std::sort 的结果一致
+template <class T, class Compared>
+bool sort_matches_std(ministl::vector<T> v, Compared comp)
+{
+    std::vector<T> expected(v.begin(), v.end());
+    std::sort(expected.begin(), expected.end(), comp);
+    ministl::sort(v.begin(), v.end(), comp);
+    return v.size() == expected.size() && std::equal(expected.begin(), expected.end(), v.begin());
+}
+
+template <class T>
+bool sort_matches_std(ministl::vector<T> v)
+{
+    std::vector<T> expected(v.begin(), v.end());
+    std::sort(expected.begin(), expected.end());
+    ministl::sort(v.begin(), v.end());
+    return v.size() == expected.size() && std::equal(expected.begin(), expected.end(), v.begin());
+}
+
+template <class T, class Gen>
+void sort_time(const std::string& name, size_t n, Gen gen)
+{
+    ministl::vector<T> v(n, T());
+    for (size_t i = 0; i < n; ++i)
+        v[i] = gen();
+    ministl::vector<T> w(v);
+    ministl::vector<T> r(v);
+    {
+        ministl::test::timer t;
+        std::sort(v.begin(), v.end());
+        ministl::test::print_time("std::sort " + name, n, t.elapsed_ms());
+    }
+    {
+        ministl::test::timer t;
+        ministl::sort(w.begin(), w.end(), ministl::less<T>());
+        ministl::test::print_time("introsort " + name, n, t.elapsed_ms());
+    }
+    {
+        ministl::test::timer t;
+        ministl::sort(r.begin(), r.end());
+        ministl::test::print_time("ministl::sort " + name, n, t.elapsed_ms());
+    }
+    EXPECT_TRUE(v == w && v == r);
+}
+
+void sort_test()
+{
+    std::cout << "[===============================================================]\n";
+    std::cout << "[------------------ Run algorithm test : sort ------------------]\n";
+    std::cout << "[-------------------------- API test ---------------------------]\n";
+    std::mt19937_64 rng(20261018);
+    const size_t n = 100003;
+
+    // 各种输入分布，既走 introsort 也走基数排序
+    {
+        ministl::vector<int> random(n, 0), sorted(n, 0), reversed(n, 0), equal(n, 7), few(n, 0), organ(n, 0);
+        for (size_t i = 0; i < n; ++i)
+        {
+            random[i] = static_cast<int>(rng());
+            sorted[i] = static_cast<int>(i);
+            reversed[i] = static_cast<int>(n - i);
+            few[i] = static_cast<int>(rng() % 4) - 2;
+            organ[i] = static_cast<int>(i < n / 2 ? i : n - i);
+        }
+        const ministl::vector<int>* inputs[] = {&random, &sorted, &reversed, &equal, &few, &organ};
+        for (const ministl::vector<int>* in : inputs)
+        {
+            EXPECT_TRUE(sort_matches_std(*in));
+            EXPECT_TRUE(sort_matches_std(*in, ministl::less<int>()));
+            EXPECT_TRUE(sort_matches_std(*in, ministl::greater<int>()));
+        }
+        for (size_t len = 0; len < 40; ++len)
+            EXPECT_TRUE(sort_matches_std(ministl::vector<int>(random.begin(), random.begin() + len)));
+    }
+    {
+        ministl::vector<double> d(n, 0.0);
+        ministl::vector<int64_t> i64(n, 0);
+        ministl::vector<unsigned char> bytes(n, 0);
+        for (size_t i = 0; i < n; ++i)
+        {
+            d[i] = static_cast<double>(static_cast<int64_t>(rng())) / 1e6;
+            i64[i] = static_cast<int64_t>(rng());
+            bytes[i] = static_cast<unsigned char>(rng());
+        }
+        d[5] = -0.0;
+        d[6] = 0.0;
+        EXPECT_TRUE(sort_matches_std(d));
+        EXPECT_TRUE(sort_matches_std(i64));
+        EXPECT_TRUE(sort_matches_std(bytes));
+        // 抽样只覆盖低位字节，少数未被抽到的键在高位字节上不同
+        ministl::vector<uint64_t> narrow(n, 0);
+        for (size_t i = 0; i < n; ++i)
+            narrow[i] = rng() % 65536;
+        EXPECT_TRUE(sort_matches_std(narrow));
+        narrow[1] = ~static_cast<uint64_t>(0);
+        narrow[n - 2] = static_cast<uint64_t>(1) << 40;
+        EXPECT_TRUE(sort_matches_std(narrow));
+        ministl::vector<std::string> s(5000, std::string());
+        for (size_t i = 0; i < s.size(); ++i)
+            s[i] = std::to_string(rng() % 1000);
+        EXPECT_TRUE(sort_matches_std(s, ministl::less<std::string>()));
+    }
+
+    // 用户特化 radix_traits 的定长键：基数排序是稳定的
+    {
+        ministl::vector<sort_record> recs(n, sort_record());
+        for (size_t i = 0; i < n; ++i)
+            recs[i] = sort_record{static_cast<uint32_t>(rng() % 1000), static_cast<uint32_t>(i)};
+        ministl::sort(recs.begin(), recs.end());
+        bool ok = true;
+        for (size_t i = 1; i < n; ++i)
+            ok = ok && (recs[i - 1].id < recs[i].id ||
+                        (recs[i - 1].id == recs[i].id && recs[i - 1].payload < recs[i].payload));
+        EXPECT_TRUE(ok);
+    }
+
+    // stable_sort：缓冲区充足、不足与没有缓冲区时都保持相等元素的原有顺序
+    {
+        typedef ministl::pair<int, int> item;
+        auto by_key = [](const item& a, const item& b) { return a.first < b.first; };
+        ministl::vector<item> items(n, item(0, 0));
+        for (size_t i = 0; i < n; ++i)
+            items[i] = item(static_cast<int>(rng() % 100), static_cast<int>(i));
+        auto stable = [](const ministl::vector<item>& v) {
+            for (size_t i = 1; i < v.size(); ++i)
+            {
+                if (v[i].first < v[i - 1].first ||
+                    (v[i].first == v[i - 1].first && v[i].second < v[i - 1].second))
+                    return false;
+            }
+            return true;
+        };
+        ministl::vector<item> a(items), b(items), c(items);
+        ministl::stable_sort(a.begin(), a.end(), by_key);
+        EXPECT_TRUE(stable(a));
+        item small_buffer[97];
+        ministl::stable_sort_adaptive(b.begin(), b.end(), small_buffer, static_cast<ptrdiff_t>(97), by_key);
+        EXPECT_TRUE(stable(b) && a == b);
+        ministl::stable_sort_adaptive(c.begin(), c.begin() + 20000, static_cast<item*>(nullptr),
+                                      static_cast<ptrdiff_t>(0), by_key);
+        EXPECT_TRUE(stable(ministl::vector<item>(c.begin(), c.begin() + 20000)));
+        // 非平凡类型：归并时不能对元素做自我移动赋值
+        ministl::vector<std::string> s(1000, std::string());
+        for (size_t i = 0; i < s.size(); ++i)
+            s[i] = std::string(1, static_cast<char>('a' + rng() % 26));
+        ministl::vector<std::string> t(s);
+        std::sort(t.begin(), t.end());
+        ministl::stable_sort(s.begin(), s.end());
+        EXPECT_TRUE(s == t);
+    }
+
+    // radix_sort 与 stable_sort 的缓冲区不再截断到 INT_MAX 字节，超过约 5 亿个 4 字节键时仍走基数排序；
+    // 只申请不写入，不占用物理内存
+    {
+        const ptrdiff_t big = static_cast<ptrdiff_t>(INT_MAX / sizeof(uint32_t)) + 1;
+        ministl::pair<uint32_t*, ptrdiff_t> buf = ministl::get_temporary_buffer<uint32_t>(big);
+        EXPECT_TRUE(buf.first != nullptr && buf.second == big);
+        ministl::release_temporary_buffer(buf.first);
+    }
+
+    // heap 算法
+    {
+        ministl::vector<int> h{3, 1, 4, 1, 5, 9, 2, 6, 5, 3, 5};
+        ministl::make_heap(h.begin(), h.end());
+        EXPECT_TRUE(h[0] == 9);
+        h.push_back(10);
+        ministl::push_heap(h.begin(), h.end());
+        EXPECT_TRUE(h[0] == 10);
+        ministl::pop_heap(h.begin(), h.end());
+        EXPECT_TRUE(h.back() == 10 && h[0] == 9);
+        ministl::sort_heap(h.begin(), h.end() - 1);
+        EXPECT_TRUE(ministl::is_sorted(h.begin(), h.end()));
+        FUN_AFTER(h, ministl::rotate(h.begin(), h.begin() + 4, h.end()));
+    }
+
+#if PERFORMANCE_TEST_ON
+    std::cout << "[--------------------- Performance Testing ---------------------]\n";
+#if LARGER_TEST_DATA_ON
+    const size_t sizes[] = {1000000, 10000000, 100000000};
+#else
+    const size_t sizes[] = {1000000, 10000000};
+#endif
+    for (size_t len : sizes)
+    {
+        sort_time<uint32_t>("uint32", len, [&rng]() { return static_cast<uint32_t>(rng()); });
+        sort_time<int64_t>("int64", len, [&rng]() { return static_cast<int64_t>(rng()); });
+        sort_time<double>("double", len, [&rng]() { return static_cast<double>(rng() % 1000000) - 5e5; });
+    }
+    {
+        const size_t len = sizes[0];
+        ministl::vector<int> v(len, 0);
+        for (size_t i = 0; i < len; ++i)
+            v[i] = static_cast<int>(rng() % 1000);
+        ministl::vector<int> w(v);
+        {
+            ministl::test::timer t;
+            std::stable_sort(v.begin(), v.end());
+            ministl::test::print_time("std::stable_sort int", len, t.elapsed_ms());
+        }
+        {
+            ministl::test::timer t;
+            ministl::stable_sort(w.begin(), w.end());
+            ministl::test::print_time("ministl::stable_sort int", len, t.elapsed_ms());
+        }
+        EXPECT_TRUE(v == w);
+    }
+#endif
+    std::cout << "[------------------ End algorithm test : sort ------------------]\n";
+}
+#endif //MINISTL_T_SORT_H
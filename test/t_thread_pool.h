@@ -0,0 +1,140 @@
+#ifndef MINISTL_T_THREAD_POOL_H
+#define MINISTL_T_THREAD_POOL_H
+#include <atomic>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include "test.h"
+#include "../vector.h"
+#include "../thread_pool.h"
+
+// 递归的 parallel_invoke，检查嵌套提交与等待
+inline long parallel_fib(int n)
+{
+    if (n < 18)
+    {
+        long a = 0, b = 1;
+        for (int i = 0; i < n; ++i)
+        {
+            const long c = a + b;
+            a = b;
+            b = c;
+        }
+        return a;
+    }
+    long x = 0, y = 0;
+    ministl::parallel_invoke([&x, n]() { x = parallel_fib(n - 1); },
+                             [&y, n]() { y = parallel_fib(n - 2); });
+    return x + y;
+}
+
+void thread_pool_test()
+{
+    std::cout << "[===============================================================]\n";
+    std::cout << "[----------------- Run concurrency test : thread_pool -----------]\n";
+    std::cout << "[-------------------------- API test ---------------------------]\n";
+    // Chase-Lev deque：所有者 LIFO，窃取者 FIFO，扩容后元素不丢失
+    {
+        ministl::work_stealing_deque<int*> dq(4);
+        int a[100];
+        for (int i = 0; i < 100; ++i)
+            dq.push(a + i);
+        int* p = nullptr;
+        EXPECT_TRUE(dq.pop(p) && p == a + 99);
+        EXPECT_TRUE(dq.steal(p) && p == a);
+        size_t left = 0;
+        while (dq.pop(p))
+            ++left;
+        EXPECT_TRUE(left == 98 && dq.empty());
+    }
+
+    // parallel_for 覆盖每个下标恰好一次
+    {
+        const size_t n = 1000003;
+        ministl::vector<int> v(n, 0);
+        ministl::parallel_for(static_cast<size_t>(0), n, static_cast<size_t>(1000),
+                              [&v](size_t lo, size_t hi) {
+                                  for (size_t i = lo; i < hi; ++i)
+                                      v[i] += static_cast<int>(i % 7);
+                              });
+        bool ok = true;
+        for (size_t i = 0; i < n; ++i)
+            ok = ok && v[i] == static_cast<int>(i % 7);
+        EXPECT_TRUE(ok);
+    }
+
+    // 嵌套并行与异常传播
+    EXPECT_TRUE(parallel_fib(27) == 196418);
+    {
+        bool thrown = false;
+        try
+        {
+            ministl::parallel_for(0, 1 << 16, 64, [](int lo, int hi) {
+                if (lo <= 40000 && 40000 < hi)
+                    throw std::runtime_error("task failed");
+            });
+        }
+        catch (const std::runtime_error&)
+        {
+            thrown = true;
+        }
+        EXPECT_TRUE(thrown);
+    }
+
+    // 独立的线程池
+    {
+        ministl::thread_pool pool(4);
+        ministl::task_group group;
+        std::atomic<int> sum(0);
+        for (int i = 1; i <= 100; ++i)
+            pool.submit(group, [&sum, i]() { sum += i; });
+        pool.wait(group);
+        EXPECT_TRUE(sum == 5050 && group.done());
+
+        // 复制任务失败时不计入 group，wait 不会一直等待
+        typedef ministl::test::counted<ministl::test::throw_on_budget> elem;
+        const elem payload(1);
+        elem::copy_budget = 1;
+        auto fn = [payload, &sum]() { sum += static_cast<int>(payload.value); };
+        bool thrown = false;
+        try
+        {
+            pool.submit(group, fn);
+        }
+        catch (const std::runtime_error&)
+        {
+            thrown = true;
+        }
+        EXPECT_TRUE(thrown && group.done());
+        pool.wait(group);
+    }
+    FUN_VALUE(ministl::default_thread_pool().size());
+    FUN_VALUE(parallel_fib(30));
+
+#if PERFORMANCE_TEST_ON
+    std::cout << "[--------------------- Performance Testing ---------------------]\n";
+#if LARGER_TEST_DATA_ON
+    const size_t n = 100000000;
+#else
+    const size_t n = 10000000;
+#endif
+    ministl::vector<double> v(n, 1.0);
+    {
+        ministl::test::timer t;
+        for (size_t i = 0; i < n; ++i)
+            v[i] = v[i] * 1.5 + 0.5;
+        ministl::test::print_time("serial for", n, t.elapsed_ms());
+    }
+    {
+        ministl::test::timer t;
+        ministl::parallel_for(static_cast<size_t>(0), n, [&v](size_t lo, size_t hi) {
+            for (size_t i = lo; i < hi; ++i)
+                v[i] = v[i] * 1.5 + 0.5;
+        });
+        ministl::test::print_time("parallel_for", n, t.elapsed_ms());
+    }
+    ministl::test::do_not_optimize(v[n / 2]);
+#endif
+    std::cout << "[----------------- End concurrency test : thread_pool -----------]\n";
+}
+#endif //MINISTL_T_THREAD_POOL_H
@@ -1,33 +1,51 @@
 #ifndef MINISTL_T_VECTOR_H
 #define MINISTL_T_VECTOR_H
+#include <fstream>
 #include <iostream>
+#include <string>
+#include "test.h"
 #include "../vector.h"
+#include "../locked_allocator.h"
 using namespace std;
 using namespace ministl;
 
-#define FUN_VALUE(fun) do {                              \
-  std::string fun_name = #fun;                           \
-  std::cout << " " << fun_name << " : " << fun << "\n";  \
-} while(0)
-
-// 遍历输出容器
-#define COUT(container) do {                             \
-  std::string con_name = #container;                     \
-  std::cout << " " << con_name << " :";                  \
-  for (auto it : container)                              \
-    std::cout << " " << it;                              \
-  std::cout << "\n";                                     \
-} while(0)
+// 预留空间后逐次记录 push_back 的耗时，比较是否预缺页
+void prefault_latency(const std::string& name, size_t n, bool prefault)
+{
+    std::vector<uint64_t> samples(n);
+    ministl::vector<int> v;
+    if (prefault)
+        v.reserve_prefault(n);
+    else
+        v.reserve(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        ministl::test::timer t;
+        v.push_back(static_cast<int>(i));
+        samples[i] = t.elapsed_ns();
+    }
+    ministl::test::do_not_optimize(v);
+    ministl::test::print_latency(name, ministl::test::summarize(samples));
+}
 
-// 输出容器调用函数后的结果
-#define FUN_AFTER(con, fun) do {                         \
-  std::string fun_name = #fun;                           \
-  std::cout << " After " << fun_name << " :\n";          \
-  fun;                                                   \
-  COUT(con);                                             \
-} while(0)
+// 本进程被 mlock 锁定的内存(KB)，读取 /proc/self/status 的 VmLck，非 Linux 平台返回 0
+size_t locked_kb()
+{
+    std::ifstream status("/proc/self/status");
+    std::string key;
+    size_t kb = 0;
+    while (status >> key)
+    {
+        if (key == "VmLck:")
+        {
+            status >> kb;
+            break;
+        }
+    }
+    return kb;
+}
 
-void test() {
+void vector_test() {
 
     std::cout << "[===============================================================]\n";
     std::cout << "[----------------- Run container test : vector -----------------]\n";
@@ -102,6 +120,45 @@ void test() {
     FUN_AFTER(v1, v1.shrink_to_fit());
     FUN_VALUE(v1.size());
     FUN_VALUE(v1.capacity());
+    FUN_AFTER(v4, v4.reserve_prefault(100000));
+    FUN_VALUE(v4.capacity());
+    // locked_allocator 锁定的正好是每次申请的页面：扩容时随旧空间解除，移动时随空间转移，
+    // 释放一块空间不影响其他空间的锁定
+    typedef ministl::locked_allocator<int> lock_alloc;
+    const size_t before = locked_kb();
+    {
+        const size_t failures = lock_alloc::lock_failures();
+        ministl::vector<int, lock_alloc> small;
+        small.reserve(1000);
+        const size_t small_kb = locked_kb();
+        {
+            ministl::vector<int, lock_alloc> v5;
+            v5.reserve(200000);
+            const bool locked = lock_alloc::lock_failures() == failures;
+            FUN_VALUE(locked);
+            const size_t kb = locked_kb();
+            EXPECT_TRUE(!locked || (small_kb > before && kb >= small_kb + 200000 * sizeof(int) / 1024));
+            ministl::vector<int, lock_alloc> v6(ministl::move(v5));
+            EXPECT_TRUE(locked_kb() == kb);
+            v6.reserve(400000);
+            const size_t grown = locked_kb();
+            EXPECT_TRUE(!locked || (grown >= small_kb + 400000 * sizeof(int) / 1024 &&
+                                    grown < kb + 400000 * sizeof(int) / 1024));
+        }
+        EXPECT_TRUE(locked_kb() == small_kb);
+    }
+    EXPECT_TRUE(locked_kb() == before);
+
+#if PERFORMANCE_TEST_ON
+    std::cout << "[--------------------- Performance Testing ---------------------]\n";
+#if LARGER_TEST_DATA_ON
+    const size_t n = 1u << 27;
+#else
+    const size_t n = 1u << 23;
+#endif
+    prefault_latency("push_back after reserve", n, false);
+    prefault_latency("push_back after prefault", n, true);
+#endif
     std::cout << "[----------------- End container test : vector -----------------]\n";
 }
 #endif //MINISTL_T_VECTOR_H
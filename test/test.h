@@ -0,0 +1,207 @@
+#ifndef MINISTL_TEST_H
+#define MINISTL_TEST_H
+
+// 测试公共部分：输出宏、异常安全测试用的计数元素以及性能测试用的计时、延迟统计工具
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// 是否开启性能测试
+#ifndef PERFORMANCE_TEST_ON
+#define PERFORMANCE_TEST_ON 1
+#endif
+
+// 是否使用大规模数据做性能测试，默认的小数据量保证测试能很快跑完
+#ifndef LARGER_TEST_DATA_ON
+#define LARGER_TEST_DATA_ON 0
+#endif
+
+#define FUN_VALUE(fun) do {                              \
+  std::string fun_name = #fun;                           \
+  std::cout << " " << fun_name << " : " << fun << "\n";  \
+} while(0)
+
+// 遍历输出容器
+#define COUT(container) do {                             \
+  std::string con_name = #container;                     \
+  std::cout << " " << con_name << " :";                  \
+  for (auto it : container)                              \
+    std::cout << " " << it;                              \
+  std::cout << "\n";                                     \
+} while(0)
+
+// 输出容器调用函数后的结果
+#define FUN_AFTER(con, fun) do {                         \
+  std::string fun_name = #fun;                           \
+  std::cout << " After " << fun_name << " :\n";          \
+  fun;                                                   \
+  COUT(con);                                             \
+} while(0)
+
+// 断言测试结果，失败时输出位置并以非零值退出
+#define EXPECT_TRUE(expr) do {                                       \
+  if (!(expr)) {                                                     \
+    std::cout << " [FAILED] " << #expr << " at " << __FILE__         \
+              << ":" << __LINE__ << "\n";                            \
+    std::exit(1);                                                    \
+  }                                                                  \
+} while(0)
+
+namespace ministl
+{
+namespace test
+{
+    // counted 的哪些操作可能抛出 std::runtime_error
+    enum counted_throws
+    {
+        throw_none      = 0,
+        throw_on_value  = 1,  // 以负数构造时抛出
+        throw_on_copy   = 2,  // 复制负数时抛出
+        throw_on_move   = 4,  // 移动负数时抛出，此时移动构造不是 noexcept
+        throw_on_budget = 8   // 复制次数用完 copy_budget 后抛出
+    };
+
+    // 记录存活对象个数的测试元素，用于检查容器在异常路径上没有泄漏或重复析构
+    template <int Throws = throw_none>
+    struct counted
+    {
+        static std::atomic<int> live;
+        static std::atomic<int> copy_budget;
+        int64_t value;
+
+        counted() noexcept : value(0) { ++live; }
+
+        counted(int64_t v) : value(v)
+        {
+            fail_if((Throws & throw_on_value) && v < 0, "bad value");
+            ++live;
+        }
+
+        counted(const counted& rhs) : value(rhs.value)
+        {
+            fail_if((Throws & throw_on_copy) && value < 0, "bad copy");
+            fail_if((Throws & throw_on_budget) && --copy_budget < 0, "copy budget exhausted");
+            ++live;
+        }
+
+        counted(counted&& rhs) noexcept(!(Throws & throw_on_move)) : value(rhs.value)
+        {
+            fail_if((Throws & throw_on_move) && value < 0, "bad move");
+            ++live;
+        }
+
+        counted& operator=(const counted& rhs) noexcept
+        {
+            value = rhs.value;
+            return *this;
+        }
+
+        counted& operator=(counted&& rhs) noexcept
+        {
+            value = rhs.value;
+            return *this;
+        }
+
+        ~counted() { --live; }
+
+        bool operator==(const counted& rhs) const noexcept { return value == rhs.value; }
+        bool operator!=(const counted& rhs) const noexcept { return value != rhs.value; }
+
+    private:
+        static void fail_if(bool cond, const char* what)
+        {
+            if (cond)
+                throw std::runtime_error(what);
+        }
+    };
+
+    template <int Throws>
+    std::atomic<int> counted<Throws>::live(0);
+
+    template <int Throws>
+    std::atomic<int> counted<Throws>::copy_budget(0);
+
+    // 计时器
+    class timer
+    {
+    private:
+        std::chrono::steady_clock::time_point start_;
+
+    public:
+        timer() : start_(std::chrono::steady_clock::now()) {}
+
+        void reset() { start_ = std::chrono::steady_clock::now(); }
+
+        uint64_t elapsed_ns() const
+        {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - start_).count());
+        }
+
+        double elapsed_ms() const { return elapsed_ns() / 1e6; }
+    };
+
+    // 单次操作延迟的分布
+    struct latency_stats
+    {
+        uint64_t p50;
+        uint64_t p99;
+        uint64_t p999;
+        uint64_t p9999;
+        uint64_t max;
+    };
+
+    // samples 会被排序
+    inline latency_stats summarize(std::vector<uint64_t>& samples)
+    {
+        latency_stats s = {0, 0, 0, 0, 0};
+        if (samples.empty())
+            return s;
+        std::sort(samples.begin(), samples.end());
+        const auto at = [&samples](double q) {
+            return samples[static_cast<size_t>(q * (samples.size() - 1))];
+        };
+        s.p50 = at(0.5);
+        s.p99 = at(0.99);
+        s.p999 = at(0.999);
+        s.p9999 = at(0.9999);
+        s.max = samples.back();
+        return s;
+    }
+
+    inline void print_latency(const std::string& name, const latency_stats& s)
+    {
+        std::cout << " |" << std::setw(30) << name
+                  << " | p50 " << std::setw(6) << s.p50
+                  << " | p99 " << std::setw(6) << s.p99
+                  << " | p99.9 " << std::setw(8) << s.p999
+                  << " | p99.99 " << std::setw(9) << s.p9999
+                  << " | max " << std::setw(11) << s.max << " | (ns)\n";
+    }
+
+    inline void print_time(const std::string& name, size_t n, double ms)
+    {
+        std::cout << " |" << std::setw(36) << name
+                  << " | n = " << std::setw(11) << n
+                  << " | " << std::setw(10) << std::fixed << std::setprecision(2) << ms << " ms |\n";
+        std::cout.unsetf(std::ios::floatfield);
+    }
+
+    // 防止被测代码被编译器优化掉
+    template <class T>
+    inline void do_not_optimize(const T& value)
+    {
+        asm volatile("" : : "g"(&value) : "memory");
+    }
+}
+}
+
+#endif //MINISTL_TEST_H
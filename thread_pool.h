@@ -0,0 +1,513 @@
+#ifndef MINISTL_THREAD_POOL_H
+#define MINISTL_THREAD_POOL_H
+
+// 这个头文件包含一个工作窃取(work-stealing)线程池，以及基于它的 parallel_for / parallel_invoke
+// work_stealing_deque : Chase-Lev 双端队列，所有者在底部 push / pop，其他线程从顶部 steal
+// thread_pool         : 每个工作线程拥有一个 deque，空闲时随机窃取其他线程的任务
+// task_group          : 一组任务的完成计数，wait() 期间当前线程会帮忙执行任务而不是阻塞
+
+// notes:
+// 工作线程内提交的任务进入自己的 deque（LIFO，缓存友好），外部线程提交的任务进入共享的注入队列。
+// 任务抛出的第一个异常保存在 task_group 中，由 wait() 重新抛出。
+// parallel_for 以二分方式递归拆分区间，直到不超过 grain 个元素，再调用 body(first, last)。
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "algobase.h"
+#include "aligned_allocator.h"
+#include "util.h"
+
+namespace ministl
+{
+    /*****************************************work_stealing_deque**********************************************/
+
+    // 参考 Lê, Pop, Cohen, Zappa Nardelli, "Correct and Efficient Work-Stealing for Weak Memory Models"
+    // T 须为可平凡复制的类型（通常是指针）
+    template <class T>
+    class work_stealing_deque
+    {
+    private:
+        struct ring
+        {
+            int64_t         cap;
+            int64_t         mask;
+            std::atomic<T>* buf;
+
+            explicit ring(int64_t c) : cap(c), mask(c - 1), buf(new std::atomic<T>[static_cast<size_t>(c)]) {}
+            ~ring() { delete[] buf; }
+
+            T    get(int64_t i) const noexcept     { return buf[i & mask].load(std::memory_order_relaxed); }
+            void put(int64_t i, T x) noexcept      { buf[i & mask].store(x, std::memory_order_relaxed); }
+        };
+
+        alignas(64) std::atomic<int64_t> top_;
+        alignas(64) std::atomic<int64_t> bottom_;
+        std::atomic<ring*>               array_;
+        std::vector<ring*>               garbage_;   //扩容后被替换的数组，窃取者可能仍在读，析构时统一释放
+
+    public:
+        explicit work_stealing_deque(int64_t cap = 256)
+                : top_(0), bottom_(0), array_(new ring(cap)) {}
+
+        ~work_stealing_deque()
+        {
+            for (auto r : garbage_)
+                delete r;
+            delete array_.load(std::memory_order_relaxed);
+        }
+
+        work_stealing_deque(const work_stealing_deque&) = delete;
+        work_stealing_deque& operator=(const work_stealing_deque&) = delete;
+
+        // 只能由所有者调用
+        void push(T x)
+        {
+            const int64_t b = bottom_.load(std::memory_order_relaxed);
+            const int64_t t = top_.load(std::memory_order_acquire);
+            ring* a = array_.load(std::memory_order_relaxed);
+            if (b - t > a->cap - 1)
+                a = grow(a, b, t);
+            a->put(b, x);
+            std::atomic_thread_fence(std::memory_order_release);
+            bottom_.store(b + 1, std::memory_order_relaxed);
+        }
+
+        // 只能由所有者调用
+        bool pop(T& x)
+        {
+            const int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+            ring* a = array_.load(std::memory_order_relaxed);
+            bottom_.store(b, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t t = top_.load(std::memory_order_relaxed);
+            if (t > b)
+            {
+                bottom_.store(b + 1, std::memory_order_relaxed);
+                return false;
+            }
+            x = a->get(b);
+            if (t == b)
+            {
+                // 只剩最后一个元素，与窃取者竞争
+                const bool won = top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                                              std::memory_order_relaxed);
+                bottom_.store(b + 1, std::memory_order_relaxed);
+                return won;
+            }
+            return true;
+        }
+
+        // 任意线程均可调用
+        bool steal(T& x)
+        {
+            int64_t t = top_.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const int64_t b = bottom_.load(std::memory_order_acquire);
+            if (t >= b)
+                return false;
+            ring* a = array_.load(std::memory_order_acquire);
+            x = a->get(t);
+            return top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                                std::memory_order_relaxed);
+        }
+
+        bool empty() const noexcept
+        {
+            return bottom_.load(std::memory_order_relaxed) <= top_.load(std::memory_order_relaxed);
+        }
+
+    private:
+        ring* grow(ring* a, int64_t b, int64_t t)
+        {
+            ring* bigger = new ring(a->cap * 2);
+            for (int64_t i = t; i != b; ++i)
+                bigger->put(i, a->get(i));
+            garbage_.push_back(a);
+            array_.store(bigger, std::memory_order_release);
+            return bigger;
+        }
+    };
+
+    /*********************************************task_group**************************************************/
+
+    class thread_pool;
+
+    class task_group
+    {
+        friend class thread_pool;
+    private:
+        std::atomic<size_t>  pending_;
+        std::mutex           error_lock_;
+        std::exception_ptr   error_;
+
+    public:
+        task_group() noexcept : pending_(0) {}
+        task_group(const task_group&) = delete;
+        task_group& operator=(const task_group&) = delete;
+
+        bool done() const noexcept { return pending_.load(std::memory_order_acquire) == 0; }
+
+    private:
+        void record(std::exception_ptr e)
+        {
+            std::lock_guard<std::mutex> guard(error_lock_);
+            if (!error_)
+                error_ = e;
+        }
+    };
+
+    /*********************************************thread_pool*************************************************/
+
+    class thread_pool
+    {
+    private:
+        struct task
+        {
+            std::function<void()> fn;
+            task_group*           group;
+        };
+
+        struct alignas(64) worker
+        {
+            work_stealing_deque<task*> tasks;
+        };
+
+        // C++11 的 new 不保证超过 alignof(std::max_align_t) 的对齐，worker 从 aligned_allocator 申请
+        typedef ministl::aligned_allocator<worker, 64> worker_allocator;
+
+        // 当前线程所属的线程池、工作线程下标以及选择窃取对象用的随机数种子
+        struct thread_slot
+        {
+            thread_pool* pool;
+            size_t       index;
+            uint64_t     seed;
+        };
+
+        static thread_slot& current() noexcept
+        {
+            static std::atomic<uint64_t> next_seed(1);
+            static thread_local thread_slot slot = {
+                nullptr, 0, 0x9E3779B97F4A7C15ull * next_seed.fetch_add(1, std::memory_order_relaxed) };
+            return slot;
+        }
+
+    private:
+        std::vector<worker*>     workers_;
+        std::vector<std::thread> threads_;
+        std::mutex               inject_lock_;
+        std::deque<task*>        inject_;
+        std::atomic<size_t>      injected_;
+        std::mutex               sleep_lock_;
+        std::condition_variable  sleep_cv_;
+        std::atomic<size_t>      sleeping_;
+        std::atomic<bool>        stop_;
+
+    public:
+        // threads 为 0 时使用 hardware_concurrency
+        explicit thread_pool(size_t threads = 0)
+                : injected_(0), sleeping_(0), stop_(false)
+        {
+            if (threads == 0)
+                threads = ministl::max(static_cast<size_t>(std::thread::hardware_concurrency()),
+                                       static_cast<size_t>(1));
+            workers_.reserve(threads);
+            for (size_t i = 0; i < threads; ++i)
+                workers_.push_back(new_worker());
+            for (size_t i = 0; i < threads; ++i)
+                threads_.emplace_back(&thread_pool::worker_loop, this, i);
+        }
+
+        ~thread_pool()
+        {
+            {
+                std::lock_guard<std::mutex> guard(sleep_lock_);
+                stop_.store(true);
+            }
+            sleep_cv_.notify_all();
+            for (auto& t : threads_)
+                t.join();
+            task* t = nullptr;
+            for (auto w : workers_)
+            {
+                while (w->tasks.pop(t))
+                    delete t;
+                w->~worker();
+                worker_allocator::deallocate(w);
+            }
+            for (auto p : inject_)
+                delete p;
+        }
+
+        thread_pool(const thread_pool&) = delete;
+        thread_pool& operator=(const thread_pool&) = delete;
+
+        size_t size() const noexcept { return workers_.size(); }
+
+        // 当前线程是否为本线程池的工作线程
+        bool in_worker() const noexcept { return current().pool == this; }
+
+        // 提交一个属于 group 的任务
+        template <class F>
+        void submit(task_group& group, F&& fn)
+        {
+            task* t = new task{ std::function<void()>(ministl::forward<F>(fn)), &group };
+            // 计数须在任务可见之前增加；入队失败时撤销，否则 wait 永远等不到 0
+            group.pending_.fetch_add(1, std::memory_order_relaxed);
+            try
+            {
+                thread_slot& slot = current();
+                if (slot.pool == this)
+                {
+                    workers_[slot.index]->tasks.push(t);
+                }
+                else
+                {
+                    std::lock_guard<std::mutex> guard(inject_lock_);
+                    inject_.push_back(t);
+                    injected_.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+            catch (...)
+            {
+                group.pending_.fetch_sub(1, std::memory_order_relaxed);
+                delete t;
+                throw;
+            }
+            wake_one();
+        }
+
+        // 等待 group 中的任务全部完成，期间执行其他任务，不阻塞在锁或条件变量上
+        // 任务抛出异常时在此重新抛出第一个异常
+        void wait(task_group& group)
+        {
+            unsigned idle = 0;
+            while (!group.done())
+            {
+                if (run_one())
+                    idle = 0;
+                else if (++idle > 64)
+                    std::this_thread::yield();
+            }
+            std::exception_ptr e;
+            {
+                std::lock_guard<std::mutex> guard(group.error_lock_);
+                e = group.error_;
+                group.error_ = nullptr;
+            }
+            if (e)
+                std::rethrow_exception(e);
+        }
+
+    private:
+        static worker* new_worker()
+        {
+            worker* w = worker_allocator::allocate(1);
+            try
+            {
+                ::new (static_cast<void*>(w)) worker();
+            }
+            catch (...)
+            {
+                worker_allocator::deallocate(w);
+                throw;
+            }
+            return w;
+        }
+
+        void wake_one()
+        {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (sleeping_.load(std::memory_order_relaxed) != 0)
+            {
+                std::lock_guard<std::mutex> guard(sleep_lock_);
+                sleep_cv_.notify_one();
+            }
+        }
+
+        static void execute(task* t)
+        {
+            task_group* group = t->group;
+            try
+            {
+                t->fn();
+            }
+            catch (...)
+            {
+                group->record(std::current_exception());
+            }
+            delete t;
+            group->pending_.fetch_sub(1, std::memory_order_release);
+        }
+
+        // 依次尝试：自己的 deque、注入队列、随机窃取
+        bool find_task(task*& t)
+        {
+            thread_slot& slot = current();
+            if (slot.pool == this && workers_[slot.index]->tasks.pop(t))
+                return true;
+            if (injected_.load(std::memory_order_relaxed) != 0)
+            {
+                std::lock_guard<std::mutex> guard(inject_lock_);
+                if (!inject_.empty())
+                {
+                    t = inject_.front();
+                    inject_.pop_front();
+                    injected_.fetch_sub(1, std::memory_order_relaxed);
+                    return true;
+                }
+            }
+            const size_t n = workers_.size();
+            slot.seed ^= slot.seed << 13;
+            slot.seed ^= slot.seed >> 7;
+            slot.seed ^= slot.seed << 17;
+            const size_t start = static_cast<size_t>(slot.seed % n);
+            for (size_t i = 0; i < n; ++i)
+            {
+                const size_t victim = (start + i) % n;
+                if (slot.pool == this && victim == slot.index)
+                    continue;
+                if (workers_[victim]->tasks.steal(t))
+                    return true;
+            }
+            return false;
+        }
+
+        bool run_one()
+        {
+            task* t = nullptr;
+            if (!find_task(t))
+                return false;
+            execute(t);
+            return true;
+        }
+
+        bool has_work() const noexcept
+        {
+            if (injected_.load(std::memory_order_relaxed) != 0)
+                return true;
+            for (auto w : workers_)
+            {
+                if (!w->tasks.empty())
+                    return true;
+            }
+            return false;
+        }
+
+        void worker_loop(size_t index)
+        {
+            current().pool = this;
+            current().index = index;
+            unsigned idle = 0;
+            while (!stop_.load(std::memory_order_relaxed))
+            {
+                if (run_one())
+                {
+                    idle = 0;
+                    continue;
+                }
+                if (++idle < 128)
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+                // 先登记为睡眠再复查任务，与 wake_one 中的 fence 配合避免丢失唤醒
+                std::unique_lock<std::mutex> lock(sleep_lock_);
+                sleeping_.fetch_add(1, std::memory_order_seq_cst);
+                if (!stop_.load() && !has_work())
+                    sleep_cv_.wait_for(lock, std::chrono::milliseconds(10));
+                sleeping_.fetch_sub(1, std::memory_order_relaxed);
+                idle = 0;
+            }
+        }
+    };
+
+    // 全局默认线程池，首次使用时创建
+    inline thread_pool& default_thread_pool()
+    {
+        static thread_pool pool;
+        return pool;
+    }
+
+    /*******************************************parallel_invoke***********************************************/
+
+    // 并行执行 f1 与 f2，f2 作为任务提交，f1 在当前线程执行
+    template <class F1, class F2>
+    void parallel_invoke(F1&& f1, F2&& f2, thread_pool& pool = default_thread_pool())
+    {
+        task_group group;
+        pool.submit(group, ministl::forward<F2>(f2));
+        try
+        {
+            f1();
+        }
+        catch (...)
+        {
+            pool.wait(group);
+            throw;
+        }
+        pool.wait(group);
+    }
+
+    /*********************************************parallel_for************************************************/
+
+    // 把 [first, last) 递归二分，直到区间不超过 grain 个元素后调用 body(lo, hi)
+    template <class Index, class Body>
+    void parallel_for_split(thread_pool& pool, task_group& group, Index first, Index last,
+                            Index grain, const Body& body)
+    {
+        while (last - first > grain)
+        {
+            const Index mid = first + (last - first) / 2;
+            pool.submit(group, [&pool, &group, mid, last, grain, &body]() {
+                parallel_for_split(pool, group, mid, last, grain, body);
+            });
+            last = mid;
+        }
+        body(first, last);
+    }
+
+    // grain 为 0 时取 区间长度 / (8 * 线程数)，让每个线程平均分到若干块以便负载均衡
+    template <class Index, class Body>
+    void parallel_for(Index first, Index last, Index grain, const Body& body,
+                      thread_pool& pool = default_thread_pool())
+    {
+        if (!(first < last))
+            return;
+        const Index n = last - first;
+        if (grain == Index(0))
+            grain = ministl::max(static_cast<Index>(n / static_cast<Index>(8 * (pool.size() + 1))), Index(1));
+        if (n <= grain)
+        {
+            body(first, last);
+            return;
+        }
+        task_group group;
+        try
+        {
+            parallel_for_split(pool, group, first, last, grain, body);
+        }
+        catch (...)
+        {
+            pool.wait(group);
+            throw;
+        }
+        pool.wait(group);
+    }
+
+    template <class Index, class Body>
+    void parallel_for(Index first, Index last, const Body& body)
+    {
+        parallel_for(first, last, Index(0), body);
+    }
+}
+
+#endif //MINISTL_THREAD_POOL_H
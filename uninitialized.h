@@ -31,7 +31,8 @@ namespace ministl
         catch (...)
         {
             for(;result != cur;++result)
-                ministl::destroy(&*cur);
+                ministl::destroy(&*result);
+            throw;
         }
         return cur;
     }
@@ -39,7 +40,7 @@ namespace ministl
     template <class InputIter,class ForwardIter>
     ForwardIter uninitialized_copy(InputIter first,InputIter last,ForwardIter result)
     {
-        return ministl::unchecked_uninitialized_copy(first, last, result,std::is_trivially_copy_assignable<
+        return ministl::unchecked_uninitialized_copy(first, last, result,std::is_trivially_copy_constructible<
                 typename iterator_traits<ForwardIter>::value_type>{});
     }
 
@@ -63,15 +64,16 @@ namespace ministl
         }
         catch (...)
         {
-            //todo may be type error here
-            ministl::destroy(first,cur);
+            for(; first != cur; ++first)
+                ministl::destroy(&*first);
+            throw;
         }
     }
 
     template <class ForwardIter, class T>
     void  uninitialized_fill(ForwardIter first, ForwardIter last, const T& value)
     {
-        ministl::unchecked_uninitialized_fill(first, last, value,std::is_trivially_copy_assignable<
+        ministl::unchecked_uninitialized_fill(first, last, value,std::is_trivially_copy_constructible<
                 typename iterator_traits<ForwardIter>::value_type>{});
     }
 
@@ -95,7 +97,9 @@ namespace ministl
         }
         catch (...)
         {
-            ministl::destroy(first,cur);
+            for(; first != cur; ++first)
+                ministl::destroy(&*first);
+            throw;
         }
         return cur;
     }
@@ -103,7 +107,7 @@ namespace ministl
     template <class ForwardIter, class Size, class T>
     ForwardIter uninitialized_fill_n(ForwardIter first, Size n, const T& value)
     {
-        return ministl::unchecked_uninitialized_fill_n(first, n, value,std::is_trivially_copy_assignable<
+        return ministl::unchecked_uninitialized_fill_n(first, n, value,std::is_trivially_copy_constructible<
         typename iterator_traits<ForwardIter>::value_type>{});
     }
 
@@ -126,7 +130,9 @@ namespace ministl
         }
         catch(...)
         {
-            ministl::destroy(result,cur);
+            for(; result != cur; ++result)
+                ministl::destroy(&*result);
+            throw;
         }
         return cur;
     }
@@ -134,7 +140,7 @@ namespace ministl
     template <class InputIter, class ForwardIter>
     ForwardIter uninitialized_move(InputIter first, InputIter last, ForwardIter result)
     {
-        return ministl::unchecked_uninitialized_move(first, last, result,std::is_trivially_move_assignable<
+        return ministl::unchecked_uninitialized_move(first, last, result,std::is_trivially_move_constructible<
         typename iterator_traits<InputIter>::value_type>{});
     }
 
@@ -172,7 +178,7 @@ namespace ministl
     template <class InputIter, class Size, class ForwardIter>
     ForwardIter uninitialized_move_n(InputIter first, Size n, ForwardIter result)
     {
-        return ministl::unchecked_uninitialized_move_n(first, n, result,std::is_trivially_move_assignable<
+        return ministl::unchecked_uninitialized_move_n(first, n, result,std::is_trivially_move_constructible<
         typename iterator_traits<InputIter>::value_type>{});
     }
 
@@ -103,7 +103,7 @@ namespace ministl
             std::is_constructible<T2,_Other2>::value &&
             std::is_convertible<_Other1&&,T1>::value &&
             std::is_convertible<_Other2&&,T2>::value,int>::type = 0>
-        constexpr pair(T1&& a, T2&& b) : first(ministl::forward<T1>(a)),second(ministl::forward<T2>(b))
+        constexpr pair(_Other1&& a, _Other2&& b) : first(ministl::forward<_Other1>(a)),second(ministl::forward<_Other2>(b))
         {
         }
 
@@ -113,7 +113,7 @@ namespace ministl
             std::is_constructible<T2,_Other2>::value &&
             (!std::is_convertible<_Other1,T1>::value ||
              !std::is_convertible<_Other2,T2>::value),int>::type = 0>
-        explicit constexpr pair(T1&& a, T2&& b) : first(ministl::forward<T1>(a)),second(ministl::forward<T2>(b))
+        explicit constexpr pair(_Other1&& a, _Other2&& b) : first(ministl::forward<_Other1>(a)),second(ministl::forward<_Other2>(b))
         {
         }
 
@@ -175,7 +175,7 @@ namespace ministl
         //移动赋值
         pair& operator=(pair &&other) noexcept
         {
-            if(this != other)
+            if(this != &other)
             {
                 first = ministl::move(other.first);
                 second = ministl::move(other.second);
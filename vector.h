@@ -19,6 +19,8 @@
 #include "exception.h"
 #include "util.h"
 #include "memory.h"
+#include "page_memory.h"
+#include "parallel_dispatch.h"
 #include "type_traits.h"
 #include <initializer_list>
 #include <limits>
@@ -35,17 +37,36 @@ namespace ministl
 #undef min
 #endif // min
 
+    // 容器共用的扩容策略：按 1.5 倍增长，至少满足 add_size 个新元素，最小以 16 个分配
+    // vector 以及基于连续存储的其他容器（如 incremental_vector）都通过它计算新容量
+    template <class Size>
+    Size growth_capacity(Size old_cap, Size add_size, Size max_size)
+    {
+        THROW_LENGTH_ERROR_IF(old_cap > max_size - add_size,
+                              "vector<T>'s size too big");
+        // old size > 2/3 max size
+        if (old_cap > max_size - old_cap / 2)
+        {
+            //最小以16个多分配
+            return old_cap + add_size > max_size - 16
+                   ? old_cap + add_size : old_cap + add_size + 16;
+        }
+        return old_cap == 0
+               ? ministl::max(add_size, static_cast<Size>(16))
+               : ministl::max(old_cap + old_cap / 2, old_cap + add_size);
+    }
+
     /***********************************************vector******************************************************/
 
-    template <class T>
+    template <class T, class Alloc = ministl::allocator<T>>
     class vector
     {
         //vector<bool>[]返回是一个proxy class,包含了对bool的封装，此处不实现
         static_assert(!std::is_same<bool ,T>::value,"bool in vector is abandoned in ministl");
     public:
         // vector 的嵌套型别定义
-        typedef typename ministl::allocator<T>                          allocator_type;
-        typedef typename ministl::allocator<T>                          data_allocator;
+        typedef Alloc                                                   allocator_type;
+        typedef Alloc                                                   data_allocator;
 
         typedef typename allocator_type::value_type                     value_type;
         typedef typename allocator_type::pointer                        pointer;
@@ -62,6 +83,9 @@ namespace ministl
 
         allocator_type get_allocator() { return data_allocator();}
 
+        // begin_ 的对齐保证，由分配器决定
+        static constexpr size_t alignment = ministl::allocator_traits<Alloc>::alignment;
+
     private:
         iterator begin_;        //目前使用空间头部
         iterator end_;          //目前使用空间尾部
@@ -77,6 +101,10 @@ namespace ministl
         vector(size_type n,const value_type& value)
         { fill_init(n,value);}
 
+        //多线程并行初始化，每个线程首次访问自己负责的页面(first-touch)
+        vector(size_type n,const value_type& value,parallel_init_t tag)
+        { parallel_fill_init(n,value,tag.run);}
+
         //范围初始化
         template <class Iter, typename std::enable_if<ministl::is_input_iterator<Iter>::value,int>::type = 0>
         vector(Iter first,Iter last)
@@ -85,11 +113,24 @@ namespace ministl
             range_init(first,last);
         }
 
+        //多线程并行复制，每个线程首次访问自己负责的页面(first-touch)
+        template <class Iter, typename std::enable_if<ministl::is_random_access_iterator<Iter>::value,int>::type = 0>
+        vector(Iter first,Iter last,parallel_init_t tag)
+        {
+            MINISTL_DEBUG(!(last < first));
+            parallel_range_init(first,last,tag.run);
+        }
+
         vector(const vector& other)
         {
             range_init(other.begin_,other.end_);
         }
 
+        vector(const vector& other,parallel_init_t tag)
+        {
+            parallel_range_init(other.begin_,other.end_,tag.run);
+        }
+
         vector(vector && other) noexcept : begin_(other.begin_),end_(other.end_),cap_(other.cap_)
         {
             other.begin_ = nullptr;
@@ -192,6 +233,10 @@ namespace ministl
         void reserve(size_type n);
         void shrink_to_fit();
 
+        // 预留空间并提前触发备用空间的缺页，之后 n 个以内的插入既不扩容也不缺页
+        // 还需要 mlock 锁定时使用 vector<T, locked_allocator<T>>，锁定随空间的申请与释放进行
+        void reserve_prefault(size_type n);
+
         //访问元素
         reference operator[](size_type n)
         {
@@ -241,8 +286,8 @@ namespace ministl
             return *(end_ - 1);
         }
 
-        pointer data()              noexcept { return begin_;}
-        const_pointer data()  const noexcept { return begin_;}
+        pointer data()              noexcept { return ministl::assume_aligned<alignment>(begin_);}
+        const_pointer data()  const noexcept { return ministl::assume_aligned<alignment>(begin_);}
 
         //修改容器相关操作
         //assign
@@ -274,10 +319,15 @@ namespace ministl
         //push_back
         void push_back(const value_type& value);
         void push_back(value_type && value)
-        {emplace_back(value);}
+        {emplace_back(ministl::move(value));}
 
         void pop_back();
 
+        // 在尾部追加 n 个元素，由 fn(p) 在未初始化空间 [p, p + n) 上构造，容量不足时按 get_new_cap 扩容一次
+        // fn 抛出异常时须已析构自己构造的部分，此时 vector 的元素不变
+        template <class Fn>
+        void append_uninitialized(size_type n, Fn fn);
+
         //insert
         iterator insert(const_iterator pos, const value_type& value);
         iterator insert(const_iterator pos, value_type&& value)
@@ -315,9 +365,15 @@ namespace ministl
 
         void init_space(size_type size,size_type cap);
         void fill_init(size_type n,const value_type& value);
+        void parallel_fill_init(size_type n,const value_type& value,parallel_runner run);
 
         template <class Iter>
         void range_init(Iter first,Iter last);
+        template <class Iter>
+        void parallel_range_init(Iter first,Iter last,parallel_runner run);
+
+        // 重新分配时把 [first, last) 移动到新空间，超过全局并行阈值时并行执行
+        iterator relocate(iterator first,iterator last,iterator result);
 
         void destroy_and_recover(iterator first,iterator last,size_type n);
 
@@ -354,8 +410,11 @@ namespace ministl
 
     /***********************************************implementation********************************************************/
 
-    template <class T>
-    vector<T>& vector<T>::operator=(const vector &other)
+    template <class T, class Alloc>
+    constexpr size_t vector<T, Alloc>::alignment;
+
+    template <class T, class Alloc>
+    vector<T, Alloc>& vector<T, Alloc>::operator=(const vector &other)
     {
         if(this != &other)
         {
@@ -377,14 +436,14 @@ namespace ministl
                 //分两段copy,一段是已经申请过的，另一段是未申请的
                 ministl::copy(other.begin(), other.begin() + size(), begin_);
                 ministl::uninitialized_copy(other.begin() + size(), other.end(), end_);
-                cap_ = end_ = begin_ + len;
+                end_ = begin_ + len;
             }
         }
         return *this;
     }
 
-    template <class T>
-    vector<T>& vector<T>::operator= (vector &&other) noexcept
+    template <class T, class Alloc>
+    vector<T, Alloc>& vector<T, Alloc>::operator= (vector &&other) noexcept
     {
         destroy_and_recover(begin_,end_,cap_ - begin_);
         begin_ = other.begin_;
@@ -397,33 +456,49 @@ namespace ministl
     }
 
     //预留空间大小,当原容量小于要求大小时,才会重新分配
-    template <class T>
-    void vector<T>::reserve(size_type n) {
+    template <class T, class Alloc>
+    void vector<T, Alloc>::reserve(size_type n) {
         if(capacity() < n)
         {
             THROW_LENGTH_ERROR_IF(n > max_size(),"n can not larger than max_size() in vector<T>::reserve(n)");
+            n = ministl::allocator_traits<Alloc>::good_size(n);
             const size_type old_size = size();
             auto tmp = data_allocator::allocate(n);
-            ministl::uninitialized_move(begin_,end_,tmp);
-            data_allocator::deallocate(begin_,cap_ - begin_);
+            try
+            {
+                relocate(begin_,end_,tmp);
+            }
+            catch (...)
+            {
+                data_allocator::deallocate(tmp,n);
+                throw;
+            }
+            destroy_and_recover(begin_,end_,cap_ - begin_);
             begin_ = tmp;
             end_ = tmp + old_size;
             cap_ = tmp + n;
         }
     }
 
+    template <class T, class Alloc>
+    void vector<T, Alloc>::reserve_prefault(size_type n)
+    {
+        reserve(n);
+        ministl::prefault_pages(end_, static_cast<size_t>(cap_ - end_) * sizeof(T));
+    }
+
     //放弃多余容量
-    template <class T>
-    void vector<T>::shrink_to_fit() {
+    template <class T, class Alloc>
+    void vector<T, Alloc>::shrink_to_fit() {
         if(end_ < cap_)
             reinsert(size());
     }
 
     // 在 pos 位置就地构造元素，避免额外的复制或移动开销
-    template <class T>
+    template <class T, class Alloc>
     template <class ...Args>
-    typename vector<T>::iterator
-    vector<T>::emplace(const_iterator pos, Args&& ...args)
+    typename vector<T, Alloc>::iterator
+    vector<T, Alloc>::emplace(const_iterator pos, Args&& ...args)
     {
         MINISTL_DEBUG(pos >= begin() && pos <= end());
         auto casted_pos = const_cast<iterator>(pos);
@@ -439,6 +514,7 @@ namespace ministl
             data_allocator::construct(ministl::address_of(*end_), *(end_ - 1));
             //整体往后移一个单位
             ministl::copy_backward(casted_pos,end_ - 1,end_);
+            ++end_;
             *casted_pos = value_type(ministl::forward<Args>(args)...);
         }
         else
@@ -450,9 +526,9 @@ namespace ministl
 
 
     // 在尾部就地构造元素，避免额外的复制或移动开销
-    template <class T>
+    template <class T, class Alloc>
     template <class ...Args>
-    void vector<T>::emplace_back(Args &&... args)
+    void vector<T, Alloc>::emplace_back(Args &&... args)
     {
         if(end_ < cap_)
         {
@@ -466,9 +542,25 @@ namespace ministl
 
     }
 
+    // append_uninitialized
+    template <class T, class Alloc>
+    template <class Fn>
+    void vector<T, Alloc>::append_uninitialized(size_type n, Fn fn)
+    {
+        if (n == 0)
+            return;
+        if (static_cast<size_type>(cap_ - end_) < n)
+        {
+            THROW_LENGTH_ERROR_IF(size() > max_size() - n, "vector<T>'s size too big");
+            reserve(ministl::max(size() + n, get_new_cap(n)));
+        }
+        fn(end_);
+        end_ += n;
+    }
+
     //push_back
-    template <class T>
-    void vector<T>::push_back(const value_type &value)
+    template <class T, class Alloc>
+    void vector<T, Alloc>::push_back(const value_type &value)
     {
         if(end_ != cap_)
         {
@@ -482,17 +574,17 @@ namespace ministl
     }
 
     //pop_back
-    template <class T>
-    void vector<T>::pop_back()
+    template <class T, class Alloc>
+    void vector<T, Alloc>::pop_back()
     {
         MINISTL_DEBUG(!empty());
         data_allocator::destroy(end_-1);
         --end_;
     }
 
-    template <class T>
-    typename vector<T>::iterator
-    vector<T>::insert(const_iterator pos, const value_type& value) {
+    template <class T, class Alloc>
+    typename vector<T, Alloc>::iterator
+    vector<T, Alloc>::insert(const_iterator pos, const value_type& value) {
         MINISTL_DEBUG(pos >= begin() && pos <= end());
         auto xpos = const_cast<iterator>(pos);
         const size_type n = xpos - begin_;
@@ -506,6 +598,7 @@ namespace ministl
             data_allocator::construct(ministl::address_of(*end_),*(end_ - 1));
             auto copy_value = value;
             ministl::copy_backward(xpos,end_-1,end_);
+            ++end_;
             *xpos = ministl::move(copy_value);
         }
         else
@@ -516,9 +609,9 @@ namespace ministl
     }
 
     // 删除 pos 位置上的元素
-    template <class T>
-    typename vector<T>::iterator
-    vector<T>::erase(const_iterator pos)
+    template <class T, class Alloc>
+    typename vector<T, Alloc>::iterator
+    vector<T, Alloc>::erase(const_iterator pos)
     {
         MINISTL_DEBUG(pos >= begin() && pos < end());
         iterator xpos = begin_ + (pos - begin());
@@ -529,9 +622,9 @@ namespace ministl
     }
 
     // 删除[first, last)上的元素
-    template <class T>
-    typename vector<T>::iterator
-    vector<T>::erase(const_iterator first, const_iterator last)
+    template <class T, class Alloc>
+    typename vector<T, Alloc>::iterator
+    vector<T, Alloc>::erase(const_iterator first, const_iterator last)
     {
         MINISTL_DEBUG(first >= begin() && last <= end() && !(last < first));
         const auto n = first - begin();
@@ -542,8 +635,8 @@ namespace ministl
         return begin_ + n;
     }
 
-    template <class T>
-    void vector<T>::resize(size_type new_size, const value_type& value)
+    template <class T, class Alloc>
+    void vector<T, Alloc>::resize(size_type new_size, const value_type& value)
     {
         if(new_size < size())
         {
@@ -556,8 +649,8 @@ namespace ministl
     }
 
     // 与另一个 vector 交换
-    template <class T>
-    void vector<T>::swap(vector<T>& rhs) noexcept
+    template <class T, class Alloc>
+    void vector<T, Alloc>::swap(vector<T, Alloc>& rhs) noexcept
     {
         if (this != &rhs)
         {
@@ -571,8 +664,8 @@ namespace ministl
     // helper function
     // try_init 函数，若分配失败则忽略，不抛出异常
 
-    template <class T>
-    void vector<T>::try_init() noexcept
+    template <class T, class Alloc>
+    void vector<T, Alloc>::try_init() noexcept
     {
         try {
             begin_ = data_allocator::allocate(16);
@@ -587,9 +680,10 @@ namespace ministl
     }
 
     // init_space 函数
-    template <class T>
-    void vector<T>::init_space(size_type size, size_type cap)
+    template <class T, class Alloc>
+    void vector<T, Alloc>::init_space(size_type size, size_type cap)
     {
+        cap = ministl::allocator_traits<Alloc>::good_size(cap);
         try
         {
             begin_ = data_allocator::allocate(cap);
@@ -606,31 +700,109 @@ namespace ministl
     }
 
     // fill_init 函数
-    template <class T>
-    void vector<T>::
+    template <class T, class Alloc>
+    void vector<T, Alloc>::
     fill_init(size_type n, const value_type& value)
     {
+        if (parallel_runner run = ministl::parallel_vector_runner_for<T>(n))
+        {
+            parallel_fill_init(n, value, run);
+            return;
+        }
         //16个起分配
         const size_type init_size = ministl::max(static_cast<size_type>(16), n);
         init_space(n, init_size);
-        ministl::uninitialized_fill_n(begin_, n, value);
+        try
+        {
+            ministl::uninitialized_fill_n(begin_, n, value);
+        }
+        catch (...)
+        {
+            data_allocator::deallocate(begin_, cap_ - begin_);
+            begin_ = end_ = cap_ = nullptr;
+            throw;
+        }
+    }
+
+    // parallel_fill_init 函数
+    template <class T, class Alloc>
+    void vector<T, Alloc>::
+    parallel_fill_init(size_type n, const value_type& value, parallel_runner run)
+    {
+        const size_type init_size = ministl::max(static_cast<size_type>(16), n);
+        init_space(n, init_size);
+        try
+        {
+            ministl::run_uninitialized_fill_n(run, begin_, n, value);
+        }
+        catch (...)
+        {
+            data_allocator::deallocate(begin_, cap_ - begin_);
+            begin_ = end_ = cap_ = nullptr;
+            throw;
+        }
     }
 
     // range_init 函数
-    template <class T>
+    template <class T, class Alloc>
     template <class Iter>
-    void vector<T>::
+    void vector<T, Alloc>::
     range_init(Iter first, Iter last)
     {
+        if (parallel_runner run = ministl::parallel_vector_runner_for<T>(static_cast<size_t>(last - first)))
+        {
+            parallel_range_init(first, last, run);
+            return;
+        }
         const size_type init_size = ministl::max(static_cast<size_type>(last - first),
                                                static_cast<size_type>(16));
         init_space(static_cast<size_type>(last - first), init_size);
-        ministl::uninitialized_copy(first, last, begin_);
+        try
+        {
+            ministl::uninitialized_copy(first, last, begin_);
+        }
+        catch (...)
+        {
+            data_allocator::deallocate(begin_, cap_ - begin_);
+            begin_ = end_ = cap_ = nullptr;
+            throw;
+        }
+    }
+
+    // parallel_range_init 函数
+    template <class T, class Alloc>
+    template <class Iter>
+    void vector<T, Alloc>::
+    parallel_range_init(Iter first, Iter last, parallel_runner run)
+    {
+        const size_type n = static_cast<size_type>(last - first);
+        init_space(n, ministl::max(n, static_cast<size_type>(16)));
+        try
+        {
+            ministl::run_uninitialized_copy(run, first, last, begin_);
+        }
+        catch (...)
+        {
+            data_allocator::deallocate(begin_, cap_ - begin_);
+            begin_ = end_ = cap_ = nullptr;
+            throw;
+        }
+    }
+
+    // relocate 函数
+    template <class T, class Alloc>
+    typename vector<T, Alloc>::iterator
+    vector<T, Alloc>::
+    relocate(iterator first, iterator last, iterator result)
+    {
+        if (parallel_runner run = ministl::parallel_vector_runner_for<T>(static_cast<size_t>(last - first)))
+            return ministl::run_uninitialized_move(run, first, last, result);
+        return ministl::uninitialized_move(first, last, result);
     }
 
     // destroy_and_recover 函数
-    template <class T>
-    void vector<T>::
+    template <class T, class Alloc>
+    void vector<T, Alloc>::
     destroy_and_recover(iterator first, iterator last, size_type n)
     {
         data_allocator::destroy(first, last);
@@ -638,30 +810,18 @@ namespace ministl
     }
 
     // get_new_cap 函数
-    template <class T>
-    typename vector<T>::size_type
-    vector<T>::
+    template <class T, class Alloc>
+    typename vector<T, Alloc>::size_type
+    vector<T, Alloc>::
     get_new_cap(size_type boom_size)
     {
-        const auto old_size = capacity();
-        THROW_LENGTH_ERROR_IF(old_size > max_size() - boom_size,
-                              "vector<T>'s size too big");
-        // old size > 2/3 max size
-        if (old_size > max_size() - old_size / 2)
-        {
-            //最小以16个多分配
-            return old_size + boom_size > max_size() - 16
-                   ? old_size + boom_size : old_size + boom_size + 16;
-        }
-        const size_type new_size = old_size == 0
-                                   ? ministl::max(boom_size, static_cast<size_type>(16))
-                                   : ministl::max(old_size + old_size / 2, old_size + boom_size);
-        return new_size;
+        return ministl::allocator_traits<Alloc>::good_size(
+                ministl::growth_capacity(capacity(), boom_size, max_size()));
     }
 
     // fill_assign 函数
-    template <class T>
-    void vector<T>::
+    template <class T, class Alloc>
+    void vector<T, Alloc>::
     fill_assign(size_type n, const value_type& value)
     {
         if (n > capacity())
@@ -680,9 +840,9 @@ namespace ministl
         }
     }
 
-    template <class T>
+    template <class T, class Alloc>
     template <class Iter>
-    void vector<T>::
+    void vector<T, Alloc>::
     copy_assign(Iter first, Iter last, ministl::input_iterator_tag)
     {
         auto cur = begin_;
@@ -701,9 +861,9 @@ namespace ministl
     }
 
     // 用 [first, last) 为容器赋值
-    template <class T>
+    template <class T, class Alloc>
     template <class FIter>
-    void vector<T>::
+    void vector<T, Alloc>::
     copy_assign(FIter first, FIter last, forward_iterator_tag)
     {
         const size_type len = ministl::distance(first, last);
@@ -732,9 +892,9 @@ namespace ministl
     }
 
     // 重新分配空间并在 pos 处就地构造元素
-    template <class T>
+    template <class T, class Alloc>
     template <class ...Args>
-    void vector<T>::
+    void vector<T, Alloc>::
     reallocate_emplace(iterator pos, Args&& ...args)
     {
         const auto new_size = get_new_cap(1);
@@ -742,10 +902,10 @@ namespace ministl
         auto new_end = new_begin;
         try
         {
-            new_end = ministl::uninitialized_move(begin_, pos, new_begin);
+            new_end = relocate(begin_, pos, new_begin);
             data_allocator::construct(ministl::address_of(*new_end), ministl::forward<Args>(args)...);
             ++new_end;
-            new_end = ministl::uninitialized_move(pos, end_, new_end);
+            new_end = relocate(pos, end_, new_end);
         }
         catch (...)
         {
@@ -759,8 +919,8 @@ namespace ministl
     }
 
     // 重新分配空间并在 pos 处插入元素
-    template <class T>
-    void vector<T>::reallocate_insert(iterator pos, const value_type& value)
+    template <class T, class Alloc>
+    void vector<T, Alloc>::reallocate_insert(iterator pos, const value_type& value)
     {
         const auto new_size = get_new_cap(1);
         auto new_begin = data_allocator::allocate(new_size);
@@ -768,10 +928,10 @@ namespace ministl
         const value_type& value_copy = value;
         try
         {
-            new_end = ministl::uninitialized_move(begin_, pos, new_begin);
+            new_end = relocate(begin_, pos, new_begin);
             data_allocator::construct(ministl::address_of(*new_end), value_copy);
             ++new_end;
-            new_end = ministl::uninitialized_move(pos, end_, new_end);
+            new_end = relocate(pos, end_, new_end);
         }
         catch (...)
         {
@@ -785,9 +945,9 @@ namespace ministl
     }
 
     // fill_insert 函数
-    template <class T>
-    typename vector<T>::iterator
-    vector<T>::
+    template <class T, class Alloc>
+    typename vector<T, Alloc>::iterator
+    vector<T, Alloc>::
     fill_insert(iterator pos, size_type n, const value_type& value)
     {
         if(n == 0)
@@ -819,16 +979,16 @@ namespace ministl
             auto new_end = new_begin;
             try
             {
-                new_end = ministl::uninitialized_move(begin_, pos, new_begin);
+                new_end = relocate(begin_, pos, new_begin);
                 new_end = ministl::uninitialized_fill_n(new_end, n, value);
-                new_end = ministl::uninitialized_move(pos, end_, new_end);
+                new_end = relocate(pos, end_, new_end);
             }
             catch (...)
             {
                 destroy_and_recover(new_begin, new_end, new_size);
                 throw;
             }
-            data_allocator::deallocate(begin_, cap_ - begin_);
+            destroy_and_recover(begin_, end_, cap_ - begin_);
             begin_ = new_begin;
             end_ = new_end;
             cap_ = begin_ + new_size;
@@ -836,13 +996,13 @@ namespace ministl
         return begin_ + xpos;
     }
 
-    template <class T>
+    template <class T, class Alloc>
     template <class IIter>
-    void vector<T>::copy_insert(iterator pos, IIter first, IIter last)
+    void vector<T, Alloc>::copy_insert(iterator pos, IIter first, IIter last)
     {
         if(first == last)
             return;
-        const auto n = distance(first,last);
+        const auto n = ministl::distance(first,last);
         if((cap_ - end_) >= n)
         {
             //备用空间足够
@@ -870,16 +1030,16 @@ namespace ministl
             auto new_end = new_begin;
             try
             {
-                new_end = ministl::uninitialized_move(begin_, pos, new_begin);
+                new_end = relocate(begin_, pos, new_begin);
                 new_end = ministl::uninitialized_copy(first, last, new_end);
-                new_end = ministl::uninitialized_move(pos, end_, new_end);
+                new_end = relocate(pos, end_, new_end);
             }
             catch (...)
             {
                 destroy_and_recover(new_begin, new_end, new_size);
                 throw;
             }
-            data_allocator::deallocate(begin_, cap_ - begin_);
+            destroy_and_recover(begin_, end_, cap_ - begin_);
             begin_ = new_begin;
             end_ = new_end;
             cap_ = begin_ + new_size;
@@ -887,65 +1047,65 @@ namespace ministl
     }
 
     // reinsert 函数
-    template <class T>
-    void vector<T>::reinsert(size_type size)
+    template <class T, class Alloc>
+    void vector<T, Alloc>::reinsert(size_type size)
     {
         auto new_begin = data_allocator::allocate(size);
         try
         {
-            ministl::uninitialized_move(begin_, end_, new_begin);
+            relocate(begin_, end_, new_begin);
         }
         catch (...)
         {
             data_allocator::deallocate(new_begin, size);
             throw;
         }
-        data_allocator::deallocate(begin_, cap_ - begin_);
+        destroy_and_recover(begin_, end_, cap_ - begin_);
         begin_ = new_begin;
         end_ = begin_ + size;
         cap_ = begin_ + size;
     }
 
     //overload
-    template <class T>
-    bool operator==(const vector<T>& lhs,const vector<T>& rhs)
+    template <class T, class Alloc>
+    bool operator==(const vector<T, Alloc>& lhs,const vector<T, Alloc>& rhs)
     {
-        return ministl::lexicographical_compare(lhs.begin(),lhs.end(),rhs.begin(),rhs.end());
+        return lhs.size() == rhs.size() && ministl::equal(lhs.begin(),lhs.end(),rhs.begin());
     }
 
-    template <class T>
-    bool operator < (const vector<T>& lhs,const vector<T>& rhs)
+    template <class T, class Alloc>
+    bool operator < (const vector<T, Alloc>& lhs,const vector<T, Alloc>& rhs)
     {
-        return ministl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), lhs.end());
+        return ministl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
     }
 
-    template <class T>
-    bool operator!=(const vector<T>& lhs, const vector<T>& rhs)
+    template <class T, class Alloc>
+    bool operator!=(const vector<T, Alloc>& lhs, const vector<T, Alloc>& rhs)
     {
         return !(lhs == rhs);
     }
 
-    template <class T>
-    bool operator>(const vector<T>& lhs, const vector<T>& rhs)
+    template <class T, class Alloc>
+    bool operator>(const vector<T, Alloc>& lhs, const vector<T, Alloc>& rhs)
     {
         return rhs < lhs;
     }
 
-    template <class T>
-    bool operator<=(const vector<T>& lhs, const vector<T>& rhs)
+    template <class T, class Alloc>
+    bool operator<=(const vector<T, Alloc>& lhs, const vector<T, Alloc>& rhs)
     {
         return !(rhs < lhs);
     }
 
-    template <class T>
-    bool operator>=(const vector<T>& lhs, const vector<T>& rhs)
+    template <class T, class Alloc>
+    bool operator>=(const vector<T, Alloc>& lhs, const vector<T, Alloc>& rhs)
     {
         return !(lhs < rhs);
     }
 
     // 重载 ministl 的 swap
-    template <class T>
-    void swap(vector<T>& lhs, vector<T>& rhs)
+    template <class T, class Alloc>
+    void swap(vector<T, Alloc>& lhs, vector<T, Alloc>& rhs)
     {
         lhs.swap(rhs);
     }